@@ -0,0 +1,44 @@
+#include <iostream>
+#include <string>
+
+#include "astral/network/SimulationClient.h"
+
+// Connects to simulation_server, rebuilds the streamed viewport and checks the
+// server's hash every tick.
+// Usage: headless_client [port|unix-socket-path] [x y width height]
+int main(int argc, char* argv[]) {
+    std::string endpoint = argc > 1 ? argv[1] : "7777";
+
+    astral::SimulationClient client;
+    bool connected = endpoint.find('/') != std::string::npos
+        ? client.connectUnix(endpoint)
+        : client.connectTcp("127.0.0.1", static_cast<uint16_t>(std::stoi(endpoint)));
+    if (!connected) {
+        std::cerr << "Failed to connect to " << endpoint << std::endl;
+        return 1;
+    }
+
+    if (argc > 5) {
+        client.setViewport(std::stoi(argv[2]), std::stoi(argv[3]), std::stoi(argv[4]), std::stoi(argv[5]));
+    } else {
+        client.setViewport(0, 0, 1 << 20, 1 << 20);
+    }
+
+    uint64_t reported = 0;
+    while (client.poll(100)) {
+        const auto& stats = client.getStats();
+        if (stats.ticks >= reported + 60) {
+            reported = stats.ticks;
+            std::cout << "tick " << client.getLastTick() << ": " << stats.chunksApplied
+                      << " chunks applied, " << stats.bytesReceived << " bytes, "
+                      << stats.verifiedTicks << " verified, " << stats.hashMismatches
+                      << " mismatches" << (client.isVerified() ? " [in sync]" : " [catching up]")
+                      << std::endl;
+        }
+    }
+
+    const auto& stats = client.getStats();
+    std::cout << "Disconnected after " << stats.ticks << " ticks: " << stats.verifiedTicks
+              << " verified, " << stats.hashMismatches << " hash mismatches" << std::endl;
+    return stats.hashMismatches == 0 && stats.protocolErrors == 0 ? 0 : 1;
+}
@@ -4,14 +4,15 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <cstdlib>
 
 #include "astral/physics/CellularAutomaton.h"
 #include "astral/physics/Material.h"
 #include "astral/core/Timer.h"
 
 // Create a larger world to test chunk-based physics
-const int WORLD_WIDTH = 256;  // Spans multiple chunks (64x64)
-const int WORLD_HEIGHT = 128; // Spans multiple chunks (64x64)
+const int WORLD_WIDTH = 256;  // Spans multiple chunks at every supported chunk size
+const int WORLD_HEIGHT = 128;
 
 // Structure to track a point for visualization
 struct Point {
@@ -76,9 +77,10 @@ void displayWorld(const astral::CellularAutomaton& automaton) {
     std::cout << "+" << std::string(viewWidth, '-') << "+" << std::endl;
     
     // Draw chunk grid
-    std::cout << "Chunk divisions (each chunk is 64x64):" << std::endl;
-    int numChunksX = (WORLD_WIDTH + 63) / 64;  // Ceiling division
-    int numChunksY = (WORLD_HEIGHT + 63) / 64; // Ceiling division
+    int chunkSize = automaton.getChunkSize();
+    std::cout << "Chunk divisions (each chunk is " << chunkSize << "x" << chunkSize << "):" << std::endl;
+    int numChunksX = (WORLD_WIDTH + chunkSize - 1) / chunkSize;  // Ceiling division
+    int numChunksY = (WORLD_HEIGHT + chunkSize - 1) / chunkSize; // Ceiling division
     
     for (int cy = 0; cy < numChunksY; cy++) {
         for (int cx = 0; cx < numChunksX; cx++) {
@@ -158,12 +160,19 @@ std::vector<Point> createStoneWalls() {
     return points;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Optional chunk size: 16, 32, 64 or 128
+    int chunkSize = argc > 1 ? std::atoi(argv[1]) : astral::CHUNK_SIZE;
+    if (!astral::isSupportedChunkSize(chunkSize)) {
+        std::cerr << "Unsupported chunk size " << chunkSize << std::endl;
+        return 1;
+    }
+    
     std::cout << "Large World Chunk Testing" << std::endl;
     std::cout << "World size: " << WORLD_WIDTH << "x" << WORLD_HEIGHT << " (spans multiple chunks)" << std::endl;
     
     // Initialize the automaton with a large world
-    astral::CellularAutomaton automaton(WORLD_WIDTH, WORLD_HEIGHT);
+    astral::CellularAutomaton automaton(WORLD_WIDTH, WORLD_HEIGHT, chunkSize);
     automaton.initialize();
     
     // Clear world
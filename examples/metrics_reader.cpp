@@ -0,0 +1,71 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "astral/core/LiveMetrics.h"
+
+// Attaches to a running engine's live metrics segment (enable with the
+// "live_metrics" config option) and prints them without touching its frame loop.
+// Usage: metrics_reader <pid|segment-name> [--prometheus] [--interval ms] [--count n]
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: metrics_reader <pid|segment-name> [--prometheus] [--interval ms] [--count n]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::string target = argv[1];
+    bool prometheus = false;
+    int intervalMs = 1000;
+    int count = 0; // 0 runs until the publisher goes away
+    for (int i = 2; i < argc; i++) {
+        if (std::strcmp(argv[i], "--prometheus") == 0) {
+            prometheus = true;
+        } else if (std::strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            intervalMs = std::stoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = std::stoi(argv[++i]);
+        }
+    }
+
+    // A bare number is the pid of an engine using the default segment name
+    std::string segment = target.find_first_not_of("0123456789") == std::string::npos
+        ? "/astral_metrics_" + target
+        : target;
+
+    astral::MetricsReader reader;
+    if (!reader.open(segment)) {
+        std::cerr << "No live metrics segment " << segment << std::endl;
+        return 1;
+    }
+    std::cerr << "Attached to " << segment << " (pid " << reader.getPublisherPid() << ")" << std::endl;
+
+    uint64_t lastFrame = 0;
+    for (int printed = 0; count == 0 || printed < count; printed++) {
+        astral::LiveMetrics metrics;
+        if (!reader.read(metrics)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+            continue;
+        }
+
+        if (prometheus) {
+            std::cout << astral::formatPrometheus(metrics) << std::endl;
+        } else {
+            std::cout << "frame " << metrics.frame << " (+" << metrics.frame - lastFrame << "): "
+                      << metrics.fps << " fps, frame time p50/p90/p99/max "
+                      << metrics.frameTimeP50Ms << "/" << metrics.frameTimeP90Ms << "/"
+                      << metrics.frameTimeP99Ms << "/" << metrics.frameTimeMaxMs << " ms, "
+                      << metrics.activeChunks << " chunks, " << metrics.updatedCells << " cells updated"
+                      << std::endl;
+            for (int i = 0; i < metrics.passCount && i < astral::LiveMetrics::MAX_PASSES; i++) {
+                std::cout << "  " << metrics.passes[i].name << ": " << metrics.passes[i].lastMs << " ms"
+                          << std::endl;
+            }
+        }
+        lastFrame = metrics.frame;
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+    }
+    return 0;
+}
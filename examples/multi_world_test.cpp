@@ -0,0 +1,47 @@
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "astral/core/ThreadPool.h"
+#include "astral/physics/Material.h"
+#include "astral/physics/WorldScheduler.h"
+
+// Hosts many independent worlds on one worker pool and reports aggregate
+// throughput. Usage: multi_world_test [worlds] [size] [ticks] [threads] [--pin]
+int main(int argc, char* argv[]) {
+    int worldCount = argc > 1 ? std::stoi(argv[1]) : 200;
+    int worldSize = argc > 2 ? std::stoi(argv[2]) : 128;
+    int ticks = argc > 3 ? std::stoi(argv[3]) : 20;
+    size_t threads = argc > 4 ? std::stoul(argv[4]) : 0;
+    bool pin = argc > 5 && std::string(argv[5]) == "--pin";
+
+    // All worlds read materials from one immutable registry
+    auto registry = astral::MaterialRegistry::createShared();
+    astral::ThreadPool pool(threads, pin);
+    astral::WorldScheduler scheduler(pool);
+
+    std::cout << "Creating " << worldCount << " worlds of " << worldSize << "x" << worldSize
+              << " on " << pool.getThreadCount() << " threads in "
+              << pool.getCoreGroupCount() << " core group(s)" << std::endl;
+
+    for (int i = 0; i < worldCount; i++) {
+        auto world = std::make_shared<astral::CellularAutomaton>(worldSize, worldSize, registry);
+        world->initialize();
+
+        // A little falling material so every world has work to do
+        int third = worldSize / 3;
+        world->fillRectangle(third, 4, third, 8, world->getMaterialIDByName("Sand"));
+        world->fillRectangle(third, 16, third, 8, world->getMaterialIDByName("Water"));
+        world->fillRectangle(0, worldSize - 4, worldSize, 4, world->getMaterialIDByName("Stone"));
+        scheduler.addWorld(world);
+    }
+
+    scheduler.run(1.0f / 60.0f, ticks);
+
+    std::cout << "Ran " << ticks << " ticks per world in " << scheduler.getLastRunSeconds()
+              << " s" << std::endl;
+    std::cout << "Aggregate throughput: " << scheduler.getAggregateTicksPerSecond()
+              << " world-ticks/s" << std::endl;
+
+    return 0;
+}
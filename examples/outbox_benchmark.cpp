@@ -0,0 +1,148 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "astral/core/ThreadPool.h"
+#include "astral/physics/CellularAutomaton.h"
+#include "astral/physics/Scenario.h"
+
+// Compares the serial movement phase with the chunk-parallel OUTBOX strategy
+// (per-chunk tasks that defer writes across chunk borders to outboxes settled
+// after the phase) on one world, for each requested worker count. Reports
+// ticks per second and the boundary writes per tick.
+//
+// Usage: outbox_benchmark [--size 1024] [--chunk-size 32] [--scenario mixed] [--activity 0.5]
+//                         [--ticks 20] [--warmup 2] [--threads 1,2,4,8]
+
+namespace {
+
+struct Options {
+    int size = 1024;
+    int chunkSize = astral::CHUNK_SIZE;
+    astral::ScenarioType scenario = astral::ScenarioType::MIXED;
+    float activity = 0.5f;
+    int ticks = 20;
+    int warmupTicks = 2;
+    std::vector<int> threads = {1, 2, 4, 8};
+};
+
+struct Result {
+    double ticksPerSecond = 0.0;
+    double writesPerTick = 0.0;
+    double conflictsPerTick = 0.0;
+    double stalePerTick = 0.0;
+};
+
+// threads == 0 runs the serial strategy
+Result run(const Options& options, int threads)
+{
+    astral::CellularAutomaton world(options.size, options.size, options.chunkSize);
+    std::unique_ptr<astral::ThreadPool> pool;
+    if (threads > 0) {
+        pool = std::make_unique<astral::ThreadPool>(threads);
+        world.setChunkUpdateStrategy(astral::ChunkUpdateStrategy::OUTBOX, pool.get());
+    }
+
+    astral::ScenarioConfig scenario;
+    scenario.type = options.scenario;
+    scenario.activity = options.activity;
+    astral::buildScenario(world, scenario);
+    for (int i = 0; i < options.warmupTicks; i++) {
+        world.update(1.0f / 60.0f);
+    }
+
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.ticks; i++) {
+        world.update(1.0f / 60.0f);
+        const astral::OutboxStats& stats = world.getOutboxStats();
+        result.writesPerTick += stats.writes;
+        result.conflictsPerTick += stats.conflicts;
+        result.stalePerTick += stats.stale;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    result.ticksPerSecond = seconds > 0.0 ? options.ticks / seconds : 0.0;
+    result.writesPerTick /= options.ticks;
+    result.conflictsPerTick /= options.ticks;
+    result.stalePerTick /= options.ticks;
+    return result;
+}
+
+bool parseThreads(const std::string& list, std::vector<int>& threads)
+{
+    threads.clear();
+    std::istringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        int count = std::stoi(item);
+        if (count <= 0) return false;
+        threads.push_back(count);
+    }
+    return !threads.empty();
+}
+
+void printResult(const std::string& mode, const Result& result, double serialTicksPerSecond)
+{
+    std::cout << std::left << std::setw(12) << mode << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << result.ticksPerSecond << std::setw(10)
+              << (serialTicksPerSecond > 0.0 ? result.ticksPerSecond / serialTicksPerSecond : 0.0) << "x"
+              << std::setprecision(0) << std::setw(14) << result.writesPerTick << std::setw(12)
+              << result.conflictsPerTick << std::setw(10) << result.stalePerTick << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) {
+            options.size = std::stoi(argv[++i]);
+        } else if (arg == "--chunk-size" && hasValue) {
+            options.chunkSize = std::stoi(argv[++i]);
+        } else if (arg == "--scenario" && hasValue) {
+            if (!astral::parseScenario(argv[++i], options.scenario)) {
+                std::cerr << "Unknown scenario " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--activity" && hasValue) {
+            options.activity = std::stof(argv[++i]);
+        } else if (arg == "--ticks" && hasValue) {
+            options.ticks = std::stoi(argv[++i]);
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmupTicks = std::stoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            if (!parseThreads(argv[++i], options.threads)) {
+                std::cerr << "Invalid thread list " << argv[i] << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (!astral::isSupportedChunkSize(options.chunkSize) || options.size <= 0 || options.ticks <= 0) {
+        std::cerr << "Invalid size, chunk size or tick count" << std::endl;
+        return 1;
+    }
+
+    std::cout << "World " << options.size << "x" << options.size << ", chunk size " << options.chunkSize
+              << ", scenario " << astral::scenarioName(options.scenario) << ", activity "
+              << options.activity << ", " << options.ticks << " ticks, "
+              << astral::ThreadPool::hardwareThreads() << " hardware threads" << std::endl;
+
+    Result serial = run(options, 0);
+    std::cout << "\nmode          ticks/sec   speedup  writes/tick   conflicts     stale" << std::endl;
+    printResult("serial", serial, serial.ticksPerSecond);
+    for (int threads : options.threads) {
+        printResult("outbox x" + std::to_string(threads), run(options, threads), serial.ticksPerSecond);
+    }
+    return 0;
+}
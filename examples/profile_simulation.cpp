@@ -0,0 +1,47 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "astral/core/SamplingProfiler.h"
+#include "astral/physics/CellularAutomaton.h"
+
+// Runs a mixed scene under the sampling profiler and writes a flat profile and
+// folded stacks (feed the latter to flamegraph.pl or speedscope).
+// Usage: profile_simulation [size] [ticks] [hz] [output-prefix]
+int main(int argc, char* argv[]) {
+    int worldSize = argc > 1 ? std::stoi(argv[1]) : 256;
+    int ticks = argc > 2 ? std::stoi(argv[2]) : 200;
+    int frequency = argc > 3 ? std::stoi(argv[3]) : 997;
+    std::string prefix = argc > 4 ? argv[4] : "simulation_profile";
+
+    astral::CellularAutomaton world(worldSize, worldSize);
+    int third = worldSize / 3;
+    world.fillRectangle(0, worldSize - 8, worldSize, 8, world.getMaterialIDByName("Stone"));
+    world.fillRectangle(8, 8, third, third, world.getMaterialIDByName("Sand"));
+    world.fillRectangle(third + 16, 8, third, third, world.getMaterialIDByName("Water"));
+    world.fillRectangle(2 * third + 24, worldSize / 2, third - 32, 16, world.getMaterialIDByName("Lava"));
+
+    astral::SamplingProfiler& profiler = astral::SamplingProfiler::getInstance();
+    if (!profiler.start(frequency)) {
+        std::cerr << "Sampling profiler is not available on this platform" << std::endl;
+        return 1;
+    }
+    for (int i = 0; i < ticks; i++) {
+        world.update(1.0f / 60.0f);
+    }
+    profiler.stop();
+
+    astral::SampleProfile profile = profiler.buildProfile();
+    std::string flatPath = prefix + ".txt";
+    std::string foldedPath = prefix + ".folded";
+    if (!astral::SamplingProfiler::writeFlatProfile(profile, flatPath, 25) ||
+        !astral::SamplingProfiler::writeFoldedStacks(profile, foldedPath)) {
+        std::cerr << "Failed to write the profile" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Wrote " << flatPath << " and " << foldedPath << std::endl << std::endl;
+    std::ifstream flat(flatPath);
+    std::cout << flat.rdbuf();
+    return 0;
+}
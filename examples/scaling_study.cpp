@@ -0,0 +1,400 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <malloc.h>
+#include <unistd.h>
+#endif
+
+#include "astral/core/Profiler.h"
+#include "astral/core/ThreadPool.h"
+#include "astral/physics/Scenario.h"
+#include "astral/physics/WorldScheduler.h"
+
+// Sweeps worker count, world size, chunk size, scenario and activity over the
+// canonical scenarios and records throughput, parallel efficiency, memory per cell and
+// tick latency. Worlds are independent and share one worker pool, so thread
+// scaling is measured across worlds (one tick of one world runs on one worker).
+//
+// Usage: scaling_study [--threads 1,2,4] [--sizes 256,512] [--scenarios sand,mixed]
+//                      [--activity 0.05,0.25] [--chunk-sizes 16,32,64,128] [--worlds N] [--ticks N] [--warmup N]
+//                      [--memory-mb N] [--csv scaling.csv] [--summary scaling_summary.txt]
+//                      [--no-profiler-check]
+
+namespace {
+
+struct Options {
+    std::vector<int> threads;
+    std::vector<int> sizes = {256, 512, 1024, 2048, 4096, 8192};
+    std::vector<astral::ScenarioType> scenarios = astral::allScenarios();
+    std::vector<float> activities = {0.05f, 0.25f, 0.75f};
+    std::vector<int> chunkSizes = {astral::CHUNK_SIZE};
+    int worlds = 0;             // 0: one world per worker at the largest thread count
+    int ticks = 30;
+    int warmupTicks = 2;
+    double memoryBudgetMb = 0;  // 0: 70% of available memory
+    std::string csvPath = "scaling.csv";
+    std::string summaryPath = "scaling_summary.txt";
+    bool profilerCheck = true;
+};
+
+struct Result {
+    astral::ScenarioType scenario;
+    float activity;
+    int size;
+    int chunkSize;
+    int worlds;
+    int threads;
+    bool profiler;
+    double seconds = 0.0;
+    double ticksPerSecond = 0.0;
+    double cellsPerSecond = 0.0;
+    double efficiency = 0.0;
+    double karpFlatt = 0.0;      // Experimentally determined serial fraction
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    double bytesPerCell = 0.0;
+    double bandwidthGBs = 0.0;   // Estimated cell traffic
+    std::string note;
+
+    Result(astral::ScenarioType scenario, float activity, int size, int chunkSize, int worlds, int threads,
+           bool profiler)
+        : scenario(scenario)
+        , activity(activity)
+        , size(size)
+        , chunkSize(chunkSize)
+        , worlds(worlds)
+        , threads(threads)
+        , profiler(profiler)
+    {
+    }
+};
+
+template <typename T>
+std::vector<T> parseList(const std::string& text, T (*convert)(const std::string&))
+{
+    std::vector<T> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) values.push_back(convert(item));
+    }
+    return values;
+}
+
+int toInt(const std::string& text) { return std::stoi(text); }
+float toFloat(const std::string& text) { return std::stof(text); }
+
+double residentBytes()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    double size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE);
+#else
+    return 0.0;
+#endif
+}
+
+double availableBytes()
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    double value;
+    std::string unit;
+    while (meminfo >> key >> value >> unit) {
+        if (key == "MemAvailable:") return value * 1024.0;
+    }
+    return 4.0 * 1024 * 1024 * 1024;
+}
+
+void releaseFreedMemory()
+{
+#if defined(__linux__) && defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+double percentile(std::vector<float>& values, double fraction)
+{
+    if (values.empty()) return 0.0;
+    size_t index = static_cast<size_t>(fraction * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+Result runConfiguration(const Options& options, astral::ScenarioType scenario, float activity,
+                        int size, int chunkSize, int worldCount, int threads, bool profiler,
+                        std::shared_ptr<const astral::MaterialRegistry> registry)
+{
+    Result result{scenario, activity, size, chunkSize, worldCount, threads, profiler};
+    astral::Profiler::getInstance().initialize(profiler);
+
+    releaseFreedMemory();
+    double rssBefore = residentBytes();
+
+    astral::ThreadPool pool(threads);
+    astral::WorldScheduler scheduler(pool);
+    for (int i = 0; i < worldCount; i++) {
+        auto world = std::make_shared<astral::CellularAutomaton>(size, size, registry, chunkSize);
+        astral::ScenarioConfig config;
+        config.type = scenario;
+        config.activity = activity;
+        config.seed = static_cast<uint32_t>(i + 1);
+        astral::buildScenario(*world, config);
+        scheduler.addWorld(world);
+    }
+
+    double cells = static_cast<double>(size) * size * worldCount;
+    result.bytesPerCell = (residentBytes() - rssBefore) / cells;
+
+    if (options.warmupTicks > 0) {
+        scheduler.run(1.0f / 60.0f, options.warmupTicks);
+    }
+    scheduler.run(1.0f / 60.0f, options.ticks);
+
+    result.seconds = scheduler.getLastRunSeconds();
+    result.ticksPerSecond = scheduler.getAggregateTicksPerSecond();
+    result.cellsPerSecond = result.ticksPerSecond * size * size;
+
+    std::vector<float> tickTimes;
+    for (size_t i = 0; i < scheduler.getWorldCount(); i++) {
+        const auto& times = scheduler.getLastRunTickTimes(i);
+        tickTimes.insert(tickTimes.end(), times.begin(), times.end());
+    }
+    result.p50Ms = percentile(tickTimes, 0.5);
+    result.p99Ms = percentile(tickTimes, 0.99);
+    result.maxMs = tickTimes.empty() ? 0.0 : *std::max_element(tickTimes.begin(), tickTimes.end());
+
+    // The tick reads and writes every cell of an active chunk about three
+    // times (movement, interactions, statistics)
+    result.bandwidthGBs = result.cellsPerSecond * sizeof(astral::Cell) * 3.0 / 1e9;
+
+    astral::Profiler::getInstance().initialize(false);
+    return result;
+}
+
+void writeCsv(const std::string& path, const std::vector<Result>& results)
+{
+    std::ofstream csv(path);
+    csv << "scenario,activity,world_size,chunk_size,worlds,threads,profiler,seconds,ticks_per_sec,"
+           "cells_per_sec,efficiency,karp_flatt,p50_ms,p99_ms,max_ms,bytes_per_cell,"
+           "est_bandwidth_gbs,note\n";
+    for (const auto& r : results) {
+        csv << astral::scenarioName(r.scenario) << "," << r.activity << "," << r.size << ","
+            << r.chunkSize << "," << r.worlds << "," << r.threads << "," << (r.profiler ? 1 : 0) << "," << r.seconds << ","
+            << r.ticksPerSecond << "," << r.cellsPerSecond << "," << r.efficiency << ","
+            << r.karpFlatt << "," << r.p50Ms << "," << r.p99Ms << "," << r.maxMs << ","
+            << r.bytesPerCell << "," << r.bandwidthGBs << "," << r.note << "\n";
+    }
+}
+
+/**
+ * One line per (scenario, activity, size, chunk size): efficiency at the largest thread
+ * count and the most likely reason it falls short.
+ */
+std::string summarize(const std::vector<Result>& results, size_t hardwareThreads)
+{
+    using Key = std::tuple<int, float, int, int>;
+    std::map<Key, std::vector<const Result*>> groups;
+    for (const auto& r : results) {
+        groups[Key(static_cast<int>(r.scenario), r.activity, r.size, r.chunkSize)].push_back(&r);
+    }
+
+    // Efficiency of the smallest world of each scenario and activity, the
+    // reference for spotting memory-bound sizes
+    std::map<std::pair<int, float>, double> smallWorldEfficiency;
+
+    std::ostringstream out;
+    out << std::left << std::setw(10) << "scenario" << std::setw(9) << "activity" << std::setw(7) << "size"
+        << std::setw(7) << "chunk"        << std::setw(9) << "threads" << std::setw(13) << "ticks/s" << std::setw(8) << "eff"
+        << std::setw(8) << "serial" << std::setw(10) << "p99 ms" << std::setw(10) << "B/cell"
+        << std::setw(9) << "GB/s" << std::setw(10) << "prof ovh" << "limit\n";
+
+    for (const auto& group : groups) {
+        const Result* widest = nullptr;
+        const Result* withProfiler = nullptr;
+        for (const Result* r : group.second) {
+            if (r->profiler) {
+                withProfiler = r;
+            } else if (r->note.empty() && (!widest || r->threads > widest->threads)) {
+                widest = r;
+            }
+        }
+        if (!widest) {
+            out << std::setw(10) << astral::scenarioName(group.second.front()->scenario)
+                << std::setw(9) << group.second.front()->activity << std::setw(7)
+                << group.second.front()->size << std::setw(7) << group.second.front()->chunkSize
+                << group.second.front()->note << "\n";
+            continue;
+        }
+
+        auto reference = std::make_pair(static_cast<int>(widest->scenario), widest->activity);
+        if (!smallWorldEfficiency.count(reference)) {
+            smallWorldEfficiency[reference] = widest->efficiency;
+        }
+
+        double profilerOverhead = withProfiler && widest->ticksPerSecond > 0.0
+            ? 1.0 - withProfiler->ticksPerSecond / widest->ticksPerSecond : 0.0;
+
+        std::string limit;
+        if (widest->threads == 1) {
+            limit = "single thread only";
+        } else if (widest->efficiency >= 0.8) {
+            limit = "scales";
+        } else if (static_cast<size_t>(widest->threads) > hardwareThreads) {
+            limit = "oversubscribed (" + std::to_string(hardwareThreads) + " hardware threads)";
+        } else if (profilerOverhead >= 0.10) {
+            limit = "Profiler lock contention";
+        } else if (smallWorldEfficiency[reference] - widest->efficiency >= 0.15) {
+            limit = "memory bandwidth";
+        } else if (widest->worlds < widest->threads) {
+            limit = "too few worlds for the workers";
+        } else {
+            limit = "serial sections";
+        }
+
+        out << std::setw(10) << astral::scenarioName(widest->scenario) << std::setw(9) << widest->activity
+            << std::setw(7) << widest->size << std::setw(7) << widest->chunkSize
+            << std::setw(9) << widest->threads
+            << std::setw(13) << std::fixed << std::setprecision(1) << widest->ticksPerSecond
+            << std::setw(8) << std::setprecision(2) << widest->efficiency
+            << std::setw(8) << widest->karpFlatt
+            << std::setw(10) << std::setprecision(1) << widest->p99Ms
+            << std::setw(10) << std::setprecision(0) << widest->bytesPerCell
+            << std::setw(9) << std::setprecision(2) << widest->bandwidthGBs
+            << std::setw(10) << (withProfiler ? std::to_string(static_cast<int>(profilerOverhead * 100)) + "%" : "-")
+            << limit << "\n";
+    }
+    return out.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() { return i + 1 < argc ? std::string(argv[++i]) : std::string(); };
+        if (arg == "--threads") options.threads = parseList(next(), toInt);
+        else if (arg == "--sizes") options.sizes = parseList(next(), toInt);
+        else if (arg == "--activity") options.activities = parseList(next(), toFloat);
+        else if (arg == "--chunk-sizes") options.chunkSizes = parseList(next(), toInt);
+        else if (arg == "--worlds") options.worlds = std::stoi(next());
+        else if (arg == "--ticks") options.ticks = std::stoi(next());
+        else if (arg == "--warmup") options.warmupTicks = std::stoi(next());
+        else if (arg == "--memory-mb") options.memoryBudgetMb = std::stod(next());
+        else if (arg == "--csv") options.csvPath = next();
+        else if (arg == "--summary") options.summaryPath = next();
+        else if (arg == "--no-profiler-check") options.profilerCheck = false;
+        else if (arg == "--scenarios") {
+            options.scenarios.clear();
+            std::stringstream names(next());
+            std::string name;
+            while (std::getline(names, name, ',')) {
+                astral::ScenarioType type;
+                if (!astral::parseScenario(name, type)) {
+                    std::cerr << "Unknown scenario " << name << std::endl;
+                    return 1;
+                }
+                options.scenarios.push_back(type);
+            }
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    size_t hardwareThreads = astral::ThreadPool::hardwareThreads();
+    if (options.threads.empty()) {
+        for (size_t t = 1; t < hardwareThreads; t *= 2) options.threads.push_back(static_cast<int>(t));
+        options.threads.push_back(static_cast<int>(hardwareThreads));
+    }
+    std::sort(options.threads.begin(), options.threads.end());
+    for (int chunkSize : options.chunkSizes) {
+        if (!astral::isSupportedChunkSize(chunkSize)) {
+            std::cerr << "Unsupported chunk size " << chunkSize << std::endl;
+            return 1;
+        }
+    }
+    int maxThreads = options.threads.back();
+    int worldCount = options.worlds > 0 ? options.worlds : maxThreads;
+    double memoryBudget = options.memoryBudgetMb > 0 ? options.memoryBudgetMb * 1024 * 1024
+                                                     : availableBytes() * 0.7;
+
+    std::cout << "Scaling study: " << hardwareThreads << " hardware threads, " << worldCount
+              << " worlds per configuration, memory budget " << static_cast<int>(memoryBudget / (1 << 20))
+              << " MB" << std::endl;
+
+    auto registry = astral::MaterialRegistry::createShared();
+    std::vector<Result> results;
+    double bytesPerCellEstimate = sizeof(astral::Cell) * 1.5;
+
+    for (astral::ScenarioType scenario : options.scenarios) {
+        for (float activity : options.activities) {
+            for (int size : options.sizes) {
+                double estimate = bytesPerCellEstimate * size * size * worldCount;
+                for (int chunkSize : options.chunkSizes) {
+                    if (estimate > memoryBudget) {
+                        Result skipped{scenario, activity, size, chunkSize, worldCount, 0, false};
+                        skipped.note = "skipped: needs ~" + std::to_string(static_cast<int>(estimate / (1 << 20))) + " MB";
+                        results.push_back(skipped);
+                        std::cout << astral::scenarioName(scenario) << " " << activity << " " << size << "^2: "
+                                  << skipped.note << std::endl;
+                        continue;
+                    }
+
+                    double singleThread = 0.0;
+                    for (int threads : options.threads) {
+                        Result result = runConfiguration(options, scenario, activity, size, chunkSize, worldCount,
+                                                         threads, false, registry);
+                        if (threads == options.threads.front()) {
+                            singleThread = result.ticksPerSecond / threads;
+                        }
+                        double speedup = singleThread > 0.0 ? result.ticksPerSecond / singleThread : 0.0;
+                        result.efficiency = speedup / threads;
+                        if (threads > 1 && speedup > 0.0) {
+                            result.karpFlatt = (1.0 / speedup - 1.0 / threads) / (1.0 - 1.0 / threads);
+                        }
+                        if (result.bytesPerCell > 0.0) {
+                            bytesPerCellEstimate = std::max(bytesPerCellEstimate, result.bytesPerCell);
+                        }
+
+                        std::cout << astral::scenarioName(scenario) << " " << activity << " " << size << "^2 x"
+                                  << worldCount << " (chunk " << chunkSize << ") on " << threads << " threads: "
+                                  << result.ticksPerSecond << " ticks/s, efficiency " << result.efficiency
+                                  << ", p99 " << result.p99Ms << " ms" << std::endl;
+                        results.push_back(result);
+                    }
+
+                    // Same widest run with the Profiler recording from every world
+                    if (options.profilerCheck && maxThreads > 1) {
+                        Result result = runConfiguration(options, scenario, activity, size, chunkSize, worldCount,
+                                                         maxThreads, true, registry);
+                        std::cout << "  with Profiler enabled: " << result.ticksPerSecond << " ticks/s" << std::endl;
+                        results.push_back(result);
+                    }
+                }
+            }
+        }
+    }
+
+    writeCsv(options.csvPath, results);
+    std::string summary = summarize(results, hardwareThreads);
+    std::ofstream(options.summaryPath) << summary;
+
+    std::cout << std::endl << summary << std::endl
+              << "Wrote " << options.csvPath << " and " << options.summaryPath << std::endl;
+    return 0;
+}
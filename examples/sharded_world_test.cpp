@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "astral/physics/Material.h"
+#include "astral/physics/WorldShard.h"
+
+// Runs one world split across N local processes and compares the wall time
+// with the same world in a single process.
+// Usage: sharded_world_test [shards] [width] [height] [ticks]
+
+namespace {
+
+// Same scene for the single world and for every shard (shards clip to their strip)
+template <typename World>
+void buildScene(World& world, const astral::MaterialRegistry& registry, int width, int height) {
+    astral::MaterialID stone = registry.getIDFromName("Stone");
+    astral::MaterialID sand = registry.getIDFromName("Sand");
+    astral::MaterialID water = registry.getIDFromName("Water");
+
+    world.fillRectangle(0, height - 8, width, 8, stone);
+    for (int x = 16; x + 24 < width; x += 96) {
+        world.fillRectangle(x, 8, 24, height / 3, sand);
+        world.fillRectangle(x + 48, height / 4, 24, height / 4, water);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int shardCount = argc > 1 ? std::stoi(argv[1]) : 4;
+    int width = argc > 2 ? std::stoi(argv[2]) : 1024;
+    int height = argc > 3 ? std::stoi(argv[3]) : 256;
+    int ticks = argc > 4 ? std::stoi(argv[4]) : 60;
+    const float deltaTime = 1.0f / 60.0f;
+
+    auto registry = astral::MaterialRegistry::createShared();
+
+    // Single-process baseline
+    double singleSeconds = 0.0;
+    {
+        astral::CellularAutomaton world(width, height, registry);
+        buildScene(world, *registry, width, height);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ticks; i++) {
+            world.update(deltaTime);
+        }
+        singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Sharded run: one child process per strip, attached by segment name
+    const std::string segment = "astral_shards_" + std::to_string(getpid());
+    auto exchange = astral::ShardExchange::create(segment, width, height, shardCount);
+
+    std::vector<pid_t> children;
+    for (int i = 0; i < shardCount; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            auto attached = astral::ShardExchange::open(segment);
+            astral::WorldShard shard(*attached, i, registry);
+            buildScene(shard, *registry, width, height);
+            shard.run(deltaTime, ticks);
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+
+    bool failed = false;
+    for (pid_t pid : children) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        failed |= !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+    if (failed) {
+        std::cerr << "A shard process failed" << std::endl;
+        return 1;
+    }
+
+    double shardedSeconds = 0.0;
+    uint64_t sent = 0, accepted = 0, displaced = 0, dropped = 0;
+    for (int i = 0; i < shardCount; i++) {
+        const astral::ShardStats& stats = exchange->getStats(i);
+        shardedSeconds = std::max(shardedSeconds, stats.elapsedSeconds);
+        sent += stats.migrantsSent;
+        accepted += stats.migrantsAccepted;
+        displaced += stats.migrantsDisplaced;
+        dropped += stats.migrantsDropped;
+        std::cout << "Shard " << i << " [" << exchange->getShardBegin(i) << ", "
+                  << exchange->getShardEnd(i) << "): " << stats.ticks << " ticks in "
+                  << stats.elapsedSeconds << " s" << std::endl;
+    }
+
+    double speedup = shardedSeconds > 0.0 ? singleSeconds / shardedSeconds : 0.0;
+    std::cout << "World " << width << "x" << height << ", " << ticks << " ticks" << std::endl;
+    std::cout << "Single process: " << singleSeconds << " s" << std::endl;
+    std::cout << shardCount << " processes:    " << shardedSeconds << " s" << std::endl;
+    std::cout << "Speedup " << speedup << "x, scaling efficiency "
+              << (speedup / shardCount * 100.0) << "%" << std::endl;
+    std::cout << "Boundary migrants: " << sent << " sent, " << accepted << " accepted, "
+              << displaced << " displaced, " << dropped << " dropped" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "astral/network/SimulationServer.h"
+#include "astral/physics/CellularAutomaton.h"
+
+// Runs a world and streams it to headless_client instances.
+// Usage: simulation_server [port|unix-socket-path] [ticks] [bandwidth-bytes-per-second]
+int main(int argc, char* argv[]) {
+    std::string endpoint = argc > 1 ? argv[1] : "7777";
+    int ticks = argc > 2 ? std::stoi(argv[2]) : 600;
+    size_t bandwidth = argc > 3 ? std::stoul(argv[3]) : 0;
+
+    astral::CellularAutomaton world(512, 256);
+    world.generateWorld(astral::WorldTemplate::TERRAIN_WITH_WATER);
+    world.fillRectangle(200, 10, 60, 40, world.getMaterialIDByName("Sand"));
+
+    astral::SimulationServer server(world);
+    server.setBandwidthLimit(bandwidth);
+    bool listening = endpoint.find('/') != std::string::npos
+        ? server.listenUnix(endpoint)
+        : server.listenTcp(static_cast<uint16_t>(std::stoi(endpoint)));
+    if (!listening) {
+        std::cerr << "Failed to listen on " << endpoint << std::endl;
+        return 1;
+    }
+    std::cout << "Streaming " << world.getWorldWidth() << "x" << world.getWorldHeight()
+              << " world on " << endpoint << std::endl;
+
+    const float deltaTime = 1.0f / 60.0f;
+    for (int tick = 0; tick < ticks; tick++) {
+        auto start = std::chrono::steady_clock::now();
+        world.update(deltaTime);
+        server.tick(deltaTime);
+
+        if (tick % 60 == 0) {
+            const auto& stats = server.getStats();
+            std::cout << "tick " << tick << ": " << server.getClientCount() << " client(s), "
+                      << stats.chunksSent << " chunks, " << stats.bytesSent << " bytes sent ("
+                      << stats.rawBytes << " raw)" << std::endl;
+        }
+
+        std::this_thread::sleep_until(start + std::chrono::duration<float>(deltaTime));
+    }
+
+    return 0;
+}
@@ -0,0 +1,236 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "astral/core/ThreadPool.h"
+#include "astral/physics/CellularAutomaton.h"
+#include "astral/physics/Scenario.h"
+
+// Compares per-chunk heap storage with the contiguous, huge-page backed chunk
+// slab on one large world: ticks per second plus data TLB misses per tick read
+// from the hardware counters (Linux perf events; reported as n/a when the
+// kernel or the container does not expose them).
+//
+// Usage: slab_benchmark [--size 8192] [--chunk-size 32] [--scenario mixed] [--activity 0.25]
+//                       [--ticks 20] [--warmup 2] [--prefault] [--first-touch-threads N]
+//                       [--no-huge-pages]
+
+namespace {
+
+struct Options {
+    int size = 8192;
+    int chunkSize = astral::CHUNK_SIZE;
+    astral::ScenarioType scenario = astral::ScenarioType::MIXED;
+    float activity = 0.25f;
+    int ticks = 20;
+    int warmupTicks = 2;
+    bool prefault = false;
+    int firstTouchThreads = 0;   // 0: prefault on the calling thread
+    bool hugePages = true;
+};
+
+// Counts one hardware cache event for the calling thread
+class PerfCounter {
+public:
+    explicit PerfCounter(uint64_t config) : fd(-1)
+    {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)config;
+#endif
+    }
+
+    ~PerfCounter()
+    {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool isAvailable() const { return fd >= 0; }
+
+    void start()
+    {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    uint64_t stop()
+    {
+        uint64_t count = 0;
+#ifdef __linux__
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != sizeof(count)) count = 0;
+#endif
+        return count;
+    }
+
+private:
+    int fd;
+};
+
+#ifdef __linux__
+uint64_t dtlbMissConfig(uint64_t op)
+{
+    return PERF_COUNT_HW_CACHE_DTLB | (op << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+#endif
+
+struct Result {
+    double ticksPerSecond = 0.0;
+    double loadMissesPerTick = -1.0;
+    double storeMissesPerTick = -1.0;
+    double setupSeconds = 0.0;
+};
+
+Result run(const Options& options, bool useSlab)
+{
+    Result result;
+    auto setupStart = std::chrono::steady_clock::now();
+
+    astral::CellularAutomaton world(options.size, options.size, options.chunkSize);
+    std::unique_ptr<astral::ThreadPool> pool;
+    if (useSlab) {
+        astral::ChunkSlabConfig config;
+        config.hugePages = options.hugePages;
+        config.prefault = options.prefault;
+        if (options.prefault && options.firstTouchThreads > 0) {
+            pool = std::make_unique<astral::ThreadPool>(options.firstTouchThreads, true);
+            config.firstTouchPool = pool.get();
+        }
+        const astral::ChunkSlab& slab = world.enableSlabStorage(config);
+        std::cout << "  slab: " << slab.getBytes() / (1024 * 1024) << " MiB, "
+                  << (slab.isMapped() ? "mmap" : "heap") << ", huge pages "
+                  << (slab.isHugePageAdvised() ? "advised" : "off") << ", "
+                  << slab.getStripeCount() << " stripe(s)" << std::endl;
+    }
+
+    astral::ScenarioConfig scenario;
+    scenario.type = options.scenario;
+    scenario.activity = options.activity;
+    astral::buildScenario(world, scenario);
+    result.setupSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - setupStart).count();
+
+    for (int i = 0; i < options.warmupTicks; i++) {
+        world.update(1.0f / 60.0f);
+    }
+
+#ifdef __linux__
+    PerfCounter loadMisses(dtlbMissConfig(PERF_COUNT_HW_CACHE_OP_READ));
+    PerfCounter storeMisses(dtlbMissConfig(PERF_COUNT_HW_CACHE_OP_WRITE));
+#else
+    PerfCounter loadMisses(0);
+    PerfCounter storeMisses(0);
+#endif
+    loadMisses.start();
+    storeMisses.start();
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.ticks; i++) {
+        world.update(1.0f / 60.0f);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t loads = loadMisses.stop();
+    uint64_t stores = storeMisses.stop();
+
+    result.ticksPerSecond = seconds > 0.0 ? options.ticks / seconds : 0.0;
+    if (loadMisses.isAvailable()) result.loadMissesPerTick = static_cast<double>(loads) / options.ticks;
+    if (storeMisses.isAvailable()) result.storeMissesPerTick = static_cast<double>(stores) / options.ticks;
+    return result;
+}
+
+std::string formatCount(double value)
+{
+    if (value < 0.0) return "n/a";
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(0) << value;
+    return out.str();
+}
+
+void printResult(const char* mode, const Result& result)
+{
+    std::cout << std::left << std::setw(6) << mode << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << result.ticksPerSecond << std::setw(16) << formatCount(result.loadMissesPerTick)
+              << std::setw(16) << formatCount(result.storeMissesPerTick) << std::setw(12)
+              << result.setupSeconds << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) {
+            options.size = std::stoi(argv[++i]);
+        } else if (arg == "--chunk-size" && hasValue) {
+            options.chunkSize = std::stoi(argv[++i]);
+        } else if (arg == "--scenario" && hasValue) {
+            if (!astral::parseScenario(argv[++i], options.scenario)) {
+                std::cerr << "Unknown scenario " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--activity" && hasValue) {
+            options.activity = std::stof(argv[++i]);
+        } else if (arg == "--ticks" && hasValue) {
+            options.ticks = std::stoi(argv[++i]);
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmupTicks = std::stoi(argv[++i]);
+        } else if (arg == "--prefault") {
+            options.prefault = true;
+        } else if (arg == "--first-touch-threads" && hasValue) {
+            options.firstTouchThreads = std::stoi(argv[++i]);
+        } else if (arg == "--no-huge-pages") {
+            options.hugePages = false;
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (!astral::isSupportedChunkSize(options.chunkSize) || options.size <= 0 || options.ticks <= 0) {
+        std::cerr << "Invalid size, chunk size or tick count" << std::endl;
+        return 1;
+    }
+
+    std::cout << "World " << options.size << "x" << options.size << ", chunk size " << options.chunkSize
+              << ", scenario " << astral::scenarioName(options.scenario) << ", activity "
+              << options.activity << ", " << options.ticks << " ticks" << std::endl;
+
+    Result heap = run(options, false);
+    Result slab = run(options, true);
+
+    std::cout << "\nmode   ticks/sec  dTLB-load/tick dTLB-store/tick   setup (s)" << std::endl;
+    printResult("heap", heap);
+    printResult("slab", slab);
+    if (heap.ticksPerSecond > 0.0) {
+        std::cout << "\nslab speedup: " << std::setprecision(2) << slab.ticksPerSecond / heap.ticksPerSecond
+                  << "x" << std::endl;
+    }
+    return 0;
+}
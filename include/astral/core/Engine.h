@@ -10,6 +10,7 @@ class Config;
 class Timer;
 class PhysicsSystem;
 class RenderingSystem;
+class TickWatchdog;
 
 class Engine {
 public:
@@ -32,6 +33,7 @@ private:
     std::unique_ptr<Timer> timer;
     std::unique_ptr<PhysicsSystem> physics;
     std::unique_ptr<RenderingSystem> renderer;
+    std::unique_ptr<TickWatchdog> watchdog;   // Slow-frame watchdog, if enabled
 
     double deltaTime;
     double time;
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace astral {
+
+/**
+ * Timing of one profiled pass (a Profiler section) in the last frame.
+ */
+struct LiveMetricsPass {
+    char name[32];
+    double lastMs;
+};
+
+/**
+ * Snapshot of engine metrics published once per frame. Plain data with a fixed
+ * layout so other processes can map it directly.
+ */
+struct LiveMetrics {
+    static constexpr int MAX_PASSES = 16;
+
+    uint64_t frame = 0;
+    double timestamp = 0.0;        // Seconds since the Unix epoch
+
+    // Frame time over the profiler's history window
+    double frameTimeMs = 0.0;
+    double frameTimeP50Ms = 0.0;
+    double frameTimeP90Ms = 0.0;
+    double frameTimeP99Ms = 0.0;
+    double frameTimeMaxMs = 0.0;
+    double fps = 0.0;
+
+    // Simulation
+    int32_t activeChunks = 0;
+    int32_t updatedCells = 0;
+    int32_t renderedCells = 0;
+
+    // Memory reported through Profiler::recordMemoryUsage
+    uint64_t memoryBytes = 0;
+
+    int32_t passCount = 0;
+    LiveMetricsPass passes[MAX_PASSES] = {};
+};
+
+/**
+ * Writes LiveMetrics into a POSIX shared-memory segment guarded by a seqlock.
+ *
+ * Publishing never blocks: the writer bumps the sequence to an odd value,
+ * copies the snapshot and bumps it back to even. Readers retry while the
+ * sequence is odd or changed during their copy, so they never stall the
+ * publishing thread.
+ */
+class MetricsPublisher {
+public:
+    MetricsPublisher();
+    ~MetricsPublisher();
+
+    MetricsPublisher(const MetricsPublisher&) = delete;
+    MetricsPublisher& operator=(const MetricsPublisher&) = delete;
+
+    /**
+     * Create the segment. An empty name keeps the metrics in private memory,
+     * which is enough for the in-process text endpoint.
+     * @return True if successful, false otherwise
+     */
+    bool open(const std::string& name);
+    void close();
+    bool isOpen() const { return segment != nullptr; }
+    const std::string& getName() const { return name; }
+
+    void publish(const LiveMetrics& metrics);
+
+    /**
+     * Read the latest consistent snapshot from this process.
+     * @return False if nothing was published yet
+     */
+    bool snapshot(LiveMetrics& out) const;
+
+    /**
+     * Default segment name for this process ("/astral_metrics_<pid>").
+     */
+    static std::string defaultSegmentName();
+
+    struct Segment;
+
+private:
+    Segment* segment;
+    std::string name;
+    bool shared;
+};
+
+/**
+ * Attaches read-only to another process's metrics segment.
+ */
+class MetricsReader {
+public:
+    MetricsReader();
+    ~MetricsReader();
+
+    MetricsReader(const MetricsReader&) = delete;
+    MetricsReader& operator=(const MetricsReader&) = delete;
+
+    bool open(const std::string& name);
+    void close();
+
+    // Latest consistent snapshot; false if nothing was published yet or the
+    // writer kept it busy
+    bool read(LiveMetrics& out) const;
+
+    // Process id of the publisher
+    int getPublisherPid() const;
+
+private:
+    const MetricsPublisher::Segment* segment;
+};
+
+/**
+ * Format a snapshot in the Prometheus text exposition format.
+ * @param residentBytes Process resident set size, or 0 to omit it
+ */
+std::string formatPrometheus(const LiveMetrics& metrics, uint64_t residentBytes = 0);
+
+} // namespace astral
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace astral {
+
+/**
+ * Bytes held by a system, broken down by what holds them.
+ *
+ * Each owner adds one entry per kind of data, named like a path
+ * ("chunks/cells", "tick/outbox"), with the number of objects the bytes are
+ * spread over so per-object sizes can be read off. Entries added twice under
+ * the same name are summed.
+ */
+class MemoryReport {
+public:
+    struct Entry {
+        std::string name;
+        size_t bytes = 0;
+        size_t count = 0;   // Chunks, bodies, buffers...; 0 when not meaningful
+    };
+
+    void add(const std::string& name, size_t bytes, size_t count = 0);
+    void clear() { entries.clear(); }
+
+    const std::vector<Entry>& getEntries() const { return entries; }
+
+    // Bytes of an entry, or of every entry below it when name is a prefix
+    // ending in '/'
+    size_t getBytes(const std::string& name) const;
+    size_t getTotalBytes() const;
+
+    // One line per entry with its share of the total and size per object
+    void print(std::ostream& out) const;
+
+private:
+    std::vector<Entry> entries;
+};
+
+// Heap bytes owned by standard containers. Vectors and strings report their
+// capacity. Node based containers are estimated from their size: libstdc++
+// allocates one node per element (two pointers of links for sets and maps,
+// a link and the cached hash for unordered ones) plus the bucket array.
+// Elements' own allocations are not included.
+
+template <typename T, typename A>
+size_t heapBytes(const std::vector<T, A>& v) { return v.capacity() * sizeof(T); }
+
+template <typename A>
+size_t heapBytes(const std::vector<bool, A>& v) { return (v.capacity() + 7) / 8; }
+
+inline size_t heapBytes(const std::string& s) {
+    // Short strings live inside the object
+    return s.capacity() > 15 ? s.capacity() + 1 : 0;
+}
+
+template <typename T, typename A>
+size_t heapBytes(const std::deque<T, A>& d) {
+    // Fixed 512 byte blocks, and the map of block pointers
+    size_t perBlock = sizeof(T) < 512 ? 512 / sizeof(T) : 1;
+    size_t blocks = d.size() / perBlock + 1;
+    return blocks * perBlock * sizeof(T) + (blocks + 2) * sizeof(void*);
+}
+
+template <typename K, typename C, typename A>
+size_t heapBytes(const std::set<K, C, A>& s) { return s.size() * (sizeof(K) + 4 * sizeof(void*)); }
+
+template <typename K, typename V, typename C, typename A>
+size_t heapBytes(const std::map<K, V, C, A>& m) {
+    return m.size() * (sizeof(typename std::map<K, V, C, A>::value_type) + 4 * sizeof(void*));
+}
+
+template <typename K, typename H, typename E, typename A>
+size_t heapBytes(const std::unordered_set<K, H, E, A>& s) {
+    return s.bucket_count() * sizeof(void*) + s.size() * (sizeof(K) + 2 * sizeof(void*));
+}
+
+template <typename K, typename V, typename H, typename E, typename A>
+size_t heapBytes(const std::unordered_map<K, V, H, E, A>& m) {
+    return m.bucket_count() * sizeof(void*) +
+           m.size() * (sizeof(typename std::unordered_map<K, V, H, E, A>::value_type) + 2 * sizeof(void*));
+}
+
+} // namespace astral
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace astral {
+
+class MetricsPublisher;
+
+/**
+ * Minimal HTTP endpoint on 127.0.0.1 serving the latest LiveMetrics in the
+ * Prometheus text format. It runs on its own thread and reads the publisher
+ * through its seqlock, so scrapes never wait on the frame loop.
+ */
+class MetricsEndpoint {
+public:
+    explicit MetricsEndpoint(const MetricsPublisher& publisher);
+    ~MetricsEndpoint();
+
+    MetricsEndpoint(const MetricsEndpoint&) = delete;
+    MetricsEndpoint& operator=(const MetricsEndpoint&) = delete;
+
+    /**
+     * Start serving.
+     * @param port Port to listen on (0 picks a free port, see getPort())
+     * @return True if successful, false otherwise
+     */
+    bool start(uint16_t port);
+    void stop();
+
+    uint16_t getPort() const { return port; }
+    uint64_t getRequestCount() const { return requests.load(std::memory_order_relaxed); }
+
+private:
+    const MetricsPublisher& publisher;
+    std::thread thread;
+    std::atomic<bool> running;
+    std::atomic<uint64_t> requests;
+    int listenSocket;
+    uint16_t port;
+
+    void serve();
+    void respond(int client);
+};
+
+} // namespace astral
@@ -10,6 +10,9 @@
 
 namespace astral {
 
+class MetricsPublisher;
+class MetricsEndpoint;
+
 /**
  * Performance metrics for different aspects of the engine.
  */
@@ -110,6 +113,12 @@ public:
      */
     void recordMemoryUsage(const std::string& name, size_t bytes);
     
+    /**
+     * Forget the memory usage of every subsystem whose name starts with a prefix.
+     * @param prefix Name prefix of the subsystems
+     */
+    void removeMemoryUsage(const std::string& prefix);
+    
     /**
      * Get the current performance metrics.
      * @return Current performance metrics
@@ -124,6 +133,12 @@ public:
      */
     std::vector<double> getMetricHistory(const std::string& name, size_t maxFrames = 0) const;
     
+    /**
+     * Get the time spent in each section during the current frame.
+     * @return Section names and times in milliseconds, sorted by name
+     */
+    std::vector<std::pair<std::string, double>> getSectionTimes() const;
+    
     /**
      * Reset all metrics and timers.
      */
@@ -136,6 +151,37 @@ public:
      */
     bool saveToFile(const std::string& filepath) const;
     
+    /**
+     * Publish live metrics (see LiveMetrics) at the end of every frame.
+     * @param segmentName Shared-memory segment name, or empty to keep the
+     *                    metrics in-process (for the text endpoint only)
+     * @return True if successful, false otherwise
+     */
+    bool enableLiveMetrics(const std::string& segmentName);
+    
+    /**
+     * Serve live metrics in Prometheus text format on 127.0.0.1.
+     * Enables in-process live metrics if they are not already on.
+     * @param port Port to listen on (0 picks a free port)
+     * @return True if successful, false otherwise
+     */
+    bool enableMetricsEndpoint(uint16_t port);
+    
+    /**
+     * Stop the endpoint and remove the shared-memory segment.
+     */
+    void disableLiveMetrics();
+    
+    /**
+     * Get the live metrics publisher, or nullptr when disabled.
+     */
+    const MetricsPublisher* getLiveMetrics() const { return liveMetrics.get(); }
+    
+    /**
+     * Get the metrics endpoint, or nullptr when not serving.
+     */
+    const MetricsEndpoint* getMetricsEndpoint() const { return metricsEndpoint.get(); }
+    
 private:
     Profiler();
     ~Profiler();
@@ -163,12 +209,19 @@ private:
     // Maximum history length
     size_t maxHistoryLength;
     
+    // Live metrics export
+    std::unique_ptr<MetricsPublisher> liveMetrics;
+    std::unique_ptr<MetricsEndpoint> metricsEndpoint;
+    uint64_t frameCount;
+    std::vector<double> sortedFrameTimes;  // Scratch for percentiles
+    
     // Thread safety
     mutable std::mutex mutex;
     
     // Helper methods
     double calculateFrameTime();
     void updateMemoryMetrics();
+    void publishLiveMetrics();
 };
 
 /**
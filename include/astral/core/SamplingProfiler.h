@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace astral {
+
+/**
+ * What the current thread is working on, for attributing sampled CPU time.
+ * Kernels update it with plain stores; the signal handler copies it into
+ * each sample. The strings must be literals (or otherwise outlive the
+ * profiler) since only the pointers are stored.
+ */
+struct SampleContext {
+    const char* phase = nullptr;      // e.g. "movement", "interactions"
+    const char* material = nullptr;   // Material type being updated
+    int32_t chunkX = 0;
+    int32_t chunkY = 0;
+    bool hasChunk = false;
+};
+
+/**
+ * Get the calling thread's sample context.
+ */
+inline SampleContext& currentSampleContext()
+{
+    static thread_local SampleContext context;
+    return context;
+}
+
+/**
+ * Sets the phase for the lifetime of the scope and restores the previous
+ * context afterwards.
+ */
+class SampleContextScope {
+public:
+    explicit SampleContextScope(const char* phase)
+        : saved(currentSampleContext())
+    {
+        currentSampleContext().phase = phase;
+    }
+    ~SampleContextScope() { currentSampleContext() = saved; }
+
+    SampleContextScope(const SampleContextScope&) = delete;
+    SampleContextScope& operator=(const SampleContextScope&) = delete;
+
+private:
+    SampleContext saved;
+};
+
+/**
+ * Aggregated samples.
+ */
+struct SampleProfile {
+    uint64_t totalSamples = 0;
+    uint64_t droppedSamples = 0;
+    int frequencyHz = 0;
+
+    std::map<std::string, uint64_t> selfSamples;       // Leaf function
+    std::map<std::string, uint64_t> totalSamplesByFunction; // Function anywhere on the stack
+    std::map<std::string, uint64_t> phaseSamples;
+    std::map<std::string, uint64_t> materialSamples;
+    std::map<std::pair<int32_t, int32_t>, uint64_t> chunkSamples;
+    std::map<std::string, uint64_t> foldedStacks;     // "root;...;leaf" -> samples
+};
+
+/**
+ * Statistical CPU profiler driven by a process CPU-time timer (timer_create
+ * with CLOCK_PROCESS_CPUTIME_ID delivering SIGPROF).
+ *
+ * Each sample stores the interrupted program counter, the call stack and the
+ * thread's SampleContext in a preallocated buffer, so the signal handler never
+ * allocates or locks. Symbols are resolved after sampling stops by reading the
+ * ELF symbol tables of the loaded modules, so no external tools are required.
+ * Only available on Linux.
+ */
+class SamplingProfiler {
+public:
+    static constexpr int MAX_STACK_DEPTH = 32;
+
+    static SamplingProfiler& getInstance();
+
+    /**
+     * Start sampling.
+     * @param frequencyHz Samples per second of process CPU time
+     * @param maxSamples Sample buffer size (about 300 bytes per sample); later
+     *                   samples are counted as dropped
+     * @return True if successful, false otherwise
+     */
+    bool start(int frequencyHz = 997, size_t maxSamples = 1 << 15);
+    void stop();
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+
+    // Discard the collected samples
+    void clear();
+
+    size_t getSampleCount() const;
+    size_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * Symbolise and aggregate the collected samples. Call after stop().
+     */
+    SampleProfile buildProfile() const;
+
+    /**
+     * Write a human-readable flat profile (self/total time per function,
+     * per phase, per material and hottest chunks).
+     */
+    static bool writeFlatProfile(const SampleProfile& profile, const std::string& filepath, size_t maxRows = 40);
+
+    /**
+     * Write folded stacks ("frame;frame;frame count" per line) for
+     * flamegraph.pl, speedscope or inferno. Context tags become root frames.
+     */
+    static bool writeFoldedStacks(const SampleProfile& profile, const std::string& filepath);
+
+    struct Sample {
+        SampleContext context;
+        uint32_t depth;
+        void* frames[MAX_STACK_DEPTH];   // Leaf first
+    };
+
+private:
+    SamplingProfiler();
+    ~SamplingProfiler();
+
+    SamplingProfiler(const SamplingProfiler&) = delete;
+    SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+    std::vector<Sample> samples;
+    std::atomic<size_t> nextSample;
+    std::atomic<size_t> dropped;
+    std::atomic<bool> running;
+    bool handlerInstalled;
+    int frequency;
+    void* timer;
+
+    static void handleSignal(int signal, void* info, void* context);
+};
+
+} // namespace astral
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace astral {
+
+/**
+ * Fixed-size worker pool shared by simulations that run side by side.
+ *
+ * Workers are grouped by core group (one group per NUMA node when the topology
+ * is available, otherwise a single group). Tasks can be submitted to a specific
+ * group; a worker prefers tasks from its own group and only steals from other
+ * groups when its own queue is empty, which keeps related work on one node.
+ */
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * Create the pool.
+     * @param threadCount Number of workers (0 uses the hardware thread count)
+     * @param pinToCoreGroups Restrict each worker to the CPUs of its core group
+     */
+    explicit ThreadPool(size_t threadCount = 0, bool pinToCoreGroups = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queue a task for execution.
+     * @param task Work to run on a worker thread
+     * @param coreGroup Preferred core group, or -1 for any group
+     */
+    void submit(Task task, int coreGroup = -1);
+
+    /**
+     * Block until every submitted task (including tasks submitted by tasks)
+     * has finished.
+     */
+    void waitIdle();
+
+    /**
+     * Run body(0) .. body(count - 1) on the workers and the calling thread,
+     * returning once those calls have finished. Unlike waitIdle() this does
+     * not wait for other work on the pool, and since the caller takes
+     * iterations itself it may be called from a task running on the pool.
+     * @param count Number of iterations
+     * @param body Work for one iteration
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    /**
+     * Get the number of worker threads.
+     */
+    size_t getThreadCount() const { return workers.size(); }
+
+    /**
+     * Get the number of core groups workers are split into.
+     */
+    size_t getCoreGroupCount() const { return groupQueues.size(); }
+
+    /**
+     * Get the number of hardware threads available to the process.
+     */
+    static size_t hardwareThreads();
+
+private:
+    std::vector<std::thread> workers;
+    std::vector<std::deque<Task>> groupQueues;   // One queue per core group
+    std::deque<Task> sharedQueue;                // Tasks without a group preference
+    std::vector<std::vector<int>> groupCpus;     // CPU ids per core group
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable idle;
+    size_t pendingTasks;                         // Queued plus running
+    bool stopping;
+
+    void workerLoop(size_t group);
+    bool popTask(size_t group, Task& task);
+    void detectCoreGroups();
+};
+
+} // namespace astral
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace astral {
+
+/**
+ * Watchdog settings.
+ */
+struct TickWatchdogConfig {
+    double thresholdMs = 100.0;          // Ticks slower than this are outliers
+    size_t historyTicks = 8;             // Ticks kept in the rolling trace
+    size_t hotChunkCount = 8;            // Chunks included in the snapshot
+    double minDumpIntervalSeconds = 10.0; // At most one dump per interval
+    size_t maxDumps = 32;                // Dumps per watchdog lifetime
+    std::string directory = ".";
+    std::string prefix = "slow_tick";
+};
+
+/**
+ * Time spent simulating one chunk during a tick.
+ */
+struct TraceChunkCost {
+    int32_t chunkX;
+    int32_t chunkY;
+    double ms;
+};
+
+/**
+ * Everything recorded about one tick.
+ */
+struct TickTrace {
+    uint64_t tick = 0;
+    double timestamp = 0.0;                       // Seconds since the Unix epoch
+    double durationMs = 0.0;
+    std::vector<std::pair<std::string, double>> sections; // Name, milliseconds
+    std::vector<TraceChunkCost> chunkCosts;
+    nlohmann::json events = nlohmann::json::array(); // Edits applied during the tick
+};
+
+/**
+ * Keeps a rolling trace of the last few ticks and writes it to disk whenever
+ * a tick exceeds the threshold.
+ *
+ * Recording reuses the trace buffers, so a normal tick costs a few vector
+ * appends. When an outlier is detected the trace is handed to a background
+ * thread that serialises and writes it; dumps are rate limited and skipped
+ * while a previous dump is still being written, so the watchdog cannot cause
+ * hitches of its own.
+ */
+class TickWatchdog {
+public:
+    // Builds the snapshot of the hottest chunks, called on the ticking thread
+    using SnapshotProvider = std::function<nlohmann::json(const std::vector<TraceChunkCost>& hottest)>;
+
+    explicit TickWatchdog(const TickWatchdogConfig& config = TickWatchdogConfig());
+    ~TickWatchdog();
+
+    TickWatchdog(const TickWatchdog&) = delete;
+    TickWatchdog& operator=(const TickWatchdog&) = delete;
+
+    void setSnapshotProvider(SnapshotProvider provider) { snapshotProvider = std::move(provider); }
+    const TickWatchdogConfig& getConfig() const { return config; }
+
+    // Start recording a tick
+    void beginTick();
+
+    // Record data for the current tick
+    void recordSection(const std::string& name, double ms);
+    void recordChunkCost(int chunkX, int chunkY, double ms);
+    void recordEvent(nlohmann::json event);
+
+    /**
+     * Finish the current tick.
+     * @param durationMs Tick duration, or negative to use the time since beginTick()
+     * @return True if the tick was an outlier and a dump was queued
+     */
+    bool endTick(double durationMs = -1.0);
+
+    // Wait until queued dumps are on disk
+    void flush();
+
+    uint64_t getTickCount() const { return tickCount; }
+    uint64_t getOutlierCount() const { return outliers; }
+    uint64_t getDumpCount() const { return dumpsWritten.load(); }
+    uint64_t getSuppressedCount() const { return suppressed; }
+    std::string getLastDumpPath() const;
+
+    // Heap bytes of the trace ring and a dump waiting to be written, not
+    // counting what the recorded events allocate (ticking thread only)
+    size_t getMemoryUsage() const;
+
+private:
+    TickWatchdogConfig config;
+    SnapshotProvider snapshotProvider;
+
+    // Ring of recent ticks; the current tick is at ring[head]
+    std::vector<TickTrace> ring;
+    size_t head;
+    size_t recorded;
+    uint64_t tickCount;
+    std::chrono::steady_clock::time_point tickStart;
+
+    // Throttling
+    uint64_t outliers;
+    uint64_t suppressed;
+    uint64_t dumpsQueued;
+    std::chrono::steady_clock::time_point lastDump;
+    bool hasDumped;
+
+    // Background writer
+    std::thread writer;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    bool stopping;
+    bool pending;
+    std::vector<TickTrace> pendingTicks;   // Oldest first, outlier last
+    nlohmann::json pendingHotChunks;
+    std::string pendingPath;
+    std::string lastDumpPath;
+    std::atomic<uint64_t> dumpsWritten;
+
+    void writerLoop();
+    void queueDump(const TickTrace& outlier);
+    nlohmann::json buildDump(const std::vector<TickTrace>& ticks, const nlohmann::json& hotChunks) const;
+};
+
+} // namespace astral
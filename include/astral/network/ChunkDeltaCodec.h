@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "astral/physics/ChunkManager.h"
+
+namespace astral {
+
+/**
+ * Message types on a simulation stream. Every message is framed as a 32-bit
+ * body length, a type byte and the body.
+ */
+enum class StreamMessage : uint8_t {
+    WORLD_INFO = 1,    // Server -> client: world width, height and chunk size
+    CHUNK_DELTA = 2,   // Server -> client: one compressed chunk delta
+    TICK_END = 3,      // Server -> client: tick number and viewport hash
+    VIEWPORT = 16,     // Client -> server: area the client wants to see
+    ACK = 17           // Client -> server: chunk version applied
+};
+
+/**
+ * Appends little-endian values to a byte buffer.
+ */
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<uint8_t>& buffer) : buffer(buffer) {}
+
+    void writeU8(uint8_t value) { buffer.push_back(value); }
+    void writeU32(uint32_t value);
+    void writeU64(uint64_t value);
+    void writeI32(int32_t value) { writeU32(static_cast<uint32_t>(value)); }
+    void writeVarint(uint64_t value);
+
+    // Start a framed message; finish it with endMessage() once the body is written
+    size_t beginMessage(StreamMessage type);
+    void endMessage(size_t start);
+
+private:
+    std::vector<uint8_t>& buffer;
+};
+
+/**
+ * Reads little-endian values from a byte range. Reads past the end fail and
+ * leave the reader in the failed state.
+ */
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : data(data), end(data + size) {}
+
+    bool readU8(uint8_t& value);
+    bool readU32(uint32_t& value);
+    bool readU64(uint64_t& value);
+    bool readI32(int32_t& value);
+    bool readVarint(uint64_t& value);
+
+    const uint8_t* position() const { return data; }
+    size_t remaining() const { return static_cast<size_t>(end - data); }
+    void skip(size_t count) { data += count < remaining() ? count : remaining(); }
+
+private:
+    const uint8_t* data;
+    const uint8_t* end;
+};
+
+/**
+ * Compresses chunk material layouts for streaming.
+ *
+ * A delta is the XOR of the current layout against the layout the client last
+ * acknowledged (all air for chunks it has never seen). The XOR values go into
+ * a palette, and the palette indices are run-length encoded. Unchanged cells
+ * XOR to zero, so a chunk with a few moving cells is a handful of runs.
+ */
+class ChunkDeltaCodec {
+public:
+    static constexpr int CELL_COUNT = CHUNK_SIZE * CHUNK_SIZE;
+
+    /**
+     * Append the delta between two layouts of CELL_COUNT materials.
+     */
+    static void encode(const MaterialID* current, const MaterialID* base, std::vector<uint8_t>& out);
+
+    /**
+     * Apply a delta to a base layout.
+     * @return false if the delta is malformed
+     */
+    static bool decode(ByteReader& reader, const MaterialID* base, MaterialID* out);
+
+    /**
+     * Chunks intersecting a viewport, clipped to the world, in row-major order.
+     * Server and client both hash exactly this set.
+     */
+    static std::vector<ChunkCoord> viewportChunks(const WorldRect& viewport, int worldWidth, int worldHeight);
+};
+
+} // namespace astral
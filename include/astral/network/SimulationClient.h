@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "astral/network/ChunkDeltaCodec.h"
+
+namespace astral {
+
+/**
+ * Headless client for a SimulationServer.
+ *
+ * Rebuilds the material layout of the chunks in its viewport from the delta
+ * stream, acknowledges every applied chunk, and checks the server's viewport
+ * hash at the end of each tick.
+ */
+class SimulationClient {
+public:
+    struct Stats {
+        uint64_t ticks = 0;              // TICK_END messages received
+        uint64_t verifiedTicks = 0;      // In-sync ticks whose hash matched
+        uint64_t hashMismatches = 0;
+        uint64_t chunksApplied = 0;
+        uint64_t bytesReceived = 0;
+        uint64_t protocolErrors = 0;
+    };
+
+    SimulationClient();
+    ~SimulationClient();
+
+    SimulationClient(const SimulationClient&) = delete;
+    SimulationClient& operator=(const SimulationClient&) = delete;
+
+    bool connectTcp(const std::string& host, uint16_t port);
+    bool connectUnix(const std::string& path);
+    void disconnect();
+    bool isConnected() const { return socket >= 0; }
+
+    // Ask the server to stream a different area
+    void setViewport(int x, int y, int width, int height);
+
+    /**
+     * Wait up to timeoutMs for data and apply every complete message.
+     * @return false once the connection is closed
+     */
+    bool poll(int timeoutMs);
+
+    // Reconstructed state (air for chunks not received)
+    MaterialID getMaterial(int x, int y) const;
+    uint64_t getChunkVersion(ChunkCoord coord) const;
+
+    int getWorldWidth() const { return worldWidth; }
+    int getWorldHeight() const { return worldHeight; }
+    uint64_t getLastTick() const { return lastTick; }
+
+    // True when the last tick was in sync and its hash matched
+    bool isVerified() const { return lastVerified; }
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct ChunkState {
+        uint64_t version = 0;
+        std::vector<MaterialID> materials;
+    };
+
+    int socket;
+    int worldWidth;
+    int worldHeight;
+    uint64_t lastTick;
+    bool lastVerified;
+    std::vector<uint8_t> inbox;
+    std::unordered_map<ChunkCoord, ChunkState, ChunkCoordHash> chunks;
+    Stats stats;
+
+    bool handleMessage(StreamMessage type, ByteReader& reader);
+    bool applyDelta(ByteReader& reader);
+    void verifyTick(ByteReader& reader);
+    bool sendAll(const std::vector<uint8_t>& data);
+};
+
+} // namespace astral
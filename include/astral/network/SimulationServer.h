@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "astral/network/ChunkDeltaCodec.h"
+#include "astral/physics/CellularAutomaton.h"
+
+namespace astral {
+
+/**
+ * Authoritative server that streams a CellularAutomaton to thin clients.
+ *
+ * Call tick() after every world update. The server accepts new connections,
+ * reads viewport changes and acknowledgements, and sends each client the
+ * chunks in its viewport whose version differs from the one the client last
+ * acknowledged. Each chunk has at most one delta in flight per client, so the
+ * XOR base on both ends is always the acknowledged layout. Every tick ends
+ * with a hash of the client's viewport so the client can verify its copy.
+ *
+ * Sockets are non-blocking and serviced from tick(); no extra threads.
+ */
+class SimulationServer {
+public:
+    struct Stats {
+        uint64_t ticks = 0;
+        uint64_t chunksSent = 0;
+        uint64_t bytesSent = 0;
+        uint64_t rawBytes = 0;      // Uncompressed size of the chunks sent
+    };
+
+    // The world must be bounded and use the default CHUNK_SIZE
+    // (std::invalid_argument otherwise)
+    explicit SimulationServer(CellularAutomaton& world);
+    ~SimulationServer();
+
+    SimulationServer(const SimulationServer&) = delete;
+    SimulationServer& operator=(const SimulationServer&) = delete;
+
+    // Listen on 127.0.0.1 (port 0 picks a free port, see getPort())
+    bool listenTcp(uint16_t port);
+
+    // Listen on a Unix domain socket, replacing any stale socket file
+    bool listenUnix(const std::string& path);
+
+    uint16_t getPort() const { return port; }
+
+    // Per-client send budget in bytes per second (0 = unlimited)
+    void setBandwidthLimit(size_t bytesPerSecond) { bandwidthLimit = bytesPerSecond; }
+
+    // Service clients and stream the current world state
+    void tick(float deltaTime);
+
+    void stop();
+
+    size_t getClientCount() const { return clients.size(); }
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct ClientChunk {
+        uint64_t ackedVersion = 0;
+        uint64_t sentVersion = 0;
+        bool inFlight = false;
+        std::vector<MaterialID> acked;   // Layout the client has at ackedVersion
+        std::vector<MaterialID> sent;    // Layout of the delta in flight
+    };
+
+    struct Client {
+        int socket = -1;
+        bool hasViewport = false;
+        WorldRect viewport{0, 0, 0, 0};
+        double tokens = 0.0;             // Bandwidth budget, may go negative
+        std::vector<uint8_t> inbox;
+        std::vector<uint8_t> outbox;
+        bool closed = false;
+        std::unordered_map<ChunkCoord, ClientChunk, ChunkCoordHash> chunks;
+    };
+
+    CellularAutomaton& world;
+    int listenSocket;
+    uint16_t port;
+    std::string unixPath;
+    size_t bandwidthLimit;
+    std::vector<std::unique_ptr<Client>> clients;
+    std::unordered_set<ChunkCoord, ChunkCoordHash> refreshedChunks;   // Versions refreshed this tick
+    Stats stats;
+
+    void acceptClients();
+    void receive(Client& client);
+    void handleMessage(Client& client, StreamMessage type, ByteReader& reader);
+    void streamChunks(Client& client, float deltaTime);
+    void flush(Client& client);
+};
+
+} // namespace astral
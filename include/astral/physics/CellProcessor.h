@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <random>
 #include "astral/physics/Material.h"
 #include "astral/physics/Cell.h"
@@ -7,50 +9,80 @@
 namespace astral {
 
 /**
- * Helper class to initialize and process cells
+ * Random source for the cell rules. Each simulation (or each worker running
+ * a kernel) owns one and passes it to the rules that roll dice, so the rules
+ * themselves share no mutable state.
+ */
+class CellRandom {
+private:
+    std::mt19937 engine;
+
+public:
+    explicit CellRandom(uint32_t seed = std::mt19937::default_seed) : engine(seed) {}
+
+    void seed(uint32_t value) { engine.seed(value); }
+
+    float getRandomFloat(float min, float max) {
+        std::uniform_real_distribution<float> dist(min, max);
+        return dist(engine);
+    }
+
+    int getRandomInt(int min, int max) {
+        std::uniform_int_distribution<int> dist(min, max);
+        return dist(engine);
+    }
+
+    bool rollProbability(float chance) {
+        // Ensure chance is between 0 and 1
+        chance = std::max(0.0f, std::min(1.0f, chance));
+        return getRandomFloat(0.0f, 1.0f) < chance;
+    }
+};
+
+/**
+ * Per-cell rules: initialization, movement, reactions, heat and state
+ * changes. The processor only reads a MaterialTable and changes nothing but
+ * the cells it is given, so one instance can be shared by every worker
+ * thread; rules that are random take the caller's CellRandom.
  */
 class CellProcessor {
 private:
-    MaterialRegistry* materialRegistry;
-    mutable std::mt19937 random;
-    
-    // Helper to get an adjacent cell safely
-    Cell* getAdjacentCell(const Cell& cell, int dx, int dy);
-    
+    const MaterialTable* materials;
+
 public:
-    CellProcessor(MaterialRegistry* registry);
-    ~CellProcessor() = default;
-    
+    explicit CellProcessor(const MaterialTable* materials) : materials(materials) {}
+
+    const MaterialTable& getMaterials() const { return *materials; }
+
     // Cell initialization
     void initializeCellFromMaterial(Cell& cell, MaterialID materialID) const;
     void applyMaterialProperties(Cell& cell, const MaterialProperties& props) const;
-    
+
     // Cell movement
     bool canCellMove(const Cell& cell, const Cell& target) const;
     bool canDisplace(const Cell& mover, const Cell& target) const;
     bool shouldSwapCells(const Cell& cell1, const Cell& cell2) const;
-    
+
     // Cell interactions
     bool canReact(const Cell& cell1, const Cell& cell2) const;
-    bool processPotentialReaction(Cell& cell1, Cell& cell2, float deltaTime);
-    void processStateChange(Cell& cell, float deltaTime);
+    bool processPotentialReaction(Cell& cell1, Cell& cell2, float deltaTime, CellRandom& random) const;
+    void processStateChange(Cell& cell, float deltaTime, CellRandom& random) const;
+    // Turn a cell whose lifetime ran out into its material's decay product,
+    // with a random or a given share of the rule's lifetime jitter
+    void applyDecay(Cell& cell, CellRandom& random) const;
+    void applyDecay(Cell& cell, int lifetimeJitter) const;
     void transferHeat(Cell& sourceCell, Cell& targetCell, float deltaTime) const;
-    bool checkStateChangeByTemperature(Cell& cell);
-    
+    bool checkStateChangeByTemperature(Cell& cell) const;
+
     // Cell effects
-    void applyVelocity(Cell& cell, const glm::vec2& direction, float speed);
-    void applyPressure(Cell& cell, float amount);
-    void damageCell(Cell& cell, float amount);
-    void igniteCell(Cell& cell);
-    void extinguishCell(Cell& cell);
-    void freezeCell(Cell& cell);
-    void meltCell(Cell& cell);
-    void dissolveCell(Cell& cell, float rate);
-    
-    // Random utilities
-    float getRandomFloat(float min, float max) const;
-    int getRandomInt(int min, int max) const;
-    bool rollProbability(float chance) const;
+    void applyVelocity(Cell& cell, const glm::vec2& direction, float speed) const;
+    void applyPressure(Cell& cell, float amount) const;
+    void damageCell(Cell& cell, float amount) const;
+    void igniteCell(Cell& cell, CellRandom& random) const;
+    void extinguishCell(Cell& cell) const;
+    void freezeCell(Cell& cell) const;
+    void meltCell(Cell& cell) const;
+    void dissolveCell(Cell& cell, float rate) const;
 };
 
-} // namespace astral
\ No newline at end of file
+} // namespace astral
@@ -5,14 +5,22 @@
 #include <memory>
 #include <unordered_map>
 #include <functional>
+#include <mutex>
 
 #include "astral/physics/ChunkManager.h"
 #include "astral/physics/CellularPhysics.h"
 #include "astral/physics/Material.h"
+#include "astral/physics/EditCommandQueue.h"
+#include "astral/physics/TickPipeline.h"
 #include "astral/core/Timer.h"
 
 namespace astral {
 
+class TickWatchdog;
+struct TickWatchdogConfig;
+class WorldAutosave;
+struct WorldAutosaveConfig;
+
 /**
  * World generation templates for initializing cellular automaton simulations.
  */
@@ -56,7 +64,9 @@ struct SimulationStats {
  */
 class CellularAutomaton {
 private:
-    MaterialRegistry materialRegistry;
+    // Either owned by this world or shared read-only with other worlds
+    std::shared_ptr<const MaterialRegistry> materialRegistry;
+    std::shared_ptr<MaterialRegistry> ownedRegistry; // Set only when the registry is private
     std::unique_ptr<ChunkManager> chunkManager;
     std::unique_ptr<CellularPhysics> physics;
     
@@ -64,21 +74,66 @@ private:
     float timeScale;
     int worldWidth;
     int worldHeight;
+    int chunkSize;
     WorldRect activeArea;
     Timer updateTimer;
     SimulationStats stats;
     
+    // This world's memory entries in the Profiler, and ticks until the next sample
+    std::string profilerPrefix;
+    int memorySampleCountdown;
+    
+    // Edits submitted from other threads, applied at the start of each tick
+    EditCommandQueue editQueue;
+    std::vector<EditCommand> pendingEdits;
+    
+    // Slow-tick watchdog, set only while enabled
+    std::unique_ptr<TickWatchdog> watchdog;
+    
+    // Background saving of changed chunks, set only while enabled
+    std::unique_ptr<WorldAutosave> autosave;
+    
+    // Statistics reduced by the pipeline, adopted into stats on the ticking thread
+    mutable std::mutex pipelinedStatsMutex;
+    SimulationStats pipelinedStats;
+    uint64_t pipelinedStatsTick;
+    uint64_t adoptedStatsTick;
+    
+    // Per-tick consumers, set only while enabled. Declared last so queued
+    // consumers finish before the members they use are destroyed.
+    std::unique_ptr<TickPipeline> pipeline;
+    
     // Initialize simulation with a specific world template
     void initializeWorldFromTemplate(WorldTemplate tmpl);
     
     // Calculate simulation statistics
     void updateSimulationStats();
+    void publishTick();
+    void adoptPipelinedStats();
     
     // Utility method for placing materials in circle/rectangle patterns
     void fillShape(int centerX, int centerY, int radius, MaterialID material);
     
+    // Apply a single edit immediately. Paint commands are rasterized chunk by
+    // chunk so each touched chunk is looked up and activated once.
+    void applyEditCommand(const EditCommand& command);
+    
 public:
-    CellularAutomaton(int width = 1000, int height = 1000);
+    // A width or height of UNBOUNDED removes the limit along that axis. The
+    // world then extends as far as its resident chunks: writing a cell loads
+    // its chunk, cells treat unloaded chunks as walls, and chunks are dropped
+    // with unloadChunksOutside(). Memory and tick cost follow the resident
+    // chunks, not the world's extent.
+    static constexpr int UNBOUNDED = CellularPhysics::UNBOUNDED;
+    
+    // chunkSize picks the chunk dimension (one of SUPPORTED_CHUNK_SIZES);
+    // unsupported sizes throw std::invalid_argument
+    CellularAutomaton(int width = 1000, int height = 1000, int chunkSize = CHUNK_SIZE);
+    
+    // Create a world that uses a shared, immutable material registry (see
+    // MaterialRegistry::createShared) instead of building its own
+    CellularAutomaton(int width, int height, std::shared_ptr<const MaterialRegistry> sharedRegistry,
+                      int chunkSize = CHUNK_SIZE);
     ~CellularAutomaton();
     
     // Initialization
@@ -103,6 +158,11 @@ public:
     MaterialID registerMaterial(const MaterialProperties& properties);
     MaterialProperties getMaterial(MaterialID id) const;
     MaterialID getMaterialIDByName(const std::string& name) const;
+    const MaterialRegistry& getMaterialRegistry() const { return *materialRegistry; }
+    
+    // Direct chunk access for systems that work chunk by chunk (streaming, saving)
+    ChunkManager& getChunkManager() { return *chunkManager; }
+    const ChunkManager& getChunkManager() const { return *chunkManager; }
     
     // Painting tools
     void paintCell(int x, int y, MaterialID material);
@@ -110,6 +170,17 @@ public:
     void paintCircle(int x, int y, int radius, MaterialID material);
     void fillRectangle(int x, int y, int width, int height, MaterialID material);
     
+    // Thread-safe edit submission. Commands are batched and applied in
+    // submission order at the start of the next update() (or by applyQueuedEdits()).
+    void submitEdit(const EditCommand& command);
+    void queuePaintCell(int x, int y, MaterialID material);
+    void queuePaintCircle(int x, int y, int radius, MaterialID material);
+    void queueFillRectangle(int x, int y, int width, int height, MaterialID material);
+    void queueExplosion(int x, int y, float radius, float power);
+    void queueHeatSource(int x, int y, float temperature, float radius);
+    void queueForce(int x, int y, const glm::vec2& direction, float strength, float radius);
+    size_t applyQueuedEdits();
+    
     // Special effects
     void createExplosion(int x, int y, float radius, float power);
     void createHeatSource(int x, int y, float temperature, float radius);
@@ -122,12 +193,139 @@ public:
     // Simulation statistics
     const SimulationStats& getSimulationStats() const { return stats; }
     
+    // Bytes held by the world: chunks by where their cells live, material
+    // tables, per-tick scratch, modules, queues and save/trace journals.
+    // While the Profiler is enabled the entries are recorded into it every
+    // MEMORY_SAMPLE_TICKS ticks as "Physics/world<N>/<name>", N numbering the
+    // worlds of the process, so its total covers every live world.
+    MemoryReport getMemoryReport() const;
+    void dumpMemoryReport() const;
+    static constexpr int MEMORY_SAMPLE_TICKS = 60;
+    const std::string& getProfilerPrefix() const { return profilerPrefix; }
+    
+    // Settled lakes are aggregated so only their shorelines are simulated
+    // per cell; see LiquidBodyTracker. Enabled by default.
+    LiquidBodyTracker& getLiquidBodies() { return physics->getLiquidBodies(); }
+    const LiquidBodyTracker& getLiquidBodies() const { return physics->getLiquidBodies(); }
+    
+    // Move thin smoke and steam on a coarse field (see GasField) instead of
+    // cell by cell. Bounded worlds only; throws std::invalid_argument
+    // otherwise. Disabling turns the field's gas back into cells.
+    GasField& enableGasField(const GasFieldConfig& config = GasFieldConfig());
+    void disableGasField() { physics->disableGasField(); }
+    const GasField* getGasField() const { return physics->getGasField(); }
+    
+    // Fast-forward chunks that re-enter the update region over the time they
+    // were frozen, in one pass (see ChunkCatchUp). Off by default since
+    // shards move their update regions around for ownership.
+    ChunkCatchUp& enableCatchUp(const ChunkCatchUpConfig& config = ChunkCatchUpConfig()) {
+        return physics->enableCatchUp(config);
+    }
+    void disableCatchUp() { physics->disableCatchUp(); }
+    const ChunkCatchUp* getCatchUp() const { return physics->getCatchUp(); }
+    
+    // Throw loose cells and sparks from explosions off the grid as particles
+    // that fly and land on their own (see ParticleSystem). Disabling puts
+    // the particles in flight back into the grid.
+    ParticleSystem& enableParticles(const ParticleSystemConfig& config = ParticleSystemConfig()) {
+        return physics->enableParticles(config);
+    }
+    void disableParticles() { physics->disableParticles(); }
+    const ParticleSystem* getParticles() const { return physics->getParticles(); }
+    
+    // Electricity in conductive materials: connected conductors share their
+    // charge and heat up while it is high (see ConductorNetwork). Bounded
+    // worlds only; throws std::invalid_argument otherwise.
+    ConductorNetwork& enableConductors(const ConductorNetworkConfig& config = ConductorNetworkConfig()) {
+        return physics->enableConductors(config);
+    }
+    void disableConductors() { physics->disableConductors(); }
+    const ConductorNetwork* getConductors() const { return physics->getConductors(); }
+    
+    // Charge the conductor at a cell and everything connected to it; returns
+    // false if conductors are disabled or the cell is not a conductor
+    bool addCharge(int x, int y, float amount) {
+        ConductorNetwork* conductors = physics->getConductors();
+        return conductors && conductors->addCharge(x, y, amount);
+    }
+    
+    // The conductors only see material changes they are told about. setCell,
+    // the edit commands and the simulation report theirs; code writing cells
+    // through getCell() reports each cell it changed with its old material.
+    void noteCellChanged(int x, int y, MaterialID before) {
+        if (ConductorNetwork* conductors = physics->getConductors()) {
+            conductors->noteChange(x, y, before, getCell(x, y).material);
+        }
+    }
+    
+    // Keep the cells of every chunk in one Morton-ordered, huge-page backed
+    // region (see ChunkSlab) instead of one allocation per chunk. Bounded
+    // worlds only; throws std::invalid_argument otherwise.
+    const ChunkSlab& enableSlabStorage(const ChunkSlabConfig& config = ChunkSlabConfig()) {
+        return chunkManager->enableSlab(worldWidth, worldHeight, config);
+    }
+    void disableSlabStorage() { chunkManager->disableSlab(); }
+    const ChunkSlab* getSlabStorage() const { return chunkManager->getSlab(); }
+
+    // Run the movement phase chunk-parallel (see ChunkUpdateStrategy). OUTBOX
+    // needs a pool, which may be the one the world ticks on; throws
+    // std::invalid_argument without one.
+    void setChunkUpdateStrategy(ChunkUpdateStrategy strategy, ThreadPool* pool = nullptr) {
+        physics->setChunkUpdateStrategy(strategy, pool);
+    }
+    ChunkUpdateStrategy getChunkUpdateStrategy() const { return physics->getChunkUpdateStrategy(); }
+    void setRandomSeed(uint32_t seed) { physics->setRandomSeed(seed); }
+    const OutboxStats& getOutboxStats() const { return physics->getOutboxStats(); }
+
+    // Hand each finished tick to read-only consumers (statistics, render
+    // prep, change feeds, saving) that run on the pool while the next tick
+    // simulates. Statistics are reduced by the pipeline and lag the
+    // simulation by up to two ticks; flushPipeline() catches them up.
+    TickPipeline& enablePipeline(ThreadPool& pool);
+    void disablePipeline();
+    TickPipeline* getPipeline() { return pipeline.get(); }
+    void flushPipeline();
+    
+    // Trace every tick and dump the recent trace, the applied edits and the
+    // hottest chunks to disk when a tick exceeds the configured threshold
+    TickWatchdog& enableWatchdog(const TickWatchdogConfig& config);
+    void disableWatchdog();
+    TickWatchdog* getWatchdog() { return watchdog.get(); }
+    
+    // Save the chunks that changed to a region file every few seconds,
+    // serialised on a background thread (see WorldAutosave). Returns false,
+    // leaving autosave off, if the file cannot be opened; disabling waits
+    // until the save in progress is on disk.
+    bool enableAutosave(const std::string& path, const WorldAutosaveConfig& config);
+    void disableAutosave();
+    WorldAutosave* getAutosave() { return autosave.get(); }
+    
     // World properties
     int getWorldWidth() const { return worldWidth; }
     int getWorldHeight() const { return worldHeight; }
+    int getChunkSize() const { return chunkSize; }
+    bool isUnbounded() const { return worldWidth == UNBOUNDED || worldHeight == UNBOUNDED; }
+    bool isInBounds(int x, int y) const {
+        return (worldWidth == UNBOUNDED || (x >= 0 && x < worldWidth)) &&
+               (worldHeight == UNBOUNDED || (y >= 0 && y < worldHeight));
+    }
+    
+    // Resident chunks. loadRegion() creates and activates the chunks
+    // overlapping a rectangle; unloadChunksOutside() drops every chunk that
+    // does not overlap it and returns how many were dropped.
+    int getResidentChunkCount() const { return chunkManager->getChunkCount(); }
+    void loadRegion(int x, int y, int width, int height);
+    size_t unloadChunksOutside(int x, int y, int width, int height);
     void setActiveArea(int x, int y, int width, int height);
     
-    // Save/load world
+    // Only simulate chunks overlapping this rectangle. Cells outside it stay
+    // in place but can still be displaced by simulated neighbours.
+    void setUpdateRegion(int x, int y, int width, int height);
+    
+    // Save every resident chunk to a region file, or load the chunks of one
+    // (see RegionFile). Loading clears the world first (see clearWorld()), so
+    // chunks missing from the file are left empty; chunks outside a bounded
+    // world are skipped.
     bool saveWorld(const std::string& filename) const;
     bool loadWorld(const std::string& filename);
 };
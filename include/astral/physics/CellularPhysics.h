@@ -2,39 +2,107 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 #include <functional>
 #include <random>
+#include <unordered_map>
 #include "astral/physics/ChunkManager.h"
+#include "astral/physics/ChunkOutbox.h"
 #include "astral/physics/Material.h"
+#include "astral/physics/CellProcessor.h"
+#include "astral/physics/ReactionMask.h"
+#include "astral/physics/LiquidBodyTracker.h"
+#include "astral/physics/GasField.h"
+#include "astral/physics/ChunkCatchUp.h"
+#include "astral/physics/ParticleSystem.h"
+#include "astral/physics/ConductorNetwork.h"
 
 namespace astral {
 
 // Forward declarations
 class MaterialRegistry;
-class CellProcessor;
+class ThreadPool;
+class TickWatchdog;
 
 /**
  * Handles cellular automaton-based physics simulation.
  */
 class CellularPhysics {
 private:
-    MaterialRegistry* materialRegistry;
+    const MaterialRegistry* materialRegistry;
     ChunkManager* chunkManager;
-    CellProcessor* cellProcessor;
-    std::vector<std::vector<bool>> updated; // Tracks which cells updated this frame
+    MaterialTable materialTable;   // Snapshot of the registry read by the rules
+    CellProcessor cellProcessor;
+    ReactionMatrix reactionMatrix;   // Material pairs canReact() accepts
+    ReactionMask reactionMask;       // Reaction candidates of the chunk being interacted
+    std::unique_ptr<LiquidBodyTracker> liquidBodies;
+    std::unique_ptr<GasField> gasField;   // Set only while enabled
+    std::unique_ptr<ChunkCatchUp> catchUp;   // Set only while enabled
+    std::unique_ptr<ParticleSystem> particles;   // Set only while enabled
+    std::unique_ptr<ConductorNetwork> conductors;   // Set only while enabled
+    uint64_t tick;   // Numbers the ticks for the per-chunk update flags
     
-    // World dimensions for update tracking
+    // World dimensions; UNBOUNDED axes end at the resident chunks
     int worldWidth;
     int worldHeight;
     
-    // Random number generator
-    std::mt19937 random;
+    // Random number generator for the rules
+    CellRandom random;
+    uint32_t randomSeed;   // Also seeds the per-chunk generators of OUTBOX tasks
+    
+    // How the movement phase runs; OUTBOX tasks run on pool
+    ChunkUpdateStrategy strategy;
+    ThreadPool* pool;
+    
+    // State of one active chunk's OUTBOX movement task
+    struct ChunkWorker {
+        Chunk* chunk = nullptr;
+        ChunkCoord coord = {0, 0};
+        std::vector<Cell> snapshot;   // The chunk's cells when the phase started
+        std::unordered_map<uint64_t, std::pair<Cell, Cell>> foreign;   // Other chunks' cells touched: as seen, as changed
+        CellRandom random;
+        ChunkOutbox outbox;
+        std::vector<WorldCoord> conductorChanges;   // Reported to the conductors after the phase
+        double costMs = 0.0;
+    };
+    std::vector<ChunkWorker> workers;
+    std::unordered_map<ChunkCoord, size_t, ChunkCoordHash> workerIndex;
+    std::vector<BoundaryWrite> boundaryWrites;
+    OutboxStats outboxStats;
+    static thread_local ChunkWorker* currentWorker;   // Task running on this thread, if any
+    
+    // The generator of the running task, or the simulation's
+    CellRandom& cellRandom() { return currentWorker ? currentWorker->random : random; }
+    
+    // Cell access from inside a task: its own chunk directly, any other chunk
+    // through a private copy of the cell taken from the snapshot
+    bool ownsCell(const ChunkWorker& worker, int x, int y) const;
+    Cell& workerCell(ChunkWorker& worker, int x, int y) const;
+    
+    // OUTBOX movement phase over the active chunks
+    void moveChunksWithOutboxes(float deltaTime, int chunkSize);
+    void applyBoundaryWrites();
+    void releaseLiquidAt(int x, int y);
+    void releaseLiquidArea(const WorldRect& area);
     
     // Function map for different material updates
     std::map<MaterialType, std::function<void(CellularPhysics*, int, int, float)>> updateFunctions;
     
+    // Receives per-chunk costs when set; chunkCosts is sorted by chunk
+    TickWatchdog* watchdog;
+    std::vector<std::pair<ChunkCoord, double>> chunkCosts;
+    void addChunkCost(const ChunkCoord& coord, double ms, size_t& cursor);
+    
     // Helper methods
     bool isValidPosition(int x, int y) const;
+    
+    // Whether a cell of a material with the given update interval is due
+    // this tick (see MaterialProperties::updateInterval)
+    bool isDueThisTick(int interval, int x, int y) const;
+    
+    // Whether a cell was already processed this tick
+    bool isUpdated(int x, int y) const;
+    void markUpdated(int x, int y);
     Cell& getCell(int x, int y);
     const Cell& getCell(int x, int y) const;
     MaterialProperties getMaterialProperties(int x, int y) const;
@@ -44,24 +112,55 @@ private:
     void moveCell(int x, int y, int newX, int newY);
     void applyForce(int x, int y, const glm::vec2& force);
     void trackLavaMovement(int x, int y, int newX, int newY); // Debug helper
-    void processMaterialInteraction(int x1, int y1, int x2, int y2, float deltaTime);
+    // Returns true when either cell changed material. Reactions are only
+    // evaluated when mayReact is set.
+    bool processMaterialInteraction(int x1, int y1, int x2, int y2, float deltaTime, bool mayReact = true);
     void applyTemperature(int x, int y, float deltaTime);
     
+    // Report a cell's material change to the conductors, if enabled; from
+    // inside a task the report waits in the task until the phase ends
+    void noteMaterialChange(int x, int y, MaterialID before, MaterialID after);
+    void noteGasFieldChanges();
+    void noteParticleLandings();
+    
     // Initialization methods
     void initialize();
     void setupUpdateFunctions();
     void resetUpdateTracker();
     
+    // Per-chunk kernels, compiled for each supported chunk size
+    template <int Size> void updateChunkCells(Chunk* chunk, float deltaTime);
+    template <int Size> void moveChunkCells(Chunk* chunk, float deltaTime);
+    template <int Size> void interactChunkCells(Chunk* chunk, float deltaTime);
+    
+    // Count fire and gas lifetimes down and turn the cells that run out into
+    // their decay products (see DecayRule)
+    template <int Size> void decayChunkCells(Chunk* chunk);
+    std::vector<uint8_t> expiredCells;   // Scratch for decayChunkCells
+    template <int Size> void processChunkHeatSources(Chunk* chunk);
+    
+    // Whether the kernels skip a cell as part of an aggregated liquid body;
+    // re-expands the body if the cell was overwritten since it formed
+    template <int Size> bool isAggregatedInterior(Chunk* chunk, int localX, int localY, int worldX, int worldY);
+    
     // Special effects processing
     void processActiveEffects(float deltaTime);
     bool isCellUpdated(int x, int y) const;
     void visualizePropertyField(const std::string& propertyName);
     
 public:
-    CellularPhysics(MaterialRegistry* registry, ChunkManager* chunkManager);
+    // World dimension with no limit (see setWorldDimensions)
+    static constexpr int UNBOUNDED = 0;
+    
+    // Temperature every cell relaxes towards, and the fraction of the
+    // difference removed per second
+    static constexpr float AMBIENT_TEMPERATURE = 20.0f;
+    static constexpr float AMBIENT_RATE = 0.01f;
+    
+    CellularPhysics(const MaterialRegistry* registry, ChunkManager* chunkManager);
     ~CellularPhysics();
     
-    // Set world dimensions for update tracking
+    // Set the world dimensions cells may move within; either may be UNBOUNDED
     void setWorldDimensions(int width, int height);
     
     // Update a specific chunk
@@ -79,6 +178,62 @@ public:
     // Main update method
     void update(float deltaTime);
     
+    // Select how the movement phase runs over the active chunks. OUTBOX needs
+    // a pool (throws std::invalid_argument otherwise); it may be the pool the
+    // update itself runs on, shared with other worlds or the tick pipeline.
+    void setChunkUpdateStrategy(ChunkUpdateStrategy strategy, ThreadPool* pool = nullptr);
+    ChunkUpdateStrategy getChunkUpdateStrategy() const { return strategy; }
+    
+    // Reseed the simulation's random stream (clock-seeded by default); two
+    // worlds with the same seed and the same cells tick alike
+    void setRandomSeed(uint32_t seed);
+    uint32_t getRandomSeed() const { return randomSeed; }
+    
+    // Boundary writes of the last OUTBOX tick
+    const OutboxStats& getOutboxStats() const { return outboxStats; }
+    
+    // Report the time spent on each active chunk to a watchdog (nullptr to stop)
+    void setWatchdog(TickWatchdog* watchdog) { this->watchdog = watchdog; }
+    
+    // Per-cell rules; they share no mutable state, so any thread may use them
+    const CellProcessor& getCellProcessor() const { return cellProcessor; }
+    
+    // Rebuild the rules' material table after registering materials
+    void refreshMaterials();
+    
+    // Settled liquid bodies whose interiors the per-cell passes skip
+    LiquidBodyTracker& getLiquidBodies() { return *liquidBodies; }
+    const LiquidBodyTracker& getLiquidBodies() const { return *liquidBodies; }
+    
+    // Move thin smoke and steam on a coarse field instead of cell by cell.
+    // Throws std::invalid_argument for unbounded worlds or bad settings;
+    // disabling turns the field's gas back into cells.
+    GasField& enableGasField(const GasFieldConfig& config);
+    void disableGasField();
+    GasField* getGasField() { return gasField.get(); }
+    const GasField* getGasField() const { return gasField.get(); }
+    
+    // Fast-forward chunks that return to the update region over the time
+    // they were frozen (see ChunkCatchUp) instead of resuming them as left
+    ChunkCatchUp& enableCatchUp(const ChunkCatchUpConfig& config = ChunkCatchUpConfig());
+    void disableCatchUp() { catchUp.reset(); }
+    const ChunkCatchUp* getCatchUp() const { return catchUp.get(); }
+    
+    // Let explosions throw loose cells and sparks off the grid as particles
+    // (see ParticleSystem). Throws std::invalid_argument for bad settings;
+    // disabling puts the particles in flight back into the grid.
+    ParticleSystem& enableParticles(const ParticleSystemConfig& config = ParticleSystemConfig());
+    void disableParticles();
+    ParticleSystem* getParticles() { return particles.get(); }
+    const ParticleSystem* getParticles() const { return particles.get(); }
+    
+    // Carry charge through connected conductive cells (see ConductorNetwork).
+    // Throws std::invalid_argument for unbounded worlds or bad settings.
+    ConductorNetwork& enableConductors(const ConductorNetworkConfig& config = ConductorNetworkConfig());
+    void disableConductors() { conductors.reset(); }
+    ConductorNetwork* getConductors() { return conductors.get(); }
+    const ConductorNetwork* getConductors() const { return conductors.get(); }
+    
     // Special effects and interactions
     void createExplosion(int x, int y, float radius, float power);
     void createHeatSource(int x, int y, float temperature, float radius);
@@ -86,6 +241,10 @@ public:
     
     // Debug methods
     void dumpPerformanceStats() const;
+    
+    // Add the bytes held by the material tables, the per-tick scratch and
+    // the enabled modules to a report
+    void addMemoryUsage(MemoryReport& report) const;
 };
 
 } // namespace astral
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "astral/core/MemoryReport.h"
+#include "astral/physics/Cell.h"
+
+namespace astral {
+
+// Forward declarations
+class Chunk;
+class CellProcessor;
+struct MaterialProperties;
+
+/**
+ * Settings for fast-forwarding chunks that were frozen.
+ */
+struct ChunkCatchUpConfig {
+    float minFrozenSeconds = 1.0f;   // Shorter absences are left to the regular ticks
+    float spreadRate = 1.2f;         // Cells per second fire crosses a fully flammable material
+    float woodBurnRate = 0.0021f;    // Health burning wood loses per second
+};
+
+// Totals since the catch-up was enabled
+struct ChunkCatchUpStats {
+    size_t chunks = 0;       // Chunks fast-forwarded
+    double seconds = 0.0;    // Simulated time skipped over
+    size_t burnedOut = 0;    // Cells whose fire or fuel ran out
+    size_t expired = 0;      // Gas cells that dissipated
+    size_t settled = 0;      // Powder and liquid cells moved down
+};
+
+/**
+ * Brings a chunk that spent a while outside the update region up to date in
+ * one pass instead of replaying the ticks it missed. Over the missed time it
+ *  1. spreads fire from burning cells through flammable neighbours (earliest
+ *     arrival at spreadRate * flammability cells per second) and burns each
+ *     reached cell out by its fuel,
+ *  2. counts fire and gas lifetimes down arithmetically, fire turning to
+ *     smoke and smoke to air as the rules do,
+ *  3. relaxes temperatures towards ambient in closed form and applies the
+ *     resulting state changes, and
+ *  4. lets powders and liquids fall column by column, by at most one cell
+ *     per missed tick, down to the next solid.
+ *
+ * The result approximates the missed evolution: nothing crosses the chunk's
+ * borders, reactions other than burning are skipped and liquids do not level
+ * out sideways; the regular ticks take it from there.
+ */
+class ChunkCatchUp {
+public:
+    ChunkCatchUp(const CellProcessor* processor, const ChunkCatchUpConfig& config);
+
+    const ChunkCatchUpConfig& getConfig() const { return config; }
+    const ChunkCatchUpStats& getStats() const { return stats; }
+
+    // Heap bytes of the scratch
+    size_t getMemoryUsage() const {
+        return heapBytes(ignitedAt) + heapBytes(column) + heapBytes(columnTaken);
+    }
+
+    // Fast-forward a chunk over frozenSeconds of ticks of deltaTime. Returns
+    // false when the absence was too short to bother.
+    bool catchUp(Chunk& chunk, double frozenSeconds, float deltaTime);
+
+private:
+    const CellProcessor* processor;
+    ChunkCatchUpConfig config;
+    ChunkCatchUpStats stats;
+
+    // Scratch reused between chunks
+    std::vector<double> ignitedAt;
+    std::vector<Cell> column;
+    std::vector<uint8_t> columnTaken;
+
+    void advanceLifetimes(Chunk& chunk, double seconds, float deltaTime);
+    void relaxTemperatures(Chunk& chunk, double seconds);
+    void settleColumns(Chunk& chunk, int64_t ticks);
+
+    // Run a cell's fire and gas lifetimes down by a number of ticks
+    void expire(Cell& cell, int64_t ticks);
+
+    // Seconds a burning cell keeps burning from when it ignites
+    double burnSeconds(const Cell& cell, const MaterialProperties& props, float deltaTime) const;
+};
+
+} // namespace astral
@@ -4,7 +4,12 @@
 #include <vector>
 #include <memory>
 #include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "astral/core/MemoryReport.h"
 #include "astral/physics/Cell.h"
+#include "astral/physics/ChunkSlab.h"
 
 namespace astral {
 
@@ -57,31 +62,97 @@ struct ChunkCoordHash {
 // Forward declarations
 class MaterialRegistry;
 
-constexpr int CHUNK_SIZE = 32; // Reduced from 64 to 32 for better performance and fewer chunk boundary issues
+constexpr int CHUNK_SIZE = 32; // Default chunk dimension; worlds can pick another supported size
+
+// Chunk dimensions the physics kernels are compiled for
+constexpr int SUPPORTED_CHUNK_SIZES[] = {16, 32, 64, 128};
+
+inline bool isSupportedChunkSize(int size) {
+    for (int supported : SUPPORTED_CHUNK_SIZES) {
+        if (size == supported) return true;
+    }
+    return false;
+}
+
+/**
+ * Call fn(std::integral_constant<int, Size>()) for a runtime chunk size, so a
+ * kernel written as a template over the chunk dimension is instantiated once
+ * per supported size and selected when the world is created.
+ */
+template <typename Fn>
+decltype(auto) dispatchChunkSize(int chunkSize, Fn&& fn) {
+    switch (chunkSize) {
+        case 16: return fn(std::integral_constant<int, 16>());
+        case 32: return fn(std::integral_constant<int, 32>());
+        case 64: return fn(std::integral_constant<int, 64>());
+        case 128: return fn(std::integral_constant<int, 128>());
+    }
+    throw std::invalid_argument("Unsupported chunk size " + std::to_string(chunkSize));
+}
+
+// FNV-1a hash of a run of material ids (a chunk's layout in row-major order)
+uint64_t hashMaterials(const MaterialID* materials, size_t count);
+
+// Fold one chunk's hash into a running hash over several chunks
+uint64_t combineChunkHash(uint64_t seed, ChunkCoord coord, uint64_t chunkHash);
 
 /**
  * A chunk contains a grid of cells that make up a portion of the world.
+ * Cells are stored row-major; kernels compiled for the chunk's size use
+ * cellAt<Size>() so the row stride is a constant. The cells live in the
+ * chunk's own allocation or in external storage such as a ChunkSlab slot.
  */
 class Chunk {
 private:
     ChunkCoord coord;
-    Cell cells[CHUNK_SIZE][CHUNK_SIZE];
+    int size;
+    std::vector<Cell> ownedCells;   // Empty while the cells live in external storage
+    Cell* cells;
+    size_t cellCount;
     bool isDirtyFlag;
     bool isActiveFlag;
-    std::vector<std::vector<bool>> activeCells;
-    MaterialRegistry* materialRegistry;
+    std::vector<bool> activeCells;
+    const MaterialRegistry* materialRegistry;
+    uint64_t version;        // Bumped whenever the material layout changes
+    uint64_t materialHash;   // Hash of the material layout at this version
+    std::vector<bool> updatedInTick;
+    uint64_t trackedTick;    // Tick the updatedInTick flags belong to
+    std::vector<MaterialID> aggregated;   // Empty unless a liquid body covers the chunk
+    size_t aggregatedCount;
     
 public:
-    Chunk(ChunkCoord coord, MaterialRegistry* materialRegistry);
+    // With storage, the chunk's cells are kept there (size * size cells that
+    // must outlive the chunk) and reset to air
+    Chunk(ChunkCoord coord, const MaterialRegistry* materialRegistry, int size = CHUNK_SIZE,
+          Cell* storage = nullptr);
     ~Chunk() = default;
     
+    Chunk(const Chunk&) = delete;
+    Chunk& operator=(const Chunk&) = delete;
+    
     // Cell access
     Cell& getCell(int x, int y);
     const Cell& getCell(int x, int y) const;
     void setCell(int x, int y, const Cell& cell);
     
+    // Unchecked access; Size must equal getSize()
+    template <int Size>
+    Cell& cellAt(int x, int y) { return cells[y * Size + x]; }
+    template <int Size>
+    const Cell& cellAt(int x, int y) const { return cells[y * Size + x]; }
+    
+    // All cells, row-major
+    const Cell* getCells() const { return cells; }
+    size_t getCellCount() const { return cellCount; }
+    
+    // Move the cells into external storage, or back into the chunk's own
+    // allocation when storage is nullptr
+    void relocateCells(Cell* storage);
+    bool hasExternalStorage() const { return ownedCells.empty(); }
+    
     // Chunk properties
     ChunkCoord getCoord() const { return coord; }
+    int getSize() const { return size; }
     bool isDirty() const { return isDirtyFlag; }
     void markDirty() { isDirtyFlag = true; }
     void clearDirty() { isDirtyFlag = false; }
@@ -95,6 +166,51 @@ public:
     
     // Update physics in this chunk
     void update(float deltaTime);
+    
+    // Material layout versioning. Cells are written through references, so
+    // changes are found by rehashing; refreshVersion() bumps the version and
+    // returns true when the layout differs from the last refresh.
+    uint64_t getVersion() const { return version; }
+    uint64_t getMaterialHash() const { return materialHash; }
+    bool refreshVersion();
+    void copyMaterials(MaterialID* out) const;
+    
+    // Cells already processed during a tick. The flags are cleared lazily the
+    // first time the chunk is marked in a new tick, so starting a tick costs
+    // nothing for chunks that are not touched.
+    bool isUpdatedInTick(int x, int y, uint64_t tick) const {
+        return trackedTick == tick && updatedInTick[y * size + x];
+    }
+    void markUpdatedInTick(int x, int y, uint64_t tick);
+    uint64_t getTrackedTick() const { return trackedTick; }
+    size_t countUpdatedInTick(uint64_t tick) const;
+    
+    // Interior cells of aggregated liquid bodies (see LiquidBodyTracker) hold
+    // the body's material here and 0 otherwise. The per-cell passes skip a
+    // cell while it still holds that material.
+    template <int Size>
+    MaterialID aggregatedAt(int x, int y) const {
+        return aggregated.empty() ? 0 : aggregated[y * Size + x];
+    }
+    MaterialID getAggregatedMaterial(int x, int y) const {
+        return aggregated.empty() ? 0 : aggregated[y * size + x];
+    }
+    void setAggregatedMaterial(int x, int y, MaterialID material);
+    size_t getAggregatedCellCount() const { return aggregatedCount; }
+    
+    // Heap bytes of the chunk's own cells (none in external storage), its
+    // per-cell flags and its liquid body layout
+    size_t getOwnedCellBytes() const { return heapBytes(ownedCells); }
+    size_t getUpdatedFlagBytes() const { return heapBytes(updatedInTick); }
+    size_t getActiveFlagBytes() const { return heapBytes(activeCells); }
+    size_t getAggregatedBytes() const { return heapBytes(aggregated); }
+};
+
+// A chunk that became active again after being kept out of the simulation
+// by the update region
+struct ThawedChunk {
+    ChunkCoord coord;
+    double frozenSeconds;   // Simulated time it missed
 };
 
 /**
@@ -103,19 +219,56 @@ public:
  */
 class ChunkManager {
 private:
+    std::unique_ptr<ChunkSlab> slab;   // Declared first so it outlives the chunks
     std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>, ChunkCoordHash> chunks;
     std::set<ChunkCoord> activeChunks;
-    MaterialRegistry* materialRegistry;
+    const MaterialRegistry* materialRegistry;
+    int chunkSize;
+    int chunkShift;   // log2(chunkSize)
+    
+    // Last chunk found by getChunk(); most lookups hit the same chunk
+    mutable ChunkCoord cachedCoord;
+    mutable Chunk* cachedChunk;
+    Chunk* findChunk(ChunkCoord coord) const;
+    
+    // Optional limit on which chunks are simulated
+    bool hasUpdateRegion;
+    WorldRect updateRegion;
+    
+    // Simulated seconds, advanced by updateChunks(). Chunks leaving the
+    // update region are stamped with it so the time they missed is known
+    // when they are activated again.
+    double simulationTime;
+    std::unordered_map<ChunkCoord, double, ChunkCoordHash> frozenSince;
+    std::vector<ThawedChunk> thawedChunks;
+    void activateChunk(ChunkCoord coord);
     
 public:
-    ChunkManager(MaterialRegistry* materialRegistry);
+    // Throws std::invalid_argument if chunkSize is not a supported size
+    ChunkManager(const MaterialRegistry* materialRegistry, int chunkSize = CHUNK_SIZE);
     ~ChunkManager() = default;
     
+    int getChunkSize() const { return chunkSize; }
+    
     // Chunk access
     Chunk* getChunk(ChunkCoord coord);
+    const Chunk* getChunk(ChunkCoord coord) const;
     Chunk* getOrCreateChunk(ChunkCoord coord);
+    
+    // Lookup that bypasses the getChunk() cache, so several threads may use it
+    // at once as long as no chunks are created or removed meanwhile
+    Chunk* peekChunk(ChunkCoord coord) const;
     void removeChunk(ChunkCoord coord);
     
+    // Drop every chunk
+    void clear();
+    
+    // Drop chunks that do not overlap the area; returns how many were removed
+    size_t removeChunksOutside(const WorldRect& area);
+    
+    // Coordinates of every chunk, in ChunkCoord order
+    std::vector<ChunkCoord> getResidentChunks() const;
+    
     // Cell access
     Cell& getCell(int worldX, int worldY);
     Cell& getCell(WorldCoord coord);
@@ -124,12 +277,22 @@ public:
     void setCell(int worldX, int worldY, const Cell& cell);
     void setCell(WorldCoord coord, const Cell& cell);
     
-    // Coordinate conversion
-    static ChunkCoord worldToChunkCoord(int worldX, int worldY);
-    static ChunkCoord worldToChunkCoord(WorldCoord worldCoord);
-    static LocalCoord worldToLocalCoord(int worldX, int worldY);
-    static LocalCoord worldToLocalCoord(WorldCoord worldCoord);
-    static WorldCoord chunkToWorldCoord(ChunkCoord chunkCoord, LocalCoord localCoord);
+    // Coordinate conversion for this manager's chunk size
+    ChunkCoord chunkCoordOf(int worldX, int worldY) const {
+        // Chunk sizes are powers of two, so an arithmetic shift floors
+        // negative coordinates and the mask gives the matching local coordinate
+        return {worldX >> chunkShift, worldY >> chunkShift};
+    }
+    LocalCoord localCoordOf(int worldX, int worldY) const {
+        return {worldX & (chunkSize - 1), worldY & (chunkSize - 1)};
+    }
+    
+    // Coordinate conversion for chunks of the given size
+    static ChunkCoord worldToChunkCoord(int worldX, int worldY, int chunkSize = CHUNK_SIZE);
+    static ChunkCoord worldToChunkCoord(WorldCoord worldCoord, int chunkSize = CHUNK_SIZE);
+    static LocalCoord worldToLocalCoord(int worldX, int worldY, int chunkSize = CHUNK_SIZE);
+    static LocalCoord worldToLocalCoord(WorldCoord worldCoord, int chunkSize = CHUNK_SIZE);
+    static WorldCoord chunkToWorldCoord(ChunkCoord chunkCoord, LocalCoord localCoord, int chunkSize = CHUNK_SIZE);
     
     // Active chunks
     const std::set<ChunkCoord>& getActiveChunks() const { return activeChunks; }
@@ -139,7 +302,32 @@ public:
         // Currently just delegates to the serial version
         updateChunks(deltaTime);
     }
-    void forceActivateChunk(ChunkCoord coord) { activeChunks.insert(coord); }
+    void forceActivateChunk(ChunkCoord coord) {
+        if (isInUpdateRegion(coord)) activateChunk(coord);
+    }
+    
+    // Chunks activated again since the last call, with the simulated time
+    // they spent outside the update region
+    double getSimulationTime() const { return simulationTime; }
+    std::vector<ThawedChunk> takeThawedChunks();
+    
+    // Keep the cells of every chunk of a bounded world in one ChunkSlab.
+    // Existing chunks are moved into it; disabling moves them back to their
+    // own allocations. Throws std::invalid_argument for an empty world.
+    const ChunkSlab& enableSlab(int worldWidth, int worldHeight,
+                                const ChunkSlabConfig& config = ChunkSlabConfig());
+    void disableSlab();
+    const ChunkSlab* getSlab() const { return slab.get(); }
+    
+    // Restrict simulation to chunks overlapping a region. Chunks outside it are
+    // never activated, but their cells can still be read and written by
+    // neighbouring cells (used for shard halos).
+    void setUpdateRegion(const WorldRect& region);
+    void clearUpdateRegion() { hasUpdateRegion = false; }
+    bool isInUpdateRegion(ChunkCoord coord) const;
+    
+    // Refresh every chunk's version; optionally collect the chunks that changed
+    void refreshChunkVersions(std::vector<ChunkCoord>* changed = nullptr);
     
     // Utility
     bool isValidCoord(WorldCoord coord) const;
@@ -156,17 +344,13 @@ public:
         float updateTime = 0.0f;
     };
     
-    // Get performance statistics
-    PerformanceStats getPerformanceStats() const {
-        PerformanceStats stats;
-        stats.totalChunks = chunks.size();
-        stats.activeChunks = activeChunks.size();
-        stats.totalCells = chunks.size() * CHUNK_SIZE * CHUNK_SIZE;
-        // Estimating active cells as we don't track individual cells
-        stats.activeCells = activeChunks.size() * CHUNK_SIZE * CHUNK_SIZE / 4; // Assuming ~25% of cells in active chunks are active
-        stats.activePercentage = stats.totalCells > 0 ? (stats.activeCells * 100.0f / stats.totalCells) : 0.0f;
-        return stats;
-    }
+    // Get performance statistics. Active cells are the cells of active
+    // chunks updated in the newest tick any of them tracked.
+    PerformanceStats getPerformanceStats() const;
+    
+    // Add the bytes held by chunks, split by where their data lives, and by
+    // the chunk index to a report
+    void addMemoryUsage(MemoryReport& report) const;
 };
 
 } // namespace astral
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "astral/physics/Cell.h"
+#include "astral/physics/ChunkManager.h"
+
+namespace astral {
+
+/**
+ * How CellularPhysics runs the movement phase over the active chunks.
+ *
+ * SERIAL visits the chunks one after the other on the updating thread.
+ * OUTBOX runs every active chunk as its own task on a ThreadPool, without
+ * locks and with two barriers per tick (after the chunk snapshots and after
+ * the moves) where checkerboard phasing needs four. A task owns its chunk's
+ * cells exclusively, sees other chunks as they were when the phase started,
+ * and writes to them only through its ChunkOutbox. The outboxes are settled
+ * on the updating thread after the phase.
+ */
+enum class ChunkUpdateStrategy {
+    SERIAL,
+    OUTBOX
+};
+
+/**
+ * A write a chunk's task deferred because it touches a cell of another chunk.
+ * It is applied only if the cells still hold the materials the task saw.
+ */
+struct BoundaryWrite {
+    enum class Kind : uint8_t {
+        MOVE,   // moveCell(from, to)
+        SWAP,   // swapCells(from, to)
+        EDIT    // Overwrite 'to' with cell
+    };
+
+    Kind kind;
+    WorldCoord from;           // The moving cell (MOVE, SWAP); equals 'to' for EDIT
+    WorldCoord to;             // The contested cell
+    MaterialID fromMaterial;   // Material 'from' must still hold (MOVE, SWAP)
+    MaterialID toMaterial;     // Material 'to' must still hold
+    Cell cell;                 // New contents of 'to' (EDIT)
+    uint64_t priority;         // The highest priority write to a cell wins
+};
+
+/**
+ * Writes and liquid body releases one chunk's task deferred to the end of
+ * the movement phase.
+ */
+class ChunkOutbox {
+public:
+    ChunkOutbox();
+
+    // Empty the outbox for a new tick
+    void reset(uint64_t tick);
+
+    void addMove(WorldCoord from, WorldCoord to, MaterialID fromMaterial, MaterialID toMaterial, bool swap);
+    void addEdit(WorldCoord to, MaterialID toMaterial, const Cell& cell);
+    void addRelease(WorldCoord cell) { releasePoints.push_back(cell); }
+    void addRelease(const WorldRect& area) { releaseAreas.push_back(area); }
+
+    const std::vector<BoundaryWrite>& getWrites() const { return writes; }
+    const std::vector<WorldCoord>& getReleasePoints() const { return releasePoints; }
+    const std::vector<WorldRect>& getReleaseAreas() const { return releaseAreas; }
+
+    size_t getMemoryUsage() const { return heapBytes(writes) + heapBytes(releasePoints) + heapBytes(releaseAreas); }
+
+    // Priority of a write in a tick: a hash of the cells and the tick, so it
+    // does not depend on which task made the write or when
+    static uint64_t priorityOf(WorldCoord from, WorldCoord to, uint64_t tick);
+
+private:
+    uint64_t tick;
+    std::vector<BoundaryWrite> writes;
+    std::vector<WorldCoord> releasePoints;
+    std::vector<WorldRect> releaseAreas;
+};
+
+// What happened to the boundary writes of one tick
+struct OutboxStats {
+    size_t writes = 0;      // Made by the tasks
+    size_t conflicts = 0;   // Lost to a higher priority write to the same cell
+    size_t stale = 0;       // Dropped because a cell no longer held the material the task saw
+    size_t applied = 0;
+};
+
+/**
+ * Settle the writes of a phase: of the writes to the same cell only the one
+ * with the highest priority survives (ties go to the lower source cell).
+ * Returns how many writes lost; writes is left holding the survivors in
+ * descending priority, the order they are applied in. The result does not
+ * depend on the order of the input.
+ */
+size_t settleBoundaryWrites(std::vector<BoundaryWrite>& writes);
+
+} // namespace astral
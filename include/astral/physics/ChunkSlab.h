@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "astral/core/MemoryReport.h"
+#include "astral/physics/Cell.h"
+
+namespace astral {
+
+// Forward declarations
+class ThreadPool;
+struct ChunkCoord;
+
+/**
+ * Settings for contiguous chunk storage.
+ */
+struct ChunkSlabConfig {
+    bool hugePages = true;              // Ask for transparent huge pages (Linux)
+    bool prefault = false;              // Touch every page now instead of when chunks are created
+    ThreadPool* firstTouchPool = nullptr;   // Prefault each stripe from a worker of its core group
+};
+
+/**
+ * One reservation holding the cells of every chunk of a bounded world.
+ *
+ * Chunks are laid out in Morton (Z-order) order of their chunk coordinates,
+ * so chunks that are close in the world are close in memory and a tick's
+ * cross-chunk moves stay within a few pages. On Linux the region is mapped
+ * anonymously, aligned to 2 MiB and advised for transparent huge pages, which
+ * cuts the TLB entries a large world needs by up to 512x; elsewhere it falls
+ * back to one heap allocation.
+ *
+ * The slots are split into one stripe per core group of the first-touch pool.
+ * Each stripe is a contiguous run of Morton slots and so a compact area of the
+ * world. When prefaulting with a pool, each stripe is first written by a worker
+ * of its group, so the kernel places its pages on that group's NUMA node.
+ * getStripe() lets callers route work on a chunk to the group owning its memory.
+ */
+class ChunkSlab {
+public:
+    // Throws std::invalid_argument for an empty grid, std::bad_alloc when the
+    // region cannot be reserved
+    ChunkSlab(int chunksX, int chunksY, int chunkSize, const ChunkSlabConfig& config = ChunkSlabConfig());
+    ~ChunkSlab();
+
+    ChunkSlab(const ChunkSlab&) = delete;
+    ChunkSlab& operator=(const ChunkSlab&) = delete;
+
+    int getChunksX() const { return chunksX; }
+    int getChunksY() const { return chunksY; }
+    int getChunkSize() const { return chunkSize; }
+
+    bool contains(ChunkCoord coord) const;
+
+    // Storage for a chunk's cells, or nullptr outside the grid. The cells are
+    // not initialised unless the slab was prefaulted.
+    Cell* getChunkCells(ChunkCoord coord) const;
+
+    // Position of a chunk in memory, in chunks from the start of the slab
+    size_t getSlot(ChunkCoord coord) const;
+
+    // Stripe (core group of the first-touch pool) a chunk's memory belongs to
+    int getStripe(ChunkCoord coord) const;
+    int getStripeCount() const { return stripeCount; }
+
+    size_t getBytes() const { return mappingSize; }
+    size_t getMemoryUsage() const { return mappingSize + heapBytes(slotOfChunk); }   // Reservation and slot table
+    bool isMapped() const { return mapped; }
+    bool isHugePageAdvised() const { return hugePageAdvised; }
+
+    // Interleave the bits of x and y (x in the even bits)
+    static uint64_t mortonCode(uint32_t x, uint32_t y);
+
+private:
+    int chunksX;
+    int chunksY;
+    int chunkSize;
+    size_t cellsPerChunk;
+    std::vector<uint32_t> slotOfChunk;  // Row-major chunk index -> Morton slot
+    int stripeCount;
+
+    void* mapping;          // Start of the reservation
+    size_t mappingSize;
+    Cell* base;             // First slot, aligned to the huge page size
+    bool mapped;            // Memory came from mmap rather than the heap
+    bool hugePageAdvised;
+
+    void reserve(bool hugePages);
+    void prefault(ThreadPool* pool);
+};
+
+} // namespace astral
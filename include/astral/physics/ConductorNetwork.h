@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include "astral/physics/ChunkManager.h"
+
+namespace astral {
+
+// Forward declarations
+class MaterialTable;
+
+/**
+ * Settings for electricity in conductors.
+ */
+struct ConductorNetworkConfig {
+    float currentThreshold = 1.0f;   // Charge per cell from which current flows
+    float heating = 20.0f;           // Degrees per second per unit of charge per cell while current flows
+    float leakRate = 0.2f;           // Fraction of a current-carrying component's charge lost per second
+};
+
+// Counts after the last update
+struct ConductorStats {
+    size_t cells = 0;        // Conductive cells tracked
+    size_t components = 0;   // Connected groups of them
+    size_t carrying = 0;     // Components current flowed through
+    size_t relabelled = 0;   // Cells reassigned because their component split
+    size_t examined = 0;     // Cells read to find the reported changes
+};
+
+/**
+ * Electricity on connected groups of conductive cells (materials with the
+ * CONDUCTIVE flag, joined through their four neighbours). The groups are
+ * kept in a union-find over the cells of a bounded world; each root holds
+ * the group's members and total charge, so charge spreads over a group at
+ * once instead of diffusing cell by cell.
+ *
+ * Whoever writes cells reports the ones that became or stopped being
+ * conductive with noteChange() (or noteChunk() for writes over a whole
+ * chunk), and every update looks only at those. New cells join their
+ * neighbours' groups with unions; a group that lost cells is relabelled by
+ * a flood fill over its remaining members and its charge shared out by
+ * size. Groups carrying more than currentThreshold charge per cell heat
+ * their cells and leak charge. Cells of groups whose charge changed get
+ * their share written to Cell::charge and FLAG_CHARGED set while current
+ * flows; cells joining a group bring no charge with them.
+ */
+class ConductorNetwork {
+public:
+    // Throws std::invalid_argument for an unbounded world
+    ConductorNetwork(const MaterialTable* materials, ChunkManager* chunkManager,
+                     int worldWidth, int worldHeight, const ConductorNetworkConfig& config);
+
+    const ConductorNetworkConfig& getConfig() const { return config; }
+    const ConductorStats& getStats() const { return stats; }
+
+    // Whether cells of a material conduct
+    bool conducts(MaterialID material) const {
+        return material < conductiveMaterial.size() ? conductiveMaterial[material] != 0 : lookUpConductive(material);
+    }
+
+    // Report a cell whose material changed; only changes into or out of a
+    // conductor are queued for the next update
+    void noteChange(int x, int y, MaterialID before, MaterialID after) {
+        if (conducts(before) != conducts(after)) noteCell(x, y);
+    }
+    void noteCell(int x, int y) {
+        if (inWorld(x, y)) changedCells.push_back(indexOf(x, y));
+    }
+
+    // Rescan a whole chunk at the next update, for writes not reported cell by cell
+    void noteChunk(const ChunkCoord& coord) { changedChunks.insert(coord); }
+
+    // Follow the reported changes and apply current effects
+    void update(float deltaTime);
+
+    // Forget everything and scan every resident chunk
+    void rebuild();
+
+    // Add charge to the group a cell belongs to; false if it is not a conductor
+    bool addCharge(int x, int y, float amount);
+
+    bool isConductor(int x, int y) const;
+    bool isConnected(int x1, int y1, int x2, int y2) const;
+
+    // Cells in the cell's group and each cell's share of its charge; 0 for
+    // cells that are not conductors
+    size_t getComponentSize(int x, int y) const;
+    float getCharge(int x, int y) const;
+
+    // Heap bytes of the union-find, the groups, the reported changes and the scratch
+    size_t getMemoryUsage() const;
+
+private:
+    struct Component {
+        std::vector<int> cells;
+        double charge = 0.0;
+        bool changed = false;   // Charge or members changed since the cells were written
+    };
+
+    const MaterialTable* materials;
+    ChunkManager* chunkManager;
+    int worldWidth;
+    int worldHeight;
+    ConductorNetworkConfig config;
+    ConductorStats stats;
+
+    mutable std::vector<int> parent;   // Per cell; -1 where there is no conductor
+    std::unordered_map<int, Component> components;   // By root
+    std::vector<uint8_t> conductiveMaterial;   // Per material id
+
+    // Reported since the last update
+    std::vector<int> changedCells;
+    std::set<ChunkCoord> changedChunks;
+
+    // Scratch
+    std::vector<int> added;
+    std::vector<int> removed;
+    std::vector<int> dirtyRoots;
+    std::vector<int> queue;
+
+    int indexOf(int x, int y) const { return y * worldWidth + x; }
+    bool inWorld(int x, int y) const { return x >= 0 && y >= 0 && x < worldWidth && y < worldHeight; }
+    int find(int index) const;
+    void unite(int a, int b);
+
+    void refreshMaterials();
+    bool lookUpConductive(MaterialID material) const;
+    void scanCell(int index);
+    void scanChunk(const Chunk& chunk);
+    void split(int root);
+    void applyCurrent(float deltaTime);
+
+    // Store a group's charge share in its cells, heating them by heat degrees
+    void writeCells(Component& component, float share, float heat);
+};
+
+} // namespace astral
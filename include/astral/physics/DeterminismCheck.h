@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "astral/physics/ChunkManager.h"
+#include "astral/physics/ChunkOutbox.h"
+#include "astral/physics/Scenario.h"
+
+namespace astral {
+
+class CellularAutomaton;
+
+/**
+ * One way of running the engine. Two setups that are meant to be
+ * interchangeable (one worker or several, heap or slab storage) must produce
+ * the same world every tick.
+ */
+struct EngineSetup {
+    std::string name;
+    ChunkUpdateStrategy strategy = ChunkUpdateStrategy::SERIAL;
+    int threads = 1;            // Workers of the pool OUTBOX runs on
+    bool slabStorage = false;
+    std::function<void(CellularAutomaton&)> configure;   // Applied after the scenario is built
+};
+
+struct DeterminismConfig {
+    ScenarioConfig scenario;
+    int worldWidth = 256;
+    int worldHeight = 256;
+    int chunkSize = CHUNK_SIZE;
+    int ticks = 120;
+    float deltaTime = 1.0f / 60.0f;
+    size_t maxCellDiffs = 16;   // Cells listed for the diverging chunk
+};
+
+// A cell that differs between the two runs
+struct CellDiff {
+    int x;
+    int y;
+    Cell first;
+    Cell second;
+};
+
+struct DeterminismResult {
+    int ticksCompared = 0;
+    bool diverged = false;
+
+    // Where the runs first differed: the tick (0 is the initial world) and
+    // the lowest diverging chunk
+    int tick = -1;
+    ChunkCoord chunk = {0, 0};
+    size_t divergingChunks = 0;
+    size_t differingCells = 0;     // In the reported chunk
+    std::vector<CellDiff> cells;   // Up to maxCellDiffs of them, row-major
+
+    // Summary line, followed by the cell diff when the runs diverged
+    std::string describe(const EngineSetup& first, const EngineSetup& second) const;
+};
+
+/**
+ * Run a scenario under two engine setups side by side and compare every
+ * chunk after every tick. Chunks are compared by a hash of all the state a
+ * saved chunk keeps (every cell field but the per-tick updated flag); the
+ * first tick with a differing chunk stops the run and the chunk is diffed
+ * cell by cell.
+ */
+DeterminismResult verifyDeterminism(const DeterminismConfig& config, const EngineSetup& first,
+                                    const EngineSetup& second);
+
+// Hash of a chunk's cells as compared by verifyDeterminism()
+uint64_t hashChunkContent(const Chunk& chunk);
+
+// Every field of a cell on one line
+std::string describeCell(const Cell& cell);
+
+} // namespace astral
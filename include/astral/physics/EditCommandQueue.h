@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <nlohmann/json.hpp>
+#include "astral/physics/Cell.h"
+
+namespace astral {
+
+/**
+ * Kinds of world edits that can be submitted from any thread.
+ */
+enum class EditCommandType {
+    PAINT_CELL,       // Set a single cell to a material
+    PAINT_CIRCLE,     // Fill a circle with a material
+    FILL_RECTANGLE,   // Fill a rectangle with a material
+    EXPLOSION,        // Explosion centered on a point
+    HEAT_SOURCE,      // Heat a circular area
+    FORCE             // Push cells in a circular area
+};
+
+/**
+ * A single world edit. Fields that do not apply to a command type are ignored.
+ */
+struct EditCommand {
+    EditCommandType type = EditCommandType::PAINT_CELL;
+    int x = 0;                  // Anchor (center or top-left corner)
+    int y = 0;
+    int width = 0;              // Rectangle size (FILL_RECTANGLE)
+    int height = 0;
+    float radius = 0.0f;        // Circle, explosion, heat and force radius
+    float amount = 0.0f;        // Explosion power, heat temperature or force strength
+    glm::vec2 direction = glm::vec2(0.0f, 0.0f); // Force direction
+    MaterialID material = 0;    // Paint material
+    uint64_t sequence = 0;      // Submission order, assigned by the queue
+};
+
+/**
+ * Serialise an edit for traces and replays.
+ */
+nlohmann::json editCommandToJson(const EditCommand& command);
+
+/**
+ * Parse an edit written by editCommandToJson.
+ * @return False if the type is unknown
+ */
+bool editCommandFromJson(const nlohmann::json& json, EditCommand& command);
+
+/**
+ * Multi-producer, single-consumer lock-free queue of edit commands.
+ *
+ * Producers push with a single CAS onto an intrusive stack. The consumer takes
+ * the whole stack with one exchange and reverses it, so commands come out in
+ * submission order without ever blocking a producer.
+ */
+class EditCommandQueue {
+private:
+    struct Node {
+        EditCommand command;
+        Node* next;
+    };
+
+    std::atomic<Node*> head;
+    std::atomic<uint64_t> nextSequence;
+
+public:
+    EditCommandQueue();
+    ~EditCommandQueue();
+
+    EditCommandQueue(const EditCommandQueue&) = delete;
+    EditCommandQueue& operator=(const EditCommandQueue&) = delete;
+
+    // Submit a command (safe from any thread)
+    void push(const EditCommand& command);
+
+    // Move all pending commands into out in submission order (consumer thread only).
+    // Returns the number of commands appended.
+    size_t drain(std::vector<EditCommand>& out);
+
+    // True if no commands are pending (approximate while producers are active)
+    bool empty() const { return head.load(std::memory_order_acquire) == nullptr; }
+
+    // Commands pending and the bytes of their nodes (consumer thread only)
+    size_t getPendingCount() const;
+    size_t getMemoryUsage() const { return getPendingCount() * sizeof(Node); }
+};
+
+} // namespace astral
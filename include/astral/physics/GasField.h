@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "astral/physics/ChunkManager.h"
+
+namespace astral {
+
+// Forward declarations
+class MaterialRegistry;
+
+/**
+ * Settings for the coarse gas field.
+ */
+struct GasFieldConfig {
+    int cellsPerSample = 4;        // Sample edge length in cells
+    int sparseCells = 3;           // Blocks with at most this many gas cells are absorbed
+    float denseCells = 8.0f;       // Samples holding this many cells' worth turn back into cells
+    float buoyancy = 120.0f;       // Upward acceleration, cells per second squared
+    float drag = 3.0f;             // Fraction of the velocity lost per second
+    float diffusion = 2.0f;        // Horizontal spreading, samples squared per second
+    std::vector<std::string> materials = {"Smoke", "Steam"};
+};
+
+/**
+ * Coarse Eulerian field for thin gases. Each sample covers a square block of
+ * cells and holds one density per tracked material (in cells' worth) plus a
+ * shared velocity.
+ *
+ * Every tick the field:
+ *  1. absorbs blocks that hold nothing but air and a few tracked gas cells
+ *     and have an open block above them,
+ *  2. accelerates the velocity upwards where there is gas and applies drag,
+ *  3. turns the gas flowing into a block with anything but air (solids,
+ *     liquids, fire, dense gas) back into cells, so all interactions stay
+ *     per-cell,
+ *  4. advects each density semi-Lagrangian (backtrace along the velocity,
+ *     bilinear sample), spreads it sideways and rescales it to conserve mass,
+ *  5. decays it with the mean lifetime of the absorbed cells, and
+ *  6. turns samples denser than denseCells back into cells.
+ *
+ * The grid arrays are contiguous per quantity and the inner loops are
+ * branch-free so the compiler vectorises them. Gas in the field does not
+ * react or change state and is not visible in the cells; renderers draw it
+ * with getDensity(). Only bounded worlds are supported.
+ */
+class GasField {
+public:
+    // Throws std::invalid_argument for an unbounded world or bad settings
+    GasField(const MaterialRegistry* registry, ChunkManager* chunkManager,
+             int worldWidth, int worldHeight, const GasFieldConfig& config);
+
+    const GasFieldConfig& getConfig() const { return config; }
+    int getSampleWidth() const { return sampleWidth; }
+    int getSampleHeight() const { return sampleHeight; }
+
+    // Advance the field by one tick
+    void update(float deltaTime);
+
+    // Turn every sample back into cells, as far as there is air for them
+    void materializeAll();
+    void clear();
+
+    // Density of a material around a cell, in cells' worth per cell
+    float getDensity(int x, int y, MaterialID material) const;
+
+    // Cells' worth of gas held by the field, for one material or all of them,
+    // including blocked gas not yet turned into cells
+    float getTotalDensity(MaterialID material) const;
+    float getTotalDensity() const;
+
+    // Whether the field takes in cells of a material
+    bool tracks(MaterialID material) const { return channelOf(material) >= 0; }
+
+    // Chunks the last update() or materializeAll() took cells from or placed
+    // cells in; a chunk may be listed more than once
+    const std::vector<ChunkCoord>& getChangedChunks() const { return changedChunks; }
+
+    // Statistics since creation
+    uint64_t getAbsorbedCells() const { return absorbedCells; }
+    uint64_t getMaterializedCells() const { return materializedCells; }
+
+    // Heap bytes of the sample grids
+    size_t getMemoryUsage() const;
+
+private:
+    // One tracked material
+    struct Channel {
+        MaterialID material;
+        std::vector<float> density;
+        std::vector<float> next;
+        std::vector<float> pending;   // Blocked gas waiting to make up a whole cell
+        float meanLifetime;       // Ticks; 0 means the gas does not decay
+        float meanTemperature;
+    };
+
+    const MaterialRegistry* materialRegistry;
+    ChunkManager* chunkManager;
+    GasFieldConfig config;
+    int worldWidth;
+    int worldHeight;
+    int sampleWidth;
+    int sampleHeight;
+
+    std::vector<Channel> channels;
+    std::vector<float> velocityX;   // Cells per second
+    std::vector<float> velocityY;
+    std::vector<float> open;        // 1 where the block holds only air and tracked gas
+    std::vector<uint16_t> gasCells; // Tracked gas cells in each open block
+    std::vector<int> channelOfMaterial;   // Material id -> channel, -1 if untracked
+    std::vector<ChunkCoord> changedChunks;
+
+    uint64_t absorbedCells;
+    uint64_t materializedCells;
+
+    int channelOf(MaterialID material) const {
+        return material < channelOfMaterial.size() ? channelOfMaterial[material] : -1;
+    }
+
+    bool isOpen(int sampleX, int sampleY) const {
+        return sampleX >= 0 && sampleY >= 0 && sampleX < sampleWidth && sampleY < sampleHeight &&
+               open[static_cast<size_t>(sampleY) * sampleWidth + sampleX] != 0.0f;
+    }
+
+    void absorbSparseBlocks();
+    void updateVelocity(float deltaTime);
+    void materializeBlocked(float deltaTime);
+    void advect(Channel& channel, float deltaTime);
+    void decay(Channel& channel);
+    void materializeDense();
+
+    // Place up to count cells of a channel's gas into the air of a sample's
+    // block; returns how many were placed
+    int materialize(Channel& channel, int sampleX, int sampleY, int count);
+};
+
+} // namespace astral
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "astral/physics/ChunkManager.h"
+
+namespace astral {
+
+// Forward declarations
+class MaterialRegistry;
+class CellProcessor;
+
+/**
+ * Aggregate record for the interior of a settled liquid body. The interior
+ * cells stay in their chunks (renderers, statistics and saves read them as
+ * before) but the per-cell passes skip them while the record exists.
+ */
+struct LiquidBody {
+    // Run of interior cells in one row, x1 exclusive
+    struct Span {
+        int y;
+        int x0;
+        int x1;
+    };
+
+    uint32_t id = 0;
+    MaterialID material = 0;
+    size_t cellCount = 0;                 // Interior cells
+    float meanTemperature = 20.0f;        // Of the interior, drifting to ambient
+    WorldRect bounds = {0, 0, 0, 0};      // Of the interior
+    std::vector<Span> interior;           // Sorted by row, then column
+    std::vector<WorldCoord> surface;      // Shallowest boundary cell of each column
+    std::vector<WorldCoord> boundary;     // Simulated cells enclosing the interior
+
+    // Interior temperatures when the body was formed; the offset from
+    // ambient shrinks by ambientDecay while the cells are skipped
+    float initialMeanTemperature = 20.0f;
+    float initialMinTemperature = 20.0f;
+    float initialMaxTemperature = 20.0f;
+    float ambientDecay = 1.0f;
+};
+
+/**
+ * Finds settled liquid bodies and replaces their interiors with LiquidBody
+ * records, so a lake costs the per-cell passes its shoreline rather than its
+ * area.
+ *
+ * A liquid cell is interior when its eight neighbours hold the same liquid;
+ * such a cell cannot move or react. A connected group of interior cells is
+ * aggregated once every cell around it is stuck as well, which rules out
+ * falling or still-spreading liquid. The boundary is checked every tick and
+ * the whole body is re-expanded into per-cell form as soon as a boundary cell
+ * changes material, an interior cell is overwritten, or the interior would
+ * cross its freezing or boiling point.
+ *
+ * While skipped, interior cells keep their own temperatures and relax to
+ * ambient exactly as applyTemperature() would have moved them; the drift is
+ * applied when the body is re-expanded. Heat still flows in from the boundary
+ * cells, but not between interior cells.
+ */
+class LiquidBodyTracker {
+public:
+    using PositionCheck = std::function<bool(int, int)>;
+
+    LiquidBodyTracker(const MaterialRegistry* registry, ChunkManager* chunkManager,
+                      const CellProcessor* cellProcessor, PositionCheck isValidPosition);
+
+    // Disabling re-expands every body
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return enabled; }
+
+    // Smaller groups of interior cells are left per-cell
+    void setMinimumCells(size_t cells) { minimumCells = cells; }
+    size_t getMinimumCells() const { return minimumCells; }
+
+    // Ticks between searches for new bodies
+    void setDetectionInterval(int ticks);
+    int getDetectionInterval() const { return detectionInterval; }
+
+    /**
+     * Called at the start of each tick: re-expand breached bodies, advance
+     * the interior temperatures and, every detection interval, aggregate new
+     * settled bodies in the active chunks.
+     */
+    void update(float deltaTime);
+
+    // Look for new bodies now
+    void detect();
+
+    // Re-expand the body containing an interior cell, if any
+    void releaseAt(int x, int y);
+
+    // Re-expand every body whose interior bounds overlap the area
+    void releaseArea(const WorldRect& area);
+    void releaseAll();
+
+    // Bodies and statistics
+    const std::vector<LiquidBody>& getBodies() const { return bodies; }
+    size_t getAggregatedCellCount() const;
+    size_t getBoundaryCellCount() const;
+    uint64_t getReleasedBodyCount() const { return releasedBodies; }
+
+    // Heap bytes of the bodies and the detection scratch
+    size_t getMemoryUsage() const;
+
+private:
+    // Material properties the tracker reads per cell, cached by id since
+    // MaterialRegistry::getMaterial() copies the whole record
+    struct MaterialInfo {
+        bool known = false;
+        bool liquid = false;
+        float freezingPoint = 0.0f;
+        float boilingPoint = 0.0f;
+    };
+
+    const MaterialRegistry* materialRegistry;
+    ChunkManager* chunkManager;
+    const CellProcessor* cellProcessor;
+    PositionCheck isValidPosition;
+
+    bool enabled;
+    size_t minimumCells;
+    int detectionInterval;
+    int ticksUntilDetection;
+    uint32_t nextBodyId;
+    uint64_t releasedBodies;
+    std::vector<LiquidBody> bodies;
+    std::vector<MaterialInfo> materialInfo;
+
+    // Per-chunk scratch marks used while detecting
+    std::unordered_map<ChunkCoord, std::vector<uint8_t>, ChunkCoordHash> marks;
+
+    const MaterialInfo& getMaterialInfo(MaterialID id);
+    const Cell* findCell(int x, int y) const;   // nullptr if the chunk is not resident
+    uint8_t& markAt(int x, int y);
+    uint8_t getMark(int x, int y) const;
+    bool isInteriorCandidate(int x, int y, const Cell& cell);
+    bool isStuck(int x, int y, const Cell& cell) const;
+    bool isBreached(const LiquidBody& body);
+    void aggregate(MaterialID material, std::vector<WorldCoord>& cells);
+    void release(size_t index);
+    void setAggregated(int x, int y, MaterialID material);
+};
+
+} // namespace astral
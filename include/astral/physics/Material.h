@@ -4,6 +4,7 @@
 #include <vector>
 #include <unordered_map>
 #include <random>
+#include <memory>
 #include <glm/glm.hpp>
 #include "astral/physics/Cell.h"
 
@@ -45,6 +46,9 @@ enum class MaterialType {
     SPECIAL         // Special materials with unique properties
 };
 
+// Name of a material type (a string literal, e.g. "LIQUID")
+const char* materialTypeName(MaterialType type);
+
 // Simple category for easy material grouping
 enum class MaterialCategory {
     NONE,        // Uncategorized
@@ -108,6 +112,10 @@ struct MaterialProperties {
     float lifetime;       // For temporary materials (like fire, smoke)
     float burnRate;       // How quickly it burns away once ignited
     
+    // Scheduling: cells are updated every updateInterval ticks, each on its
+    // own phase, with the time step scaled to match (1 = every tick)
+    int updateInterval;
+    
     // Simple flags (bit field for efficient storage)
     uint32_t flags;
     enum Flags {
@@ -130,6 +138,13 @@ struct MaterialProperties {
     MaterialProperties();
     MaterialProperties(MaterialType type, const std::string& name, const glm::vec4& color);
     
+    // Heap bytes of the name, reactions and state changes
+    size_t getMemoryUsage() const;
+    
+    // Update interval for a viscous material: one tick more per 0.25 of
+    // viscosity (lava at 0.6 updates every third tick)
+    static int intervalForViscosity(float viscosity);
+    
     // Flag helpers
     bool hasFlag(Flags flag) const { return (flags & flag) != 0; }
     void setFlag(Flags flag) { flags |= flag; }
@@ -155,9 +170,16 @@ public:
     // Register basic built-in materials
     void registerBasicMaterials();
     
+    // Create a registry holding the basic materials, meant to be shared
+    // read-only between many simulations
+    static std::shared_ptr<const MaterialRegistry> createShared();
+    
     // Get material properties
     MaterialProperties getMaterial(MaterialID id) const;
     
+    // One past the highest registered material id
+    MaterialID getIDLimit() const { return nextID; }
+    
     // Get material ID from name
     MaterialID getIDFromName(const std::string& name) const;
     bool hasMaterialName(const std::string& name) const;
@@ -174,6 +196,83 @@ public:
     MaterialID getSmokeID() const;
     MaterialID getWoodID() const;
     MaterialID getOilFireID() const;
+    
+    // Heap bytes held, not counting the registry itself
+    size_t getMemoryUsage() const;
+};
+
+/**
+ * What a cell of a temporary material turns into when its lifetime runs
+ * out. Fire turns to smoke and gases dissipate into air.
+ */
+struct DecayRule {
+    MaterialID product = 0;
+    float temperature = -1.0f;   // Temperature of the product; negative keeps the cell's
+    uint8_t lifetime = 0;        // Lifetime of the product, plus up to lifetimeJitter ticks
+    uint8_t lifetimeJitter = 0;
+    uint8_t metadata = 0;
+};
+
+/**
+ * Read-only snapshot of a registry for the physics rules: properties in a
+ * vector indexed by material id, returned by reference, and the ids of the
+ * common materials resolved once. It is never written after construction,
+ * so any number of threads can read it. Rebuild it after registering
+ * materials.
+ */
+class MaterialTable {
+private:
+    std::vector<MaterialProperties> properties;   // Unknown ids hold air
+    std::vector<uint8_t> updateIntervals;         // Per id, clamped to 1..255
+    std::vector<uint8_t> decaying;                // Per id, 1 if the lifetime counts down
+    std::vector<DecayRule> decayRules;
+    MaterialID sandID;
+    MaterialID waterID;
+    MaterialID stoneID;
+    MaterialID oilID;
+    MaterialID lavaID;
+    MaterialID fireID;
+    MaterialID steamID;
+    MaterialID smokeID;
+    MaterialID woodID;
+    MaterialID oilFireID;
+    
+public:
+    explicit MaterialTable(const MaterialRegistry& registry);
+    
+    // Properties of a material; unknown ids return air like the registry
+    const MaterialProperties& getMaterial(MaterialID id) const {
+        return properties[id < properties.size() ? id : 0];
+    }
+    size_t size() const { return properties.size(); }
+    
+    // Ticks between updates of a material's cells
+    int getUpdateInterval(MaterialID id) const {
+        return updateIntervals[id < updateIntervals.size() ? id : 0];
+    }
+    
+    // Whether cells of a material count their lifetime down every tick, as
+    // one flag per id (size() entries), and what they turn into at zero
+    bool decays(MaterialID id) const { return decaying[id < decaying.size() ? id : 0] != 0; }
+    const uint8_t* getDecayFlags() const { return decaying.data(); }
+    const DecayRule& getDecayRule(MaterialID id) const {
+        return decayRules[id < decayRules.size() ? id : 0];
+    }
+    
+    MaterialID getDefaultMaterialID() const { return 0; }
+    MaterialID getSandID() const { return sandID; }
+    MaterialID getWaterID() const { return waterID; }
+    MaterialID getStoneID() const { return stoneID; }
+    MaterialID getOilID() const { return oilID; }
+    MaterialID getLavaID() const { return lavaID; }
+    MaterialID getFireID() const { return fireID; }
+    MaterialID getSteamID() const { return steamID; }
+    MaterialID getSmokeID() const { return smokeID; }
+    MaterialID getWoodID() const { return woodID; }
+    MaterialID getOilFireID() const { return oilFireID; }
+    
+    // Heap bytes held, not counting the table itself
+    size_t getMemoryUsage() const;
 };
 
 // CellProcessor moved to its own header file
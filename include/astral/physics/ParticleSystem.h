@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include "astral/physics/ChunkManager.h"
+
+namespace astral {
+
+// Forward declarations
+class CellProcessor;
+
+/**
+ * Settings for airborne particles.
+ */
+struct ParticleSystemConfig {
+    size_t maxParticles = 16384;   // Spawns beyond this are refused
+    float gravity = 200.0f;        // Downward acceleration, cells per second squared
+    float drag = 0.5f;             // Fraction of the velocity lost per second
+    float restitution = 0.3f;      // Share of the speed kept across a bounce
+    float friction = 0.6f;         // Share of the sliding speed kept across a bounce
+    float restSpeed = 4.0f;        // Particles slower than this after a bounce settle, cells per second
+    float ejectChance = 0.5f;      // Chance a loose cell in a blast flies off as a particle
+    float ejectSpeed = 8.0f;       // Launch speed per unit of blast power at the centre, cells per second
+    int sparks = 12;               // Fire particles thrown from a blast's centre
+    float sparkSeconds = 0.6f;     // How long a spark flies before it burns out
+};
+
+// Totals since the system was created
+struct ParticleStats {
+    uint64_t spawned = 0;
+    uint64_t deposited = 0;   // Came to rest and went back into the grid
+    uint64_t burnedOut = 0;   // Ran out of time in flight
+    uint64_t lost = 0;        // Found no free cell to come to rest in
+};
+
+/**
+ * Cells flying off the grid: debris and droplets thrown by explosions and
+ * sparks. Particles live in contiguous per-quantity arrays (position,
+ * velocity, remaining flight time) and carry the cell they will become.
+ *
+ * Every tick the system:
+ *  1. integrates gravity and drag for all particles in one branch-free loop
+ *     the compiler vectorises,
+ *  2. traces each particle's step cell by cell against bitmasks of the
+ *     occupied cells of the chunks it crosses (built once per tick and only
+ *     for those chunks), bouncing off what it hits,
+ *  3. writes particles that slowed below restSpeed back into the grid at
+ *     their cell, or the nearest free cell above it, and wakes the chunk,
+ *  4. drops sparks whose flight time ran out.
+ *
+ * Air and gas do not stop particles; everything else does, as do cells
+ * outside the world and chunks that are not loaded. Particles in flight do
+ * not react, exchange heat or keep chunks awake.
+ */
+class ParticleSystem {
+public:
+    // worldWidth or worldHeight may be 0 for an unbounded axis
+    ParticleSystem(const CellProcessor* processor, ChunkManager* chunkManager,
+                   int worldWidth, int worldHeight, const ParticleSystemConfig& config);
+
+    const ParticleSystemConfig& getConfig() const { return config; }
+    const ParticleStats& getStats() const { return stats; }
+
+    // Add a particle carrying a cell; returns false when the system is full.
+    // flightSeconds bounds its time in the air.
+    bool spawn(float x, float y, float velocityX, float velocityY, const Cell& cell,
+               float flightSeconds = std::numeric_limits<float>::infinity());
+
+    // Advance every particle by one tick
+    void update(float deltaTime);
+
+    // Put every particle into the grid where it is
+    void depositAll();
+    void clear();
+
+    // Particles in flight, for rendering; positions are in cells
+    size_t size() const { return positionX.size(); }
+    bool empty() const { return positionX.empty(); }
+    const std::vector<float>& getPositionsX() const { return positionX; }
+    const std::vector<float>& getPositionsY() const { return positionY; }
+    const std::vector<float>& getVelocitiesX() const { return velocityX; }
+    const std::vector<float>& getVelocitiesY() const { return velocityY; }
+    const std::vector<Cell>& getCells() const { return cells; }
+
+    // Cells particles came to rest in during the last update() or depositAll()
+    const std::vector<WorldCoord>& getLanded() const { return landed; }
+
+    // Particles carrying a material
+    size_t countMaterial(MaterialID material) const;
+
+    // Heap bytes of the particle arrays and the occupancy masks
+    size_t getMemoryUsage() const;
+
+private:
+    const CellProcessor* processor;
+    ChunkManager* chunkManager;
+    int worldWidth;
+    int worldHeight;
+    ParticleSystemConfig config;
+    ParticleStats stats;
+
+    std::vector<float> positionX;
+    std::vector<float> positionY;
+    std::vector<float> velocityX;   // Cells per second; +y is down
+    std::vector<float> velocityY;
+    std::vector<float> flightLeft;  // Seconds
+    std::vector<Cell> cells;        // What each particle turns back into
+    std::vector<float> lastX;       // Positions before the tick's step
+    std::vector<float> lastY;
+    std::vector<WorldCoord> landed;
+
+    // Occupied cells of the chunks particles crossed this tick, one bit per
+    // cell in rows of wordsPerRow words
+    int wordsPerRow;
+    std::unordered_map<ChunkCoord, std::vector<uint64_t>, ChunkCoordHash> occupancy;
+
+    bool isBlocked(int x, int y);
+    void markOccupied(int x, int y);
+    const std::vector<uint64_t>* occupancyOf(ChunkCoord coord);
+
+    // Move a particle along its step; returns true when it came to rest
+    bool trace(size_t index);
+
+    // Write a particle into the grid at or above a cell; false if no cell was free
+    bool deposit(size_t index, int x, int y);
+    void remove(size_t index);
+};
+
+} // namespace astral
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "astral/physics/ChunkManager.h"
+
+namespace astral {
+
+// Forward declarations
+class CellProcessor;
+
+/**
+ * Which ordered material pairs can react. CellProcessor::canReact only looks
+ * at the two materials, so it is evaluated once per pair when the material
+ * table is built. Materials that take part in at least one reactive pair are
+ * numbered densely as participants.
+ */
+class ReactionMatrix {
+public:
+    explicit ReactionMatrix(const CellProcessor& processor);
+
+    // Whether a cell of material a can react with a neighbour of material b;
+    // ids outside the table never react
+    bool canReact(MaterialID a, MaterialID b) const {
+        return a < materialCount && b < materialCount && pairs[static_cast<size_t>(a) * materialCount + b];
+    }
+
+    // Participant index of a material, or -1 if it never reacts
+    int getParticipant(MaterialID material) const {
+        return material < materialCount ? participantOf[material] : -1;
+    }
+    int getParticipantCount() const { return static_cast<int>(participants.size()); }
+
+    // Participants a participant can react with as the first cell of a pair
+    const std::vector<int>& getPartners(int participant) const { return partners[participant]; }
+
+    // Heap bytes held
+    size_t getMemoryUsage() const;
+
+private:
+    size_t materialCount;
+    std::vector<uint8_t> pairs;             // materialCount x materialCount
+    std::vector<int> participantOf;         // Material id -> participant, -1 if none
+    std::vector<MaterialID> participants;
+    std::vector<std::vector<int>> partners;
+};
+
+/**
+ * Per-chunk bitmask of the cells that have at least one neighbour (of the 8)
+ * they can react with, so the interaction pass only evaluates reactions
+ * there.
+ *
+ * build() sets one bit row per participant material for the chunk and a one
+ * cell halo from its neighbours, dilates each row to the 3x3 neighbourhood
+ * with shifted ORs, and ANDs every material's rows with the OR of its
+ * partners' dilated rows. Chunks without participants cost one pass over
+ * their cells. Cells whose materials change during the pass must be marked
+ * with markAround() so reactions that become possible are not missed.
+ */
+class ReactionMask {
+public:
+    ReactionMask();
+
+    void build(const ReactionMatrix& matrix, const ChunkManager& chunks, ChunkCoord coord);
+
+    bool isCandidate(int x, int y) const {
+        int column = x + 1;
+        return (candidates[static_cast<size_t>(y) * words + column / 64] >> (column % 64)) & 1;
+    }
+
+    // Whether a row has no candidates
+    bool isRowQuiet(int y) const;
+
+    // Mark the 3x3 neighbourhood of a cell (clipped to the chunk)
+    void markAround(int x, int y);
+
+    // Candidates in the last build, before any marks
+    size_t getBuiltCandidateCount() const { return builtCandidates; }
+
+    // Heap bytes held
+    size_t getMemoryUsage() const {
+        return heapBytes(candidates) + heapBytes(present) + heapBytes(near) + heapBytes(reach) + heapBytes(isPartner);
+    }
+
+private:
+    int size;
+    int words;                        // Words per row of size + 2 bits (one halo column each side)
+    std::vector<uint64_t> candidates; // size rows
+    std::vector<uint64_t> present;    // Per participant: size + 2 rows, halo included
+    std::vector<uint64_t> near;       // Per participant: size rows, dilated to the 3x3 neighbourhood
+    std::vector<uint64_t> reach;      // One row: OR of the partners' near rows
+    std::vector<uint8_t> isPartner;   // Per participant: some participant reacts with it
+    size_t builtCandidates;
+};
+
+} // namespace astral
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "astral/physics/ChunkManager.h"
+
+namespace astral {
+
+/**
+ * Log-structured file of saved chunks.
+ *
+ * After a header (magic and chunk size) the file is a sequence of records,
+ * each a 32-bit body length, a checksum of the body and the body: chunk
+ * coordinate, the tick it was copied at and its encoded cells. Saving a
+ * chunk appends a record, and the newest record of a coordinate wins, so a
+ * save never rewrites data in place. A crash can only leave a torn record
+ * at the end; opening the file stops at the first record whose length or
+ * checksum is wrong and cuts it off.
+ *
+ * Superseded records are dropped by compact(), which writes the live ones
+ * to a new file and renames it over the old one.
+ *
+ * Cells are stored one field at a time, each field run-length encoded, so
+ * uniform areas (air at ambient temperature) take a few bytes. The
+ * per-tick updated flag is not stored.
+ */
+class RegionFile {
+public:
+    RegionFile();
+    ~RegionFile();
+
+    RegionFile(const RegionFile&) = delete;
+    RegionFile& operator=(const RegionFile&) = delete;
+
+    /**
+     * Open a region file and index its records.
+     * @param create Start an empty file if there is none
+     * @return False if the file cannot be opened or has another chunk size
+     */
+    bool open(const std::string& path, int chunkSize, bool create);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    // Append a chunk encoded with encodeCells()
+    bool append(ChunkCoord coord, uint64_t tick, const std::vector<uint8_t>& encoded);
+
+    // Flush appended records to disk
+    bool sync();
+
+    // Rewrite the file with only the newest record of each chunk
+    bool compact();
+
+    // Read the newest copy of a chunk into chunkSize * chunkSize cells
+    bool read(ChunkCoord coord, Cell* cells);
+
+    std::vector<ChunkCoord> getChunks() const;
+    size_t getChunkCount() const { return index.size(); }
+    uint64_t getFileBytes() const { return fileBytes; }
+    uint64_t getLiveBytes() const { return liveBytes; }   // Header plus the newest records
+
+    // Heap bytes of the record index
+    size_t getMemoryUsage() const { return heapBytes(index) + heapBytes(path); }
+
+    static void encodeCells(const Cell* cells, size_t count, std::vector<uint8_t>& out);
+    static bool decodeCells(const uint8_t* data, size_t size, Cell* cells, size_t count);
+
+    // FNV-1a over bytes; record checksums are its low 32 bits
+    static uint64_t hashBytes(const uint8_t* data, size_t size);
+
+private:
+    struct Record {
+        uint64_t offset;   // Of the record's length field
+        uint32_t length;   // Whole record, length and checksum included
+        uint64_t tick;
+    };
+
+    std::FILE* file;
+    std::string path;
+    int chunkSize;
+    std::unordered_map<ChunkCoord, Record, ChunkCoordHash> index;
+    uint64_t fileBytes;
+    uint64_t liveBytes;
+
+    bool scan();
+    void indexRecord(ChunkCoord coord, const Record& record);
+};
+
+} // namespace astral
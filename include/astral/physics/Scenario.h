@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace astral {
+
+class CellularAutomaton;
+
+/**
+ * Canonical, seeded world setups shared by benchmarks and regression checks.
+ * The same configuration always produces the same initial world.
+ */
+enum class ScenarioType {
+    IDLE,    // Settled stone only: the cost of simulating nothing
+    SAND,    // Falling powder
+    WATER,   // Pouring and spreading liquid
+    LAVA,    // Lava meeting water and wood: heat transfer and reactions
+    MIXED    // All of the above
+};
+
+struct ScenarioConfig {
+    ScenarioType type = ScenarioType::MIXED;
+    float activity = 0.25f;   // Fraction of the world covered by moving material
+    uint32_t seed = 1;
+};
+
+const char* scenarioName(ScenarioType type);
+bool parseScenario(const std::string& name, ScenarioType& type);
+std::vector<ScenarioType> allScenarios();
+
+/**
+ * Clear the world and build a scenario in it: a stone floor plus seeded
+ * blocks of the scenario's materials covering about `activity` of the area.
+ * The seed also seeds the world's random stream, so a scenario runs the same
+ * way every time.
+ */
+void buildScenario(CellularAutomaton& world, const ScenarioConfig& config);
+
+} // namespace astral
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "astral/core/ThreadPool.h"
+#include "astral/physics/ChunkManager.h"
+
+namespace astral {
+
+/**
+ * Copy of one simulated chunk as it was at the end of a tick.
+ */
+struct PublishedChunk {
+    ChunkCoord coord;
+    std::vector<Cell> cells;    // Row-major, chunkSize x chunkSize
+};
+
+/**
+ * Read-only data of a finished tick, handed to the pipeline's consumers.
+ */
+struct PublishedTick {
+    uint64_t tick = 0;
+    int chunkSize = CHUNK_SIZE;
+    float updateTimeMs = 0.0f;
+    std::vector<PublishedChunk> chunks;   // Active chunks, in ChunkCoord order
+};
+
+/**
+ * Runs the read-only consumers of a tick (statistics, render prep, change
+ * feeds, saving) on a thread pool while the world simulates the next tick.
+ *
+ * The ticking thread copies the active chunks into one of two buffers and
+ * queues one job per consumer. Before a buffer is reused two ticks later the
+ * jobs still reading it must have finished; if they have not started yet,
+ * the ticking thread runs them itself, so a world ticking on a pool worker
+ * cannot deadlock on a pool that is busy with other worlds.
+ *
+ * Consumers of one tick may run concurrently with each other, and a
+ * consumer may run for tick N+1 before finishing tick N, so consumers must
+ * synchronise any state they share.
+ */
+class TickPipeline {
+public:
+    using Consumer = std::function<void(const PublishedTick&)>;
+
+    // With pool == nullptr consumers run on the ticking thread during publish()
+    explicit TickPipeline(ThreadPool* pool);
+    ~TickPipeline();
+
+    TickPipeline(const TickPipeline&) = delete;
+    TickPipeline& operator=(const TickPipeline&) = delete;
+
+    // Register a consumer for every later tick; waits for queued jobs first
+    void addConsumer(const std::string& name, Consumer consumer);
+    size_t getConsumerCount() const;
+
+    /**
+     * Get the buffer for the next tick, waiting for consumers that still read
+     * it. Fill it, then call publish().
+     */
+    PublishedTick& beginPublish();
+    void publish();
+
+    // Copy the active chunks of a chunk manager into the buffer
+    static void capture(const ChunkManager& chunks, PublishedTick& out);
+
+    // Wait until every queued job has finished
+    void flush();
+
+    // Statistics
+    uint64_t getPublishedTicks() const { return publishedTicks; }
+    double getWaitMilliseconds() const;      // Ticking thread blocked on consumers
+    double getConsumerMilliseconds(const std::string& name) const;
+
+    // Heap bytes of both tick buffers and the job queue (ticking thread only)
+    size_t getMemoryUsage() const;
+
+private:
+    struct Job {
+        size_t slot;
+        size_t consumer;
+    };
+
+    // Shared with the queued pool tasks so they stay valid if the pipeline
+    // is destroyed after a helper thread already ran their job
+    struct State {
+        std::vector<std::pair<std::string, Consumer>> consumers;
+        std::vector<double> consumerMilliseconds;
+        PublishedTick slots[2];
+        size_t outstanding[2] = {0, 0};
+        std::deque<Job> queue;
+        mutable std::mutex mutex;
+        std::condition_variable done;
+
+        // Run one queued job; returns false when the queue is empty
+        bool runOne(std::unique_lock<std::mutex>& lock);
+    };
+
+    ThreadPool* pool;
+    std::shared_ptr<State> state;
+    size_t currentSlot;
+    uint64_t publishedTicks;
+    double waitMilliseconds;
+
+    void waitForSlot(size_t slot);
+};
+
+} // namespace astral
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "astral/physics/ChunkManager.h"
+#include "astral/physics/RegionFile.h"
+
+namespace astral {
+
+/**
+ * Autosave settings.
+ */
+struct WorldAutosaveConfig {
+    float intervalSeconds = 10.0f;     // Time between saves
+    double handoffBudgetMs = 0.2;      // Main thread time per tick spent copying chunks
+    float compactRatio = 2.0f;         // Compact once the file is this many times its live data
+    uint64_t compactMinBytes = 1 << 20; // Smaller files are never compacted
+};
+
+// Totals since autosave was enabled
+struct WorldAutosaveStats {
+    uint64_t saves = 0;             // Saves whose chunks are all on disk
+    uint64_t chunksCopied = 0;      // Handed to the writer
+    uint64_t chunksWritten = 0;     // Appended to the file
+    uint64_t chunksUnchanged = 0;   // Copied but equal to what was saved last
+    uint64_t bytesWritten = 0;
+    uint64_t compactions = 0;
+    uint64_t failures = 0;          // Appends, syncs or compactions that failed
+    double maxHandoffMs = 0.0;      // Longest time a tick spent copying; flush() is not counted
+};
+
+/**
+ * Saves the chunks that changed to a RegionFile in the background.
+ *
+ * Every tick the world reports its active chunks; only those and their
+ * neighbours (which moving cells can spill into) can change, so they are
+ * the candidates of the next save. Every intervalSeconds a save starts and
+ * the candidates are copied whole, between ticks, into reused buffers. The
+ * copying stops for the tick once handoffBudgetMs is used up and goes on in
+ * the next ticks, so a large save is spread out instead of causing a hitch;
+ * each chunk is a consistent copy as of the tick it was taken at.
+ *
+ * A writer thread encodes each copy, skips chunks whose encoding equals the
+ * one it saved last, appends the rest and syncs the file once the save is
+ * complete. When superseded records make up too much of the file it is
+ * compacted on the same thread.
+ *
+ * The copies are not taken from a TickPipeline: a published tick only holds
+ * the simulated chunks, not the neighbours a save also needs; the pipeline
+ * is optional; and its consumers may run out of tick order, while a save's
+ * chunks must reach the writer before the job that ends it.
+ */
+class WorldAutosave {
+public:
+    WorldAutosave(ChunkManager* chunkManager, const WorldAutosaveConfig& config);
+    ~WorldAutosave();
+
+    WorldAutosave(const WorldAutosave&) = delete;
+    WorldAutosave& operator=(const WorldAutosave&) = delete;
+
+    /**
+     * Open the region file (created if missing) and start the writer.
+     * @return False if the file cannot be opened or has another chunk size
+     */
+    bool start(const std::string& path);
+
+    // Hand the save's chunks off and wait until they are on disk
+    void stop();
+
+    const WorldAutosaveConfig& getConfig() const { return config; }
+    WorldAutosaveStats getStats() const;
+
+    // Called after every tick with the chunks that were simulated
+    void tick(float deltaTime, const std::set<ChunkCoord>& activeChunks);
+
+    // Start a save now instead of at the end of the interval
+    void saveNow();
+
+    // Copy everything the current save still needs and wait for the writer
+    void flush();
+
+    bool isSaving() const { return !pendingChunks.empty(); }
+
+    // Heap bytes of the candidates, the copies in flight and the pooled
+    // buffers, and the writer's index as of its last write (ticking thread)
+    size_t getMemoryUsage() const;
+
+private:
+    struct Job {
+        ChunkCoord coord;
+        uint64_t tick;
+        std::vector<Cell> cells;   // Empty for the job that ends a save
+    };
+
+    ChunkManager* chunkManager;
+    WorldAutosaveConfig config;
+    float sinceSave;
+    uint64_t tickCount;
+
+    // Ticking thread: chunks that may have changed since the last save was
+    // started, and the chunks of that save not copied yet
+    std::unordered_set<ChunkCoord, ChunkCoordHash> touched;
+    std::vector<ChunkCoord> pendingChunks;
+
+    // Shared with the writer
+    std::thread writer;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    bool stopping;
+    bool writing;
+    std::deque<Job> jobs;
+    std::vector<std::vector<Cell>> freeBuffers;
+    WorldAutosaveStats stats;
+
+    // Writer thread only
+    RegionFile file;
+    std::unordered_map<ChunkCoord, uint64_t, ChunkCoordHash> savedHashes;
+    std::vector<uint8_t> encoded;
+    std::atomic<size_t> writerBytes;   // Heap bytes of the above and the file's index
+
+    void beginSave();
+    void handOff(double budgetMs);
+    void writerLoop();
+    void write(const Job& job);
+};
+
+} // namespace astral
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "astral/core/ThreadPool.h"
+#include "astral/physics/CellularAutomaton.h"
+
+namespace astral {
+
+/**
+ * Runs many independent CellularAutomaton worlds on one shared ThreadPool.
+ *
+ * Each world ticks on one worker at a time. After a tick the world goes to the
+ * back of its core group's queue, so worlds are interleaved round-robin and a
+ * slow world never holds up the others. Worlds are split across core groups in
+ * contiguous blocks and stay there, which keeps their chunks on one NUMA node
+ * unless a group runs dry and another group's worker steals the tick.
+ */
+class WorldScheduler {
+private:
+    struct WorldSlot {
+        std::shared_ptr<CellularAutomaton> world;
+        int coreGroup = 0;
+        uint64_t ticks = 0;       // Ticks completed over the scheduler's lifetime
+        int remainingTicks = 0;   // Ticks left in the current run
+        std::vector<float> tickMilliseconds; // Duration of each tick in the last run
+    };
+
+    ThreadPool& pool;
+    std::vector<WorldSlot> worlds;
+    size_t roundOffset;           // Rotates which world is scheduled first
+    double lastRunSeconds;
+    uint64_t lastRunTicks;
+
+    // Completion tracking for run()
+    std::mutex mutex;
+    std::condition_variable finished;
+    size_t runningWorlds;
+
+    void scheduleTick(size_t index, float deltaTime);
+
+public:
+    explicit WorldScheduler(ThreadPool& pool);
+    ~WorldScheduler() = default;
+
+    // Add a world and return its index
+    size_t addWorld(std::shared_ptr<CellularAutomaton> world);
+    size_t getWorldCount() const { return worlds.size(); }
+    CellularAutomaton& getWorld(size_t index) { return *worlds[index].world; }
+
+    // Advance every world by ticksPerWorld ticks. Blocks until all are done.
+    void run(float deltaTime, int ticksPerWorld = 1);
+
+    // Statistics
+    uint64_t getWorldTicks(size_t index) const { return worlds[index].ticks; }
+    int getWorldCoreGroup(size_t index) const { return worlds[index].coreGroup; }
+    const std::vector<float>& getLastRunTickTimes(size_t index) const { return worlds[index].tickMilliseconds; }
+    double getLastRunSeconds() const { return lastRunSeconds; }
+    double getAggregateTicksPerSecond() const {
+        return lastRunSeconds > 0.0 ? lastRunTicks / lastRunSeconds : 0.0;
+    }
+};
+
+} // namespace astral
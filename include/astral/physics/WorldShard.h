@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "astral/physics/CellularAutomaton.h"
+
+namespace astral {
+
+/**
+ * A cell that crossed a shard boundary during a tick. The receiving shard
+ * accepts it only if the target still holds the material the sender saw there.
+ */
+struct ShardMigrant {
+    int32_t x;                 // Global world coordinates
+    int32_t y;
+    MaterialID expected;       // Material the sender's halo held before the tick
+    Cell cell;
+};
+
+/**
+ * Per-shard counters, kept in shared memory so the launching process can read
+ * them after the shard processes exit.
+ */
+struct ShardStats {
+    uint64_t ticks = 0;
+    double elapsedSeconds = 0.0;
+    uint64_t migrantsSent = 0;
+    uint64_t migrantsAccepted = 0;   // Placed at their target
+    uint64_t migrantsDisplaced = 0;  // Target taken, placed in a nearby free cell
+    uint64_t migrantsDropped = 0;    // No free cell near the target
+};
+
+/**
+ * POSIX shared-memory segment connecting the shards of one world.
+ *
+ * The world is split into vertical strips of whole chunk columns, one strip per
+ * shard. For every boundary between two strips there is one link in each
+ * direction. A link holds the sender's border chunk column (full world height)
+ * and the cells that left the sender's strip through that border. All shards
+ * synchronise on a process-shared barrier.
+ */
+class ShardExchange {
+public:
+    ~ShardExchange();
+
+    ShardExchange(const ShardExchange&) = delete;
+    ShardExchange& operator=(const ShardExchange&) = delete;
+
+    /**
+     * Create and initialise a new segment. The creator unlinks it on destruction.
+     * @throws std::invalid_argument if the world has fewer chunk columns than shards
+     * @throws std::runtime_error if the segment cannot be created
+     */
+    static std::unique_ptr<ShardExchange> create(const std::string& name, int worldWidth,
+                                                 int worldHeight, int shardCount);
+
+    /**
+     * Attach to a segment created by another process.
+     * @throws std::runtime_error if the segment does not exist or is invalid
+     */
+    static std::unique_ptr<ShardExchange> open(const std::string& name);
+
+    int getWorldWidth() const;
+    int getWorldHeight() const;
+    int getShardCount() const;
+
+    // Global x range [begin, end) owned by a shard
+    int getShardBegin(int shard) const;
+    int getShardEnd(int shard) const;
+
+    // Block until every shard reaches the barrier
+    void arriveAndWait();
+
+    // Link from shard `from` to its neighbour on side `toRight`
+    Cell* getEdge(int from, bool toRight);
+    uint32_t& getMigrantCount(int from, bool toRight);
+    ShardMigrant* getMigrants(int from, bool toRight);
+    size_t getLinkCapacity() const;
+
+    ShardStats& getStats(int shard);
+
+private:
+    ShardExchange() = default;
+
+    std::string name;
+    bool owner = false;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+
+    struct Header;
+    Header* header() const;
+    char* linkBase(int from, bool toRight) const;
+    static size_t linkSize(int worldHeight);
+    static size_t totalSize(int worldHeight, int shardCount);
+};
+
+/**
+ * One shard of a world split across processes (or threads) sharing a
+ * ShardExchange.
+ *
+ * The shard simulates its strip plus a read-only halo chunk column on each side
+ * that has a neighbour. The halo is refreshed from the neighbour every tick and
+ * is never simulated itself. Owned cells may still move into it. Every halo
+ * cell that changed during the tick is sent to the neighbour, which becomes its
+ * owner from then on.
+ */
+class WorldShard {
+public:
+    WorldShard(ShardExchange& exchange, int shardIndex,
+               std::shared_ptr<const MaterialRegistry> registry);
+
+    // Advance one tick in lockstep with every other shard
+    void tick(float deltaTime);
+
+    // Run a number of ticks and record the timing in the shared stats
+    void run(float deltaTime, int ticks);
+
+    // Fill the owned part of a global rectangle
+    void fillRectangle(int x, int y, int width, int height, MaterialID material);
+
+    // Count owned cells of a material
+    size_t countMaterial(MaterialID material) const;
+
+    bool ownsColumn(int globalX) const { return globalX >= ownedBegin && globalX < ownedEnd; }
+    int getShardIndex() const { return shardIndex; }
+    CellularAutomaton& getWorld() { return world; }
+    ShardStats& getStats() { return exchange.getStats(shardIndex); }
+
+private:
+    ShardExchange& exchange;
+    int shardIndex;
+    int ownedBegin;      // Global x range owned by this shard
+    int ownedEnd;
+    int localOrigin;     // Global x of local column 0
+    bool hasLeft;
+    bool hasRight;
+    CellularAutomaton world;
+    std::vector<MaterialID> haloBefore[2];   // Halo materials at the start of the tick
+
+    void applyMigrants(int from, bool toRight);
+    bool placeNearTarget(const ShardMigrant& migrant, MaterialID air);
+    void publishEdge(bool toRight);
+    void loadHalo(bool right);
+    void sendMigrants(bool right);
+    int haloBegin(bool right) const;
+};
+
+} // namespace astral
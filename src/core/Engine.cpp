@@ -3,6 +3,9 @@
 #include "astral/core/Config.h"
 #include "astral/core/Timer.h"
 #include "astral/core/Profiler.h"
+#include "astral/core/LiveMetrics.h"
+#include "astral/core/TickWatchdog.h"
+#include "astral/core/SamplingProfiler.h"
 #include "astral/physics/PhysicsSystem.h"
 #include "astral/rendering/RenderingSystem.h"
 #include <iostream>
@@ -20,6 +23,7 @@ Engine::Engine()
     , timer(nullptr)
     , physics(nullptr)
     , renderer(nullptr)
+    , watchdog(nullptr)
 {
 }
 
@@ -54,6 +58,10 @@ bool Engine::initialize(const std::string& configFile)
         config->set("fullscreen", false);
         config->set("target_fps", 60);
         config->set("enable_profiling", true);
+        config->set("live_metrics", false);
+        config->set("metrics_port", 0);
+        config->set("watchdog_threshold_ms", 0.0);
+        config->set("sampling_profiler_hz", 0);
         
         // Save default config for next time
         config->saveToFile(configFile);
@@ -63,6 +71,51 @@ bool Engine::initialize(const std::string& configFile)
     bool enableProfiling = config->get<bool>("enable_profiling", true);
     Profiler::getInstance().initialize(enableProfiling);
     
+    // Live metrics replace periodic profiling dumps for external tools
+    if (enableProfiling && config->get<bool>("live_metrics", false))
+    {
+        std::string segment = config->get<std::string>("live_metrics_segment",
+                                                       MetricsPublisher::defaultSegmentName());
+        if (Profiler::getInstance().enableLiveMetrics(segment))
+        {
+            logger->info("Publishing live metrics to shared memory segment " + segment);
+        }
+    }
+    int metricsPort = config->get<int>("metrics_port", 0);
+    if (enableProfiling && metricsPort > 0)
+    {
+        if (Profiler::getInstance().enableMetricsEndpoint(static_cast<uint16_t>(metricsPort)))
+        {
+            logger->info("Serving metrics on http://127.0.0.1:" + std::to_string(metricsPort) + "/metrics");
+        }
+    }
+    
+    // Dump a trace of any frame slower than the threshold (0 disables)
+    double watchdogThreshold = config->get<double>("watchdog_threshold_ms", 0.0);
+    if (watchdogThreshold > 0.0)
+    {
+        TickWatchdogConfig watchdogConfig;
+        watchdogConfig.thresholdMs = watchdogThreshold;
+        watchdogConfig.directory = config->get<std::string>("watchdog_directory", "traces");
+        watchdogConfig.prefix = "slow_frame";
+        watchdog = std::make_unique<TickWatchdog>(watchdogConfig);
+        logger->info("Tracing frames slower than " + std::to_string(watchdogThreshold) + " ms");
+    }
+    
+    // Statistical CPU profile of the whole run (0 disables)
+    int samplingHz = config->get<int>("sampling_profiler_hz", 0);
+    if (samplingHz > 0)
+    {
+        if (SamplingProfiler::getInstance().start(samplingHz))
+        {
+            logger->info("Sampling CPU profile at " + std::to_string(samplingHz) + " Hz");
+        }
+        else
+        {
+            logger->warn("Failed to start the sampling profiler");
+        }
+    }
+    
     // Initialize timer
     timer = std::make_unique<Timer>();
     timer->reset();
@@ -87,7 +140,8 @@ void Engine::shutdown()
     // Clean up in reverse order of initialization
     logger->info("Shutting down Astral Engine...");
     
-    // Clean up systems
+    // Clean up systems (the watchdog finishes writing any pending trace)
+    watchdog.reset();
     renderer.reset();
     physics.reset();
     timer.reset();
@@ -98,6 +152,19 @@ void Engine::shutdown()
     {
         Profiler::getInstance().saveToFile("profiling_data.json");
     }
+    Profiler::getInstance().disableLiveMetrics();
+    
+    // Write the sampled profile
+    SamplingProfiler& sampler = SamplingProfiler::getInstance();
+    if (sampler.isRunning())
+    {
+        sampler.stop();
+        SampleProfile profile = sampler.buildProfile();
+        SamplingProfiler::writeFlatProfile(profile, "profile_flat.txt");
+        SamplingProfiler::writeFoldedStacks(profile, "profile.folded");
+        logger->info("Wrote " + std::to_string(profile.totalSamples) +
+                     " CPU samples to profile_flat.txt and profile.folded");
+    }
     
     logger.reset();
 }
@@ -122,6 +189,10 @@ void Engine::run()
     {
         // Begin frame profiling
         Profiler::getInstance().beginFrame();
+        if (watchdog)
+        {
+            watchdog->beginTick();
+        }
         
         // Update time using the timer
         deltaTime = timer->update();
@@ -131,6 +202,19 @@ void Engine::run()
         update();
         render();
         
+        // Frame work ends here; the frame cap sleep below is not an outlier
+        if (watchdog)
+        {
+            for (const auto& section : Profiler::getInstance().getSectionTimes())
+            {
+                watchdog->recordSection(section.first, section.second);
+            }
+            if (watchdog->endTick())
+            {
+                logger->warn("Slow frame, writing trace to " + watchdog->getConfig().directory);
+            }
+        }
+        
         // Cap frame rate if needed
         double frameTime = timer->getDeltaTime();
         if (frameTime < targetFrameTime)
@@ -145,13 +229,6 @@ void Engine::run()
         // Record performance metrics
         auto& profiler = Profiler::getInstance();
         profiler.recordValue("FPS", 1.0 / frameTime);
-        
-        // Periodically save profiling data
-        static int frameCount = 0;
-        if (++frameCount % 300 == 0 && profiler.isEnabled())
-        {
-            profiler.saveToFile("profiling_data.json");
-        }
     }
     
     logger->info("Engine stopped");
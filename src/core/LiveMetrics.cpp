@@ -0,0 +1,292 @@
+#include "astral/core/LiveMetrics.h"
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace astral {
+
+namespace {
+
+constexpr uint32_t METRICS_MAGIC = 0x4D525441; // "ATRM"
+constexpr uint32_t METRICS_LAYOUT_VERSION = 1;
+
+} // namespace
+
+struct MetricsPublisher::Segment {
+    uint32_t magic;
+    uint32_t layoutVersion;
+    int32_t pid;
+    std::atomic<uint64_t> sequence;   // Odd while a write is in progress
+    LiveMetrics metrics;
+};
+
+namespace {
+
+bool readSegment(const MetricsPublisher::Segment* segment, LiveMetrics& out)
+{
+    if (!segment) {
+        return false;
+    }
+
+    // A writer publishes about once a frame, so a handful of retries is plenty
+    for (int attempt = 0; attempt < 1000; attempt++) {
+        uint64_t before = segment->sequence.load(std::memory_order_acquire);
+        if (before == 0) {
+            return false; // Nothing published yet
+        }
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::memcpy(&out, &segment->metrics, sizeof(LiveMetrics));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (segment->sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// ==================== MetricsPublisher ====================
+
+MetricsPublisher::MetricsPublisher()
+    : segment(nullptr)
+    , shared(false)
+{
+}
+
+MetricsPublisher::~MetricsPublisher()
+{
+    close();
+}
+
+std::string MetricsPublisher::defaultSegmentName()
+{
+#ifdef __linux__
+    return "/astral_metrics_" + std::to_string(getpid());
+#else
+    return "";
+#endif
+}
+
+bool MetricsPublisher::open(const std::string& segmentName)
+{
+    close();
+
+    void* memory = nullptr;
+#ifdef __linux__
+    if (!segmentName.empty()) {
+        std::string path = segmentName[0] == '/' ? segmentName : "/" + segmentName;
+        int fd = shm_open(path.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        if (ftruncate(fd, sizeof(Segment)) != 0) {
+            ::close(fd);
+            shm_unlink(path.c_str());
+            return false;
+        }
+        memory = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            shm_unlink(path.c_str());
+            return false;
+        }
+        name = path;
+        shared = true;
+    }
+#endif
+    if (!memory) {
+        if (!segmentName.empty()) {
+            return false; // Shared memory is not available on this platform
+        }
+        memory = ::operator new(sizeof(Segment));
+    }
+
+    segment = new (memory) Segment();
+    segment->layoutVersion = METRICS_LAYOUT_VERSION;
+#ifdef __linux__
+    segment->pid = static_cast<int32_t>(getpid());
+#else
+    segment->pid = 0;
+#endif
+    segment->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    segment->magic = METRICS_MAGIC;
+    return true;
+}
+
+void MetricsPublisher::close()
+{
+    if (!segment) {
+        return;
+    }
+
+    segment->~Segment();
+#ifdef __linux__
+    if (shared) {
+        munmap(segment, sizeof(Segment));
+        shm_unlink(name.c_str());
+    } else
+#endif
+    {
+        ::operator delete(segment);
+    }
+
+    segment = nullptr;
+    shared = false;
+    name.clear();
+}
+
+void MetricsPublisher::publish(const LiveMetrics& metrics)
+{
+    if (!segment) {
+        return;
+    }
+
+    // Single writer: odd sequence marks the copy in progress
+    uint64_t sequence = segment->sequence.load(std::memory_order_relaxed);
+    segment->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(&segment->metrics, &metrics, sizeof(LiveMetrics));
+
+    segment->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool MetricsPublisher::snapshot(LiveMetrics& out) const
+{
+    return readSegment(segment, out);
+}
+
+// ==================== MetricsReader ====================
+
+MetricsReader::MetricsReader()
+    : segment(nullptr)
+{
+}
+
+MetricsReader::~MetricsReader()
+{
+    close();
+}
+
+bool MetricsReader::open(const std::string& segmentName)
+{
+    close();
+#ifdef __linux__
+    std::string path = !segmentName.empty() && segmentName[0] == '/' ? segmentName : "/" + segmentName;
+    int fd = shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(MetricsPublisher::Segment)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* memory = mmap(nullptr, sizeof(MetricsPublisher::Segment), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+
+    segment = static_cast<const MetricsPublisher::Segment*>(memory);
+    if (segment->magic != METRICS_MAGIC || segment->layoutVersion != METRICS_LAYOUT_VERSION) {
+        close();
+        return false;
+    }
+    return true;
+#else
+    (void)segmentName;
+    return false;
+#endif
+}
+
+void MetricsReader::close()
+{
+#ifdef __linux__
+    if (segment) {
+        munmap(const_cast<MetricsPublisher::Segment*>(segment), sizeof(MetricsPublisher::Segment));
+    }
+#endif
+    segment = nullptr;
+}
+
+bool MetricsReader::read(LiveMetrics& out) const
+{
+    return readSegment(segment, out);
+}
+
+int MetricsReader::getPublisherPid() const
+{
+    return segment ? segment->pid : 0;
+}
+
+// ==================== Prometheus formatting ====================
+
+std::string formatPrometheus(const LiveMetrics& metrics, uint64_t residentBytes)
+{
+    std::ostringstream out;
+
+    auto gauge = [&out](const char* name, const char* help, double value) {
+        out << "# HELP " << name << " " << help << "\n"
+            << "# TYPE " << name << " gauge\n"
+            << name << " " << value << "\n";
+    };
+
+    out << "# HELP astral_frames_total Frames completed\n"
+        << "# TYPE astral_frames_total counter\n"
+        << "astral_frames_total " << metrics.frame << "\n";
+
+    out << "# HELP astral_frame_time_ms Frame time over the recent window\n"
+        << "# TYPE astral_frame_time_ms gauge\n"
+        << "astral_frame_time_ms{quantile=\"0.5\"} " << metrics.frameTimeP50Ms << "\n"
+        << "astral_frame_time_ms{quantile=\"0.9\"} " << metrics.frameTimeP90Ms << "\n"
+        << "astral_frame_time_ms{quantile=\"0.99\"} " << metrics.frameTimeP99Ms << "\n"
+        << "astral_frame_time_ms{quantile=\"1\"} " << metrics.frameTimeMaxMs << "\n";
+
+    gauge("astral_last_frame_time_ms", "Duration of the last frame", metrics.frameTimeMs);
+    gauge("astral_fps", "Frames per second of the last frame", metrics.fps);
+    gauge("astral_active_chunks", "Chunks simulated in the last frame", metrics.activeChunks);
+    gauge("astral_updated_cells", "Cells that changed in the last frame", metrics.updatedCells);
+    gauge("astral_rendered_cells", "Cells rendered in the last frame", metrics.renderedCells);
+    gauge("astral_tracked_memory_bytes", "Memory reported by engine subsystems",
+          static_cast<double>(metrics.memoryBytes));
+    if (residentBytes > 0) {
+        gauge("astral_process_resident_bytes", "Resident set size of the process",
+              static_cast<double>(residentBytes));
+    }
+
+    if (metrics.passCount > 0) {
+        out << "# HELP astral_pass_time_ms Time spent in each profiled pass in the last frame\n"
+            << "# TYPE astral_pass_time_ms gauge\n";
+        for (int i = 0; i < metrics.passCount && i < LiveMetrics::MAX_PASSES; i++) {
+            std::string pass(metrics.passes[i].name,
+                             strnlen(metrics.passes[i].name, sizeof(metrics.passes[i].name)));
+            // Label values may not contain quotes, backslashes or newlines
+            for (char& c : pass) {
+                if (c == '"' || c == '\\' || c == '\n') c = '_';
+            }
+            out << "astral_pass_time_ms{pass=\"" << pass << "\"} " << metrics.passes[i].lastMs << "\n";
+        }
+    }
+
+    return out.str();
+}
+
+} // namespace astral
@@ -0,0 +1,62 @@
+#include "astral/core/MemoryReport.h"
+#include <iomanip>
+
+namespace astral {
+
+void MemoryReport::add(const std::string& name, size_t bytes, size_t count)
+{
+    for (Entry& entry : entries) {
+        if (entry.name == name) {
+            entry.bytes += bytes;
+            entry.count += count;
+            return;
+        }
+    }
+    entries.push_back({name, bytes, count});
+}
+
+size_t MemoryReport::getBytes(const std::string& name) const
+{
+    bool prefix = !name.empty() && name.back() == '/';
+    size_t bytes = 0;
+    for (const Entry& entry : entries) {
+        if (prefix ? entry.name.compare(0, name.size(), name) == 0 : entry.name == name) {
+            bytes += entry.bytes;
+        }
+    }
+    return bytes;
+}
+
+size_t MemoryReport::getTotalBytes() const
+{
+    size_t total = 0;
+    for (const Entry& entry : entries) {
+        total += entry.bytes;
+    }
+    return total;
+}
+
+void MemoryReport::print(std::ostream& out) const
+{
+    size_t total = getTotalBytes();
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(1);
+
+    for (const Entry& entry : entries) {
+        out << std::left << std::setw(24) << entry.name << std::right
+            << std::setw(12) << entry.bytes / 1024.0 << " KB"
+            << std::setw(7) << (total > 0 ? entry.bytes * 100.0 / total : 0.0) << "%";
+        if (entry.count > 0) {
+            out << "  " << entry.count << " x " << static_cast<double>(entry.bytes) / entry.count << " B";
+        }
+        out << std::endl;
+    }
+    out << std::left << std::setw(24) << "total" << std::right
+        << std::setw(12) << total / 1024.0 << " KB" << std::endl;
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace astral
@@ -0,0 +1,173 @@
+#include "astral/core/MetricsEndpoint.h"
+#include "astral/core/LiveMetrics.h"
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace astral {
+
+namespace {
+
+// Resident set size from procfs, read on the endpoint thread at scrape time
+uint64_t residentBytes()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0, resident = 0;
+    if (statm >> size >> resident) {
+        return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+} // namespace
+
+MetricsEndpoint::MetricsEndpoint(const MetricsPublisher& publisher)
+    : publisher(publisher)
+    , running(false)
+    , requests(0)
+    , listenSocket(-1)
+    , port(0)
+{
+}
+
+MetricsEndpoint::~MetricsEndpoint()
+{
+    stop();
+}
+
+bool MetricsEndpoint::start(uint16_t requestedPort)
+{
+#ifdef __linux__
+    stop();
+
+    listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(requestedPort);
+
+    socklen_t length = sizeof(address);
+    if (bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenSocket, 8) != 0 ||
+        getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        close(listenSocket);
+        listenSocket = -1;
+        return false;
+    }
+
+    port = ntohs(address.sin_port);
+    running = true;
+    thread = std::thread(&MetricsEndpoint::serve, this);
+    return true;
+#else
+    (void)requestedPort;
+    return false;
+#endif
+}
+
+void MetricsEndpoint::stop()
+{
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+#ifdef __linux__
+    if (listenSocket >= 0) {
+        close(listenSocket);
+        listenSocket = -1;
+    }
+#endif
+    port = 0;
+}
+
+void MetricsEndpoint::serve()
+{
+#ifdef __linux__
+    while (running) {
+        // Wake up regularly to notice stop()
+        pollfd descriptor{listenSocket, POLLIN, 0};
+        if (poll(&descriptor, 1, 100) <= 0) {
+            continue;
+        }
+
+        int client = accept(listenSocket, nullptr, nullptr);
+        if (client < 0) {
+            continue;
+        }
+        respond(client);
+        close(client);
+    }
+#endif
+}
+
+void MetricsEndpoint::respond(int client)
+{
+#ifdef __linux__
+    // Read the request head; every path returns the metrics
+    char request[1024];
+    size_t received = 0;
+    while (received < sizeof(request) - 1) {
+        pollfd descriptor{client, POLLIN, 0};
+        if (poll(&descriptor, 1, 500) <= 0) {
+            break;
+        }
+        ssize_t count = recv(client, request + received, sizeof(request) - 1 - received, 0);
+        if (count <= 0) {
+            break;
+        }
+        received += static_cast<size_t>(count);
+        request[received] = '\0';
+        if (std::strstr(request, "\r\n\r\n")) {
+            break;
+        }
+    }
+
+    LiveMetrics metrics;
+    std::string body;
+    std::string status = "200 OK";
+    if (publisher.snapshot(metrics)) {
+        body = formatPrometheus(metrics, residentBytes());
+    } else {
+        status = "503 Service Unavailable";
+        body = "metrics unavailable\n";
+    }
+
+    std::string response = "HTTP/1.1 " + status + "\r\n"
+        "Content-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+        "Connection: close\r\n\r\n" + body;
+
+    requests.fetch_add(1, std::memory_order_relaxed);
+
+    size_t offset = 0;
+    while (offset < response.size()) {
+        ssize_t sent = send(client, response.data() + offset, response.size() - offset, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            break;
+        }
+        offset += static_cast<size_t>(sent);
+    }
+#else
+    (void)client;
+#endif
+}
+
+} // namespace astral
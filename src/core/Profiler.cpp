@@ -1,4 +1,7 @@
 #include "astral/core/Profiler.h"
+#include "astral/core/LiveMetrics.h"
+#include "astral/core/MetricsEndpoint.h"
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <algorithm>
@@ -15,10 +18,12 @@ Profiler& Profiler::getInstance() {
 Profiler::Profiler()
     : enabled(false)
     , maxHistoryLength(300) // 5 seconds of history at 60 FPS
+    , frameCount(0)
 {
 }
 
 Profiler::~Profiler() {
+    disableLiveMetrics();
 }
 
 void Profiler::initialize(bool enabled) {
@@ -81,6 +86,11 @@ void Profiler::endFrame() {
             history.second.erase(history.second.begin());
         }
     }
+    
+    frameCount++;
+    if (liveMetrics) {
+        publishLiveMetrics();
+    }
 }
 
 void Profiler::beginSection(const std::string& name) {
@@ -152,6 +162,18 @@ void Profiler::recordMemoryUsage(const std::string& name, size_t bytes) {
     memoryUsage[name] = bytes;
 }
 
+void Profiler::removeMemoryUsage(const std::string& prefix) {
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    for (auto it = memoryUsage.begin(); it != memoryUsage.end();) {
+        if (it->first.compare(0, prefix.size(), prefix) == 0) {
+            it = memoryUsage.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 const PerformanceMetrics& Profiler::getMetrics() const {
     return currentMetrics;
 }
@@ -238,6 +260,108 @@ bool Profiler::saveToFile(const std::string& filepath) const {
     }
 }
 
+std::vector<std::pair<std::string, double>> Profiler::getSectionTimes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    std::vector<std::pair<std::string, double>> times;
+    times.reserve(sections.size());
+    for (const auto& section : sections) {
+        times.emplace_back(section.first, section.second.totalTime * 1000.0);
+    }
+    std::sort(times.begin(), times.end());
+    return times;
+}
+
+bool Profiler::enableLiveMetrics(const std::string& segmentName) {
+    std::lock_guard<std::mutex> lock(mutex);
+    
+    auto publisher = std::make_unique<MetricsPublisher>();
+    if (!publisher->open(segmentName)) {
+        std::cerr << "Failed to create live metrics segment " << segmentName << std::endl;
+        return false;
+    }
+    
+    // The endpoint reads from the publisher, so restart it on the new one
+    uint16_t port = metricsEndpoint ? metricsEndpoint->getPort() : 0;
+    metricsEndpoint.reset();
+    liveMetrics = std::move(publisher);
+    if (port != 0) {
+        metricsEndpoint = std::make_unique<MetricsEndpoint>(*liveMetrics);
+        metricsEndpoint->start(port);
+    }
+    return true;
+}
+
+bool Profiler::enableMetricsEndpoint(uint16_t port) {
+    if (!liveMetrics && !enableLiveMetrics("")) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex);
+    metricsEndpoint = std::make_unique<MetricsEndpoint>(*liveMetrics);
+    if (!metricsEndpoint->start(port)) {
+        std::cerr << "Failed to start metrics endpoint on port " << port << std::endl;
+        metricsEndpoint.reset();
+        return false;
+    }
+    return true;
+}
+
+void Profiler::disableLiveMetrics() {
+    std::lock_guard<std::mutex> lock(mutex);
+    metricsEndpoint.reset();
+    liveMetrics.reset();
+}
+
+void Profiler::publishLiveMetrics() {
+    LiveMetrics metrics;
+    metrics.frame = frameCount;
+    metrics.timestamp = std::chrono::duration<double>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    
+    metrics.frameTimeMs = currentMetrics.frameTime * 1000.0;
+    metrics.fps = currentMetrics.fps;
+    
+    // Percentiles over the frame time history window
+    const auto& frameTimes = metricHistory["FrameTime"];
+    if (!frameTimes.empty()) {
+        sortedFrameTimes.assign(frameTimes.begin(), frameTimes.end());
+        std::sort(sortedFrameTimes.begin(), sortedFrameTimes.end());
+        auto percentile = [this](double fraction) {
+            size_t index = static_cast<size_t>(fraction * (sortedFrameTimes.size() - 1) + 0.5);
+            return sortedFrameTimes[index] * 1000.0;
+        };
+        metrics.frameTimeP50Ms = percentile(0.5);
+        metrics.frameTimeP90Ms = percentile(0.9);
+        metrics.frameTimeP99Ms = percentile(0.99);
+        metrics.frameTimeMaxMs = sortedFrameTimes.back() * 1000.0;
+    }
+    
+    metrics.activeChunks = currentMetrics.activeChunks;
+    metrics.updatedCells = currentMetrics.updatedCells;
+    metrics.renderedCells = currentMetrics.renderedCells;
+    metrics.memoryBytes = currentMetrics.memoryUsage;
+    
+    // Passes in name order so their slots stay stable between frames
+    std::vector<const std::pair<const std::string, ProfileSection>*> passes;
+    for (const auto& section : sections) {
+        passes.push_back(&section);
+    }
+    std::sort(passes.begin(), passes.end(), [](const auto* a, const auto* b) {
+        return a->first < b->first;
+    });
+    
+    for (const auto* pass : passes) {
+        if (metrics.passCount == LiveMetrics::MAX_PASSES) break;
+        LiveMetricsPass& slot = metrics.passes[metrics.passCount++];
+        std::strncpy(slot.name, pass->first.c_str(), sizeof(slot.name) - 1);
+        slot.name[sizeof(slot.name) - 1] = '\0';
+        slot.lastMs = pass->second.totalTime * 1000.0;
+    }
+    
+    liveMetrics->publish(metrics);
+}
+
 double Profiler::calculateFrameTime() {
     auto now = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - frameStartTime);
@@ -259,7 +383,7 @@ ScopedTimer::ScopedTimer(const std::string& name, Profiler* profiler)
     : name(name)
     , profiler(profiler ? profiler : &Profiler::getInstance())
 {
-    profiler->beginSection(name);
+    this->profiler->beginSection(name);
 }
 
 ScopedTimer::~ScopedTimer() {
@@ -0,0 +1,482 @@
+#include "astral/core/SamplingProfiler.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <csignal>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <elf.h>
+#include <execinfo.h>
+#include <link.h>
+#include <ctime>
+#include <ucontext.h>
+#endif
+
+namespace astral {
+
+namespace {
+
+#ifdef __linux__
+
+// Program counter of the interrupted instruction
+void* interruptedPc(void* context)
+{
+    const ucontext_t* uc = static_cast<const ucontext_t*>(context);
+#if defined(__x86_64__)
+    return reinterpret_cast<void*>(uc->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+    return reinterpret_cast<void*>(uc->uc_mcontext.pc);
+#else
+    (void)uc;
+    return nullptr;
+#endif
+}
+
+/**
+ * Function symbols of one ELF module, read from .symtab (or .dynsym when the
+ * binary is stripped).
+ */
+class ElfSymbols {
+public:
+    explicit ElfSymbols(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return;
+
+        Elf64_Ehdr header;
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.e_ident, ELFMAG, SELFMAG) != 0 ||
+            header.e_ident[EI_CLASS] != ELFCLASS64) {
+            return;
+        }
+
+        std::vector<Elf64_Shdr> sections(header.e_shnum);
+        file.seekg(static_cast<std::streamoff>(header.e_shoff));
+        if (!file.read(reinterpret_cast<char*>(sections.data()), sections.size() * sizeof(Elf64_Shdr))) {
+            return;
+        }
+
+        if (!load(file, sections, SHT_SYMTAB)) {
+            load(file, sections, SHT_DYNSYM);
+        }
+        std::sort(symbols.begin(), symbols.end(),
+            [](const Symbol& a, const Symbol& b) { return a.address < b.address; });
+    }
+
+    // Name of the function containing a module-relative address
+    const std::string* find(uint64_t address) const
+    {
+        auto it = std::upper_bound(symbols.begin(), symbols.end(), address,
+            [](uint64_t value, const Symbol& symbol) { return value < symbol.address; });
+        if (it == symbols.begin()) return nullptr;
+        --it;
+        if (address >= it->address + std::max<uint64_t>(it->size, 1)) return nullptr;
+        return &it->name;
+    }
+
+private:
+    struct Symbol {
+        uint64_t address;
+        uint64_t size;
+        std::string name;
+    };
+    std::vector<Symbol> symbols;
+
+    bool load(std::ifstream& file, const std::vector<Elf64_Shdr>& sections, uint32_t type)
+    {
+        for (const auto& section : sections) {
+            if (section.sh_type != type || section.sh_link >= sections.size()) continue;
+
+            const Elf64_Shdr& strings = sections[section.sh_link];
+            std::vector<char> names(strings.sh_size);
+            std::vector<Elf64_Sym> entries(section.sh_size / sizeof(Elf64_Sym));
+            file.seekg(static_cast<std::streamoff>(strings.sh_offset));
+            file.read(names.data(), names.size());
+            file.seekg(static_cast<std::streamoff>(section.sh_offset));
+            file.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(Elf64_Sym));
+            if (!file) return false;
+
+            for (const auto& entry : entries) {
+                if (ELF64_ST_TYPE(entry.st_info) != STT_FUNC || entry.st_value == 0 ||
+                    entry.st_name >= names.size()) {
+                    continue;
+                }
+                symbols.push_back({entry.st_value, entry.st_size, demangle(&names[entry.st_name])});
+            }
+            return !symbols.empty();
+        }
+        return false;
+    }
+
+    static std::string demangle(const char* name)
+    {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status != 0 || !demangled) return name;
+        std::string result(demangled);
+        std::free(demangled);
+        return result;
+    }
+};
+
+/**
+ * Resolves addresses to "function" or "module+0xoffset" names.
+ */
+class Symbolizer {
+public:
+    Symbolizer()
+    {
+        dl_iterate_phdr([](dl_phdr_info* info, size_t, void* data) {
+            Module module;
+            module.bias = info->dlpi_addr;
+            module.path = info->dlpi_name && info->dlpi_name[0] ? info->dlpi_name : "/proc/self/exe";
+            module.begin = UINTPTR_MAX;
+            module.end = 0;
+            for (int i = 0; i < info->dlpi_phnum; i++) {
+                const auto& segment = info->dlpi_phdr[i];
+                if (segment.p_type != PT_LOAD) continue;
+                module.begin = std::min<uintptr_t>(module.begin, info->dlpi_addr + segment.p_vaddr);
+                module.end = std::max<uintptr_t>(module.end, info->dlpi_addr + segment.p_vaddr + segment.p_memsz);
+            }
+            static_cast<Symbolizer*>(data)->modules.push_back(std::move(module));
+            return 0;
+        }, this);
+    }
+
+    const std::string& name(void* pc)
+    {
+        auto cached = names.find(pc);
+        if (cached != names.end()) return cached->second;
+
+        uintptr_t address = reinterpret_cast<uintptr_t>(pc);
+        std::string result;
+        for (auto& module : modules) {
+            if (address < module.begin || address >= module.end) continue;
+            if (!module.symbols) {
+                module.symbols = std::make_unique<ElfSymbols>(module.path);
+            }
+            if (const std::string* symbol = module.symbols->find(address - module.bias)) {
+                result = *symbol;
+            } else {
+                std::ostringstream fallback;
+                fallback << module.path.substr(module.path.find_last_of('/') + 1)
+                         << "+0x" << std::hex << (address - module.bias);
+                result = fallback.str();
+            }
+            break;
+        }
+        if (result.empty()) {
+            std::ostringstream unknown;
+            unknown << "0x" << std::hex << address;
+            result = unknown.str();
+        }
+        return names.emplace(pc, std::move(result)).first->second;
+    }
+
+private:
+    struct Module {
+        uintptr_t bias;
+        uintptr_t begin;
+        uintptr_t end;
+        std::string path;
+        std::unique_ptr<ElfSymbols> symbols;
+    };
+    std::vector<Module> modules;
+    std::unordered_map<void*, std::string> names;
+};
+
+#endif
+
+// Folded stack frames may not contain the separators
+std::string foldedFrame(std::string frame)
+{
+    for (char& c : frame) {
+        if (c == ';') c = ':';
+        else if (c == '\n') c = ' ';
+    }
+    return frame;
+}
+
+template <typename Key>
+std::vector<std::pair<Key, uint64_t>> sortedByCount(const std::map<Key, uint64_t>& counts)
+{
+    std::vector<std::pair<Key, uint64_t>> rows(counts.begin(), counts.end());
+    std::stable_sort(rows.begin(), rows.end(),
+        [](const auto& a, const auto& b) { return a.second > b.second; });
+    return rows;
+}
+
+} // namespace
+
+SamplingProfiler& SamplingProfiler::getInstance()
+{
+    static SamplingProfiler instance;
+    return instance;
+}
+
+SamplingProfiler::SamplingProfiler()
+    : nextSample(0)
+    , dropped(0)
+    , running(false)
+    , handlerInstalled(false)
+    , frequency(0)
+    , timer(nullptr)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+}
+
+bool SamplingProfiler::start(int frequencyHz, size_t maxSamples)
+{
+#ifdef __linux__
+    if (running || frequencyHz <= 0) {
+        return false;
+    }
+
+    clear();
+    samples.resize(maxSamples);
+    frequency = frequencyHz;
+
+    // The first backtrace() call loads the unwinder, which allocates; do it
+    // here rather than inside the signal handler
+    void* warmup[4];
+    backtrace(warmup, 4);
+
+    // The handler stays installed after stop() so a signal that is already
+    // in flight does not hit the default action (terminate)
+    if (!handlerInstalled) {
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_sigaction = [](int signal, siginfo_t* info, void* context) {
+            handleSignal(signal, info, context);
+        };
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) != 0) {
+            return false;
+        }
+        handlerInstalled = true;
+    }
+
+    sigevent event;
+    std::memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_SIGNAL;
+    event.sigev_signo = SIGPROF;
+    timer_t timerId;
+    if (timer_create(CLOCK_PROCESS_CPUTIME_ID, &event, &timerId) != 0) {
+        return false;
+    }
+
+    long intervalNs = 1000000000L / frequencyHz;
+    itimerspec interval;
+    interval.it_interval.tv_sec = intervalNs / 1000000000L;
+    interval.it_interval.tv_nsec = intervalNs % 1000000000L;
+    interval.it_value = interval.it_interval;
+
+    running.store(true, std::memory_order_release);
+    if (timer_settime(timerId, 0, &interval, nullptr) != 0) {
+        running.store(false, std::memory_order_release);
+        timer_delete(timerId);
+        return false;
+    }
+    timer = timerId;
+    return true;
+#else
+    (void)frequencyHz;
+    (void)maxSamples;
+    return false;
+#endif
+}
+
+void SamplingProfiler::stop()
+{
+#ifdef __linux__
+    if (!running) {
+        return;
+    }
+    running.store(false, std::memory_order_release);
+    timer_delete(static_cast<timer_t>(timer));
+    timer = nullptr;
+#endif
+}
+
+void SamplingProfiler::clear()
+{
+    nextSample.store(0, std::memory_order_relaxed);
+    dropped.store(0, std::memory_order_relaxed);
+}
+
+size_t SamplingProfiler::getSampleCount() const
+{
+    return std::min(nextSample.load(std::memory_order_acquire), samples.size());
+}
+
+void SamplingProfiler::handleSignal(int, void*, void* context)
+{
+#ifdef __linux__
+    SamplingProfiler& profiler = getInstance();
+    if (!profiler.running.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    size_t index = profiler.nextSample.fetch_add(1, std::memory_order_relaxed);
+    if (index >= profiler.samples.size()) {
+        profiler.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    int savedErrno = errno;
+    Sample& sample = profiler.samples[index];
+    sample.context = currentSampleContext();
+
+    // The unwound stack starts with this handler and the signal trampoline;
+    // keep it from the interrupted instruction on
+    void* frames[MAX_STACK_DEPTH + 4];
+    int count = backtrace(frames, MAX_STACK_DEPTH + 4);
+    void* pc = interruptedPc(context);
+    int first = 0;
+    while (first < count && frames[first] != pc) {
+        first++;
+    }
+
+    uint32_t depth = 0;
+    if (first == count) {
+        // Unwinding did not pass through the signal frame; keep just the pc
+        sample.frames[depth++] = pc;
+    } else {
+        for (int i = first; i < count && depth < MAX_STACK_DEPTH; i++) {
+            sample.frames[depth++] = frames[i];
+        }
+    }
+    sample.depth = depth;
+    errno = savedErrno;
+#else
+    (void)context;
+#endif
+}
+
+SampleProfile SamplingProfiler::buildProfile() const
+{
+    SampleProfile profile;
+    profile.frequencyHz = frequency;
+    profile.droppedSamples = getDroppedCount();
+
+#ifdef __linux__
+    Symbolizer symbolizer;
+    std::vector<const std::string*> stack;
+    std::unordered_set<const std::string*> seen;
+
+    size_t count = getSampleCount();
+    for (size_t i = 0; i < count; i++) {
+        const Sample& sample = samples[i];
+        if (sample.depth == 0) continue;
+        profile.totalSamples++;
+
+        // Return addresses point after the call; look up the call itself
+        stack.clear();
+        for (uint32_t frame = 0; frame < sample.depth; frame++) {
+            char* address = static_cast<char*>(sample.frames[frame]);
+            stack.push_back(&symbolizer.name(frame == 0 ? address : address - 1));
+        }
+
+        profile.selfSamples[*stack.front()]++;
+        seen.clear();
+        for (const std::string* function : stack) {
+            if (seen.insert(function).second) {
+                profile.totalSamplesByFunction[*function]++;
+            }
+        }
+
+        const SampleContext& context = sample.context;
+        profile.phaseSamples[context.phase ? context.phase : "(none)"]++;
+        if (context.material) {
+            profile.materialSamples[context.material]++;
+        }
+        if (context.hasChunk) {
+            profile.chunkSamples[{context.chunkX, context.chunkY}]++;
+        }
+
+        // Root first, context tags above the real frames
+        std::string folded;
+        if (context.phase) {
+            folded += std::string("[phase ") + context.phase + "];";
+        }
+        if (context.material) {
+            folded += std::string("[material ") + context.material + "];";
+        }
+        for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+            folded += foldedFrame(**it);
+            folded += ';';
+        }
+        folded.pop_back();
+        profile.foldedStacks[folded]++;
+    }
+#endif
+
+    return profile;
+}
+
+bool SamplingProfiler::writeFlatProfile(const SampleProfile& profile, const std::string& filepath, size_t maxRows)
+{
+    std::ofstream file(filepath);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    double total = static_cast<double>(std::max<uint64_t>(profile.totalSamples, 1));
+    double msPerSample = profile.frequencyHz > 0 ? 1000.0 / profile.frequencyHz : 0.0;
+
+    file << "Samples: " << profile.totalSamples << " at " << profile.frequencyHz << " Hz ("
+         << std::fixed << std::setprecision(1) << profile.totalSamples * msPerSample << " ms CPU), "
+         << profile.droppedSamples << " dropped\n";
+
+    auto table = [&](const char* title, const auto& rows) {
+        file << "\n" << title << "\n";
+        size_t printed = 0;
+        for (const auto& row : rows) {
+            if (printed++ == maxRows) break;
+            file << std::setw(8) << row.second << "  " << std::setw(5) << std::setprecision(1)
+                 << 100.0 * row.second / total << "%  " << row.first << "\n";
+        }
+    };
+
+    table("Self samples by function:", sortedByCount(profile.selfSamples));
+    table("Total samples by function (anywhere on the stack):", sortedByCount(profile.totalSamplesByFunction));
+    table("Samples by phase:", sortedByCount(profile.phaseSamples));
+    table("Samples by material type:", sortedByCount(profile.materialSamples));
+
+    std::map<std::string, uint64_t> chunks;
+    for (const auto& chunk : profile.chunkSamples) {
+        chunks["(" + std::to_string(chunk.first.first) + ", " + std::to_string(chunk.first.second) + ")"] =
+            chunk.second;
+    }
+    table("Hottest chunks:", sortedByCount(chunks));
+
+    return static_cast<bool>(file);
+}
+
+bool SamplingProfiler::writeFoldedStacks(const SampleProfile& profile, const std::string& filepath)
+{
+    std::ofstream file(filepath);
+    if (!file.is_open()) {
+        return false;
+    }
+    for (const auto& stack : profile.foldedStacks) {
+        file << stack.first << " " << stack.second << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+} // namespace astral
@@ -0,0 +1,266 @@
+#include "astral/core/ThreadPool.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace astral {
+
+namespace {
+
+// Parse a kernel CPU list such as "0-3,8,10-11"
+std::vector<int> parseCpuList(const std::string& text)
+{
+    std::vector<int> cpus;
+    std::stringstream stream(text);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty()) continue;
+        size_t dash = range.find('-');
+        try {
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(range));
+            } else {
+                int first = std::stoi(range.substr(0, dash));
+                int last = std::stoi(range.substr(dash + 1));
+                for (int cpu = first; cpu <= last; cpu++) {
+                    cpus.push_back(cpu);
+                }
+            }
+        } catch (const std::exception&) {
+            // Ignore malformed entries
+        }
+    }
+    return cpus;
+}
+
+// Iterations of one parallelFor(), shared with the helper tasks, which may
+// only start after the call returned
+struct Batch {
+    std::function<void(size_t)> body;
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t next = 0;
+    size_t count = 0;
+    size_t unfinished = 0;
+
+    // Run the next iteration; returns false when none are left to take
+    bool runOne()
+    {
+        size_t index;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (next == count) {
+                return false;
+            }
+            index = next++;
+        }
+
+        body(index);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--unfinished == 0) {
+            done.notify_all();
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount, bool pinToCoreGroups)
+    : pendingTasks(0)
+    , stopping(false)
+{
+    if (threadCount == 0) {
+        threadCount = hardwareThreads();
+    }
+
+    detectCoreGroups();
+    groupQueues.resize(groupCpus.size());
+
+    // Deal workers round-robin across groups so every group gets a share
+    for (size_t i = 0; i < threadCount; i++) {
+        size_t group = i % groupCpus.size();
+        workers.emplace_back(&ThreadPool::workerLoop, this, group);
+
+#ifdef __linux__
+        if (pinToCoreGroups && !groupCpus[group].empty()) {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            for (int cpu : groupCpus[group]) {
+                CPU_SET(cpu, &cpuSet);
+            }
+            pthread_setaffinity_np(workers.back().native_handle(), sizeof(cpuSet), &cpuSet);
+        }
+#else
+        (void)pinToCoreGroups;
+#endif
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(Task task, int coreGroup)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (coreGroup >= 0) {
+            groupQueues[coreGroup % groupQueues.size()].push_back(std::move(task));
+        } else {
+            sharedQueue.push_back(std::move(task));
+        }
+        pendingTasks++;
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return pendingTasks == 0; });
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body)
+{
+    if (count == 0) {
+        return;
+    }
+
+    auto batch = std::make_shared<Batch>();
+    batch->body = body;
+    batch->count = count;
+    batch->unfinished = count;
+
+    // The caller takes iterations too, so one helper fewer than iterations
+    size_t helpers = std::min(count - 1, workers.size());
+    for (size_t i = 0; i < helpers; i++) {
+        submit([batch]() {
+            while (batch->runOne()) {
+            }
+        });
+    }
+    while (batch->runOne()) {
+    }
+
+    // Iterations taken by helpers may still be running
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->done.wait(lock, [&batch]() { return batch->unfinished == 0; });
+}
+
+size_t ThreadPool::hardwareThreads()
+{
+    unsigned int count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+bool ThreadPool::popTask(size_t group, Task& task)
+{
+    // Own group first, then ungrouped work, then steal from other groups
+    if (!groupQueues[group].empty()) {
+        task = std::move(groupQueues[group].front());
+        groupQueues[group].pop_front();
+        return true;
+    }
+
+    if (!sharedQueue.empty()) {
+        task = std::move(sharedQueue.front());
+        sharedQueue.pop_front();
+        return true;
+    }
+
+    for (size_t offset = 1; offset < groupQueues.size(); offset++) {
+        auto& queue = groupQueues[(group + offset) % groupQueues.size()];
+        if (!queue.empty()) {
+            task = std::move(queue.front());
+            queue.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t group)
+{
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(lock, [this, group, &task]() {
+                return popTask(group, task) || stopping;
+            });
+            if (!task) {
+                return;
+            }
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingTasks--;
+            if (pendingTasks == 0) {
+                idle.notify_all();
+            }
+        }
+    }
+}
+
+void ThreadPool::detectCoreGroups()
+{
+    groupCpus.clear();
+
+#ifdef __linux__
+    // CPUs this process may run on
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool haveAffinity = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    // One group per NUMA node
+    for (int node = 0; node < 256; node++) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file.is_open()) {
+            if (node > 0) break;
+            continue;
+        }
+
+        std::string text;
+        std::getline(file, text);
+
+        std::vector<int> cpus;
+        for (int cpu : parseCpuList(text)) {
+            if (!haveAffinity || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))) {
+                cpus.push_back(cpu);
+            }
+        }
+
+        if (!cpus.empty()) {
+            groupCpus.push_back(cpus);
+        }
+    }
+#endif
+
+    // Fall back to a single group when the topology is unknown
+    if (groupCpus.empty()) {
+        groupCpus.emplace_back();
+    }
+}
+
+} // namespace astral
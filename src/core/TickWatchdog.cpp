@@ -0,0 +1,241 @@
+#include "astral/core/TickWatchdog.h"
+#include "astral/core/MemoryReport.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace astral {
+
+TickWatchdog::TickWatchdog(const TickWatchdogConfig& config)
+    : config(config)
+    , ring(std::max<size_t>(config.historyTicks, 1))
+    , head(0)
+    , recorded(0)
+    , tickCount(0)
+    , outliers(0)
+    , suppressed(0)
+    , dumpsQueued(0)
+    , hasDumped(false)
+    , stopping(false)
+    , pending(false)
+    , dumpsWritten(0)
+{
+    writer = std::thread(&TickWatchdog::writerLoop, this);
+}
+
+TickWatchdog::~TickWatchdog()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    writer.join();
+}
+
+void TickWatchdog::beginTick()
+{
+    // Reuse the oldest slot; clear() keeps the vectors' capacity
+    head = (head + 1) % ring.size();
+    TickTrace& trace = ring[head];
+    trace.tick = tickCount;
+    trace.timestamp = std::chrono::duration<double>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    trace.durationMs = 0.0;
+    trace.sections.clear();
+    trace.chunkCosts.clear();
+    if (!trace.events.empty()) {
+        trace.events = nlohmann::json::array();
+    }
+    tickStart = std::chrono::steady_clock::now();
+}
+
+void TickWatchdog::recordSection(const std::string& name, double ms)
+{
+    ring[head].sections.emplace_back(name, ms);
+}
+
+void TickWatchdog::recordChunkCost(int chunkX, int chunkY, double ms)
+{
+    ring[head].chunkCosts.push_back({chunkX, chunkY, ms});
+}
+
+void TickWatchdog::recordEvent(nlohmann::json event)
+{
+    ring[head].events.push_back(std::move(event));
+}
+
+bool TickWatchdog::endTick(double durationMs)
+{
+    TickTrace& trace = ring[head];
+    if (durationMs < 0.0) {
+        durationMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - tickStart).count();
+    }
+    trace.durationMs = durationMs;
+    tickCount++;
+    recorded = std::min(recorded + 1, ring.size());
+
+    if (durationMs <= config.thresholdMs) {
+        return false;
+    }
+    outliers++;
+
+    // Throttle: bounded number of dumps, spaced out, one in flight at a time
+    auto now = std::chrono::steady_clock::now();
+    bool tooSoon = hasDumped &&
+        std::chrono::duration<double>(now - lastDump).count() < config.minDumpIntervalSeconds;
+    bool busy;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        busy = pending;
+    }
+    if (tooSoon || busy || dumpsQueued >= config.maxDumps) {
+        suppressed++;
+        return false;
+    }
+
+    lastDump = now;
+    hasDumped = true;
+    dumpsQueued++;
+    queueDump(trace);
+    return true;
+}
+
+void TickWatchdog::queueDump(const TickTrace& outlier)
+{
+    // Hottest chunks of the outlier tick
+    std::vector<TraceChunkCost> hottest = outlier.chunkCosts;
+    size_t hotCount = std::min(config.hotChunkCount, hottest.size());
+    std::partial_sort(hottest.begin(), hottest.begin() + hotCount, hottest.end(),
+        [](const TraceChunkCost& a, const TraceChunkCost& b) { return a.ms > b.ms; });
+    hottest.resize(hotCount);
+
+    // The snapshot has to see the world as the tick left it, so it is taken
+    // here; serialisation and file IO happen on the writer thread
+    nlohmann::json hotChunks = snapshotProvider ? snapshotProvider(hottest) : nlohmann::json::array();
+
+    std::vector<TickTrace> ticks;
+    ticks.reserve(recorded);
+    for (size_t i = recorded; i > 0; i--) {
+        ticks.push_back(ring[(head + ring.size() - (i - 1)) % ring.size()]);
+    }
+
+    std::string path = (std::filesystem::path(config.directory) /
+        (config.prefix + "_" + std::to_string(outlier.tick) + ".json")).string();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingTicks = std::move(ticks);
+        pendingHotChunks = std::move(hotChunks);
+        pendingPath = std::move(path);
+        pending = true;
+    }
+    wake.notify_one();
+}
+
+nlohmann::json TickWatchdog::buildDump(const std::vector<TickTrace>& ticks,
+                                       const nlohmann::json& hotChunks) const
+{
+    nlohmann::json dump;
+    dump["thresholdMs"] = config.thresholdMs;
+    dump["outlierTick"] = ticks.back().tick;
+    dump["outlierMs"] = ticks.back().durationMs;
+
+    dump["ticks"] = nlohmann::json::array();
+    for (const TickTrace& trace : ticks) {
+        nlohmann::json tick;
+        tick["tick"] = trace.tick;
+        tick["timestamp"] = trace.timestamp;
+        tick["durationMs"] = trace.durationMs;
+        for (const auto& section : trace.sections) {
+            tick["sections"][section.first] = section.second;
+        }
+
+        // Most expensive chunks first
+        std::vector<TraceChunkCost> costs = trace.chunkCosts;
+        std::sort(costs.begin(), costs.end(),
+            [](const TraceChunkCost& a, const TraceChunkCost& b) { return a.ms > b.ms; });
+        tick["chunkCosts"] = nlohmann::json::array();
+        for (const auto& cost : costs) {
+            tick["chunkCosts"].push_back({cost.chunkX, cost.chunkY, cost.ms});
+        }
+
+        tick["events"] = trace.events;
+        dump["ticks"].push_back(std::move(tick));
+    }
+
+    dump["hotChunks"] = hotChunks;
+    return dump;
+}
+
+void TickWatchdog::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || pending; });
+        if (!pending) {
+            return;
+        }
+
+        std::vector<TickTrace> ticks = std::move(pendingTicks);
+        nlohmann::json hotChunks = std::move(pendingHotChunks);
+        std::string path = pendingPath;
+        lock.unlock();
+
+        try {
+            std::filesystem::create_directories(config.directory);
+            std::ofstream file(path);
+            if (file.is_open()) {
+                file << buildDump(ticks, hotChunks).dump();
+                dumpsWritten++;
+            } else {
+                std::cerr << "TickWatchdog: failed to open " << path << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "TickWatchdog: failed to write " << path << ": " << e.what() << std::endl;
+        }
+
+        lock.lock();
+        lastDumpPath = path;
+        pending = false;
+        idle.notify_all();
+    }
+}
+
+void TickWatchdog::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return !pending; });
+}
+
+std::string TickWatchdog::getLastDumpPath() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastDumpPath;
+}
+
+size_t TickWatchdog::getMemoryUsage() const
+{
+    auto traceBytes = [](const TickTrace& trace) {
+        size_t bytes = heapBytes(trace.sections) + heapBytes(trace.chunkCosts) + trace.events.size() * sizeof(nlohmann::json);
+        for (const auto& section : trace.sections) {
+            bytes += heapBytes(section.first);
+        }
+        return bytes;
+    };
+
+    size_t bytes = heapBytes(ring);
+    for (const TickTrace& trace : ring) {
+        bytes += traceBytes(trace);
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    bytes += heapBytes(pendingTicks);
+    for (const TickTrace& trace : pendingTicks) {
+        bytes += traceBytes(trace);
+    }
+    return bytes;
+}
+
+} // namespace astral
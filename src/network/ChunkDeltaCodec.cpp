@@ -0,0 +1,211 @@
+#include "astral/network/ChunkDeltaCodec.h"
+#include <algorithm>
+
+namespace astral {
+
+// ==================== ByteWriter / ByteReader ====================
+
+void ByteWriter::writeU32(uint32_t value)
+{
+    for (int i = 0; i < 4; i++) {
+        buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+void ByteWriter::writeU64(uint64_t value)
+{
+    for (int i = 0; i < 8; i++) {
+        buffer.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    }
+}
+
+void ByteWriter::writeVarint(uint64_t value)
+{
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+size_t ByteWriter::beginMessage(StreamMessage type)
+{
+    size_t start = buffer.size();
+    writeU32(0); // Patched by endMessage
+    writeU8(static_cast<uint8_t>(type));
+    return start;
+}
+
+void ByteWriter::endMessage(size_t start)
+{
+    uint32_t length = static_cast<uint32_t>(buffer.size() - start - 4);
+    for (int i = 0; i < 4; i++) {
+        buffer[start + i] = static_cast<uint8_t>(length >> (i * 8));
+    }
+}
+
+bool ByteReader::readU8(uint8_t& value)
+{
+    if (remaining() < 1) { data = end; return false; }
+    value = *data++;
+    return true;
+}
+
+bool ByteReader::readU32(uint32_t& value)
+{
+    if (remaining() < 4) { data = end; return false; }
+    value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(*data++) << (i * 8);
+    }
+    return true;
+}
+
+bool ByteReader::readU64(uint64_t& value)
+{
+    if (remaining() < 8) { data = end; return false; }
+    value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= static_cast<uint64_t>(*data++) << (i * 8);
+    }
+    return true;
+}
+
+bool ByteReader::readI32(int32_t& value)
+{
+    uint32_t raw;
+    if (!readU32(raw)) return false;
+    value = static_cast<int32_t>(raw);
+    return true;
+}
+
+bool ByteReader::readVarint(uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte;
+        if (!readU8(byte)) return false;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    data = end;
+    return false;
+}
+
+// ==================== ChunkDeltaCodec ====================
+
+void ChunkDeltaCodec::encode(const MaterialID* current, const MaterialID* base, std::vector<uint8_t>& out)
+{
+    ByteWriter writer(out);
+
+    // Palette of XOR values, most chunks need only a few entries
+    MaterialID deltas[CELL_COUNT];
+    std::vector<MaterialID> palette;
+    uint8_t indices[CELL_COUNT];
+    bool paletteFull = false;
+
+    for (int i = 0; i < CELL_COUNT; i++) {
+        deltas[i] = current[i] ^ base[i];
+        auto it = std::find(palette.begin(), palette.end(), deltas[i]);
+        if (it == palette.end()) {
+            if (palette.size() == 256) {
+                paletteFull = true;
+                break;
+            }
+            palette.push_back(deltas[i]);
+            it = palette.end() - 1;
+        }
+        indices[i] = static_cast<uint8_t>(it - palette.begin());
+    }
+
+    // Too many distinct values for byte indices: send raw XOR values
+    if (paletteFull) {
+        writer.writeVarint(0);
+        for (int i = 0; i < CELL_COUNT; i++) {
+            MaterialID delta = current[i] ^ base[i];
+            writer.writeU8(static_cast<uint8_t>(delta));
+            writer.writeU8(static_cast<uint8_t>(delta >> 8));
+        }
+        return;
+    }
+
+    writer.writeVarint(palette.size());
+    for (MaterialID value : palette) {
+        writer.writeVarint(value);
+    }
+
+    // Runs of (length, palette index) until every cell is covered
+    int i = 0;
+    while (i < CELL_COUNT) {
+        int run = 1;
+        while (i + run < CELL_COUNT && indices[i + run] == indices[i]) {
+            run++;
+        }
+        writer.writeVarint(static_cast<uint64_t>(run));
+        writer.writeU8(indices[i]);
+        i += run;
+    }
+}
+
+bool ChunkDeltaCodec::decode(ByteReader& reader, const MaterialID* base, MaterialID* out)
+{
+    uint64_t paletteSize;
+    if (!reader.readVarint(paletteSize) || paletteSize > 256) {
+        return false;
+    }
+
+    if (paletteSize == 0) {
+        for (int i = 0; i < CELL_COUNT; i++) {
+            uint8_t low, high;
+            if (!reader.readU8(low) || !reader.readU8(high)) return false;
+            out[i] = base[i] ^ static_cast<MaterialID>(low | (high << 8));
+        }
+        return true;
+    }
+
+    MaterialID palette[256];
+    for (uint64_t p = 0; p < paletteSize; p++) {
+        uint64_t value;
+        if (!reader.readVarint(value)) return false;
+        palette[p] = static_cast<MaterialID>(value);
+    }
+
+    int i = 0;
+    while (i < CELL_COUNT) {
+        uint64_t run;
+        uint8_t index;
+        if (!reader.readVarint(run) || !reader.readU8(index)) return false;
+        if (run == 0 || run > static_cast<uint64_t>(CELL_COUNT - i) || index >= paletteSize) {
+            return false;
+        }
+        for (uint64_t r = 0; r < run; r++, i++) {
+            out[i] = base[i] ^ palette[index];
+        }
+    }
+    return true;
+}
+
+std::vector<ChunkCoord> ChunkDeltaCodec::viewportChunks(const WorldRect& viewport, int worldWidth, int worldHeight)
+{
+    std::vector<ChunkCoord> coords;
+
+    // The viewport comes from the client, so its far edges are summed in 64 bits
+    int minX = std::max(0, viewport.x);
+    int minY = std::max(0, viewport.y);
+    int maxX = static_cast<int>(std::min<int64_t>(worldWidth, int64_t(viewport.x) + viewport.width)) - 1;
+    int maxY = static_cast<int>(std::min<int64_t>(worldHeight, int64_t(viewport.y) + viewport.height)) - 1;
+    if (maxX < minX || maxY < minY) {
+        return coords;
+    }
+
+    ChunkCoord first = ChunkManager::worldToChunkCoord(minX, minY);
+    ChunkCoord last = ChunkManager::worldToChunkCoord(maxX, maxY);
+    for (int y = first.y; y <= last.y; y++) {
+        for (int x = first.x; x <= last.x; x++) {
+            coords.push_back({x, y});
+        }
+    }
+    return coords;
+}
+
+} // namespace astral
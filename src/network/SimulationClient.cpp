@@ -0,0 +1,311 @@
+#include "astral/network/SimulationClient.h"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __unix__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace astral {
+
+namespace {
+
+// Largest server message: a raw chunk delta plus headers
+constexpr uint32_t MAX_SERVER_MESSAGE = 64 * 1024;
+
+} // namespace
+
+SimulationClient::SimulationClient()
+    : socket(-1)
+    , worldWidth(0)
+    , worldHeight(0)
+    , lastTick(0)
+    , lastVerified(false)
+{
+}
+
+SimulationClient::~SimulationClient()
+{
+    disconnect();
+}
+
+bool SimulationClient::connectTcp(const std::string& host, uint16_t port)
+{
+#ifdef __unix__
+    disconnect();
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        return false;
+    }
+
+    socket = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (socket < 0) {
+        return false;
+    }
+    if (connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        disconnect();
+        return false;
+    }
+
+    // Acks are tiny and latency bound
+    int noDelay = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    return true;
+#else
+    (void)host;
+    (void)port;
+    return false;
+#endif
+}
+
+bool SimulationClient::connectUnix(const std::string& path)
+{
+#ifdef __unix__
+    disconnect();
+    sockaddr_un address;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket < 0) {
+        return false;
+    }
+    if (connect(socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        disconnect();
+        return false;
+    }
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void SimulationClient::disconnect()
+{
+#ifdef __unix__
+    if (socket >= 0) {
+        close(socket);
+        socket = -1;
+    }
+#endif
+    inbox.clear();
+}
+
+void SimulationClient::setViewport(int x, int y, int width, int height)
+{
+    std::vector<uint8_t> message;
+    ByteWriter writer(message);
+    size_t start = writer.beginMessage(StreamMessage::VIEWPORT);
+    writer.writeI32(x);
+    writer.writeI32(y);
+    writer.writeI32(width);
+    writer.writeI32(height);
+    writer.endMessage(start);
+    sendAll(message);
+}
+
+bool SimulationClient::poll(int timeoutMs)
+{
+#ifdef __unix__
+    if (socket < 0) {
+        return false;
+    }
+
+    pollfd descriptor{socket, POLLIN, 0};
+    if (::poll(&descriptor, 1, timeoutMs) <= 0) {
+        return true;
+    }
+
+    uint8_t buffer[16384];
+    while (true) {
+        ssize_t received = recv(socket, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (received > 0) {
+            inbox.insert(inbox.end(), buffer, buffer + received);
+            stats.bytesReceived += static_cast<uint64_t>(received);
+            continue;
+        }
+        if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            disconnect();
+            return false;
+        }
+        break;
+    }
+
+    size_t offset = 0;
+    while (inbox.size() - offset >= 5) {
+        ByteReader header(inbox.data() + offset, inbox.size() - offset);
+        uint32_t length;
+        header.readU32(length);
+        if (length == 0 || length > MAX_SERVER_MESSAGE) {
+            stats.protocolErrors++;
+            disconnect();
+            return false;
+        }
+        if (inbox.size() - offset - 4 < length) {
+            break;
+        }
+
+        uint8_t type;
+        header.readU8(type);
+        ByteReader body(header.position(), length - 1);
+        if (!handleMessage(static_cast<StreamMessage>(type), body)) {
+            stats.protocolErrors++;
+        }
+        offset += 4 + length;
+    }
+    inbox.erase(inbox.begin(), inbox.begin() + offset);
+    return true;
+#else
+    (void)timeoutMs;
+    return false;
+#endif
+}
+
+bool SimulationClient::handleMessage(StreamMessage type, ByteReader& reader)
+{
+    switch (type) {
+        case StreamMessage::WORLD_INFO: {
+            int32_t chunkSize;
+            if (!reader.readI32(worldWidth) || !reader.readI32(worldHeight) ||
+                !reader.readI32(chunkSize)) {
+                return false;
+            }
+            // Deltas are laid out for the server's chunk size
+            return chunkSize == CHUNK_SIZE;
+        }
+        case StreamMessage::CHUNK_DELTA:
+            return applyDelta(reader);
+        case StreamMessage::TICK_END:
+            verifyTick(reader);
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool SimulationClient::applyDelta(ByteReader& reader)
+{
+    ChunkCoord coord;
+    uint64_t version;
+    uint64_t baseVersion;
+    if (!reader.readI32(coord.x) || !reader.readI32(coord.y) ||
+        !reader.readU64(version) || !reader.readU64(baseVersion)) {
+        return false;
+    }
+
+    ChunkState& state = chunks[coord];
+    if (state.materials.empty()) {
+        state.materials.assign(ChunkDeltaCodec::CELL_COUNT, 0);
+    }
+    if (state.version != baseVersion) {
+        return false;
+    }
+
+    std::vector<MaterialID> updated(ChunkDeltaCodec::CELL_COUNT);
+    if (!ChunkDeltaCodec::decode(reader, state.materials.data(), updated.data())) {
+        return false;
+    }
+    state.materials.swap(updated);
+    state.version = version;
+    stats.chunksApplied++;
+
+    std::vector<uint8_t> ack;
+    ByteWriter writer(ack);
+    size_t start = writer.beginMessage(StreamMessage::ACK);
+    writer.writeI32(coord.x);
+    writer.writeI32(coord.y);
+    writer.writeU64(version);
+    writer.endMessage(start);
+    return sendAll(ack);
+}
+
+void SimulationClient::verifyTick(ByteReader& reader)
+{
+    WorldRect viewport;
+    uint8_t synced;
+    uint64_t hash;
+    if (!reader.readU64(lastTick) || !reader.readI32(viewport.x) || !reader.readI32(viewport.y) ||
+        !reader.readI32(viewport.width) || !reader.readI32(viewport.height) ||
+        !reader.readU8(synced) || !reader.readU64(hash)) {
+        stats.protocolErrors++;
+        return;
+    }
+    stats.ticks++;
+
+    // While catching up (bandwidth cap) there is nothing to check yet
+    lastVerified = false;
+    if (!synced) {
+        return;
+    }
+
+    static const std::vector<MaterialID> air(ChunkDeltaCodec::CELL_COUNT, 0);
+    uint64_t local = 0;
+    for (const ChunkCoord& coord : ChunkDeltaCodec::viewportChunks(viewport, worldWidth, worldHeight)) {
+        auto it = chunks.find(coord);
+        const std::vector<MaterialID>& materials =
+            (it != chunks.end() && !it->second.materials.empty()) ? it->second.materials : air;
+        local = combineChunkHash(local, coord, hashMaterials(materials.data(), materials.size()));
+    }
+
+    if (local == hash) {
+        stats.verifiedTicks++;
+        lastVerified = true;
+    } else {
+        stats.hashMismatches++;
+    }
+}
+
+MaterialID SimulationClient::getMaterial(int x, int y) const
+{
+    if (x < 0 || y < 0) {
+        return 0;
+    }
+    auto it = chunks.find(ChunkManager::worldToChunkCoord(x, y));
+    if (it == chunks.end() || it->second.materials.empty()) {
+        return 0;
+    }
+    LocalCoord local = ChunkManager::worldToLocalCoord(x, y);
+    return it->second.materials[local.y * CHUNK_SIZE + local.x];
+}
+
+uint64_t SimulationClient::getChunkVersion(ChunkCoord coord) const
+{
+    auto it = chunks.find(coord);
+    return it != chunks.end() ? it->second.version : 0;
+}
+
+bool SimulationClient::sendAll(const std::vector<uint8_t>& data)
+{
+#ifdef __unix__
+    size_t offset = 0;
+    while (socket >= 0 && offset < data.size()) {
+        ssize_t sent = send(socket, data.data() + offset, data.size() - offset, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            disconnect();
+            return false;
+        }
+        offset += static_cast<size_t>(sent);
+    }
+    return socket >= 0;
+#else
+    (void)data;
+    return false;
+#endif
+}
+
+} // namespace astral
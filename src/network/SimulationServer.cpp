@@ -0,0 +1,401 @@
+#include "astral/network/SimulationServer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef __unix__
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace astral {
+
+namespace {
+
+#ifdef __unix__
+bool setNonBlocking(int socket)
+{
+    int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+// Largest message a client may send; anything bigger is a protocol error
+constexpr uint32_t MAX_CLIENT_MESSAGE = 1024;
+
+} // namespace
+
+SimulationServer::SimulationServer(CellularAutomaton& world)
+    : world(world)
+    , listenSocket(-1)
+    , port(0)
+    , bandwidthLimit(0)
+{
+    // The codec works on CHUNK_SIZE x CHUNK_SIZE layouts
+    if (world.getChunkSize() != CHUNK_SIZE) {
+        throw std::invalid_argument("SimulationServer requires a world with the default chunk size");
+    }
+    // Viewports are clipped to the world's extent, which must be finite
+    if (world.isUnbounded()) {
+        throw std::invalid_argument("SimulationServer requires a bounded world");
+    }
+}
+
+SimulationServer::~SimulationServer()
+{
+    stop();
+}
+
+bool SimulationServer::listenTcp(uint16_t requestedPort)
+{
+#ifdef __unix__
+    stop();
+    listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(requestedPort);
+
+    socklen_t length = sizeof(address);
+    if (bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenSocket, 16) != 0 || !setNonBlocking(listenSocket) ||
+        getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        std::cerr << "SimulationServer: failed to listen on port " << requestedPort << std::endl;
+        stop();
+        return false;
+    }
+
+    port = ntohs(address.sin_port);
+    return true;
+#else
+    (void)requestedPort;
+    return false;
+#endif
+}
+
+bool SimulationServer::listenUnix(const std::string& path)
+{
+#ifdef __unix__
+    stop();
+    sockaddr_un address;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+
+    listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        return false;
+    }
+
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    unlink(path.c_str());
+
+    if (bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenSocket, 16) != 0 || !setNonBlocking(listenSocket)) {
+        std::cerr << "SimulationServer: failed to listen on " << path << std::endl;
+        stop();
+        return false;
+    }
+
+    unixPath = path;
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void SimulationServer::stop()
+{
+#ifdef __unix__
+    for (auto& client : clients) {
+        close(client->socket);
+    }
+    clients.clear();
+
+    if (listenSocket >= 0) {
+        close(listenSocket);
+        listenSocket = -1;
+    }
+    if (!unixPath.empty()) {
+        unlink(unixPath.c_str());
+        unixPath.clear();
+    }
+    port = 0;
+#endif
+}
+
+void SimulationServer::tick(float deltaTime)
+{
+    if (listenSocket < 0) {
+        return;
+    }
+
+    acceptClients();
+    refreshedChunks.clear();
+
+    for (auto& client : clients) {
+        receive(*client);
+        if (!client->closed && client->hasViewport) {
+            streamChunks(*client, deltaTime);
+        }
+        flush(*client);
+    }
+
+    // Drop disconnected clients
+    clients.erase(std::remove_if(clients.begin(), clients.end(), [](const std::unique_ptr<Client>& client) {
+        if (client->closed) {
+#ifdef __unix__
+            close(client->socket);
+#endif
+            return true;
+        }
+        return false;
+    }), clients.end());
+
+    stats.ticks++;
+}
+
+void SimulationServer::acceptClients()
+{
+#ifdef __unix__
+    while (true) {
+        int socket = accept(listenSocket, nullptr, nullptr);
+        if (socket < 0) {
+            break;
+        }
+        if (!setNonBlocking(socket)) {
+            close(socket);
+            continue;
+        }
+
+        auto client = std::make_unique<Client>();
+        client->socket = socket;
+        client->tokens = static_cast<double>(bandwidthLimit);
+
+        ByteWriter writer(client->outbox);
+        size_t start = writer.beginMessage(StreamMessage::WORLD_INFO);
+        writer.writeI32(world.getWorldWidth());
+        writer.writeI32(world.getWorldHeight());
+        writer.writeI32(CHUNK_SIZE);
+        writer.endMessage(start);
+
+        clients.push_back(std::move(client));
+    }
+#endif
+}
+
+void SimulationServer::receive(Client& client)
+{
+#ifdef __unix__
+    uint8_t buffer[4096];
+    while (true) {
+        ssize_t received = recv(client.socket, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (received > 0) {
+            client.inbox.insert(client.inbox.end(), buffer, buffer + received);
+            continue;
+        }
+        if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            client.closed = true;
+        }
+        break;
+    }
+
+    // Parse complete frames
+    size_t offset = 0;
+    while (client.inbox.size() - offset >= 5) {
+        ByteReader header(client.inbox.data() + offset, client.inbox.size() - offset);
+        uint32_t length;
+        header.readU32(length);
+        if (length == 0 || length > MAX_CLIENT_MESSAGE) {
+            client.closed = true;
+            break;
+        }
+        if (client.inbox.size() - offset - 4 < length) {
+            break;
+        }
+
+        uint8_t type;
+        header.readU8(type);
+        ByteReader body(header.position(), length - 1);
+        handleMessage(client, static_cast<StreamMessage>(type), body);
+        offset += 4 + length;
+    }
+    client.inbox.erase(client.inbox.begin(), client.inbox.begin() + offset);
+#else
+    (void)client;
+#endif
+}
+
+void SimulationServer::handleMessage(Client& client, StreamMessage type, ByteReader& reader)
+{
+    switch (type) {
+        case StreamMessage::VIEWPORT: {
+            WorldRect viewport;
+            if (reader.readI32(viewport.x) && reader.readI32(viewport.y) &&
+                reader.readI32(viewport.width) && reader.readI32(viewport.height)) {
+                client.viewport = viewport;
+                client.hasViewport = true;
+            }
+            break;
+        }
+        case StreamMessage::ACK: {
+            ChunkCoord coord;
+            uint64_t version;
+            if (!reader.readI32(coord.x) || !reader.readI32(coord.y) || !reader.readU64(version)) {
+                break;
+            }
+            auto it = client.chunks.find(coord);
+            if (it != client.chunks.end() && it->second.inFlight && it->second.sentVersion == version) {
+                ClientChunk& state = it->second;
+                state.acked.swap(state.sent);
+                state.ackedVersion = version;
+                state.inFlight = false;
+            }
+            break;
+        }
+        default:
+            // Server-to-client message types are not valid here
+            client.closed = true;
+            break;
+    }
+}
+
+void SimulationServer::streamChunks(Client& client, float deltaTime)
+{
+    ChunkManager& chunkManager = world.getChunkManager();
+    std::vector<ChunkCoord> coords = ChunkDeltaCodec::viewportChunks(
+        client.viewport, world.getWorldWidth(), world.getWorldHeight());
+
+    // Only chunks a client watches are rehashed, once per tick
+    for (const ChunkCoord& coord : coords) {
+        Chunk* chunk = chunkManager.getChunk(coord);
+        if (chunk && refreshedChunks.insert(coord).second) {
+            chunk->refreshVersion();
+        }
+    }
+
+    // Refill the bandwidth budget, allowing at most one second of burst
+    if (bandwidthLimit > 0) {
+        client.tokens = std::min(client.tokens + bandwidthLimit * static_cast<double>(deltaTime),
+                                 static_cast<double>(bandwidthLimit));
+    }
+
+    // Chunks nearest the viewport centre go first when bandwidth is short
+    std::vector<ChunkCoord> order = coords;
+    float centerX = (client.viewport.x + client.viewport.width * 0.5f) / CHUNK_SIZE - 0.5f;
+    float centerY = (client.viewport.y + client.viewport.height * 0.5f) / CHUNK_SIZE - 0.5f;
+    std::stable_sort(order.begin(), order.end(), [centerX, centerY](const ChunkCoord& a, const ChunkCoord& b) {
+        float da = (a.x - centerX) * (a.x - centerX) + (a.y - centerY) * (a.y - centerY);
+        float db = (b.x - centerX) * (b.x - centerX) + (b.y - centerY) * (b.y - centerY);
+        return da < db;
+    });
+
+    ByteWriter writer(client.outbox);
+    MaterialID current[ChunkDeltaCodec::CELL_COUNT];
+    static const std::vector<MaterialID> air(ChunkDeltaCodec::CELL_COUNT, 0);
+
+    for (const ChunkCoord& coord : order) {
+        if (bandwidthLimit > 0 && client.tokens <= 0.0) {
+            break;
+        }
+
+        const Chunk* chunk = chunkManager.getChunk(coord);
+        uint64_t version = chunk ? chunk->getVersion() : 0;
+        ClientChunk& state = client.chunks[coord];
+        if (state.inFlight || state.ackedVersion == version) {
+            continue;
+        }
+
+        if (chunk) {
+            chunk->copyMaterials(current);
+        } else {
+            std::fill(current, current + ChunkDeltaCodec::CELL_COUNT, MaterialID(0));
+        }
+        const std::vector<MaterialID>& base = state.acked.empty() ? air : state.acked;
+
+        size_t before = client.outbox.size();
+        size_t start = writer.beginMessage(StreamMessage::CHUNK_DELTA);
+        writer.writeI32(coord.x);
+        writer.writeI32(coord.y);
+        writer.writeU64(version);
+        writer.writeU64(state.ackedVersion);
+        ChunkDeltaCodec::encode(current, base.data(), client.outbox);
+        writer.endMessage(start);
+
+        size_t bytes = client.outbox.size() - before;
+        client.tokens -= static_cast<double>(bytes);
+        stats.chunksSent++;
+        stats.bytesSent += bytes;
+        stats.rawBytes += sizeof(current);
+
+        state.sent.assign(current, current + ChunkDeltaCodec::CELL_COUNT);
+        state.sentVersion = version;
+        state.inFlight = true;
+    }
+
+    // The viewport is in sync once every chunk's latest version is on its way
+    bool synced = true;
+    uint64_t hash = 0;
+    for (const ChunkCoord& coord : coords) {
+        const Chunk* chunk = chunkManager.getChunk(coord);
+        uint64_t version = chunk ? chunk->getVersion() : 0;
+        const ClientChunk& state = client.chunks[coord];
+        bool current = state.inFlight ? state.sentVersion == version : state.ackedVersion == version;
+        synced = synced && current;
+
+        uint64_t chunkHash = chunk ? chunk->getMaterialHash()
+                                   : hashMaterials(air.data(), air.size());
+        hash = combineChunkHash(hash, coord, chunkHash);
+    }
+
+    size_t start = writer.beginMessage(StreamMessage::TICK_END);
+    writer.writeU64(stats.ticks);
+    writer.writeI32(client.viewport.x);
+    writer.writeI32(client.viewport.y);
+    writer.writeI32(client.viewport.width);
+    writer.writeI32(client.viewport.height);
+    writer.writeU8(synced ? 1 : 0);
+    writer.writeU64(hash);
+    writer.endMessage(start);
+}
+
+void SimulationServer::flush(Client& client)
+{
+#ifdef __unix__
+    size_t offset = 0;
+    while (offset < client.outbox.size()) {
+        ssize_t sent = send(client.socket, client.outbox.data() + offset,
+                            client.outbox.size() - offset, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (sent > 0) {
+            offset += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+            client.closed = true;
+        }
+        break;
+    }
+    client.outbox.erase(client.outbox.begin(), client.outbox.begin() + offset);
+#else
+    (void)client;
+#endif
+}
+
+} // namespace astral
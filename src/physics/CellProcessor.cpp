@@ -1,25 +1,17 @@
 #include "astral/physics/CellProcessor.h"
 #include "astral/physics/Material.h"
-#include <chrono>
 #include <algorithm>
 #include <cmath>
 #include <iostream>
 
 namespace astral {
 
-CellProcessor::CellProcessor(MaterialRegistry* registry)
-    : materialRegistry(registry)
-{
-    // Initialize random number generator with current time
-    random.seed(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
-}
-
 void CellProcessor::initializeCellFromMaterial(Cell& cell, MaterialID materialID) const
 {
     // Safety check - verify materialID is valid
     // If materilaID is outside valid range, reset to air
     if (materialID < 0 || materialID > 100) { // Assuming we won't have more than 100 material types
-        materialID = materialRegistry->getDefaultMaterialID(); // Reset to air if invalid
+        materialID = materials->getDefaultMaterialID(); // Reset to air if invalid
     }
 
     // Reset the cell to defaults
@@ -36,7 +28,7 @@ void CellProcessor::initializeCellFromMaterial(Cell& cell, MaterialID materialID
     cell.metadata = 0;
     
     // Apply material-specific properties
-    const MaterialProperties& props = materialRegistry->getMaterial(materialID);
+    const MaterialProperties& props = materials->getMaterial(materialID);
     applyMaterialProperties(cell, props);
 }
 
@@ -129,18 +121,18 @@ void CellProcessor::applyMaterialProperties(Cell& cell, const MaterialProperties
 bool CellProcessor::canCellMove(const Cell& cell, const Cell& target) const
 {
     // Cannot move if the cell is not movable
-    const MaterialProperties& cellProps = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& cellProps = materials->getMaterial(cell.material);
     if (!cellProps.movable) {
         return false;
     }
     
     // Can always move into empty space
-    if (target.material == materialRegistry->getDefaultMaterialID()) {
+    if (target.material == materials->getDefaultMaterialID()) {
         return true;
     }
     
     // Check if densities allow displacement
-    const MaterialProperties& targetProps = materialRegistry->getMaterial(target.material);
+    const MaterialProperties& targetProps = materials->getMaterial(target.material);
     
     // Allow any cell to move into air spaces
     if (targetProps.type == MaterialType::EMPTY) {
@@ -198,11 +190,11 @@ bool CellProcessor::canDisplace(const Cell& mover, const Cell& target) const
     }
     
     // Get material properties
-    const MaterialProperties& moverProps = materialRegistry->getMaterial(mover.material);
-    const MaterialProperties& targetProps = materialRegistry->getMaterial(target.material);
+    const MaterialProperties& moverProps = materials->getMaterial(mover.material);
+    const MaterialProperties& targetProps = materials->getMaterial(target.material);
     
     // Empty space is always displaceable
-    if (target.material == materialRegistry->getDefaultMaterialID()) {
+    if (target.material == materials->getDefaultMaterialID()) {
         return true;
     }
     
@@ -229,7 +221,7 @@ bool CellProcessor::shouldSwapCells(const Cell& cell1, const Cell& cell2) const
     // Identical materials don't need swapping except for pressure equalization
     if (cell1.material == cell2.material) {
         // For liquids and gases, may swap based on pressure
-        const MaterialProperties& props = materialRegistry->getMaterial(cell1.material);
+        const MaterialProperties& props = materials->getMaterial(cell1.material);
         if ((props.type == MaterialType::LIQUID || props.type == MaterialType::GAS) &&
             std::abs(cell1.pressure - cell2.pressure) > 0.1f) {
             return true;
@@ -251,8 +243,8 @@ bool CellProcessor::shouldSwapCells(const Cell& cell1, const Cell& cell2) const
 bool CellProcessor::canReact(const Cell& cell1, const Cell& cell2) const
 {
     // Get material properties
-    const MaterialProperties& props1 = materialRegistry->getMaterial(cell1.material);
-    const MaterialProperties& props2 = materialRegistry->getMaterial(cell2.material);
+    const MaterialProperties& props1 = materials->getMaterial(cell1.material);
+    const MaterialProperties& props2 = materials->getMaterial(cell2.material);
     
     // Check for direct reaction rules in material properties
     for (const auto& reaction : props1.reactions) {
@@ -286,7 +278,7 @@ bool CellProcessor::canReact(const Cell& cell1, const Cell& cell2) const
     return false;
 }
 
-bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float deltaTime)
+bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float deltaTime, CellRandom& random) const
 {
     // Check if reaction is possible
     if (!canReact(cell1, cell2)) {
@@ -294,33 +286,33 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
     }
     
     // Get material properties
-    const MaterialProperties& props1 = materialRegistry->getMaterial(cell1.material);
-    const MaterialProperties& props2 = materialRegistry->getMaterial(cell2.material);
+    const MaterialProperties& props1 = materials->getMaterial(cell1.material);
+    const MaterialProperties& props2 = materials->getMaterial(cell2.material);
     
     // Special case: Lava interactions with other materials
-    if (props1.name == "Lava" && cell2.material != materialRegistry->getLavaID()) {
+    if (props1.name == "Lava" && cell2.material != materials->getLavaID()) {
         // Special case for water - creates stone and steam
-        if (cell2.material == materialRegistry->getWaterID()) {
+        if (cell2.material == materials->getWaterID()) {
             // When lava touches water, it rapidly cools to stone
-            if (rollProbability(0.8f)) {
+            if (random.rollProbability(0.8f)) {
                 // Convert lava to stone
-                cell1.material = materialRegistry->getStoneID();
+                cell1.material = materials->getStoneID();
                 cell1.temperature = 200.0f;  // Still hot but cooled down
                 
                 // Convert water to steam with high probability
-                if (rollProbability(0.85f)) {
-                    cell2.material = materialRegistry->getSteamID();
+                if (random.rollProbability(0.85f)) {
+                    cell2.material = materials->getSteamID();
                     cell2.temperature = 150.0f;
-                    cell2.lifetime = static_cast<uint8_t>(60 + getRandomInt(0, 20));
+                    cell2.lifetime = static_cast<uint8_t>(60 + random.getRandomInt(0, 20));
                     cell2.velocity.y = -1.0f; // Steam rises upward (negative y)
                 }
                 return true;
             }
         }
         // Special case for oil - INSTANT ignition from lava, guaranteed
-        else if (cell2.material == materialRegistry->getOilID()) {
+        else if (cell2.material == materials->getOilID()) {
             // Instantly convert oil to oil fire with no probability check
-            cell2.material = materialRegistry->getOilFireID();
+            cell2.material = materials->getOilFireID();
             cell2.temperature = 700.0f;  // Extra hot
             cell2.setFlag(Cell::FLAG_BURNING);
             cell2.lifetime = static_cast<uint8_t>(120);  // Long-lasting oil fire from lava
@@ -328,10 +320,10 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
             return true;
         }
         // Handle sand - lava should melt sand to more lava
-        else if (cell2.material == materialRegistry->getSandID()) {
+        else if (cell2.material == materials->getSandID()) {
             // Sand melts into lava when touching lava
-            if (rollProbability(0.6f * deltaTime * 10.0f)) {
-                cell2.material = materialRegistry->getLavaID();
+            if (random.rollProbability(0.6f * deltaTime * 10.0f)) {
+                cell2.material = materials->getLavaID();
                 cell2.temperature = 1000.0f;
                 return true;
             }
@@ -339,13 +331,13 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
         // Normal handling for other flammable materials
         else if (props2.flammable) {
             // Lava ignites flammable materials with high probability
-            if (rollProbability(0.7f * deltaTime * 10.0f)) {  // Higher probability for more predictable behavior
+            if (random.rollProbability(0.7f * deltaTime * 10.0f)) {  // Higher probability for more predictable behavior
                 // Convert to fire based on material type
                 if (props2.name == "Oil") {
-                    cell2.material = materialRegistry->getOilFireID();
+                    cell2.material = materials->getOilFireID();
                     cell2.temperature = 650.0f;
                 } else {
-                    cell2.material = materialRegistry->getFireID();
+                    cell2.material = materials->getFireID();
                     cell2.temperature = 550.0f;
                 }
                 cell2.setFlag(Cell::FLAG_BURNING);
@@ -356,26 +348,26 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
         // Lava damages and eventually melts non-flammable materials (except stone)
         else if (props2.name != "Stone" && props2.name != "Lava" && props2.name != "Air") {
             // More aggressive damage rate for predictable gameplay
-            if (rollProbability(0.4f * deltaTime * 10.0f)) {
+            if (random.rollProbability(0.4f * deltaTime * 10.0f)) {
                 cell2.health -= 0.2f;  // Double the damage rate
                 cell2.temperature += 50.0f;  // Heat up the material
                 
                 if (cell2.health <= 0.0f) {
                     // Higher chance of creating lava instead of just destruction
-                    if (rollProbability(0.6f)) {
+                    if (random.rollProbability(0.6f)) {
                         // Convert destroyed material to lava
-                        cell2.material = materialRegistry->getLavaID();
+                        cell2.material = materials->getLavaID();
                         cell2.temperature = 1000.0f;
                     } 
                     // Sometimes create smoke for effect
-                    else if (rollProbability(0.5f)) {
-                        cell2.material = materialRegistry->getSmokeID();
+                    else if (random.rollProbability(0.5f)) {
+                        cell2.material = materials->getSmokeID();
                         cell2.temperature = 200.0f;
                         cell2.lifetime = 60;
                     } 
                     // Otherwise just replace with air
                     else {
-                        cell2.material = materialRegistry->getDefaultMaterialID();
+                        cell2.material = materials->getDefaultMaterialID();
                     }
                     return true;
                 }
@@ -383,29 +375,29 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
         }
     }
     // Also check the reverse direction
-    else if (props2.name == "Lava" && cell1.material != materialRegistry->getLavaID()) {
+    else if (props2.name == "Lava" && cell1.material != materials->getLavaID()) {
         // Special case for water - creates stone and steam
-        if (cell1.material == materialRegistry->getWaterID()) {
+        if (cell1.material == materials->getWaterID()) {
             // When lava touches water, it rapidly cools to stone
-            if (rollProbability(0.8f)) {
+            if (random.rollProbability(0.8f)) {
                 // Convert lava to stone
-                cell2.material = materialRegistry->getStoneID();
+                cell2.material = materials->getStoneID();
                 cell2.temperature = 200.0f;  // Still hot but cooled down
                 
                 // Convert water to steam with high probability
-                if (rollProbability(0.85f)) {
-                    cell1.material = materialRegistry->getSteamID();
+                if (random.rollProbability(0.85f)) {
+                    cell1.material = materials->getSteamID();
                     cell1.temperature = 150.0f;
-                    cell1.lifetime = static_cast<uint8_t>(60 + getRandomInt(0, 20));
+                    cell1.lifetime = static_cast<uint8_t>(60 + random.getRandomInt(0, 20));
                     cell1.velocity.y = -1.0f; // Steam rises upward (negative y)
                 }
                 return true;
             }
         }
         // Special case for oil - INSTANT ignition from lava, guaranteed
-        else if (cell1.material == materialRegistry->getOilID()) {
+        else if (cell1.material == materials->getOilID()) {
             // Instantly convert oil to oil fire with no probability check
-            cell1.material = materialRegistry->getOilFireID();
+            cell1.material = materials->getOilFireID();
             cell1.temperature = 700.0f;  // Extra hot
             cell1.setFlag(Cell::FLAG_BURNING);
             cell1.lifetime = static_cast<uint8_t>(120);  // Long-lasting oil fire from lava
@@ -413,10 +405,10 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
             return true;
         }
         // Handle sand - lava should melt sand to more lava
-        else if (cell1.material == materialRegistry->getSandID()) {
+        else if (cell1.material == materials->getSandID()) {
             // Sand melts into lava when touching lava
-            if (rollProbability(0.6f * deltaTime * 10.0f)) {
-                cell1.material = materialRegistry->getLavaID();
+            if (random.rollProbability(0.6f * deltaTime * 10.0f)) {
+                cell1.material = materials->getLavaID();
                 cell1.temperature = 1000.0f;
                 return true;
             }
@@ -424,13 +416,13 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
         // Normal handling for other flammable materials
         else if (props1.flammable) {
             // Lava ignites flammable materials with high probability
-            if (rollProbability(0.7f * deltaTime * 10.0f)) {  // Higher probability for more predictable behavior
+            if (random.rollProbability(0.7f * deltaTime * 10.0f)) {  // Higher probability for more predictable behavior
                 // Convert to fire based on material type
                 if (props1.name == "Oil") {
-                    cell1.material = materialRegistry->getOilFireID();
+                    cell1.material = materials->getOilFireID();
                     cell1.temperature = 650.0f;
                 } else {
-                    cell1.material = materialRegistry->getFireID();
+                    cell1.material = materials->getFireID();
                     cell1.temperature = 550.0f;
                 }
                 cell1.setFlag(Cell::FLAG_BURNING);
@@ -441,26 +433,26 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
         // Lava damages and eventually melts non-flammable materials (except stone)
         else if (props1.name != "Stone" && props1.name != "Lava" && props1.name != "Air") {
             // More aggressive damage rate for predictable gameplay
-            if (rollProbability(0.4f * deltaTime * 10.0f)) {
+            if (random.rollProbability(0.4f * deltaTime * 10.0f)) {
                 cell1.health -= 0.2f;  // Double the damage rate
                 cell1.temperature += 50.0f;  // Heat up the material
                 
                 if (cell1.health <= 0.0f) {
                     // Higher chance of creating lava instead of just destruction
-                    if (rollProbability(0.6f)) {
+                    if (random.rollProbability(0.6f)) {
                         // Convert destroyed material to lava
-                        cell1.material = materialRegistry->getLavaID();
+                        cell1.material = materials->getLavaID();
                         cell1.temperature = 1000.0f;
                     } 
                     // Sometimes create smoke for effect
-                    else if (rollProbability(0.5f)) {
-                        cell1.material = materialRegistry->getSmokeID();
+                    else if (random.rollProbability(0.5f)) {
+                        cell1.material = materials->getSmokeID();
                         cell1.temperature = 200.0f;
                         cell1.lifetime = 60;
                     } 
                     // Otherwise just replace with air
                     else {
-                        cell1.material = materialRegistry->getDefaultMaterialID();
+                        cell1.material = materials->getDefaultMaterialID();
                     }
                     return true;
                 }
@@ -471,7 +463,7 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
     for (const auto& reaction : props1.reactions) {
         if (reaction.reactantMaterial == cell2.material) {
             // Apply probability check
-            if (rollProbability(reaction.probability * deltaTime * 10.0f)) {
+            if (random.rollProbability(reaction.probability * deltaTime * 10.0f)) {
                 // Store original target material for byproduct handling
                 MaterialID originalMaterial = cell2.material;
                 
@@ -487,7 +479,7 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
                     cell2.material = reaction.byproduct;
                     
                     // Set appropriate temperatures based on materials
-                    const MaterialProperties& byproductProps = materialRegistry->getMaterial(reaction.byproduct);
+                    const MaterialProperties& byproductProps = materials->getMaterial(reaction.byproduct);
                     
                     // Lava/water reaction special case
                     if (props1.name.find("Water") != std::string::npos && 
@@ -507,7 +499,7 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
                 }
                 
                 // Set appropriate flag based on material properties
-                const MaterialProperties& resultProps = materialRegistry->getMaterial(reaction.resultMaterial);
+                const MaterialProperties& resultProps = materials->getMaterial(reaction.resultMaterial);
                 if (resultProps.hasFlag(MaterialProperties::Flags::HOT)) {
                     cell1.setFlag(Cell::FLAG_BURNING);
                 }
@@ -520,18 +512,18 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
     // Special case: Fire and flammable materials
     if (props1.type == MaterialType::FIRE && props2.flammable) {
         // Check which type of fire (regular or oil fire)
-        bool isOilFire = (cell1.material == materialRegistry->getOilFireID());
+        bool isOilFire = (cell1.material == materials->getOilFireID());
         float ignitionMultiplier = isOilFire ? 8.0f : 5.0f;  // Oil fire ignites materials more aggressively
         
         // Special treatment for wood - it should burn in place rather than immediately turning to fire
-        if (cell2.material == materialRegistry->getWoodID()) {
+        if (cell2.material == materials->getWoodID()) {
             // Wood should burn, but slowly enough to spread properly
             
             // If this wood is already burning, check if it will spread to other wood neighbors first
             if (cell2.hasFlag(Cell::FLAG_BURNING)) {
                 // Burning wood has a high chance to spread to adjacent wood blocks
                 // This is critical for proper fire propagation through wooden structures
-                if (rollProbability(0.4f * deltaTime * 10.0f)) {
+                if (random.rollProbability(0.4f * deltaTime * 10.0f)) {
                     // Try to find adjacent wood cells to spread to
                     // Note: We're using a dummy implementation here because the actual implementation 
                     // would require access to the world grid to find true adjacent cells
@@ -545,7 +537,7 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
             
             // Basic burning process - wood should burn VERY slowly
             // Real wood takes minutes to hours to burn - we need to simulate this in accelerated time
-            if (rollProbability(0.07f * deltaTime * 10.0f)) {  // Drastically reduced probability for much slower burn
+            if (random.rollProbability(0.07f * deltaTime * 10.0f)) {  // Drastically reduced probability for much slower burn
                 // Reduce wood health as it burns, at an extremely slow rate
                 cell2.health -= 0.003f;  // Extremely slow burn rate
                 
@@ -555,59 +547,27 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
                 // Make the wood hot - even hotter to ensure proper fire spread
                 cell2.temperature = std::max(cell2.temperature, 400.0f);
                 
-                // Burning wood has a much higher chance to generate fire and smoke
-                // Make sure there's always visible fire coming from burning wood
-                if (rollProbability(0.6f)) {  // Increased from 0.2f to 0.6f
-                    // Generate smoke and flames around the wood as it burns
-                    
-                    // 80% chance of creating fire vs 20% smoke - prioritize visible flames
-                    if (rollProbability(0.8f)) {
-                        // Try to add some fire effects to empty cells
-                        Cell* neighborCell = getAdjacentCell(cell2, 0, -1); // Try above first
-                        if (neighborCell && neighborCell->material == materialRegistry->getDefaultMaterialID()) {
-                            neighborCell->material = materialRegistry->getFireID();
-                            neighborCell->temperature = 500.0f;  // Hotter fire
-                            neighborCell->setFlag(Cell::FLAG_BURNING);
-                            neighborCell->lifetime = static_cast<uint8_t>(50 + getRandomInt(0, 20)); // Longer lasting fire
-                            
-                            // To make the fire more visibly active, give it an upward velocity
-                            neighborCell->velocity.y = -0.5f; // Upward movement
-                        }
-                    } else {
-                        // Try to add some smoke effects to empty cells 
-                        Cell* neighborCell = getAdjacentCell(cell2, 0, -1); // Try above first
-                        if (neighborCell && neighborCell->material == materialRegistry->getDefaultMaterialID()) {
-                            neighborCell->material = materialRegistry->getSmokeID();
-                            neighborCell->temperature = 150.0f;  // Hotter smoke
-                            neighborCell->lifetime = static_cast<uint8_t>(70 + getRandomInt(0, 20)); // Longer lasting smoke
-                            
-                            // To make the smoke rise more visibly
-                            neighborCell->velocity.y = -0.3f; // Upward movement
-                        }
-                    }
-                }
-                
                 // When wood is completely burned, it turns to fire and then quickly to ash
                 if (cell2.health <= 0.0f) {
-                    cell2.material = materialRegistry->getFireID();
+                    cell2.material = materials->getFireID();
                     cell2.temperature = 400.0f;
-                    cell2.lifetime = static_cast<uint8_t>(25 + getRandomInt(-5, 5));
+                    cell2.lifetime = static_cast<uint8_t>(25 + random.getRandomInt(-5, 5));
                 }
                 
                 return true;
             }
         } 
         // Regular ignition for other materials
-        else if (rollProbability(props2.flammability * deltaTime * ignitionMultiplier)) {
+        else if (random.rollProbability(props2.flammability * deltaTime * ignitionMultiplier)) {
             // Oil ignites INSTANTLY and always (100% chance) when in contact with fire or lava
-            if (cell2.material == materialRegistry->getOilID()) {
-                cell2.material = materialRegistry->getOilFireID();
+            if (cell2.material == materials->getOilID()) {
+                cell2.material = materials->getOilFireID();
                 cell2.temperature = std::max(cell2.temperature, 650.0f);
                 // Make oil fire spread to nearby oil more aggressively
                 cell2.temperature += 50.0f;  // Extra hot to ignite nearby oil
                 cell2.energy += 50.0f;       // Extra energy for stronger fire
             } else {
-                cell2.material = materialRegistry->getFireID();
+                cell2.material = materials->getFireID();
                 cell2.temperature = std::max(cell2.temperature, 500.0f);
             }
             
@@ -615,14 +575,14 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
             
             // Adjust lifetime based on material type
             float lifetimeScale = 1.0f;
-            if (cell2.material == materialRegistry->getOilID()) {
+            if (cell2.material == materials->getOilID()) {
                 lifetimeScale = 2.0f;  // Oil burns longer
             }
             
             cell2.lifetime = static_cast<uint8_t>(props2.burnRate * 200.0f * lifetimeScale);
             
             // Generate smoke occasionally during ignition
-            if (rollProbability(0.1f)) {
+            if (random.rollProbability(0.1f)) {
                 cell2.temperature += 20.0f;  // Extra heat from combustion
             }
             
@@ -631,18 +591,18 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
     }
     else if (props2.type == MaterialType::FIRE && props1.flammable) {
         // Check which type of fire (regular or oil fire)
-        bool isOilFire = (cell2.material == materialRegistry->getOilFireID());
+        bool isOilFire = (cell2.material == materials->getOilFireID());
         float ignitionMultiplier = isOilFire ? 8.0f : 5.0f;  // Oil fire ignites materials more aggressively
         
         // Special treatment for wood - it should burn in place rather than immediately turning to fire
-        if (cell1.material == materialRegistry->getWoodID()) {
+        if (cell1.material == materials->getWoodID()) {
             // Wood should burn, but slowly enough to spread properly
             
             // If this wood is already burning, check if it will spread to other wood neighbors first
             if (cell1.hasFlag(Cell::FLAG_BURNING)) {
                 // Burning wood has a high chance to spread to adjacent wood blocks
                 // This is critical for proper fire propagation through wooden structures
-                if (rollProbability(0.4f * deltaTime * 10.0f)) {
+                if (random.rollProbability(0.4f * deltaTime * 10.0f)) {
                     // Try to find adjacent wood cells to spread to
                     // Note: We're using a dummy implementation here because the actual implementation 
                     // would require access to the world grid to find true adjacent cells
@@ -656,7 +616,7 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
             
             // Basic burning process - wood should burn VERY slowly
             // Real wood takes minutes to hours to burn - we need to simulate this in accelerated time
-            if (rollProbability(0.07f * deltaTime * 10.0f)) {  // Drastically reduced probability for much slower burn
+            if (random.rollProbability(0.07f * deltaTime * 10.0f)) {  // Drastically reduced probability for much slower burn
                 // Reduce wood health as it burns, at an extremely slow rate
                 cell1.health -= 0.003f;  // Extremely slow burn rate
                 
@@ -666,59 +626,27 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
                 // Make the wood hot - even hotter to ensure proper fire spread
                 cell1.temperature = std::max(cell1.temperature, 400.0f);
                 
-                // Burning wood has a much higher chance to generate fire and smoke
-                // Make sure there's always visible fire coming from burning wood
-                if (rollProbability(0.6f)) {  // Increased from 0.2f to 0.6f
-                    // Generate smoke and flames around the wood as it burns
-                    
-                    // 80% chance of creating fire vs 20% smoke - prioritize visible flames
-                    if (rollProbability(0.8f)) {
-                        // Try to add some fire effects to empty cells
-                        Cell* neighborCell = getAdjacentCell(cell1, 0, -1); // Try above first
-                        if (neighborCell && neighborCell->material == materialRegistry->getDefaultMaterialID()) {
-                            neighborCell->material = materialRegistry->getFireID();
-                            neighborCell->temperature = 500.0f;  // Hotter fire
-                            neighborCell->setFlag(Cell::FLAG_BURNING);
-                            neighborCell->lifetime = static_cast<uint8_t>(50 + getRandomInt(0, 20)); // Longer lasting fire
-                            
-                            // To make the fire more visibly active, give it an upward velocity
-                            neighborCell->velocity.y = -0.5f; // Upward movement
-                        }
-                    } else {
-                        // Try to add some smoke effects to empty cells
-                        Cell* neighborCell = getAdjacentCell(cell1, 0, -1); // Try above first
-                        if (neighborCell && neighborCell->material == materialRegistry->getDefaultMaterialID()) {
-                            neighborCell->material = materialRegistry->getSmokeID();
-                            neighborCell->temperature = 150.0f;  // Hotter smoke
-                            neighborCell->lifetime = static_cast<uint8_t>(70 + getRandomInt(0, 20)); // Longer lasting smoke
-                            
-                            // To make the smoke rise more visibly
-                            neighborCell->velocity.y = -0.3f; // Upward movement
-                        }
-                    }
-                }
-                
                 // When wood is completely burned, it turns to fire and then quickly to ash
                 if (cell1.health <= 0.0f) {
-                    cell1.material = materialRegistry->getFireID();
+                    cell1.material = materials->getFireID();
                     cell1.temperature = 400.0f;
-                    cell1.lifetime = static_cast<uint8_t>(25 + getRandomInt(-5, 5));
+                    cell1.lifetime = static_cast<uint8_t>(25 + random.getRandomInt(-5, 5));
                 }
                 
                 return true;
             }
         } 
         // Regular ignition for other materials
-        else if (rollProbability(props1.flammability * deltaTime * ignitionMultiplier)) {
+        else if (random.rollProbability(props1.flammability * deltaTime * ignitionMultiplier)) {
             // Oil ignites INSTANTLY and always (100% chance) when in contact with fire or lava
-            if (cell1.material == materialRegistry->getOilID()) {
-                cell1.material = materialRegistry->getOilFireID();
+            if (cell1.material == materials->getOilID()) {
+                cell1.material = materials->getOilFireID();
                 cell1.temperature = std::max(cell1.temperature, 650.0f);
                 // Make oil fire spread to nearby oil more aggressively
                 cell1.temperature += 50.0f;  // Extra hot to ignite nearby oil
                 cell1.energy += 50.0f;       // Extra energy for stronger fire
             } else {
-                cell1.material = materialRegistry->getFireID();
+                cell1.material = materials->getFireID();
                 cell1.temperature = std::max(cell1.temperature, 500.0f);
             }
             
@@ -726,14 +654,14 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
             
             // Adjust lifetime based on material type
             float lifetimeScale = 1.0f;
-            if (cell1.material == materialRegistry->getOilID()) {
+            if (cell1.material == materials->getOilID()) {
                 lifetimeScale = 2.0f;  // Oil burns longer
             }
             
             cell1.lifetime = static_cast<uint8_t>(props1.burnRate * 200.0f * lifetimeScale);
             
             // Generate smoke occasionally during ignition
-            if (rollProbability(0.1f)) {
+            if (random.rollProbability(0.1f)) {
                 cell1.temperature += 20.0f;  // Extra heat from combustion
             }
             
@@ -747,12 +675,12 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
         props2.name.find("Water") != std::string::npos) {
         
         // Oil fire is harder to extinguish with water
-        bool isOilFire = (cell1.material == materialRegistry->getOilFireID());
+        bool isOilFire = (cell1.material == materials->getOilFireID());
         float extinguishProbability = isOilFire ? 0.4f : 0.8f;
         
-        if (rollProbability(extinguishProbability * deltaTime * 10.0f)) {
+        if (random.rollProbability(extinguishProbability * deltaTime * 10.0f)) {
             // Convert to smoke
-            cell1.material = materialRegistry->getSmokeID();
+            cell1.material = materials->getSmokeID();
             cell1.clearFlag(Cell::FLAG_BURNING);
             
             // Oil fire produces more steam/smoke and hotter water
@@ -762,8 +690,8 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
                 cell2.temperature += 40.0f; // Water heats up more from oil fire
                 
                 // Small chance of steam generation from the hot water
-                if (rollProbability(0.3f)) {
-                    cell2.material = materialRegistry->getSteamID();
+                if (random.rollProbability(0.3f)) {
+                    cell2.material = materials->getSteamID();
                     cell2.temperature = 110.0f;
                 }
             } else {
@@ -780,12 +708,12 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
              props1.name.find("Water") != std::string::npos) {
         
         // Oil fire is harder to extinguish with water
-        bool isOilFire = (cell2.material == materialRegistry->getOilFireID());
+        bool isOilFire = (cell2.material == materials->getOilFireID());
         float extinguishProbability = isOilFire ? 0.4f : 0.8f;
         
-        if (rollProbability(extinguishProbability * deltaTime * 10.0f)) {
+        if (random.rollProbability(extinguishProbability * deltaTime * 10.0f)) {
             // Convert to smoke
-            cell2.material = materialRegistry->getSmokeID();
+            cell2.material = materials->getSmokeID();
             cell2.clearFlag(Cell::FLAG_BURNING);
             
             // Oil fire produces more steam/smoke and hotter water
@@ -795,8 +723,8 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
                 cell1.temperature += 40.0f; // Water heats up more from oil fire
                 
                 // Small chance of steam generation from the hot water
-                if (rollProbability(0.3f)) {
-                    cell1.material = materialRegistry->getSteamID();
+                if (random.rollProbability(0.3f)) {
+                    cell1.material = materials->getSteamID();
                     cell1.temperature = 110.0f;
                 }
             } else {
@@ -811,19 +739,19 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
     
     // Acid dissolving materials
     if (props1.name.find("Acid") != std::string::npos && props2.type == MaterialType::SOLID) {
-        if (rollProbability(0.2f * deltaTime * 5.0f)) {
+        if (random.rollProbability(0.2f * deltaTime * 5.0f)) {
             cell2.health -= 0.2f * deltaTime * 5.0f;
             if (cell2.health <= 0.0f) {
-                cell2.material = materialRegistry->getDefaultMaterialID(); // Dissolved to nothing
+                cell2.material = materials->getDefaultMaterialID(); // Dissolved to nothing
             }
             return true;
         }
     }
     else if (props2.name.find("Acid") != std::string::npos && props1.type == MaterialType::SOLID) {
-        if (rollProbability(0.2f * deltaTime * 5.0f)) {
+        if (random.rollProbability(0.2f * deltaTime * 5.0f)) {
             cell1.health -= 0.2f * deltaTime * 5.0f;
             if (cell1.health <= 0.0f) {
-                cell1.material = materialRegistry->getDefaultMaterialID(); // Dissolved to nothing
+                cell1.material = materials->getDefaultMaterialID(); // Dissolved to nothing
             }
             return true;
         }
@@ -832,14 +760,32 @@ bool CellProcessor::processPotentialReaction(Cell& cell1, Cell& cell2, float del
     return false;
 }
 
-void CellProcessor::processStateChange(Cell& cell, float deltaTime)
+void CellProcessor::applyDecay(Cell& cell, CellRandom& random) const
+{
+    const DecayRule& rule = materials->getDecayRule(cell.material);
+    applyDecay(cell, rule.lifetimeJitter ? random.getRandomInt(0, rule.lifetimeJitter) : 0);
+}
+
+void CellProcessor::applyDecay(Cell& cell, int lifetimeJitter) const
+{
+    const DecayRule& rule = materials->getDecayRule(cell.material);
+    cell.material = rule.product;
+    cell.clearFlag(Cell::FLAG_BURNING);
+    if (rule.temperature >= 0.0f) {
+        cell.temperature = rule.temperature;
+    }
+    cell.lifetime = static_cast<uint8_t>(rule.lifetime + std::clamp(lifetimeJitter, 0, static_cast<int>(rule.lifetimeJitter)));
+    cell.metadata = rule.metadata;
+}
+
+void CellProcessor::processStateChange(Cell& cell, float deltaTime, CellRandom& random) const
 {
     // Skip empty cells
-    if (cell.material == materialRegistry->getDefaultMaterialID()) {
+    if (cell.material == materials->getDefaultMaterialID()) {
         return;
     }
     
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materials->getMaterial(cell.material);
     
     // Process lifetime for temporary materials
     if (props.lifetime > 0.0f) {
@@ -847,12 +793,12 @@ void CellProcessor::processStateChange(Cell& cell, float deltaTime)
         if (cell.lifetime == 0) {
             // Material has decayed, transform to its decay product
             if (props.type == MaterialType::FIRE) {
-                cell.material = materialRegistry->getSmokeID();
+                cell.material = materials->getSmokeID();
                 cell.temperature = std::max(100.0f, cell.temperature * 0.5f);
                 cell.clearFlag(Cell::FLAG_BURNING);
             }
             else if (props.type == MaterialType::GAS) {
-                cell.material = materialRegistry->getDefaultMaterialID(); // Gas dissipates
+                cell.material = materials->getDefaultMaterialID(); // Gas dissipates
             }
             return;
         }
@@ -873,7 +819,7 @@ void CellProcessor::processStateChange(Cell& cell, float deltaTime)
         }
         
         // Apply probability check
-        if (conditionMet && rollProbability(stateChange.probability * deltaTime * 5.0f)) {
+        if (conditionMet && random.rollProbability(stateChange.probability * deltaTime * 5.0f)) {
             // Apply the state change
             MaterialID oldMaterial = cell.material;
             
@@ -883,7 +829,7 @@ void CellProcessor::processStateChange(Cell& cell, float deltaTime)
                 cell.material = stateChange.targetMaterial;
             } else {
                 // Invalid ID - use Air instead
-                cell.material = materialRegistry->getDefaultMaterialID(); // Air (0)
+                cell.material = materials->getDefaultMaterialID(); // Air (0)
             }
             
             // Initialize the new material properties
@@ -903,14 +849,14 @@ void CellProcessor::transferHeat(Cell& sourceCell, Cell& targetCell, float delta
 {
     // Skip if cells are the same or if either is empty
     if (&sourceCell == &targetCell || 
-        sourceCell.material == materialRegistry->getDefaultMaterialID() || 
-        targetCell.material == materialRegistry->getDefaultMaterialID()) {
+        sourceCell.material == materials->getDefaultMaterialID() || 
+        targetCell.material == materials->getDefaultMaterialID()) {
         return;
     }
     
     // Get material properties
-    const MaterialProperties& sourceProps = materialRegistry->getMaterial(sourceCell.material);
-    const MaterialProperties& targetProps = materialRegistry->getMaterial(targetCell.material);
+    const MaterialProperties& sourceProps = materials->getMaterial(sourceCell.material);
+    const MaterialProperties& targetProps = materials->getMaterial(targetCell.material);
     
     // Calculate temperature difference
     float tempDiff = sourceCell.temperature - targetCell.temperature;
@@ -981,10 +927,10 @@ void CellProcessor::transferHeat(Cell& sourceCell, Cell& targetCell, float delta
     */
 }
 
-bool CellProcessor::checkStateChangeByTemperature(Cell& cell)
+bool CellProcessor::checkStateChangeByTemperature(Cell& cell) const
 {
     // Get material properties
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materials->getMaterial(cell.material);
     
     // Check melting point (solid to liquid)
     if (props.type == MaterialType::SOLID && props.meltingPoint > 0 && 
@@ -992,7 +938,7 @@ bool CellProcessor::checkStateChangeByTemperature(Cell& cell)
         
         // Find appropriate liquid form of this material
         for (const auto& stateChange : props.stateChanges) {
-            const MaterialProperties& targetProps = materialRegistry->getMaterial(stateChange.targetMaterial);
+            const MaterialProperties& targetProps = materials->getMaterial(stateChange.targetMaterial);
             if (targetProps.type == MaterialType::LIQUID) {
                 cell.material = stateChange.targetMaterial;
                 return true;
@@ -1006,7 +952,7 @@ bool CellProcessor::checkStateChangeByTemperature(Cell& cell)
         
         // Find appropriate solid form of this material
         for (const auto& stateChange : props.stateChanges) {
-            const MaterialProperties& targetProps = materialRegistry->getMaterial(stateChange.targetMaterial);
+            const MaterialProperties& targetProps = materials->getMaterial(stateChange.targetMaterial);
             if (targetProps.type == MaterialType::SOLID) {
                 cell.material = stateChange.targetMaterial;
                 return true;
@@ -1020,7 +966,7 @@ bool CellProcessor::checkStateChangeByTemperature(Cell& cell)
         
         // Find appropriate gas form of this material
         for (const auto& stateChange : props.stateChanges) {
-            const MaterialProperties& targetProps = materialRegistry->getMaterial(stateChange.targetMaterial);
+            const MaterialProperties& targetProps = materials->getMaterial(stateChange.targetMaterial);
             if (targetProps.type == MaterialType::GAS) {
                 cell.material = stateChange.targetMaterial;
                 return true;
@@ -1034,7 +980,7 @@ bool CellProcessor::checkStateChangeByTemperature(Cell& cell)
         
         // Find appropriate liquid form of this material
         for (const auto& stateChange : props.stateChanges) {
-            const MaterialProperties& targetProps = materialRegistry->getMaterial(stateChange.targetMaterial);
+            const MaterialProperties& targetProps = materials->getMaterial(stateChange.targetMaterial);
             if (targetProps.type == MaterialType::LIQUID) {
                 cell.material = stateChange.targetMaterial;
                 return true;
@@ -1047,16 +993,16 @@ bool CellProcessor::checkStateChangeByTemperature(Cell& cell)
         cell.temperature >= props.ignitionPoint) {
         
         // Only convert to fire if material is not wood
-        if (props.name != "Wood" && cell.material != materialRegistry->getWoodID()) {
+        if (props.name != "Wood" && cell.material != materials->getWoodID()) {
             // Set burning flag
             cell.setFlag(Cell::FLAG_BURNING);
             
             // For oil, use oil fire
-            if (props.name == "Oil" || cell.material == materialRegistry->getOilID()) {
-                cell.material = materialRegistry->getOilFireID();
+            if (props.name == "Oil" || cell.material == materials->getOilID()) {
+                cell.material = materials->getOilFireID();
             } else {
                 // Verify material ID is valid
-                MaterialID fireID = materialRegistry->getFireID();
+                MaterialID fireID = materials->getFireID();
                 if (fireID > 0 && fireID <= 100) {
                     cell.material = fireID;
                 }
@@ -1075,10 +1021,10 @@ bool CellProcessor::checkStateChangeByTemperature(Cell& cell)
     return false;
 }
 
-void CellProcessor::applyVelocity(Cell& cell, const glm::vec2& direction, float speed)
+void CellProcessor::applyVelocity(Cell& cell, const glm::vec2& direction, float speed) const
 {
     // Get material properties
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materials->getMaterial(cell.material);
     
     // Adjust speed based on material properties
     float adjustedSpeed = speed;
@@ -1108,10 +1054,10 @@ void CellProcessor::applyVelocity(Cell& cell, const glm::vec2& direction, float
     cell.velocity = normalizedDir * adjustedSpeed;
 }
 
-void CellProcessor::applyPressure(Cell& cell, float amount)
+void CellProcessor::applyPressure(Cell& cell, float amount) const
 {
     // Only apply pressure to materials that can be pressurized
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materials->getMaterial(cell.material);
     
     if (props.type == MaterialType::LIQUID || props.type == MaterialType::GAS) {
         cell.pressure += amount;
@@ -1130,14 +1076,14 @@ void CellProcessor::applyPressure(Cell& cell, float amount)
     }
 }
 
-void CellProcessor::damageCell(Cell& cell, float amount)
+void CellProcessor::damageCell(Cell& cell, float amount) const
 {
     // Apply damage to cell health
     cell.health = std::max(0.0f, cell.health - amount);
     
     // If health is depleted, handle destruction
     if (cell.health <= 0.0f) {
-        const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+        const MaterialProperties& props = materials->getMaterial(cell.material);
         
         // Different materials break/destroy differently
         switch (props.type) {
@@ -1145,35 +1091,35 @@ void CellProcessor::damageCell(Cell& cell, float amount)
                 // Solids can break into powders or disappear
                 if (props.name.find("Stone") != std::string::npos || 
                     props.name.find("Rock") != std::string::npos) {
-                    cell.material = materialRegistry->getSandID(); // Rock breaks to sand
+                    cell.material = materials->getSandID(); // Rock breaks to sand
                 } else {
-                    cell.material = materialRegistry->getDefaultMaterialID(); // Disappear
+                    cell.material = materials->getDefaultMaterialID(); // Disappear
                 }
                 break;
                 
             case MaterialType::POWDER:
                 // Powders can compact or disperse
-                cell.material = materialRegistry->getDefaultMaterialID();
+                cell.material = materials->getDefaultMaterialID();
                 break;
                 
             case MaterialType::LIQUID:
                 // Liquids typically evaporate
-                cell.material = materialRegistry->getDefaultMaterialID();
+                cell.material = materials->getDefaultMaterialID();
                 break;
                 
             case MaterialType::GAS:
                 // Gases dissipate
-                cell.material = materialRegistry->getDefaultMaterialID();
+                cell.material = materials->getDefaultMaterialID();
                 break;
                 
             case MaterialType::FIRE:
                 // Fire extinguishes
-                cell.material = materialRegistry->getSmokeID();
+                cell.material = materials->getSmokeID();
                 cell.clearFlag(Cell::FLAG_BURNING);
                 break;
                 
             default:
-                cell.material = materialRegistry->getDefaultMaterialID();
+                cell.material = materials->getDefaultMaterialID();
                 break;
         }
         
@@ -1184,17 +1130,17 @@ void CellProcessor::damageCell(Cell& cell, float amount)
     }
 }
 
-void CellProcessor::igniteCell(Cell& cell)
+void CellProcessor::igniteCell(Cell& cell, CellRandom& random) const
 {
     // Check if material is flammable
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materials->getMaterial(cell.material);
     
     if (props.flammable) {
         // Convert to fire based on material type
         MaterialID oldMaterial = cell.material;
         
         // Handle wood specially - wood stays as wood but gets the burning flag
-        if (oldMaterial == materialRegistry->getWoodID() || props.name == "Wood") {
+        if (oldMaterial == materials->getWoodID() || props.name == "Wood") {
             // Just set the burning flag, don't change material
             cell.setFlag(Cell::FLAG_BURNING);
             std::cout << "WOOD IGNITED: Burning flag set, material unchanged" << std::endl;
@@ -1202,12 +1148,12 @@ void CellProcessor::igniteCell(Cell& cell)
         }
         
         // Special case for oil - it creates oil fire
-        if (oldMaterial == materialRegistry->getOilID() || props.name == "Oil") {
+        if (oldMaterial == materials->getOilID() || props.name == "Oil") {
             std::cout << "OIL IGNITED: Converting to oil fire" << std::endl;
-            cell.material = materialRegistry->getOilFireID();
+            cell.material = materials->getOilFireID();
         } else {
             // Regular fire for everything else - ensure ID is valid first
-            MaterialID fireID = materialRegistry->getFireID();
+            MaterialID fireID = materials->getFireID();
             if (fireID > 0 && fireID <= 100) {
                 cell.material = fireID;
             } else {
@@ -1220,7 +1166,7 @@ void CellProcessor::igniteCell(Cell& cell)
         
         // Fire lifetime based on burn rate of original material
         float lifetimeScale = 1.0f;
-        if (oldMaterial == materialRegistry->getOilID()) {
+        if (oldMaterial == materials->getOilID()) {
             lifetimeScale = 2.0f;  // Oil burns longer
         }
         
@@ -1230,7 +1176,7 @@ void CellProcessor::igniteCell(Cell& cell)
         cell.energy = props.flammability * 100.0f;
         
         // Smoke production starts with the ignition
-        if (getRandomFloat(0.0f, 1.0f) < 0.2f) {
+        if (random.getRandomFloat(0.0f, 1.0f) < 0.2f) {
             // Occasionally spawn smoke particles above the fire
             cell.temperature += 20.0f;  // Extra heat boost from the combustion
         }
@@ -1241,14 +1187,14 @@ void CellProcessor::igniteCell(Cell& cell)
     }
 }
 
-void CellProcessor::extinguishCell(Cell& cell)
+void CellProcessor::extinguishCell(Cell& cell) const
 {
     // Check if cell is on fire
     if (cell.hasFlag(Cell::FLAG_BURNING) || 
-        materialRegistry->getMaterial(cell.material).type == MaterialType::FIRE) {
+        materials->getMaterial(cell.material).type == MaterialType::FIRE) {
         
         // Convert fire to smoke
-        cell.material = materialRegistry->getSmokeID();
+        cell.material = materials->getSmokeID();
         cell.clearFlag(Cell::FLAG_BURNING);
         
         // Base temperature and lifetime for smoke
@@ -1256,7 +1202,7 @@ void CellProcessor::extinguishCell(Cell& cell)
         uint8_t smokeLifetime = 100;
         
         // Oil fires produce denser, hotter smoke that lasts longer
-        if (cell.material == materialRegistry->getOilFireID()) {
+        if (cell.material == materials->getOilFireID()) {
             smokeTemp = 130.0f;
             smokeLifetime = 150;
             
@@ -1269,16 +1215,16 @@ void CellProcessor::extinguishCell(Cell& cell)
     }
 }
 
-void CellProcessor::freezeCell(Cell& cell)
+void CellProcessor::freezeCell(Cell& cell) const
 {
     // Check if material can freeze
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materials->getMaterial(cell.material);
     
     if (props.type == MaterialType::LIQUID && props.freezingPoint > 0) {
         // Find an appropriate solid version
         for (const auto& stateChange : props.stateChanges) {
             if (stateChange.temperatureThreshold < 0) { // Negative threshold for freezing
-                const MaterialProperties& targetProps = materialRegistry->getMaterial(stateChange.targetMaterial);
+                const MaterialProperties& targetProps = materials->getMaterial(stateChange.targetMaterial);
                 if (targetProps.type == MaterialType::SOLID) {
                     // Apply the freeze
                     cell.material = stateChange.targetMaterial;
@@ -1299,16 +1245,16 @@ void CellProcessor::freezeCell(Cell& cell)
     }
 }
 
-void CellProcessor::meltCell(Cell& cell)
+void CellProcessor::meltCell(Cell& cell) const
 {
     // Check if material can melt
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materials->getMaterial(cell.material);
     
     if (props.type == MaterialType::SOLID && props.meltingPoint > 0) {
         // Find an appropriate liquid version
         for (const auto& stateChange : props.stateChanges) {
             if (stateChange.temperatureThreshold > 0) { // Positive threshold for melting
-                const MaterialProperties& targetProps = materialRegistry->getMaterial(stateChange.targetMaterial);
+                const MaterialProperties& targetProps = materials->getMaterial(stateChange.targetMaterial);
                 if (targetProps.type == MaterialType::LIQUID) {
                     // Apply the melt
                     cell.material = stateChange.targetMaterial;
@@ -1329,10 +1275,10 @@ void CellProcessor::meltCell(Cell& cell)
     }
 }
 
-void CellProcessor::dissolveCell(Cell& cell, float rate)
+void CellProcessor::dissolveCell(Cell& cell, float rate) const
 {
     // Check if material can dissolve - in our simplified system, we use CORROSIVE flag
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materials->getMaterial(cell.material);
     
     // Use corrosive flag instead of dissolves property
     if (props.hasFlag(MaterialProperties::Flags::CORROSIVE)) {
@@ -1343,79 +1289,11 @@ void CellProcessor::dissolveCell(Cell& cell, float rate)
         
         // Check if completely dissolved
         if (cell.health <= 0.0f) {
-            cell.material = materialRegistry->getDefaultMaterialID();
+            cell.material = materials->getDefaultMaterialID();
             cell.health = 1.0f;
             cell.clearFlag(Cell::FLAG_DISSOLVING);
         }
     }
 }
 
-Cell* CellProcessor::getAdjacentCell(const Cell& cell, int dx, int dy)
-{
-    // This is a placeholder implementation because we don't have access to the world grid here
-    // In a real implementation, we would need to get the coordinates of the current cell
-    // and return a pointer to the adjacent cell at (x+dx, y+dy)
-    
-    // Since we don't have direct access to the world coordinates or grid from the CellProcessor,
-    // we'll use a dummy approach just to make the code compile
-    
-    // CRITICAL: Use a NEW dummyCell each time to avoid memory corruption
-    // This prevents issues with invalid material IDs
-    static Cell dummyCell1; // For up direction
-    static Cell dummyCell2; // For down direction
-    static Cell dummyCell3; // For left direction
-    static Cell dummyCell4; // For right direction
-    
-    // We'll return null for diagonal cells
-    if (dx != 0 && dy != 0) {
-        return nullptr;
-    }
-    
-    // Only allow cardinal directions
-    // Use a different static cell for each direction to prevent corruption
-    if (dy < 0 && dx == 0) { // Up
-        // Reset cell to valid state
-        dummyCell1 = Cell(); // Reset to default state with valid IDs
-        dummyCell1.material = materialRegistry->getDefaultMaterialID(); // Air
-        return &dummyCell1;
-    } 
-    else if (dy > 0 && dx == 0) { // Down
-        dummyCell2 = Cell(); // Reset completely
-        dummyCell2.material = materialRegistry->getDefaultMaterialID();
-        return &dummyCell2;
-    }
-    else if (dx < 0 && dy == 0) { // Left
-        dummyCell3 = Cell(); // Reset completely
-        dummyCell3.material = materialRegistry->getDefaultMaterialID();
-        return &dummyCell3;
-    }
-    else if (dx > 0 && dy == 0) { // Right
-        dummyCell4 = Cell(); // Reset completely
-        dummyCell4.material = materialRegistry->getDefaultMaterialID();
-        return &dummyCell4;
-    }
-    
-    // Otherwise return null
-    return nullptr;
-}
-
-float CellProcessor::getRandomFloat(float min, float max) const
-{
-    std::uniform_real_distribution<float> dist(min, max);
-    return dist(random);
-}
-
-int CellProcessor::getRandomInt(int min, int max) const
-{
-    std::uniform_int_distribution<int> dist(min, max);
-    return dist(random);
-}
-
-bool CellProcessor::rollProbability(float chance) const
-{
-    // Ensure chance is between 0 and 1
-    chance = std::max(0.0f, std::min(1.0f, chance));
-    return getRandomFloat(0.0f, 1.0f) < chance;
-}
-
-} // namespace astral
\ No newline at end of file
+} // namespace astral
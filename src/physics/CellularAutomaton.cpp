@@ -1,8 +1,14 @@
 #include "astral/physics/CellularAutomaton.h"
 #include "astral/physics/CellProcessor.h"
+#include "astral/core/Profiler.h"
+#include "astral/core/TickWatchdog.h"
+#include "astral/physics/RegionFile.h"
+#include "astral/physics/WorldAutosave.h"
+#include <atomic>
 #include <random>
 #include <chrono>
 #include <cmath>
+#include <cstdio>
 #include <algorithm>
 #include <fstream>
 #include <iostream>
@@ -10,15 +16,34 @@
 
 namespace astral {
 
-CellularAutomaton::CellularAutomaton(int width, int height)
-    : materialRegistry()
+namespace {
+
+// Numbers the worlds' entries in the Profiler
+std::atomic<int> nextWorldNumber{0};
+
+} // namespace
+
+CellularAutomaton::CellularAutomaton(int width, int height, int chunkSize)
+    : CellularAutomaton(width, height, nullptr, chunkSize)
+{
+}
+
+CellularAutomaton::CellularAutomaton(int width, int height, std::shared_ptr<const MaterialRegistry> sharedRegistry,
+                                     int chunkSize)
+    : materialRegistry(std::move(sharedRegistry))
+    , ownedRegistry(nullptr)
     , chunkManager(nullptr)
     , physics(nullptr)
     , isPaused(false)
     , timeScale(1.0f)
     , worldWidth(width)
     , worldHeight(height)
+    , chunkSize(chunkSize)
     , updateTimer()
+    , profilerPrefix("Physics/world" + std::to_string(nextWorldNumber++) + "/")
+    , memorySampleCountdown(0)
+    , pipelinedStatsTick(0)
+    , adoptedStatsTick(0)
 {
     // Initialize active area to the full world
     activeArea.x = 0;
@@ -26,27 +51,43 @@ CellularAutomaton::CellularAutomaton(int width, int height)
     activeArea.width = worldWidth;
     activeArea.height = worldHeight;
     
+    // Without a shared registry, this world gets a private one it may extend
+    if (!materialRegistry) {
+        ownedRegistry = std::make_shared<MaterialRegistry>();
+        materialRegistry = ownedRegistry;
+    }
+    
     // Initialize the material registry with default materials
     initialize();
 }
 
 CellularAutomaton::~CellularAutomaton()
 {
+    // Queued consumers may still read this world's registry
+    pipeline.reset();
+    
+    // Memory this world reported is no longer held
+    Profiler::getInstance().removeMemoryUsage(profilerPrefix);
+    
     // Materials will be cleaned up by the registry's destructor
     // Chunks will be cleaned up by the ChunkManager's destructor
 }
 
 void CellularAutomaton::initialize()
 {
-    // Use the built-in basic materials registration
-    materialRegistry.registerBasicMaterials();
+    // Use the built-in basic materials registration. A shared registry is
+    // already populated and must not be modified.
+    if (ownedRegistry) {
+        ownedRegistry->registerBasicMaterials();
+    }
     
     // Create chunk manager
-    chunkManager = std::make_unique<ChunkManager>(&materialRegistry);
+    chunkManager = std::make_unique<ChunkManager>(materialRegistry.get(), chunkSize);
     
     // Create cellular physics system
-    physics = std::make_unique<CellularPhysics>(&materialRegistry, chunkManager.get());
+    physics = std::make_unique<CellularPhysics>(materialRegistry.get(), chunkManager.get());
     physics->setWorldDimensions(worldWidth, worldHeight);
+    physics->setWatchdog(watchdog.get());
     
     // Initialize with empty world
     reset(WorldTemplate::EMPTY);
@@ -54,6 +95,9 @@ void CellularAutomaton::initialize()
 
 void CellularAutomaton::reset(WorldTemplate tmpl)
 {
+    // Reductions of the old world must not overwrite the fresh stats
+    flushPipeline();
+    
     // Reset timer
     updateTimer.reset();
     
@@ -73,7 +117,8 @@ void CellularAutomaton::reset(WorldTemplate tmpl)
     // Reset stats
     stats = SimulationStats();
     stats.activeChunks = chunkManager->getActiveChunkCount();
-    stats.totalCells = worldWidth * worldHeight;
+    stats.totalCells = isUnbounded() ? getResidentChunkCount() * chunkSize * chunkSize
+                                     : worldWidth * worldHeight;
     
     // Resume simulation
     isPaused = false;
@@ -82,8 +127,31 @@ void CellularAutomaton::reset(WorldTemplate tmpl)
 
 void CellularAutomaton::update(float deltaTime)
 {
-    // Skip if paused
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+    Clock::time_point sectionStart;
+    if (watchdog) {
+        watchdog->beginTick();
+        sectionStart = Clock::now();
+    }
+    
+    // Apply edits submitted since the last tick. This also runs while paused
+    // so painting stays responsive.
+    applyQueuedEdits();
+    
+    if (watchdog) {
+        watchdog->recordSection("Edits", elapsedMs(sectionStart));
+        for (const auto& edit : pendingEdits) {
+            watchdog->recordEvent(editCommandToJson(edit));
+        }
+    }
+    
+    // Skip if paused; edits still reach the autosave
     if (isPaused) {
+        if (autosave) autosave->tick(deltaTime, chunkManager->getActiveChunks());
+        if (watchdog) watchdog->endTick();
         return;
     }
     
@@ -94,16 +162,55 @@ void CellularAutomaton::update(float deltaTime)
     updateTimer.reset();
     
     // Update active chunks
+    if (watchdog) sectionStart = Clock::now();
     chunkManager->updateActiveChunks(activeArea);
+    if (watchdog) watchdog->recordSection("ActiveChunks", elapsedMs(sectionStart));
     
     // Update physics
+    if (watchdog) sectionStart = Clock::now();
     physics->update(scaledDeltaTime);
+    if (watchdog) watchdog->recordSection("Physics", elapsedMs(sectionStart));
     
     // Update timer to get elapsed time
     updateTimer.update();
     
-    // Update statistics
-    updateSimulationStats();
+    // Update statistics, or hand the tick to the pipeline which reduces them
+    // while the next tick runs
+    if (watchdog) sectionStart = Clock::now();
+    if (pipeline) {
+        publishTick();
+    } else {
+        updateSimulationStats();
+    }
+    if (watchdog) {
+        watchdog->recordSection(pipeline ? "Publish" : "Stats", elapsedMs(sectionStart));
+    }
+    
+    // Hand changed chunks to the autosave writer, within its time budget
+    if (autosave) {
+        if (watchdog) sectionStart = Clock::now();
+        autosave->tick(deltaTime, chunkManager->getActiveChunks());
+        if (watchdog) watchdog->recordSection("Autosave", elapsedMs(sectionStart));
+    }
+    if (watchdog) {
+        watchdog->endTick();
+    }
+    
+    // Feed the per-frame profiler metrics (and live metrics, when enabled)
+    Profiler& profiler = Profiler::getInstance();
+    if (profiler.isEnabled()) {
+        profiler.recordValue("ActiveChunks", stats.activeChunks);
+        profiler.recordValue("UpdatedCells", stats.activeCells);
+        
+        // The report walks every resident chunk, so it is only sampled
+        if (memorySampleCountdown-- <= 0) {
+            memorySampleCountdown = MEMORY_SAMPLE_TICKS - 1;
+            MemoryReport memory = getMemoryReport();
+            for (const MemoryReport::Entry& entry : memory.getEntries()) {
+                profiler.recordMemoryUsage(profilerPrefix + entry.name, entry.bytes);
+            }
+        }
+    }
 }
 
 Cell& CellularAutomaton::getCell(int x, int y)
@@ -118,13 +225,16 @@ const Cell& CellularAutomaton::getCell(int x, int y) const
 
 void CellularAutomaton::setCell(int x, int y, const Cell& cell)
 {
+    if (ConductorNetwork* conductors = physics->getConductors()) {
+        conductors->noteChange(x, y, chunkManager->getCell(x, y).material, cell.material);
+    }
     chunkManager->setCell(x, y, cell);
 }
 
 void CellularAutomaton::setCell(int x, int y, MaterialID material)
 {
     // Make sure the position is in the world
-    if (x < 0 || x >= worldWidth || y < 0 || y >= worldHeight) {
+    if (!isInBounds(x, y)) {
         return;
     }
     
@@ -132,69 +242,61 @@ void CellularAutomaton::setCell(int x, int y, MaterialID material)
     Cell cell(material);
     
     // Initialize the cell with the material's properties
-    CellProcessor processor(&materialRegistry);
-    processor.initializeCellFromMaterial(cell, material);
+    physics->getCellProcessor().initializeCellFromMaterial(cell, material);
     
     // Mark the cell as updated to ensure it's active for at least one frame
     cell.updated = true;
     
     // Set the cell in the world
-    chunkManager->setCell(x, y, cell);
+    setCell(x, y, cell);
     
     // Make sure the active area includes this cell
     WorldRect cellRect = {x, y, 1, 1};
     chunkManager->updateActiveChunks(cellRect);
 }
 
-void CellularAutomaton::updateSimulationStats()
+namespace {
+
+// Reduce the cells of the simulated chunks into statistics
+void reduceStats(const std::vector<const Cell*>& chunks, size_t cellsPerChunk,
+                 const MaterialRegistry& materialRegistry, SimulationStats& stats)
 {
-    // Get active chunks
-    const auto& activeChunks = chunkManager->getActiveChunks();
-    
     // Reset stats
     stats.totalCells = 0;
     stats.activeCells = 0;
-    stats.activeChunks = activeChunks.size();
+    stats.activeChunks = static_cast<int>(chunks.size());
     stats.averageTemp = 0.0f;
     stats.averagePressure = 0.0f;
     stats.materialCounts.clear();
     
-    // Time taken for update (convert from seconds to milliseconds)
-    stats.updateTimeMs = static_cast<float>(updateTimer.getDeltaTime() * 1000.0);
-    
     // Count active cells and calculate averages
     int tempCellCount = 0;
     int pressureCellCount = 0;
     
-    for (const auto& chunkCoord : activeChunks) {
-        Chunk* chunk = chunkManager->getChunk(chunkCoord);
-        if (!chunk) continue;
-        
-        for (int y = 0; y < CHUNK_SIZE; y++) {
-            for (int x = 0; x < CHUNK_SIZE; x++) {
-                const Cell& cell = chunk->getCell(x, y);
-                stats.totalCells++;
-                
-                // Count cells that were updated this frame
-                if (cell.updated) {
-                    stats.activeCells++;
-                }
-                
-                // Count by material type
-                stats.materialCounts[cell.material]++;
-                
-                // Temperature average (skip empty cells)
-                if (cell.material != materialRegistry.getDefaultMaterialID()) {
-                    stats.averageTemp += cell.temperature;
-                    tempCellCount++;
-                }
-                
-                // Pressure average (only for fluids and gases)
-                const MaterialProperties& props = materialRegistry.getMaterial(cell.material);
-                if (props.type == MaterialType::LIQUID || props.type == MaterialType::GAS) {
-                    stats.averagePressure += cell.pressure;
-                    pressureCellCount++;
-                }
+    for (const Cell* cells : chunks) {
+        for (size_t i = 0; i < cellsPerChunk; i++) {
+            const Cell& cell = cells[i];
+            stats.totalCells++;
+            
+            // Count cells that were updated this frame
+            if (cell.updated) {
+                stats.activeCells++;
+            }
+            
+            // Count by material type
+            stats.materialCounts[cell.material]++;
+            
+            // Temperature average (skip empty cells)
+            if (cell.material != materialRegistry.getDefaultMaterialID()) {
+                stats.averageTemp += cell.temperature;
+                tempCellCount++;
+            }
+            
+            // Pressure average (only for fluids and gases)
+            const MaterialProperties& props = materialRegistry.getMaterial(cell.material);
+            if (props.type == MaterialType::LIQUID || props.type == MaterialType::GAS) {
+                stats.averagePressure += cell.pressure;
+                pressureCellCount++;
             }
         }
     }
@@ -209,19 +311,106 @@ void CellularAutomaton::updateSimulationStats()
     }
 }
 
+} // namespace
+
+void CellularAutomaton::updateSimulationStats()
+{
+    std::vector<const Cell*> chunks;
+    for (const auto& chunkCoord : chunkManager->getActiveChunks()) {
+        const Chunk* chunk = chunkManager->getChunk(chunkCoord);
+        if (chunk) chunks.push_back(chunk->getCells());
+    }
+    reduceStats(chunks, static_cast<size_t>(chunkSize) * chunkSize, *materialRegistry, stats);
+    
+    // Time taken for update (convert from seconds to milliseconds)
+    stats.updateTimeMs = static_cast<float>(updateTimer.getDeltaTime() * 1000.0);
+}
+
+GasField& CellularAutomaton::enableGasField(const GasFieldConfig& config)
+{
+    return physics->enableGasField(config);
+}
+
+TickPipeline& CellularAutomaton::enablePipeline(ThreadPool& pool)
+{
+    pipeline = std::make_unique<TickPipeline>(&pool);
+    pipeline->addConsumer("stats", [this](const PublishedTick& tick) {
+        std::vector<const Cell*> chunks;
+        chunks.reserve(tick.chunks.size());
+        for (const auto& chunk : tick.chunks) {
+            chunks.push_back(chunk.cells.data());
+        }
+        SimulationStats reduced;
+        reduceStats(chunks, static_cast<size_t>(tick.chunkSize) * tick.chunkSize, *materialRegistry, reduced);
+        reduced.updateTimeMs = tick.updateTimeMs;
+        
+        // Reductions of consecutive ticks can finish out of order
+        std::lock_guard<std::mutex> lock(pipelinedStatsMutex);
+        if (tick.tick > pipelinedStatsTick) {
+            pipelinedStats = std::move(reduced);
+            pipelinedStatsTick = tick.tick;
+        }
+    });
+    return *pipeline;
+}
+
+void CellularAutomaton::disablePipeline()
+{
+    flushPipeline();
+    pipeline.reset();
+}
+
+void CellularAutomaton::flushPipeline()
+{
+    if (!pipeline) return;
+    pipeline->flush();
+    adoptPipelinedStats();
+}
+
+void CellularAutomaton::publishTick()
+{
+    // Waits for the consumers of the tick that last used this buffer
+    PublishedTick& published = pipeline->beginPublish();
+    adoptPipelinedStats();
+    
+    TickPipeline::capture(*chunkManager, published);
+    published.tick = pipeline->getPublishedTicks() + 1;
+    published.updateTimeMs = static_cast<float>(updateTimer.getDeltaTime() * 1000.0);
+    pipeline->publish();
+}
+
+void CellularAutomaton::adoptPipelinedStats()
+{
+    std::lock_guard<std::mutex> lock(pipelinedStatsMutex);
+    if (pipelinedStatsTick > adoptedStatsTick) {
+        float fpsLimit = stats.fpsLimit;
+        stats = pipelinedStats;
+        stats.fpsLimit = fpsLimit;
+        adoptedStatsTick = pipelinedStatsTick;
+    }
+}
+
 MaterialID CellularAutomaton::registerMaterial(const MaterialProperties& properties)
 {
-    return materialRegistry.registerMaterial(properties);
+    if (!ownedRegistry) {
+        // Shared registries are immutable; only existing materials can be resolved
+        std::cerr << "Cannot register material '" << properties.name
+                  << "' on a world with a shared material registry" << std::endl;
+        return materialRegistry->getIDFromName(properties.name);
+    }
+    MaterialID id = ownedRegistry->registerMaterial(properties);
+    physics->refreshMaterials();
+    return id;
 }
 
 MaterialProperties CellularAutomaton::getMaterial(MaterialID id) const
 {
-    return materialRegistry.getMaterial(id);
+    return materialRegistry->getMaterial(id);
 }
 
 MaterialID CellularAutomaton::getMaterialIDByName(const std::string& name) const
 {
-    return materialRegistry.getIDFromName(name);
+    return materialRegistry->getIDFromName(name);
 }
 
 void CellularAutomaton::paintCell(int x, int y, MaterialID material)
@@ -265,49 +454,310 @@ void CellularAutomaton::paintLine(int x1, int y1, int x2, int y2, MaterialID mat
 
 void CellularAutomaton::paintCircle(int x, int y, int radius, MaterialID material)
 {
-    // Check basic bounds first
-    if (x < -radius || x >= worldWidth + radius || 
-        y < -radius || y >= worldHeight + radius) {
+    EditCommand command;
+    command.type = EditCommandType::PAINT_CIRCLE;
+    command.x = x;
+    command.y = y;
+    command.radius = static_cast<float>(radius);
+    command.material = material;
+    applyEditCommand(command);
+}
+
+void CellularAutomaton::fillRectangle(int x, int y, int width, int height, MaterialID material)
+{
+    EditCommand command;
+    command.type = EditCommandType::FILL_RECTANGLE;
+    command.x = x;
+    command.y = y;
+    command.width = width;
+    command.height = height;
+    command.material = material;
+    applyEditCommand(command);
+}
+
+void CellularAutomaton::fillShape(int centerX, int centerY, int radius, MaterialID material)
+{
+    // This is a more general utility method used by paintCircle and fillRectangle
+    // In this implementation, we're just mapping to paintCircle
+    paintCircle(centerX, centerY, radius, material);
+}
+
+void CellularAutomaton::applyEditCommand(const EditCommand& command)
+{
+    // Effects operate on existing cells through the physics system
+    switch (command.type) {
+        case EditCommandType::EXPLOSION:
+            physics->createExplosion(command.x, command.y, command.radius, command.amount);
+            return;
+        case EditCommandType::HEAT_SOURCE:
+            physics->createHeatSource(command.x, command.y, command.amount, command.radius);
+            return;
+        case EditCommandType::FORCE:
+            physics->applyForceField(command.x, command.y, command.direction, command.amount, command.radius);
+            return;
+        default:
+            break;
+    }
+    
+    // Paint commands: compute the affected rectangle
+    int radius = static_cast<int>(command.radius);
+    int minX = command.x;
+    int minY = command.y;
+    int maxX = command.x;
+    int maxY = command.y;
+    
+    if (command.type == EditCommandType::PAINT_CIRCLE) {
+        minX = command.x - radius;
+        minY = command.y - radius;
+        maxX = command.x + radius;
+        maxY = command.y + radius;
+    } else if (command.type == EditCommandType::FILL_RECTANGLE) {
+        maxX = command.x + command.width - 1;
+        maxY = command.y + command.height - 1;
+    }
+    
+    // Clamp to world boundaries
+    if (worldWidth != UNBOUNDED) {
+        minX = std::max(0, minX);
+        maxX = std::min(worldWidth - 1, maxX);
+    }
+    if (worldHeight != UNBOUNDED) {
+        minY = std::max(0, minY);
+        maxY = std::min(worldHeight - 1, maxY);
+    }
+    if (minX > maxX || minY > maxY) {
         return;
     }
     
-    // Fill a circle using midpoint circle algorithm
-    for (int cy = -radius; cy <= radius; cy++) {
-        for (int cx = -radius; cx <= radius; cx++) {
-            if (cx*cx + cy*cy <= radius*radius) {
-                int px = x + cx;
-                int py = y + cy;
-                
-                // Check bounds for each point
-                if (px >= 0 && px < worldWidth && py >= 0 && py < worldHeight) {
-                    paintCell(px, py, material);
+    // Every painted cell is identical, so initialize it once
+    Cell cell(command.material);
+    physics->getCellProcessor().initializeCellFromMaterial(cell, command.material);
+    
+    // Mark the cell as updated to ensure it's active for at least one frame
+    cell.updated = true;
+    
+    // Walk the rectangle one chunk at a time
+    ConductorNetwork* conductors = physics->getConductors();
+    ChunkCoord minChunk = ChunkManager::worldToChunkCoord(minX, minY, chunkSize);
+    ChunkCoord maxChunk = ChunkManager::worldToChunkCoord(maxX, maxY, chunkSize);
+    
+    for (int chunkY = minChunk.y; chunkY <= maxChunk.y; chunkY++) {
+        for (int chunkX = minChunk.x; chunkX <= maxChunk.x; chunkX++) {
+            ChunkCoord chunkCoord = {chunkX, chunkY};
+            WorldCoord origin = ChunkManager::chunkToWorldCoord(chunkCoord, {0, 0}, chunkSize);
+            
+            int startX = std::max(minX, origin.x);
+            int startY = std::max(minY, origin.y);
+            int endX = std::min(maxX, origin.x + chunkSize - 1);
+            int endY = std::min(maxY, origin.y + chunkSize - 1);
+            
+            Chunk* chunk = nullptr;
+            for (int y = startY; y <= endY; y++) {
+                for (int x = startX; x <= endX; x++) {
+                    if (command.type == EditCommandType::PAINT_CIRCLE) {
+                        int dx = x - command.x;
+                        int dy = y - command.y;
+                        if (dx*dx + dy*dy > radius*radius) continue;
+                    }
+                    
+                    if (!chunk) {
+                        chunk = chunkManager->getOrCreateChunk(chunkCoord);
+                    }
+                    if (conductors) {
+                        MaterialID before = chunk->getCell(x - origin.x, y - origin.y).material;
+                        conductors->noteChange(x, y, before, command.material);
+                    }
+                    chunk->setCell(x - origin.x, y - origin.y, cell);
                 }
             }
+            
+            // Make sure the chunk gets simulated
+            if (chunk) {
+                chunk->setActive(true);
+                chunkManager->forceActivateChunk(chunkCoord);
+            }
         }
     }
 }
 
-void CellularAutomaton::fillRectangle(int x, int y, int width, int height, MaterialID material)
+void CellularAutomaton::submitEdit(const EditCommand& command)
 {
-    // Clamp to world boundaries
-    int startX = std::max(0, x);
-    int startY = std::max(0, y);
-    int endX = std::min(worldWidth - 1, x + width - 1);
-    int endY = std::min(worldHeight - 1, y + height - 1);
-    
-    // Fill the rectangle
-    for (int cy = startY; cy <= endY; cy++) {
-        for (int cx = startX; cx <= endX; cx++) {
-            paintCell(cx, cy, material);
+    editQueue.push(command);
+}
+
+void CellularAutomaton::queuePaintCell(int x, int y, MaterialID material)
+{
+    EditCommand command;
+    command.type = EditCommandType::PAINT_CELL;
+    command.x = x;
+    command.y = y;
+    command.material = material;
+    editQueue.push(command);
+}
+
+void CellularAutomaton::queuePaintCircle(int x, int y, int radius, MaterialID material)
+{
+    EditCommand command;
+    command.type = EditCommandType::PAINT_CIRCLE;
+    command.x = x;
+    command.y = y;
+    command.radius = static_cast<float>(radius);
+    command.material = material;
+    editQueue.push(command);
+}
+
+void CellularAutomaton::queueFillRectangle(int x, int y, int width, int height, MaterialID material)
+{
+    EditCommand command;
+    command.type = EditCommandType::FILL_RECTANGLE;
+    command.x = x;
+    command.y = y;
+    command.width = width;
+    command.height = height;
+    command.material = material;
+    editQueue.push(command);
+}
+
+void CellularAutomaton::queueExplosion(int x, int y, float radius, float power)
+{
+    EditCommand command;
+    command.type = EditCommandType::EXPLOSION;
+    command.x = x;
+    command.y = y;
+    command.radius = radius;
+    command.amount = power;
+    editQueue.push(command);
+}
+
+void CellularAutomaton::queueHeatSource(int x, int y, float temperature, float radius)
+{
+    EditCommand command;
+    command.type = EditCommandType::HEAT_SOURCE;
+    command.x = x;
+    command.y = y;
+    command.radius = radius;
+    command.amount = temperature;
+    editQueue.push(command);
+}
+
+void CellularAutomaton::queueForce(int x, int y, const glm::vec2& direction, float strength, float radius)
+{
+    EditCommand command;
+    command.type = EditCommandType::FORCE;
+    command.x = x;
+    command.y = y;
+    command.direction = direction;
+    command.amount = strength;
+    command.radius = radius;
+    editQueue.push(command);
+}
+
+TickWatchdog& CellularAutomaton::enableWatchdog(const TickWatchdogConfig& config)
+{
+    watchdog = std::make_unique<TickWatchdog>(config);
+    physics->setWatchdog(watchdog.get());
+    
+    // Hot chunks are stored as run-length encoded materials plus their
+    // temperature range, enough to rebuild the scene around the outlier
+    watchdog->setSnapshotProvider([this](const std::vector<TraceChunkCost>& hottest) {
+        nlohmann::json chunks = nlohmann::json::array();
+        for (const auto& cost : hottest) {
+            const Chunk* chunk = chunkManager->getChunk(ChunkCoord{cost.chunkX, cost.chunkY});
+            if (!chunk) continue;
+            
+            nlohmann::json runs = nlohmann::json::array();
+            MaterialID runMaterial = chunk->getCell(0, 0).material;
+            int runLength = 0;
+            float minTemperature = chunk->getCell(0, 0).temperature;
+            float maxTemperature = minTemperature;
+            for (int y = 0; y < chunkSize; y++) {
+                for (int x = 0; x < chunkSize; x++) {
+                    const Cell& cell = chunk->getCell(x, y);
+                    minTemperature = std::min(minTemperature, cell.temperature);
+                    maxTemperature = std::max(maxTemperature, cell.temperature);
+                    if (cell.material == runMaterial) {
+                        runLength++;
+                        continue;
+                    }
+                    runs.push_back({runMaterial, runLength});
+                    runMaterial = cell.material;
+                    runLength = 1;
+                }
+            }
+            runs.push_back({runMaterial, runLength});
+            
+            chunks.push_back({
+                {"chunk", {cost.chunkX, cost.chunkY}},
+                {"ms", cost.ms},
+                {"size", chunkSize},
+                {"materials", std::move(runs)},
+                {"temperatureRange", {minTemperature, maxTemperature}}
+            });
         }
+        return chunks;
+    });
+    return *watchdog;
+}
+
+void CellularAutomaton::disableWatchdog()
+{
+    physics->setWatchdog(nullptr);
+    watchdog.reset();
+}
+
+bool CellularAutomaton::enableAutosave(const std::string& path, const WorldAutosaveConfig& config)
+{
+    disableAutosave();
+    auto saver = std::make_unique<WorldAutosave>(chunkManager.get(), config);
+    if (!saver->start(path)) {
+        return false;
     }
+    autosave = std::move(saver);
+    return true;
 }
 
-void CellularAutomaton::fillShape(int centerX, int centerY, int radius, MaterialID material)
+void CellularAutomaton::disableAutosave()
 {
-    // This is a more general utility method used by paintCircle and fillRectangle
-    // In this implementation, we're just mapping to paintCircle
-    paintCircle(centerX, centerY, radius, material);
+    autosave.reset();
+}
+
+MemoryReport CellularAutomaton::getMemoryReport() const
+{
+    MemoryReport report;
+    chunkManager->addMemoryUsage(report);
+    
+    // A shared registry belongs to no world in particular
+    report.add("materials/registry", ownedRegistry ? ownedRegistry->getMemoryUsage() : 0);
+    physics->addMemoryUsage(report);
+    
+    report.add("queues/edits", editQueue.getMemoryUsage() + heapBytes(pendingEdits), editQueue.getPendingCount());
+    report.add("queues/pipeline", pipeline ? pipeline->getMemoryUsage() : 0);
+    report.add("journals/autosave", autosave ? autosave->getMemoryUsage() : 0);
+    report.add("journals/watchdog", watchdog ? watchdog->getMemoryUsage() : 0);
+    return report;
+}
+
+void CellularAutomaton::dumpMemoryReport() const
+{
+    std::cout << "===== Physics Memory =====" << std::endl;
+    getMemoryReport().print(std::cout);
+    std::cout << "==========================" << std::endl;
+}
+
+size_t CellularAutomaton::applyQueuedEdits()
+{
+    pendingEdits.clear();
+    if (editQueue.drain(pendingEdits) == 0) {
+        return 0;
+    }
+    
+    // Edits may overlap, so they apply in submission order (the order the
+    // queue drains in); each paint still visits the chunks it covers once
+    for (const auto& command : pendingEdits) {
+        applyEditCommand(command);
+    }
+    
+    return pendingEdits.size();
 }
 
 void CellularAutomaton::createExplosion(int x, int y, float radius, float power)
@@ -328,19 +778,61 @@ void CellularAutomaton::applyForce(int x, int y, const glm::vec2& direction, flo
 void CellularAutomaton::setActiveArea(int x, int y, int width, int height)
 {
     // Clamp to world boundaries
-    activeArea.x = std::max(0, x);
-    activeArea.y = std::max(0, y);
-    activeArea.width = std::min(worldWidth - activeArea.x, width);
-    activeArea.height = std::min(worldHeight - activeArea.y, height);
+    activeArea = {x, y, width, height};
+    if (worldWidth != UNBOUNDED) {
+        activeArea.x = std::max(0, x);
+        activeArea.width = std::min(worldWidth - activeArea.x, width);
+    }
+    if (worldHeight != UNBOUNDED) {
+        activeArea.y = std::max(0, y);
+        activeArea.height = std::min(worldHeight - activeArea.y, height);
+    }
     
     // Update active chunks
     chunkManager->updateActiveChunks(activeArea);
 }
 
+void CellularAutomaton::loadRegion(int x, int y, int width, int height)
+{
+    if (worldWidth != UNBOUNDED) {
+        width = std::min(worldWidth, x + width) - std::max(0, x);
+        x = std::max(0, x);
+    }
+    if (worldHeight != UNBOUNDED) {
+        height = std::min(worldHeight, y + height) - std::max(0, y);
+        y = std::max(0, y);
+    }
+    chunkManager->updateActiveChunks({x, y, width, height});
+}
+
+size_t CellularAutomaton::unloadChunksOutside(int x, int y, int width, int height)
+{
+    return chunkManager->removeChunksOutside({x, y, width, height});
+}
+
+void CellularAutomaton::setUpdateRegion(int x, int y, int width, int height)
+{
+    chunkManager->setUpdateRegion({x, y, width, height});
+}
+
 void CellularAutomaton::clearWorld()
 {
+    physics->getLiquidBodies().releaseAll();
+    if (GasField* gasField = physics->getGasField()) {
+        gasField->clear();
+    }
+    if (ParticleSystem* particles = physics->getParticles()) {
+        particles->clear();
+    }
+    
+    // An unbounded world is empty once nothing is resident
+    if (isUnbounded()) {
+        chunkManager->clear();
+        return;
+    }
+    
     // Fill the world with the default material (air)
-    MaterialID airId = materialRegistry.getDefaultMaterialID();
+    MaterialID airId = materialRegistry->getDefaultMaterialID();
     
     // For efficiency, we'll activate chunks first
     WorldRect fullWorld = {0, 0, worldWidth, worldHeight};
@@ -352,13 +844,16 @@ void CellularAutomaton::clearWorld()
         Chunk* chunk = chunkManager->getChunk(chunkCoord);
         if (!chunk) continue;
         
-        for (int y = 0; y < CHUNK_SIZE; y++) {
-            for (int x = 0; x < CHUNK_SIZE; x++) {
+        for (int y = 0; y < chunkSize; y++) {
+            for (int x = 0; x < chunkSize; x++) {
                 Cell emptyCell(airId);
                 chunk->setCell(x, y, emptyCell);
             }
         }
     }
+    if (ConductorNetwork* conductors = physics->getConductors()) {
+        conductors->rebuild();
+    }
 }
 
 void CellularAutomaton::generateWorld(WorldTemplate tmpl)
@@ -375,11 +870,19 @@ void CellularAutomaton::initializeWorldFromTemplate(WorldTemplate tmpl)
     // Clear existing world
     clearWorld();
     
+    // The templates are laid out relative to the world's edges
+    if (isUnbounded()) {
+        if (tmpl != WorldTemplate::EMPTY) {
+            std::cerr << "World templates need a bounded world; leaving it empty" << std::endl;
+        }
+        return;
+    }
+    
     // Get material IDs for common materials
-    MaterialID airId = materialRegistry.getDefaultMaterialID();
-    MaterialID stoneId = materialRegistry.getStoneID();
-    MaterialID sandId = materialRegistry.getSandID();
-    MaterialID waterId = materialRegistry.getWaterID();
+    MaterialID airId = materialRegistry->getDefaultMaterialID();
+    MaterialID stoneId = materialRegistry->getStoneID();
+    MaterialID sandId = materialRegistry->getSandID();
+    MaterialID waterId = materialRegistry->getWaterID();
     
     // Generate world based on template
     switch (tmpl) {
@@ -507,18 +1010,65 @@ void CellularAutomaton::initializeWorldFromTemplate(WorldTemplate tmpl)
 
 bool CellularAutomaton::saveWorld(const std::string& filename) const
 {
-    // TODO: Implement world saving using JSON or binary format
-    // For now, return a failure indicator
-    std::cerr << "World saving not implemented yet" << std::endl;
-    return false;
+    // Written next to the target and renamed over it, so a failed save
+    // leaves the previous one in place
+    std::string tempPath = filename + ".tmp";
+    std::remove(tempPath.c_str());
+    RegionFile file;
+    if (!file.open(tempPath, chunkSize, true)) {
+        std::cerr << "Failed to create " << tempPath << std::endl;
+        return false;
+    }
+    
+    std::vector<uint8_t> encoded;
+    bool ok = true;
+    for (const ChunkCoord& coord : chunkManager->getResidentChunks()) {
+        const Chunk* chunk = chunkManager->getChunk(coord);
+        RegionFile::encodeCells(chunk->getCells(), chunk->getCellCount(), encoded);
+        ok = ok && file.append(coord, 0, encoded);
+    }
+    ok = ok && file.sync();
+    file.close();
+    if (!ok || std::rename(tempPath.c_str(), filename.c_str()) != 0) {
+        std::cerr << "Failed to save the world to " << filename << std::endl;
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
 }
 
 bool CellularAutomaton::loadWorld(const std::string& filename)
 {
-    // TODO: Implement world loading using JSON or binary format
-    // For now, return a failure indicator
-    std::cerr << "World loading not implemented yet" << std::endl;
-    return false;
+    RegionFile file;
+    if (!file.open(filename, chunkSize, false)) {
+        std::cerr << "Failed to open " << filename << " as a world with chunk size " << chunkSize << std::endl;
+        return false;
+    }
+    
+    // Start from an empty world, so chunks the file lacks do not keep live
+    // state and nothing kept outside the cells outlives them
+    clearWorld();
+    
+    std::vector<Cell> cells(static_cast<size_t>(chunkSize) * chunkSize);
+    for (const ChunkCoord& coord : file.getChunks()) {
+        if (!isInBounds(coord.x * chunkSize, coord.y * chunkSize)) continue;
+        if (!file.read(coord, cells.data())) {
+            std::cerr << "Skipping unreadable chunk (" << coord.x << ", " << coord.y << ") in " << filename << std::endl;
+            continue;
+        }
+        Chunk* chunk = chunkManager->getOrCreateChunk(coord);
+        for (int y = 0; y < chunkSize; y++) {
+            for (int x = 0; x < chunkSize; x++) {
+                chunk->getCell(x, y) = cells[static_cast<size_t>(y) * chunkSize + x];
+            }
+        }
+        chunk->markDirty();
+        chunkManager->forceActivateChunk(coord);
+    }
+    if (ConductorNetwork* conductors = physics->getConductors()) {
+        conductors->rebuild();
+    }
+    return true;
 }
 
 } // namespace astral
\ No newline at end of file
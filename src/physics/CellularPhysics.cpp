@@ -1,27 +1,62 @@
 #include "astral/physics/CellularPhysics.h"
 #include "astral/physics/Material.h"
 #include "astral/physics/CellProcessor.h"
+#include "astral/core/TickWatchdog.h"
+#include "astral/core/SamplingProfiler.h"
+#include "astral/core/ThreadPool.h"
 #include <chrono>
 #include <algorithm>
 #include <random>
 #include <cmath>
+#include <cstring>
 #include <functional>
 #include <iostream>
 
 namespace astral {
 
-CellularPhysics::CellularPhysics(MaterialRegistry* registry, ChunkManager* chunkManager)
+namespace {
+
+// Whether a task changed a cell of another chunk (the updated flag aside)
+bool sameCell(const Cell& a, const Cell& b)
+{
+    return a.material == b.material && a.temperature == b.temperature && a.velocity == b.velocity &&
+           a.metadata == b.metadata && a.pressure == b.pressure && a.health == b.health &&
+           a.lifetime == b.lifetime && a.energy == b.energy && a.charge == b.charge &&
+           a.stateFlags == b.stateFlags;
+}
+
+// Seed of a chunk's generator in a tick, so OUTBOX results do not depend on
+// which worker runs the chunk
+uint32_t chunkSeed(uint32_t seed, ChunkCoord coord, uint64_t tick)
+{
+    std::seed_seq sequence{seed, static_cast<uint32_t>(tick), static_cast<uint32_t>(tick >> 32),
+                           static_cast<uint32_t>(coord.x), static_cast<uint32_t>(coord.y)};
+    uint32_t value;
+    sequence.generate(&value, &value + 1);
+    return value;
+}
+
+} // namespace
+
+CellularPhysics::CellularPhysics(const MaterialRegistry* registry, ChunkManager* chunkManager)
     : materialRegistry(registry)
     , chunkManager(chunkManager)
-    , cellProcessor(nullptr)
+    , materialTable(*registry)
+    , cellProcessor(&materialTable)
+    , reactionMatrix(cellProcessor)
+    , tick(0)
     , worldWidth(1000) // Default values, should be set properly later
     , worldHeight(1000)
+    , randomSeed(static_cast<uint32_t>(std::chrono::system_clock::now().time_since_epoch().count()))
+    , strategy(ChunkUpdateStrategy::SERIAL)
+    , pool(nullptr)
+    , watchdog(nullptr)
 {
     // Initialize with current time
-    random.seed(static_cast<unsigned int>(std::chrono::system_clock::now().time_since_epoch().count()));
+    random.seed(randomSeed);
     
-    // Create cell processor
-    cellProcessor = new CellProcessor(materialRegistry);
+    liquidBodies = std::make_unique<LiquidBodyTracker>(materialRegistry, chunkManager, &cellProcessor,
+        [this](int x, int y) { return isValidPosition(x, y); });
     
     // Initialize
     initialize();
@@ -29,28 +64,88 @@ CellularPhysics::CellularPhysics(MaterialRegistry* registry, ChunkManager* chunk
 
 CellularPhysics::~CellularPhysics()
 {
-    if (cellProcessor) {
-        delete cellProcessor;
-        cellProcessor = nullptr;
-    }
+    // The tracker holds a pointer to the processor
+    liquidBodies.reset();
 }
 
 void CellularPhysics::initialize()
 {
-    // Set up update tracking grid
-    resetUpdateTracker();
-    
     // Map material types to their corresponding update functions
     setupUpdateFunctions();
 }
 
+void CellularPhysics::refreshMaterials()
+{
+    materialTable = MaterialTable(*materialRegistry);
+    reactionMatrix = ReactionMatrix(cellProcessor);
+}
+
+thread_local CellularPhysics::ChunkWorker* CellularPhysics::currentWorker = nullptr;
+
+void CellularPhysics::setChunkUpdateStrategy(ChunkUpdateStrategy strategy, ThreadPool* pool)
+{
+    if (strategy == ChunkUpdateStrategy::OUTBOX && !pool) {
+        throw std::invalid_argument("The OUTBOX chunk update strategy needs a thread pool");
+    }
+    this->strategy = strategy;
+    this->pool = pool;
+    outboxStats = OutboxStats();
+}
+
+void CellularPhysics::setRandomSeed(uint32_t seed)
+{
+    randomSeed = seed;
+    random.seed(seed);
+}
+
 void CellularPhysics::setWorldDimensions(int width, int height)
 {
     worldWidth = width;
     worldHeight = height;
-    
-    // Resize update tracking grid
-    resetUpdateTracker();
+}
+
+GasField& CellularPhysics::enableGasField(const GasFieldConfig& config)
+{
+    disableGasField();
+    gasField = std::make_unique<GasField>(materialRegistry, chunkManager, worldWidth, worldHeight, config);
+    return *gasField;
+}
+
+ChunkCatchUp& CellularPhysics::enableCatchUp(const ChunkCatchUpConfig& config)
+{
+    catchUp = std::make_unique<ChunkCatchUp>(&cellProcessor, config);
+    return *catchUp;
+}
+
+ParticleSystem& CellularPhysics::enableParticles(const ParticleSystemConfig& config)
+{
+    disableParticles();
+    particles = std::make_unique<ParticleSystem>(&cellProcessor, chunkManager, worldWidth, worldHeight, config);
+    return *particles;
+}
+
+ConductorNetwork& CellularPhysics::enableConductors(const ConductorNetworkConfig& config)
+{
+    conductors = std::make_unique<ConductorNetwork>(&materialTable, chunkManager, worldWidth, worldHeight, config);
+    return *conductors;
+}
+
+void CellularPhysics::disableParticles()
+{
+    if (particles) {
+        particles->depositAll();
+        noteParticleLandings();
+        particles.reset();
+    }
+}
+
+void CellularPhysics::disableGasField()
+{
+    if (gasField) {
+        gasField->materializeAll();
+        noteGasFieldChanges();
+        gasField.reset();
+    }
 }
 
 void CellularPhysics::setupUpdateFunctions()
@@ -67,34 +162,111 @@ void CellularPhysics::setupUpdateFunctions()
 
 void CellularPhysics::resetUpdateTracker()
 {
-    updated.resize(worldHeight);
-    for (int y = 0; y < worldHeight; y++) {
-        updated[y].resize(worldWidth);
-        for (int x = 0; x < worldWidth; x++) {
-            updated[y][x] = false;
-        }
+    // Chunks clear their flags when first marked in the new tick
+    tick++;
+}
+
+bool CellularPhysics::isUpdated(int x, int y) const
+{
+    // Tasks track their own chunk only; other chunks are marked when their
+    // boundary writes are applied
+    if (currentWorker) {
+        if (!ownsCell(*currentWorker, x, y)) return false;
+        LocalCoord local = chunkManager->localCoordOf(x, y);
+        return currentWorker->chunk->isUpdatedInTick(local.x, local.y, tick);
     }
+    
+    const Chunk* chunk = chunkManager->getChunk(chunkManager->chunkCoordOf(x, y));
+    if (!chunk) return false;
+    LocalCoord local = chunkManager->localCoordOf(x, y);
+    return chunk->isUpdatedInTick(local.x, local.y, tick);
+}
+
+void CellularPhysics::markUpdated(int x, int y)
+{
+    if (currentWorker) {
+        if (!ownsCell(*currentWorker, x, y)) return;
+        LocalCoord local = chunkManager->localCoordOf(x, y);
+        currentWorker->chunk->markUpdatedInTick(local.x, local.y, tick);
+        return;
+    }
+    
+    Chunk* chunk = chunkManager->getChunk(chunkManager->chunkCoordOf(x, y));
+    if (!chunk) return;
+    LocalCoord local = chunkManager->localCoordOf(x, y);
+    chunk->markUpdatedInTick(local.x, local.y, tick);
+}
+
+bool CellularPhysics::isDueThisTick(int interval, int x, int y) const
+{
+    // Hash the position so neighbouring cells fall on different ticks and
+    // the work is spread evenly over the interval
+    uint32_t phase = static_cast<uint32_t>(x) * 0x9E3779B1u ^ static_cast<uint32_t>(y) * 0x85EBCA77u;
+    phase ^= phase >> 15;
+    return (tick + phase) % static_cast<uint32_t>(interval) == 0;
 }
 
 bool CellularPhysics::isValidPosition(int x, int y) const
 {
-    return x >= 0 && x < worldWidth && y >= 0 && y < worldHeight;
+    if (worldWidth != UNBOUNDED && (x < 0 || x >= worldWidth)) return false;
+    if (worldHeight != UNBOUNDED && (y < 0 || y >= worldHeight)) return false;
+    
+    // Along an unbounded axis the world ends where the resident chunks end
+    if (worldWidth == UNBOUNDED || worldHeight == UNBOUNDED) {
+        // Tasks running side by side must not share the lookup cache
+        ChunkCoord coord = chunkManager->chunkCoordOf(x, y);
+        return (currentWorker ? chunkManager->peekChunk(coord) : chunkManager->getChunk(coord)) != nullptr;
+    }
+    return true;
 }
 
 Cell& CellularPhysics::getCell(int x, int y)
 {
+    if (currentWorker) return workerCell(*currentWorker, x, y);
     return chunkManager->getCell(x, y);
 }
 
 const Cell& CellularPhysics::getCell(int x, int y) const
 {
+    if (currentWorker) return workerCell(*currentWorker, x, y);
     return chunkManager->getCell(x, y);
 }
 
+bool CellularPhysics::ownsCell(const ChunkWorker& worker, int x, int y) const
+{
+    return chunkManager->chunkCoordOf(x, y) == worker.coord;
+}
+
+Cell& CellularPhysics::workerCell(ChunkWorker& worker, int x, int y) const
+{
+    ChunkCoord coord = chunkManager->chunkCoordOf(x, y);
+    LocalCoord local = chunkManager->localCoordOf(x, y);
+    if (coord == worker.coord) {
+        return worker.chunk->getCell(local.x, local.y);
+    }
+    
+    uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    auto found = worker.foreign.find(key);
+    if (found != worker.foreign.end()) {
+        return found->second.second;
+    }
+    
+    // Active chunks are read from their snapshot, the others are not written
+    // during the phase; a missing chunk reads as air
+    Cell seen;
+    auto slot = workerIndex.find(coord);
+    if (slot != workerIndex.end()) {
+        seen = workers[slot->second].snapshot[static_cast<size_t>(local.y) * chunkManager->getChunkSize() + local.x];
+    } else if (const Chunk* chunk = chunkManager->peekChunk(coord)) {
+        seen = chunk->getCell(local.x, local.y);
+    }
+    return worker.foreign.emplace(key, std::make_pair(seen, seen)).first->second.second;
+}
+
 MaterialProperties CellularPhysics::getMaterialProperties(int x, int y) const
 {
     const Cell& cell = getCell(x, y);
-    return materialRegistry->getMaterial(cell.material);
+    return materialTable.getMaterial(cell.material);
 }
 
 bool CellularPhysics::canMove(int x, int y, int newX, int newY)
@@ -104,12 +276,17 @@ bool CellularPhysics::canMove(int x, int y, int newX, int newY)
         return false;
     }
     
+    // A task only moves the cells of its own chunk
+    if (currentWorker && !ownsCell(*currentWorker, x, y)) {
+        return false;
+    }
+    
     // Get cells
     Cell& sourceCell = getCell(x, y);
     Cell& targetCell = getCell(newX, newY);
     
     // Return result
-    return cellProcessor->canCellMove(sourceCell, targetCell);
+    return cellProcessor.canCellMove(sourceCell, targetCell);
 }
 
 void CellularPhysics::swapCells(int x, int y, int newX, int newY)
@@ -119,11 +296,19 @@ void CellularPhysics::swapCells(int x, int y, int newX, int newY)
         return;
     }
     
+    // Swaps across a chunk border wait in the task's outbox
+    if (currentWorker && !(ownsCell(*currentWorker, x, y) && ownsCell(*currentWorker, newX, newY))) {
+        currentWorker->outbox.addMove({x, y}, {newX, newY}, getCell(x, y).material, getCell(newX, newY).material, true);
+        return;
+    }
+    
     // Get cells
     Cell& cell1 = getCell(x, y);
     Cell& cell2 = getCell(newX, newY);
     
     // Perform swap
+    noteMaterialChange(x, y, cell1.material, cell2.material);
+    noteMaterialChange(newX, newY, cell2.material, cell1.material);
     std::swap(cell1.material, cell2.material);
     std::swap(cell1.temperature, cell2.temperature);
     std::swap(cell1.velocity, cell2.velocity);
@@ -140,8 +325,8 @@ void CellularPhysics::swapCells(int x, int y, int newX, int newY)
     cell2.updated = true;
     
     // Mark in update tracker
-    if (isValidPosition(x, y)) updated[y][x] = true;
-    if (isValidPosition(newX, newY)) updated[newY][newX] = true;
+    if (isValidPosition(x, y)) markUpdated(x, y);
+    if (isValidPosition(newX, newY)) markUpdated(newX, newY);
 }
 
 // Track ANY cell movements
@@ -156,12 +341,21 @@ void CellularPhysics::moveCell(int x, int y, int newX, int newY)
         return;
     }
     
+    // Moves across a chunk border wait in the task's outbox; the cell stays
+    // where it is until the move is applied
+    if (currentWorker && !(ownsCell(*currentWorker, x, y) && ownsCell(*currentWorker, newX, newY))) {
+        currentWorker->outbox.addMove({x, y}, {newX, newY}, getCell(x, y).material, getCell(newX, newY).material, false);
+        return;
+    }
+    
     // Get cells
     Cell& sourceCell = getCell(x, y);
     Cell& targetCell = getCell(newX, newY);
     
     // Preserve target cell temporarily
     Cell tempCell = targetCell;
+    noteMaterialChange(newX, newY, targetCell.material, sourceCell.material);
+    noteMaterialChange(x, y, sourceCell.material, materialTable.getDefaultMaterialID());
     
     // Move source to target
     targetCell.material = sourceCell.material;
@@ -177,7 +371,7 @@ void CellularPhysics::moveCell(int x, int y, int newX, int newY)
     targetCell.updated = true;
     
     // Reset source cell (to air/empty)
-    sourceCell.material = materialRegistry->getDefaultMaterialID();
+    sourceCell.material = materialTable.getDefaultMaterialID();
     sourceCell.temperature = 20.0f; // Room temperature
     sourceCell.velocity = glm::vec2(0.0f, 0.0f);
     sourceCell.metadata = 0;
@@ -190,8 +384,8 @@ void CellularPhysics::moveCell(int x, int y, int newX, int newY)
     sourceCell.updated = true;
     
     // Mark in update tracker
-    if (isValidPosition(x, y)) updated[y][x] = true;
-    if (isValidPosition(newX, newY)) updated[newY][newX] = true;
+    if (isValidPosition(x, y)) markUpdated(x, y);
+    if (isValidPosition(newX, newY)) markUpdated(newX, newY);
 }
 
 void CellularPhysics::applyForce(int x, int y, const glm::vec2& force)
@@ -205,7 +399,7 @@ void CellularPhysics::applyForce(int x, int y, const glm::vec2& force)
     Cell& cell = getCell(x, y);
     
     // Get material properties
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materialTable.getMaterial(cell.material);
     
     // If material can move, apply the force
     if (props.movable) {
@@ -245,11 +439,11 @@ void CellularPhysics::applyForce(int x, int y, const glm::vec2& force)
     }
 }
 
-void CellularPhysics::processMaterialInteraction(int x1, int y1, int x2, int y2, float deltaTime)
+bool CellularPhysics::processMaterialInteraction(int x1, int y1, int x2, int y2, float deltaTime, bool mayReact)
 {
     // Boundary check
     if (!isValidPosition(x1, y1) || !isValidPosition(x2, y2)) {
-        return;
+        return false;
     }
     
     // Get cells
@@ -257,20 +451,32 @@ void CellularPhysics::processMaterialInteraction(int x1, int y1, int x2, int y2,
     Cell& cell2 = getCell(x2, y2);
     
     // Skip if either cell is empty
-    if (cell1.material == materialRegistry->getDefaultMaterialID() && 
-        cell2.material == materialRegistry->getDefaultMaterialID()) {
-        return;
+    if (cell1.material == materialTable.getDefaultMaterialID() && 
+        cell2.material == materialTable.getDefaultMaterialID()) {
+        return false;
     }
+    const MaterialID material1 = cell1.material;
+    const MaterialID material2 = cell2.material;
     
-    // Transfer heat between cells
-    cellProcessor->transferHeat(cell1, cell2, deltaTime);
+    // Tag the sub-steps for the sampling profiler
+    SampleContext& sampleContext = currentSampleContext();
+    const char* phase = sampleContext.phase;
     
-    // Check for and process reactions
-    cellProcessor->processPotentialReaction(cell1, cell2, deltaTime);
+    // Transfer heat between cells
+    sampleContext.phase = "heat_transfer";
+    cellProcessor.transferHeat(cell1, cell2, deltaTime);
+    
+    // Check for and process reactions; the matrix answers canReact() for
+    // the pair without evaluating the rules
+    if (mayReact && reactionMatrix.canReact(cell1.material, cell2.material)) {
+        sampleContext.phase = "reactions";
+        cellProcessor.processPotentialReaction(cell1, cell2, deltaTime, cellRandom());
+    }
+    sampleContext.phase = phase;
     
     // Check for pressure equalization (for fluids)
-    const MaterialProperties& props1 = materialRegistry->getMaterial(cell1.material);
-    const MaterialProperties& props2 = materialRegistry->getMaterial(cell2.material);
+    const MaterialProperties& props1 = materialTable.getMaterial(cell1.material);
+    const MaterialProperties& props2 = materialTable.getMaterial(cell2.material);
     
     if ((props1.type == MaterialType::LIQUID || props1.type == MaterialType::GAS) &&
         (props2.type == MaterialType::LIQUID || props2.type == MaterialType::GAS)) {
@@ -280,6 +486,10 @@ void CellularPhysics::processMaterialInteraction(int x1, int y1, int x2, int y2,
         cell1.pressure = avgPressure;
         cell2.pressure = avgPressure;
     }
+    
+    noteMaterialChange(x1, y1, material1, cell1.material);
+    noteMaterialChange(x2, y2, material2, cell2.material);
+    return cell1.material != material1 || cell2.material != material2;
 }
 
 void CellularPhysics::applyTemperature(int x, int y, float deltaTime)
@@ -293,18 +503,15 @@ void CellularPhysics::applyTemperature(int x, int y, float deltaTime)
     Cell& cell = getCell(x, y);
     
     // Skip empty cells
-    if (cell.material == materialRegistry->getDefaultMaterialID()) {
+    if (cell.material == materialTable.getDefaultMaterialID()) {
         return;
     }
     
     // Get material properties
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materialTable.getMaterial(cell.material);
     
     // Natural cooling/heating towards ambient temperature
-    const float AMBIENT_TEMP = 20.0f; // Room temperature
-    const float AMBIENT_RATE = 0.01f;
-    
-    cell.temperature += (AMBIENT_TEMP - cell.temperature) * AMBIENT_RATE * deltaTime;
+    cell.temperature += (AMBIENT_TEMPERATURE - cell.temperature) * AMBIENT_RATE * deltaTime;
     
     // Heat generation for fire
     if (props.type == MaterialType::FIRE || cell.hasFlag(Cell::FLAG_BURNING)) {
@@ -318,7 +525,9 @@ void CellularPhysics::applyTemperature(int x, int y, float deltaTime)
     }
     
     // Apply temperature-based state changes
-    cellProcessor->checkStateChangeByTemperature(cell);
+    MaterialID material = cell.material;
+    cellProcessor.checkStateChangeByTemperature(cell);
+    noteMaterialChange(x, y, material, cell.material);
 }
 
 // Cellular automaton rules for different material types
@@ -342,14 +551,14 @@ void CellularPhysics::updateEmpty(int x, int y, float deltaTime)
 void CellularPhysics::updateSolid(int x, int y, float deltaTime)
 {
     // Skip if already updated
-    if (updated[y][x]) return;
+    if (isUpdated(x, y)) return;
     
     Cell& cell = getCell(x, y);
     cell.updated = true;
-    updated[y][x] = true;
+    markUpdated(x, y);
     
     // Get material properties
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materialTable.getMaterial(cell.material);
     
     // Solids generally don't move, but they can:
     // 1. Conduct heat
@@ -367,7 +576,7 @@ void CellularPhysics::updateSolid(int x, int y, float deltaTime)
         // Check cell below
         if (isValidPosition(x, y + 1)) {
             const Cell& below = getCell(x, y + 1);
-            const MaterialProperties& belowProps = materialRegistry->getMaterial(below.material);
+            const MaterialProperties& belowProps = materialTable.getMaterial(below.material);
             
             if (belowProps.type == MaterialType::SOLID && !belowProps.movable) {
                 hasSupport = true;
@@ -402,16 +611,16 @@ void CellularPhysics::updateSolid(int x, int y, float deltaTime)
 void CellularPhysics::updatePowder(int x, int y, float deltaTime)
 {
     // Skip if already updated
-    if (updated[y][x]) {
+    if (isUpdated(x, y)) {
         return;
     }
     
     Cell& cell = getCell(x, y);
     cell.updated = true;
-    updated[y][x] = true;
+    markUpdated(x, y);
     
     // Get material properties
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materialTable.getMaterial(cell.material);
     
     // Check if the material is actually of powder type
     if (props.type != MaterialType::POWDER) {
@@ -462,16 +671,16 @@ void CellularPhysics::updatePowder(int x, int y, float deltaTime)
 void CellularPhysics::updateLiquid(int x, int y, float deltaTime)
 {
     // Skip if already updated this tick
-    if (updated[y][x]) {
+    if (isUpdated(x, y)) {
         return;
     }
     
     Cell& cell = getCell(x, y);
     cell.updated = true;
-    updated[y][x] = true;
+    markUpdated(x, y);
     
     // Only process if the cell is a liquid
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materialTable.getMaterial(cell.material);
     if (props.type != MaterialType::LIQUID) {
         return;
     }
@@ -540,33 +749,23 @@ void CellularPhysics::updateLiquid(int x, int y, float deltaTime)
 void CellularPhysics::updateGas(int x, int y, float deltaTime)
 {
     // Skip if already updated
-    if (updated[y][x]) return;
+    if (isUpdated(x, y)) return;
     
     Cell& cell = getCell(x, y);
     cell.updated = true;
-    updated[y][x] = true;
+    markUpdated(x, y);
     
     // Get material properties
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materialTable.getMaterial(cell.material);
     
     // Check if the material is actually of gas type
     if (props.type != MaterialType::GAS) {
         return;
     }
     
-    // Apply temperature effects
+    // Apply temperature effects; the lifetime counts down in decayChunkCells
     applyTemperature(x, y, deltaTime);
     
-    // Lifetime decay for gases
-    if (cell.lifetime > 0) {
-        cell.lifetime--;
-        if (cell.lifetime == 0) {
-            cell.material = materialRegistry->getDefaultMaterialID(); // Dissipate
-            cell.updated = true;
-            return;
-        }
-    }
-    
     // Gas simulation: try to rise up (opposite of liquids)
     // Note: In our coordinate system, up is -y (negative y is upward)
     
@@ -584,11 +783,11 @@ void CellularPhysics::updateGas(int x, int y, float deltaTime)
             riseSpeed = 0.9f + (freshness * 0.09f);
             
             // Increase vertical speed for smoke - make it rise faster
-            if (freshness > 0.5f && cellProcessor->rollProbability(0.3f)) {
+            if (freshness > 0.5f && cellRandom().rollProbability(0.3f)) {
                 // Occasionally try to make smoke move up two cells at once for faster rising
                 int upDist = (props.name == "Smoke") ? 2 : 1;
                 if (isValidPosition(x, y - upDist) && 
-                    getCell(x, y - upDist).material == materialRegistry->getDefaultMaterialID()) {
+                    getCell(x, y - upDist).material == materialTable.getDefaultMaterialID()) {
                     moveCell(x, y, x, y - upDist);
                     return;
                 }
@@ -596,7 +795,7 @@ void CellularPhysics::updateGas(int x, int y, float deltaTime)
         }
         
         // Higher probability of rising for smoke/steam
-        if (cellProcessor->rollProbability(riseSpeed)) {
+        if (cellRandom().rollProbability(riseSpeed)) {
             if (canMove(x, y, x, y - 1)) {
                 moveCell(x, y, x, y - 1);
                 return;
@@ -611,7 +810,7 @@ void CellularPhysics::updateGas(int x, int y, float deltaTime)
     }
     
     // Try diagonal rises with random direction preference
-    bool tryLeftFirst = cellProcessor->rollProbability(0.5f);
+    bool tryLeftFirst = cellRandom().rollProbability(0.5f);
     
     if (tryLeftFirst) {
         if (canMove(x, y, x - 1, y - 1)) {
@@ -640,7 +839,7 @@ void CellularPhysics::updateGas(int x, int y, float deltaTime)
         // Dispersion probability decreases with distance
         float disperseChance = 0.7f - (dist - 1) * 0.1f;
         
-        if (!cellProcessor->rollProbability(disperseChance)) {
+        if (!cellRandom().rollProbability(disperseChance)) {
             continue;
         }
         
@@ -670,14 +869,14 @@ void CellularPhysics::updateGas(int x, int y, float deltaTime)
 void CellularPhysics::updateFire(int x, int y, float deltaTime)
 {
     // Skip if already updated
-    if (updated[y][x]) return;
+    if (isUpdated(x, y)) return;
     
     Cell& cell = getCell(x, y);
     cell.updated = true;
-    updated[y][x] = true;
+    markUpdated(x, y);
     
     // Get material properties
-    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+    const MaterialProperties& props = materialTable.getMaterial(cell.material);
     
     // Check if the material is actually of fire type
     if (props.type != MaterialType::FIRE) {
@@ -685,7 +884,7 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
     }
     
     // Determine if this is oil fire or regular fire
-    bool isOilFire = (cell.material == materialRegistry->getOilFireID());
+    bool isOilFire = (cell.material == materialTable.getOilFireID());
     
     // Fire has a chance to spread to flammable neighbors
     for (int dy = -1; dy <= 1; dy++) {
@@ -698,7 +897,7 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
             if (!isValidPosition(nx, ny)) continue;
             
             Cell& neighbor = getCell(nx, ny);
-            const MaterialProperties& neighborProps = materialRegistry->getMaterial(neighbor.material);
+            const MaterialProperties& neighborProps = materialTable.getMaterial(neighbor.material);
             
             if (neighborProps.flammable) {
                 // Oil fire spreads more aggressively
@@ -706,13 +905,15 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
                 float ignitionChance = neighborProps.flammability * ignitionMultiplier * deltaTime * 10.0f;
                 
                 // Increased ignition chance for wood specifically
-                if (neighbor.material == materialRegistry->getWoodID()) {
+                if (neighbor.material == materialTable.getWoodID()) {
                     ignitionChance *= 1.2f;
                 }
                 
-                if (cellProcessor->rollProbability(ignitionChance)) {
+                if (cellRandom().rollProbability(ignitionChance)) {
                     // Ignite neighbor
-                    cellProcessor->igniteCell(neighbor);
+                    MaterialID material = neighbor.material;
+                    cellProcessor.igniteCell(neighbor, cellRandom());
+                    noteMaterialChange(nx, ny, material, neighbor.material);
                 }
             }
         }
@@ -723,7 +924,7 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
     bool hasFuel = false;
     if (isValidPosition(x, y+1)) { // Check below
         const Cell& belowCell = getCell(x, y+1);
-        const MaterialProperties& belowProps = materialRegistry->getMaterial(belowCell.material);
+        const MaterialProperties& belowProps = materialTable.getMaterial(belowCell.material);
         hasFuel = belowProps.flammable || belowProps.type == MaterialType::FIRE || 
                  belowProps.name == "Lava" || belowProps.name == "Oil";
     }
@@ -738,14 +939,15 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
         smokeChance = isOilFire ? 0.005f : 0.003f;
     }
     
-    if (cellProcessor->rollProbability(smokeChance)) {
+    if (cellRandom().rollProbability(smokeChance)) {
         // Check if there's an empty space above to create smoke
         int smokeY = y - 1;  // Smoke rises upward (negative y)
         if (isValidPosition(x, smokeY) && 
-            getCell(x, smokeY).material == materialRegistry->getDefaultMaterialID()) {
+            getCell(x, smokeY).material == materialTable.getDefaultMaterialID()) {
             
             Cell& smokeCell = getCell(x, smokeY);
-            smokeCell.material = materialRegistry->getSmokeID();
+            smokeCell.material = materialTable.getSmokeID();
+            noteMaterialChange(x, smokeY, materialTable.getDefaultMaterialID(), smokeCell.material);
             smokeCell.temperature = isOilFire ? 130.0f : 100.0f;
             
             // Shorter-lived smoke
@@ -774,7 +976,7 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
         bool hasFuel = false;
         if (isValidPosition(x, y+1)) { // Down is +y direction
             const Cell& belowCell = getCell(x, y+1);
-            const MaterialProperties& belowProps = materialRegistry->getMaterial(belowCell.material);
+            const MaterialProperties& belowProps = materialTable.getMaterial(belowCell.material);
             
             // Fire has fuel if it's on flammable material or another fire
             hasFuel = belowProps.flammable || belowProps.type == MaterialType::FIRE || 
@@ -784,23 +986,23 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
         // If fire has no fuel source below it, make it burn out EXTREMELY quickly
         if (!hasFuel) {
             // EXTREMELY aggressive burn out for floating fire
-            if (cellProcessor->rollProbability(0.9f)) {
+            if (cellRandom().rollProbability(0.9f)) {
                 cell.lifetime -= 5; // Burn out 5x faster when not on fuel
             }
             
             // Almost guaranteed to convert to air when no fuel source
-            if (cellProcessor->rollProbability(0.8f)) {
+            if (cellRandom().rollProbability(0.8f)) {
                 // Convert floating fire directly to air in most cases
-                if (cellProcessor->rollProbability(0.8f)) {
+                if (cellRandom().rollProbability(0.8f)) {
                     // Just remove the fire completely
-                    cell.material = materialRegistry->getDefaultMaterialID();
+                    cell.material = materialTable.getDefaultMaterialID();
                     cell.clearFlag(Cell::FLAG_BURNING);
                 } else {
                     // Occasionally convert to a small amount of smoke
-                    cell.material = materialRegistry->getSmokeID();
+                    cell.material = materialTable.getSmokeID();
                     cell.clearFlag(Cell::FLAG_BURNING);
                     cell.temperature = isOilFire ? 120.0f : 90.0f;
-                    cell.lifetime = 15 + cellProcessor->getRandomInt(0, 10); // Very short-lived smoke
+                    cell.lifetime = 15 + cellRandom().getRandomInt(0, 10); // Very short-lived smoke
                     cell.metadata = isOilFire ? 1 : 0;
                 }
                 return;
@@ -813,40 +1015,36 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
             cell.temperature = cell.temperature * 0.92f;
             
             // Higher chance to convert to smoke when nearly extinguished
-            if (cellProcessor->rollProbability(0.25f)) {
+            if (cellRandom().rollProbability(0.25f)) {
                 // Convert low-intensity fire directly to smoke
-                cell.material = materialRegistry->getSmokeID();
+                cell.material = materialTable.getSmokeID();
                 cell.clearFlag(Cell::FLAG_BURNING);
                 
                 // Oil fire produces darker, hotter smoke that lasts longer
                 if (isOilFire) {
                     cell.temperature = 130.0f;
-                    cell.lifetime = 70 + cellProcessor->getRandomInt(0, 30);
+                    cell.lifetime = 70 + cellRandom().getRandomInt(0, 30);
                     cell.metadata = 1; // Mark as oil fire smoke
                 } else {
                     cell.temperature = 100.0f;
-                    cell.lifetime = 50 + cellProcessor->getRandomInt(0, 30);
+                    cell.lifetime = 50 + cellRandom().getRandomInt(0, 30);
                 }
                 return;
             }
         }
         
-        // Decrement lifetime with some randomness for more natural fading
-        if (cellProcessor->rollProbability(0.95f)) { // Increased probability to ensure depletion
-            cell.lifetime--;
-        }
-        
         // When fire is almost extinguished, slow down its movement and increase smoke generation
         if (cell.lifetime < 5) {
             // Generate more smoke as the fire is dying
-            if (cellProcessor->rollProbability(0.3f)) {
+            if (cellRandom().rollProbability(0.3f)) {
                 // Check if there's space above to create smoke
                 int smokeY = y - 1;  // Smoke rises upward (negative y)
                 if (isValidPosition(x, smokeY) && 
-                    getCell(x, smokeY).material == materialRegistry->getDefaultMaterialID()) {
+                    getCell(x, smokeY).material == materialTable.getDefaultMaterialID()) {
                     
                     Cell& smokeCell = getCell(x, smokeY);
-                    smokeCell.material = materialRegistry->getSmokeID();
+                    smokeCell.material = materialTable.getSmokeID();
+                    noteMaterialChange(x, smokeY, materialTable.getDefaultMaterialID(), smokeCell.material);
                     smokeCell.temperature = isOilFire ? 130.0f : 100.0f;
                     smokeCell.lifetime = isOilFire ? 120 : 80;
                     
@@ -861,26 +1059,11 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
             return; // Skip movement code below
         }
         
-        if (cell.lifetime <= 0) {
-            // Transform to smoke when lifetime is depleted
-            cell.material = materialRegistry->getSmokeID();
-            cell.clearFlag(Cell::FLAG_BURNING);
-            
-            // Oil fire produces darker, hotter smoke that lasts longer
-            if (isOilFire) {
-                cell.temperature = 130.0f;
-                cell.lifetime = 120 + cellProcessor->getRandomInt(0, 30);
-                cell.metadata = 1; // Mark as oil fire smoke
-            } else {
-                cell.temperature = 100.0f;
-                cell.lifetime = 80 + cellProcessor->getRandomInt(0, 20);
-            }
-            return;
-        }
-    } else if (cellProcessor->rollProbability(isOilFire ? 0.07f : 0.12f * deltaTime * 10.0f)) { // Increased chance
+        // The lifetime counts down, and runs out into smoke, in decayChunkCells
+    } else if (cellRandom().rollProbability(isOilFire ? 0.07f : 0.12f * deltaTime * 10.0f)) { // Increased chance
         // Random burnout chance (oil fire has lower chance)
         // Add some additional smoke before fully burning out
-        if (cellProcessor->rollProbability(0.4f)) {
+        if (cellRandom().rollProbability(0.4f)) {
             // Check if there's space around to create smoke
             for (int dy = -1; dy <= 0; dy++) {
                 for (int dx = -1; dx <= 1; dx++) {
@@ -892,10 +1075,11 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
                     
                     if (!isValidPosition(nx, ny)) continue;
                     
-                    if (getCell(nx, ny).material == materialRegistry->getDefaultMaterialID()) {
+                    if (getCell(nx, ny).material == materialTable.getDefaultMaterialID()) {
                         // Create some additional smoke
                         Cell& smokeCell = getCell(nx, ny);
-                        smokeCell.material = materialRegistry->getSmokeID();
+                        smokeCell.material = materialTable.getSmokeID();
+                        noteMaterialChange(nx, ny, materialTable.getDefaultMaterialID(), smokeCell.material);
                         smokeCell.temperature = isOilFire ? 130.0f : 100.0f;
                         smokeCell.lifetime = isOilFire ? 120 : 80;
                         if (isOilFire) {
@@ -908,7 +1092,7 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
         }
         
         // Convert the fire cell to smoke
-        cell.material = materialRegistry->getSmokeID();
+        cell.material = materialTable.getSmokeID();
         cell.clearFlag(Cell::FLAG_BURNING);
         
         // Oil fire produces darker, hotter smoke that lasts longer
@@ -943,12 +1127,12 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
                         
     // Add randomness to fire height - occasionally let it "lick" upward
     // This creates a flickering effect without constant rising
-    if (cellProcessor->rollProbability(0.03f)) {
+    if (cellRandom().rollProbability(0.03f)) {
         // Random "licking" of flames - temporary rise
         riseChance = 0.8f;  // Occasional burst upward
     }
     
-    if (cellProcessor->rollProbability(riseChance)) {
+    if (cellRandom().rollProbability(riseChance)) {
         // Try to rise upward
         if (canMove(x, y, x, y - 1)) {
             moveCell(x, y, x, y - 1);
@@ -956,7 +1140,7 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
         }
         
         // Fire can also rise diagonally
-        bool tryLeftFirst = cellProcessor->rollProbability(0.5f);
+        bool tryLeftFirst = cellRandom().rollProbability(0.5f);
         
         if (tryLeftFirst) {
             if (canMove(x, y, x - 1, y - 1)) {
@@ -980,8 +1164,8 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
     }
     
     // Horizontal movement for fire
-    if (cellProcessor->rollProbability(spreadChance)) {
-        int dir = cellProcessor->rollProbability(0.5f) ? 1 : -1;
+    if (cellRandom().rollProbability(spreadChance)) {
+        int dir = cellRandom().rollProbability(0.5f) ? 1 : -1;
         
         if (canMove(x, y, x + dir, y)) {
             moveCell(x, y, x + dir, y);
@@ -992,11 +1176,11 @@ void CellularPhysics::updateFire(int x, int y, float deltaTime)
 void CellularPhysics::updateSpecial(int x, int y, float deltaTime)
 {
     // Skip if already updated
-    if (updated[y][x]) return;
+    if (isUpdated(x, y)) return;
     
     Cell& cell = getCell(x, y);
     cell.updated = true;
-    updated[y][x] = true;
+    markUpdated(x, y);
     
     // Special materials can have custom behavior defined by the metadata
     // For example, metadata could define different special material types:
@@ -1015,7 +1199,7 @@ void CellularPhysics::updateSpecial(int x, int y, float deltaTime)
             if (cell.temperature > 100.0f || cell.hasFlag(Cell::FLAG_BURNING)) {
                 // Create explosion
                 createExplosion(x, y, 5.0f, 10.0f);
-                cell.material = materialRegistry->getFireID();
+                cell.material = materialTable.getFireID();
                 cell.temperature = 500.0f;
                 cell.setFlag(Cell::FLAG_BURNING);
             }
@@ -1033,15 +1217,16 @@ void CellularPhysics::updateSpecial(int x, int y, float deltaTime)
                     if (!isValidPosition(nx, ny)) continue;
                     
                     Cell& neighbor = getCell(nx, ny);
-                    const MaterialProperties& neighborProps = materialRegistry->getMaterial(neighbor.material);
                     
                     // Acid doesn't dissolve other acid or empty space
-                    if (neighbor.material == materialRegistry->getDefaultMaterialID() ||
+                    if (neighbor.material == materialTable.getDefaultMaterialID() ||
                         neighbor.metadata == 2) continue;
                     
                     // Try to dissolve
-                    if (cellProcessor->rollProbability(0.1f * deltaTime * 5.0f)) {
-                        cellProcessor->damageCell(neighbor, 0.2f);
+                    if (cellRandom().rollProbability(0.1f * deltaTime * 5.0f)) {
+                        MaterialID material = neighbor.material;
+                        cellProcessor.damageCell(neighbor, 0.2f);
+                        noteMaterialChange(nx, ny, material, neighbor.material);
                     }
                 }
             }
@@ -1081,6 +1266,25 @@ void CellularPhysics::updateChunk(Chunk* chunk, float deltaTime)
 {
     if (!chunk || !chunk->isActive()) return;
     
+    dispatchChunkSize(chunk->getSize(), [&](auto size) {
+        updateChunkCells<decltype(size)::value>(chunk, deltaTime);
+    });
+}
+
+template <int Size>
+bool CellularPhysics::isAggregatedInterior(Chunk* chunk, int localX, int localY, int worldX, int worldY)
+{
+    MaterialID aggregated = chunk->aggregatedAt<Size>(localX, localY);
+    if (aggregated == 0) return false;
+    if (aggregated == chunk->cellAt<Size>(localX, localY).material) return true;
+    
+    releaseLiquidAt(worldX, worldY);
+    return false;
+}
+
+template <int Size>
+void CellularPhysics::updateChunkCells(Chunk* chunk, float deltaTime)
+{
     ChunkCoord coord = chunk->getCoord();
     
     // To avoid artifacts from sequential updating, use different orders:
@@ -1088,59 +1292,64 @@ void CellularPhysics::updateChunk(Chunk* chunk, float deltaTime)
     // - For gases and fire, update top to bottom
     
     // First pass: bottom to top (for falling materials)
-    for (int localY = CHUNK_SIZE - 1; localY >= 0; localY--) {
-        for (int localX = 0; localX < CHUNK_SIZE; localX++) {
+    for (int localY = Size - 1; localY >= 0; localY--) {
+        for (int localX = 0; localX < Size; localX++) {
             // Convert to world coordinates
-            WorldCoord worldCoord = ChunkManager::chunkToWorldCoord(coord, {localX, localY});
+            WorldCoord worldCoord = ChunkManager::chunkToWorldCoord(coord, {localX, localY}, Size);
             
             if (!isValidPosition(worldCoord.x, worldCoord.y)) continue;
+            if (isAggregatedInterior<Size>(chunk, localX, localY, worldCoord.x, worldCoord.y)) continue;
             
-            const Cell& cell = chunk->getCell(localX, localY);
-            const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+            const Cell& cell = chunk->cellAt<Size>(localX, localY);
+            const MaterialProperties& props = materialTable.getMaterial(cell.material);
             
             // Update falling materials
             if (props.type == MaterialType::POWDER || props.type == MaterialType::LIQUID) {
                 // Use the appropriate update function
                 auto it = updateFunctions.find(props.type);
                 if (it != updateFunctions.end()) {
+                    MaterialID material = cell.material;
                     it->second(this, worldCoord.x, worldCoord.y, deltaTime);
+                    noteMaterialChange(worldCoord.x, worldCoord.y, material, cell.material);
                 }
             }
         }
     }
     
     // Second pass: top to bottom (for rising materials)
-    for (int localY = 0; localY < CHUNK_SIZE; localY++) {
-        for (int localX = 0; localX < CHUNK_SIZE; localX++) {
+    for (int localY = 0; localY < Size; localY++) {
+        for (int localX = 0; localX < Size; localX++) {
             // Convert to world coordinates
-            WorldCoord worldCoord = ChunkManager::chunkToWorldCoord(coord, {localX, localY});
+            WorldCoord worldCoord = ChunkManager::chunkToWorldCoord(coord, {localX, localY}, Size);
             
             if (!isValidPosition(worldCoord.x, worldCoord.y)) continue;
             
-            const Cell& cell = chunk->getCell(localX, localY);
-            const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+            const Cell& cell = chunk->cellAt<Size>(localX, localY);
+            const MaterialProperties& props = materialTable.getMaterial(cell.material);
             
             // Update rising materials
             if (props.type == MaterialType::GAS || props.type == MaterialType::FIRE) {
                 // Use the appropriate update function
                 auto it = updateFunctions.find(props.type);
                 if (it != updateFunctions.end()) {
+                    MaterialID material = cell.material;
                     it->second(this, worldCoord.x, worldCoord.y, deltaTime);
+                    noteMaterialChange(worldCoord.x, worldCoord.y, material, cell.material);
                 }
             }
         }
     }
     
     // Third pass: solid and special materials
-    for (int localY = 0; localY < CHUNK_SIZE; localY++) {
-        for (int localX = 0; localX < CHUNK_SIZE; localX++) {
+    for (int localY = 0; localY < Size; localY++) {
+        for (int localX = 0; localX < Size; localX++) {
             // Convert to world coordinates
-            WorldCoord worldCoord = ChunkManager::chunkToWorldCoord(coord, {localX, localY});
+            WorldCoord worldCoord = ChunkManager::chunkToWorldCoord(coord, {localX, localY}, Size);
             
             if (!isValidPosition(worldCoord.x, worldCoord.y)) continue;
             
-            const Cell& cell = chunk->getCell(localX, localY);
-            const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+            const Cell& cell = chunk->cellAt<Size>(localX, localY);
+            const MaterialProperties& props = materialTable.getMaterial(cell.material);
             
             // Update solid and special materials
             if (props.type == MaterialType::SOLID || props.type == MaterialType::SPECIAL || 
@@ -1149,19 +1358,22 @@ void CellularPhysics::updateChunk(Chunk* chunk, float deltaTime)
                 // Use the appropriate update function
                 auto it = updateFunctions.find(props.type);
                 if (it != updateFunctions.end()) {
+                    MaterialID material = cell.material;
                     it->second(this, worldCoord.x, worldCoord.y, deltaTime);
+                    noteMaterialChange(worldCoord.x, worldCoord.y, material, cell.material);
                 }
             }
         }
     }
     
     // Fourth pass: process interactions between adjacent cells
-    for (int localY = 0; localY < CHUNK_SIZE; localY++) {
-        for (int localX = 0; localX < CHUNK_SIZE; localX++) {
+    for (int localY = 0; localY < Size; localY++) {
+        for (int localX = 0; localX < Size; localX++) {
             // Convert to world coordinates
-            WorldCoord worldCoord = ChunkManager::chunkToWorldCoord(coord, {localX, localY});
+            WorldCoord worldCoord = ChunkManager::chunkToWorldCoord(coord, {localX, localY}, Size);
             
             if (!isValidPosition(worldCoord.x, worldCoord.y)) continue;
+            if (isAggregatedInterior<Size>(chunk, localX, localY, worldCoord.x, worldCoord.y)) continue;
             
             // Process interactions with neighbors
             for (int dy = -1; dy <= 1; dy++) {
@@ -1180,108 +1392,278 @@ void CellularPhysics::updateChunk(Chunk* chunk, float deltaTime)
     }
 }
 
+template <int Size>
+void CellularPhysics::moveChunkCells(Chunk* chunk, float deltaTime)
+{
+    SampleContext& sampleContext = currentSampleContext();
+    ChunkCoord chunkCoord = chunk->getCoord();
+    
+    // Process cells in the chunk using our update methods
+    for (int localY = 0; localY < Size; localY++) {
+        for (int localX = 0; localX < Size; localX++) {
+            // Convert to world coordinates
+            int worldX = chunkCoord.x * Size + localX;
+            int worldY = chunkCoord.y * Size + localY;
+            
+            // Get cell and material 
+            Cell& cell = chunk->cellAt<Size>(localX, localY);
+            
+            // Skip empty cells and the interiors of settled liquid bodies
+            if (isAggregatedInterior<Size>(chunk, localX, localY, worldX, worldY)) continue;
+            if (cell.material == 0) continue;
+            
+            // Slow materials are updated every few ticks with a longer step
+            int interval = materialTable.getUpdateInterval(cell.material);
+            if (interval > 1 && !isDueThisTick(interval, worldX, worldY)) continue;
+            float cellDeltaTime = deltaTime * interval;
+            
+            // Get material properties
+            const MaterialID material = cell.material;
+            const MaterialProperties& props = materialTable.getMaterial(material);
+            sampleContext.material = materialTypeName(props.type);
+            
+            // Call the appropriate update function based on material type
+            switch (props.type) {
+                case MaterialType::EMPTY:
+                    updateEmpty(worldX, worldY, cellDeltaTime);
+                    break;
+                case MaterialType::SOLID:
+                    updateSolid(worldX, worldY, cellDeltaTime);
+                    break;
+                case MaterialType::POWDER:
+                    updatePowder(worldX, worldY, cellDeltaTime);
+                    break;
+                case MaterialType::LIQUID:
+                    updateLiquid(worldX, worldY, cellDeltaTime);
+                    break;
+                case MaterialType::GAS:
+                    updateGas(worldX, worldY, cellDeltaTime);
+                    break;
+                case MaterialType::FIRE:
+                    updateFire(worldX, worldY, cellDeltaTime);
+                    break;
+                case MaterialType::SPECIAL:
+                    updateSpecial(worldX, worldY, cellDeltaTime);
+                    break;
+            }
+            
+            // The rules report the cells they move and the neighbours they
+            // change; changes of the cell itself are caught here
+            noteMaterialChange(worldX, worldY, material, cell.material);
+        }
+    }
+}
+
+template <int Size>
+void CellularPhysics::decayChunkCells(Chunk* chunk)
+{
+    // Count the lifetime of every decaying cell down in one branch-free pass
+    // over the chunk, flagging the cells that ran out in a byte plane
+    const uint8_t* decaying = materialTable.getDecayFlags();
+    const size_t materialCount = materialTable.size();
+    Cell* cells = &chunk->cellAt<Size>(0, 0);
+    expiredCells.resize(Size * Size);
+    uint8_t* expired = expiredCells.data();
+    for (int i = 0; i < Size * Size; i++) {
+        MaterialID material = cells[i].material;
+        uint8_t counts = decaying[material < materialCount ? material : 0] & (cells[i].lifetime != 0);
+        cells[i].lifetime -= counts;
+        expired[i] = counts & (cells[i].lifetime == 0);
+    }
+    
+    // Apply the decay transitions of the few cells that ran out, skipping
+    // eight clear flags at a time
+    for (int i = 0; i < Size * Size; i += 8) {
+        uint64_t flags;
+        std::memcpy(&flags, expired + i, sizeof(flags));
+        if (flags == 0) continue;
+        for (int j = i; j < i + 8; j++) {
+            if (!expired[j]) continue;
+            MaterialID material = cells[j].material;
+            cellProcessor.applyDecay(cells[j], cellRandom());
+            if (conductors) {
+                noteMaterialChange(chunk->getCoord().x * Size + j % Size, chunk->getCoord().y * Size + j / Size,
+                                   material, cells[j].material);
+            }
+        }
+    }
+}
+
+template <int Size>
+void CellularPhysics::interactChunkCells(Chunk* chunk, float deltaTime)
+{
+    ChunkCoord chunkCoord = chunk->getCoord();
+    
+    // Cells with no neighbour they can react with skip the reaction rules.
+    // Material changes during the pass mark their neighbourhood, so the
+    // reactions evaluated are exactly those of the unmasked pass.
+    reactionMask.build(reactionMatrix, *chunkManager, chunkCoord);
+    
+    for (int localY = 0; localY < Size; localY++) {
+        for (int localX = 0; localX < Size; localX++) {
+            // Convert to world coordinates
+            int worldX = chunkCoord.x * Size + localX;
+            int worldY = chunkCoord.y * Size + localY;
+            
+            // Skip empty cells or out of bounds
+            if (!isValidPosition(worldX, worldY)) continue;
+            if (isAggregatedInterior<Size>(chunk, localX, localY, worldX, worldY)) continue;
+            Cell& cell = chunk->cellAt<Size>(localX, localY);
+            if (cell.material == 0) continue;
+            int interval = materialTable.getUpdateInterval(cell.material);
+            if (interval > 1 && !isDueThisTick(interval, worldX, worldY)) continue;
+            float cellDeltaTime = deltaTime * interval;
+            
+            // Apply temperature effects to all cells
+            MaterialID material = cell.material;
+            applyTemperature(worldX, worldY, cellDeltaTime);
+            if (cell.material != material) reactionMask.markAround(localX, localY);
+            
+            // Process interactions with ALL neighboring cells
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    if (dx == 0 && dy == 0) continue;
+                    
+                    int nx = worldX + dx;
+                    int ny = worldY + dy;
+                    
+                    if (isValidPosition(nx, ny)) {
+                        // Process material interaction and heat transfer between cells
+                        bool mayReact = reactionMask.isCandidate(localX, localY);
+                        if (processMaterialInteraction(worldX, worldY, nx, ny, cellDeltaTime, mayReact)) {
+                            reactionMask.markAround(localX, localY);
+                            reactionMask.markAround(localX + dx, localY + dy);
+                        }
+                    }
+                }
+            }
+            
+            // Check for state changes by temperature for this cell
+            // This handles phase transitions like water->steam, etc.
+            material = cell.material;
+            if (cellProcessor.checkStateChangeByTemperature(cell)) {
+                reactionMask.markAround(localX, localY);
+                noteMaterialChange(worldX, worldY, material, cell.material);
+            }
+        }
+    }
+}
+
 void CellularPhysics::update(float deltaTime)
 {
     // Reset update tracking for new frame
     resetUpdateTracker();
     
+    // Attribute sampled CPU time to phase, chunk and material (plain stores,
+    // restored when the update returns)
+    SampleContextScope sampleScope("chunk_update");
+    SampleContext& sampleContext = currentSampleContext();
+    
+    // Re-expand breached liquid bodies and aggregate newly settled ones
+    if (liquidBodies->isEnabled()) {
+        sampleContext.phase = "liquid_bodies";
+        liquidBodies->update(deltaTime);
+        sampleContext.phase = "chunk_update";
+    }
+    
+    // Absorb sparse gas into the coarse field and advance it
+    if (gasField) {
+        sampleContext.phase = "gas_field";
+        gasField->update(deltaTime);
+        noteGasFieldChanges();
+        sampleContext.phase = "chunk_update";
+    }
+    
+    // Fly debris and sparks, landing those that came to rest
+    if (particles && !particles->empty()) {
+        sampleContext.phase = "particles";
+        particles->update(deltaTime);
+        noteParticleLandings();
+        sampleContext.phase = "chunk_update";
+    }
+    
+    // Fast-forward chunks that came back into the update region
+    std::vector<ThawedChunk> thawed = chunkManager->takeThawedChunks();
+    if (catchUp && !thawed.empty()) {
+        sampleContext.phase = "catch_up";
+        for (const ThawedChunk& entry : thawed) {
+            if (Chunk* chunk = chunkManager->getChunk(entry.coord)) {
+                catchUp->catchUp(*chunk, entry.frozenSeconds, deltaTime);
+                if (conductors) conductors->noteChunk(entry.coord);
+            }
+        }
+        sampleContext.phase = "chunk_update";
+    }
+    
     // Use optimized parallel chunk processing for better performance
     chunkManager->updateChunksParallel(deltaTime);
+    const int chunkSize = chunkManager->getChunkSize();
     
     // Directly update all cells in active chunks
     const auto& activeChunks = chunkManager->getActiveChunks();
     
+    // Per-chunk cost tracking for the watchdog, accumulated over both phases
+    using Clock = std::chrono::steady_clock;
+    size_t costCursor = 0;
+    Clock::time_point chunkStart;
+    chunkCosts.clear();
+    
     // FIRST PHASE: Process all cell movements based on their type
-    for (const auto& chunkCoord : activeChunks) {
-        Chunk* chunk = chunkManager->getChunk(chunkCoord);
-        if (chunk) {
-            // Process cells in the chunk using our update methods
-            for (int localY = 0; localY < CHUNK_SIZE; localY++) {
-                for (int localX = 0; localX < CHUNK_SIZE; localX++) {
-                    // Convert to world coordinates
-                    int worldX = chunkCoord.x * CHUNK_SIZE + localX;
-                    int worldY = chunkCoord.y * CHUNK_SIZE + localY;
-                    
-                    // Get cell and material 
-                    Cell& cell = chunkManager->getCell(worldX, worldY);
-                    
-                    // Skip empty cells
-                    if (cell.material == 0) continue;
-                    
-                    // Get material properties
-                    MaterialProperties props = materialRegistry->getMaterial(cell.material);
-                    
-                    // Call the appropriate update function based on material type
-                    switch (props.type) {
-                        case MaterialType::EMPTY:
-                            updateEmpty(worldX, worldY, deltaTime);
-                            break;
-                        case MaterialType::SOLID:
-                            updateSolid(worldX, worldY, deltaTime);
-                            break;
-                        case MaterialType::POWDER:
-                            updatePowder(worldX, worldY, deltaTime);
-                            break;
-                        case MaterialType::LIQUID:
-                            updateLiquid(worldX, worldY, deltaTime);
-                            break;
-                        case MaterialType::GAS:
-                            updateGas(worldX, worldY, deltaTime);
-                            break;
-                        case MaterialType::FIRE:
-                            updateFire(worldX, worldY, deltaTime);
-                            break;
-                        case MaterialType::SPECIAL:
-                            updateSpecial(worldX, worldY, deltaTime);
-                            break;
-                    }
-                }
+    sampleContext.phase = "movement";
+    sampleContext.hasChunk = true;
+    if (strategy == ChunkUpdateStrategy::OUTBOX) {
+        moveChunksWithOutboxes(deltaTime, chunkSize);
+        if (watchdog) {
+            for (const ChunkWorker& worker : workers) {
+                addChunkCost(worker.coord, worker.costMs, costCursor);
+            }
+        }
+    } else {
+        for (const auto& chunkCoord : activeChunks) {
+            Chunk* chunk = chunkManager->getChunk(chunkCoord);
+            sampleContext.chunkX = chunkCoord.x;
+            sampleContext.chunkY = chunkCoord.y;
+            if (watchdog) chunkStart = Clock::now();
+            if (chunk) {
+                dispatchChunkSize(chunkSize, [&](auto size) {
+                    moveChunkCells<decltype(size)::value>(chunk, deltaTime);
+                });
+            }
+            if (watchdog) {
+                addChunkCost(chunkCoord, std::chrono::duration<double, std::milli>(Clock::now() - chunkStart).count(), costCursor);
             }
         }
     }
     
     // SECOND PHASE: Process all material interactions between cells
+    costCursor = 0;
+    sampleContext.phase = "interactions";
+    sampleContext.material = nullptr;
     for (const auto& chunkCoord : activeChunks) {
         Chunk* chunk = chunkManager->getChunk(chunkCoord);
+        sampleContext.chunkX = chunkCoord.x;
+        sampleContext.chunkY = chunkCoord.y;
+        if (watchdog) chunkStart = Clock::now();
         if (chunk) {
-            for (int localY = 0; localY < CHUNK_SIZE; localY++) {
-                for (int localX = 0; localX < CHUNK_SIZE; localX++) {
-                    // Convert to world coordinates
-                    int worldX = chunkCoord.x * CHUNK_SIZE + localX;
-                    int worldY = chunkCoord.y * CHUNK_SIZE + localY;
-                    
-                    // Skip empty cells or out of bounds
-                    if (!isValidPosition(worldX, worldY)) continue;
-                    Cell& cell = chunkManager->getCell(worldX, worldY);
-                    if (cell.material == 0) continue;
-                    
-                    // Apply temperature effects to all cells
-                    applyTemperature(worldX, worldY, deltaTime);
-                    
-                    // Process interactions with ALL neighboring cells
-                    for (int dy = -1; dy <= 1; dy++) {
-                        for (int dx = -1; dx <= 1; dx++) {
-                            if (dx == 0 && dy == 0) continue;
-                            
-                            int nx = worldX + dx;
-                            int ny = worldY + dy;
-                            
-                            if (isValidPosition(nx, ny)) {
-                                // Process material interaction and heat transfer between cells
-                                processMaterialInteraction(worldX, worldY, nx, ny, deltaTime);
-                            }
-                        }
-                    }
-                    
-                    // Check for state changes by temperature for this cell
-                    // This handles phase transitions like water->steam, etc.
-                    cellProcessor->checkStateChangeByTemperature(cell);
-                }
-            }
+            dispatchChunkSize(chunkSize, [&](auto size) {
+                decayChunkCells<decltype(size)::value>(chunk);
+                interactChunkCells<decltype(size)::value>(chunk, deltaTime);
+            });
+        }
+        if (watchdog) {
+            addChunkCost(chunkCoord, std::chrono::duration<double, std::milli>(Clock::now() - chunkStart).count(), costCursor);
+        }
+    }
+    
+    if (watchdog) {
+        for (const auto& cost : chunkCosts) {
+            watchdog->recordChunkCost(cost.first.x, cost.first.y, cost.second);
         }
     }
     
     // THIRD PHASE: Ensure all cells are active for the next frame
+    sampleContext.phase = "effects";
+    sampleContext.hasChunk = false;
     for (const auto& chunkCoord : activeChunks) {
         Chunk* chunk = chunkManager->getChunk(chunkCoord);
         if (chunk) {
@@ -1296,7 +1678,7 @@ void CellularPhysics::update(float deltaTime)
             //             cell.updated = true;
                         
             //             // Only give random velocity to cells that are already moving or to gases/fire
-            //             const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
+            //             const MaterialProperties& props = materialTable.getMaterial(cell.material);
                         
             //             // Check if cell is already moving - don't disturb resting cells
             //             bool isMoving = (glm::length(cell.velocity) > 0.05f);
@@ -1340,15 +1722,218 @@ void CellularPhysics::update(float deltaTime)
         }
     }
     
+    // Follow the conductor changes reported this tick and run current
+    // through charged conductors
+    if (conductors) {
+        sampleContext.phase = "conductors";
+        conductors->update(deltaTime);
+        sampleContext.phase = "chunk_update";
+    }
+    
     // If we have any active special effects, process them
     processActiveEffects(deltaTime);
 }
 
+void CellularPhysics::moveChunksWithOutboxes(float deltaTime, int chunkSize)
+{
+    using Clock = std::chrono::steady_clock;
+    
+    // One task per resident active chunk
+    workerIndex.clear();
+    size_t count = 0;
+    for (const auto& chunkCoord : chunkManager->getActiveChunks()) {
+        Chunk* chunk = chunkManager->getChunk(chunkCoord);
+        if (!chunk) continue;
+        if (count == workers.size()) workers.emplace_back();
+        ChunkWorker& worker = workers[count];
+        worker.chunk = chunk;
+        worker.coord = chunkCoord;
+        worker.foreign.clear();
+        worker.random.seed(chunkSeed(randomSeed, chunkCoord, tick));
+        worker.outbox.reset(tick);
+        worker.conductorChanges.clear();
+        worker.costMs = 0.0;
+        workerIndex[chunkCoord] = count++;
+    }
+    workers.resize(count);
+    
+    // Snapshot every chunk before any task moves a cell, so tasks read their
+    // neighbours' cells as they were when the phase started. Each phase waits
+    // only for its own chunks, and the ticking thread takes chunks too, so the
+    // pool may be shared with other worlds and the tick pipeline.
+    pool->parallelFor(workers.size(), [this](size_t index) {
+        ChunkWorker& worker = workers[index];
+        const Cell* cells = worker.chunk->getCells();
+        worker.snapshot.assign(cells, cells + worker.chunk->getCellCount());
+    });
+    
+    pool->parallelFor(workers.size(), [this, deltaTime, chunkSize](size_t index) {
+        ChunkWorker& worker = workers[index];
+        SampleContextScope sampleScope("movement");
+        SampleContext& sampleContext = currentSampleContext();
+        sampleContext.hasChunk = true;
+        sampleContext.chunkX = worker.coord.x;
+        sampleContext.chunkY = worker.coord.y;
+        Clock::time_point start = Clock::now();
+        
+        currentWorker = &worker;
+        dispatchChunkSize(chunkSize, [&](auto size) {
+            moveChunkCells<decltype(size)::value>(worker.chunk, deltaTime);
+        });
+        currentWorker = nullptr;
+        
+        // Cells of other chunks the rules changed in place (ignition,
+        // smoke, explosions) become edits
+        for (const auto& entry : worker.foreign) {
+            const Cell& seen = entry.second.first;
+            const Cell& changed = entry.second.second;
+            if (sameCell(seen, changed)) continue;
+            WorldCoord cell = {static_cast<int>(static_cast<uint32_t>(entry.first >> 32)),
+                               static_cast<int>(static_cast<uint32_t>(entry.first))};
+            worker.outbox.addEdit(cell, seen.material, changed);
+        }
+        worker.costMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    });
+    
+    applyBoundaryWrites();
+}
+
+void CellularPhysics::applyBoundaryWrites()
+{
+    // Liquid bodies the tasks found overwritten re-expand first, so the
+    // writes below land on real cells
+    boundaryWrites.clear();
+    for (const ChunkWorker& worker : workers) {
+        for (const WorldCoord& cell : worker.outbox.getReleasePoints()) {
+            liquidBodies->releaseAt(cell.x, cell.y);
+        }
+        for (const WorldRect& area : worker.outbox.getReleaseAreas()) {
+            liquidBodies->releaseArea(area);
+        }
+        if (conductors) {
+            for (const WorldCoord& cell : worker.conductorChanges) {
+                conductors->noteCell(cell.x, cell.y);
+            }
+        }
+        const auto& writes = worker.outbox.getWrites();
+        boundaryWrites.insert(boundaryWrites.end(), writes.begin(), writes.end());
+    }
+    
+    outboxStats = OutboxStats();
+    outboxStats.writes = boundaryWrites.size();
+    outboxStats.conflicts = settleBoundaryWrites(boundaryWrites);
+    
+    // A write only applies while its cells hold the materials the task saw;
+    // otherwise the cell stays put and tries again next tick
+    for (const BoundaryWrite& write : boundaryWrites) {
+        const WorldCoord& from = write.from;
+        const WorldCoord& to = write.to;
+        if (!isValidPosition(from.x, from.y) || !isValidPosition(to.x, to.y) ||
+            getCell(from.x, from.y).material != write.fromMaterial ||
+            getCell(to.x, to.y).material != write.toMaterial) {
+            outboxStats.stale++;
+            continue;
+        }
+        
+        switch (write.kind) {
+            case BoundaryWrite::Kind::MOVE:
+                moveCell(from.x, from.y, to.x, to.y);
+                break;
+            case BoundaryWrite::Kind::SWAP:
+                swapCells(from.x, from.y, to.x, to.y);
+                break;
+            case BoundaryWrite::Kind::EDIT:
+                noteMaterialChange(to.x, to.y, write.toMaterial, write.cell.material);
+                getCell(to.x, to.y) = write.cell;
+                break;
+        }
+        outboxStats.applied++;
+    }
+}
+
+void CellularPhysics::releaseLiquidAt(int x, int y)
+{
+    if (currentWorker) {
+        currentWorker->outbox.addRelease(WorldCoord{x, y});
+    } else {
+        liquidBodies->releaseAt(x, y);
+    }
+}
+
+void CellularPhysics::releaseLiquidArea(const WorldRect& area)
+{
+    if (currentWorker) {
+        currentWorker->outbox.addRelease(area);
+    } else {
+        liquidBodies->releaseArea(area);
+    }
+}
+
+void CellularPhysics::noteMaterialChange(int x, int y, MaterialID before, MaterialID after)
+{
+    if (!conductors || conductors->conducts(before) == conductors->conducts(after)) {
+        return;
+    }
+    if (currentWorker) {
+        currentWorker->conductorChanges.push_back({x, y});
+    } else {
+        conductors->noteCell(x, y);
+    }
+}
+
+void CellularPhysics::noteGasFieldChanges()
+{
+    // The field takes in and gives back whole blocks of cells, so its chunks
+    // are rescanned, and only while one of the gases it tracks conducts
+    if (!conductors || gasField->getChangedChunks().empty()) {
+        return;
+    }
+    bool conductiveGas = false;
+    for (size_t id = 0; id < materialTable.size() && !conductiveGas; id++) {
+        MaterialID material = static_cast<MaterialID>(id);
+        conductiveGas = gasField->tracks(material) && conductors->conducts(material);
+    }
+    if (!conductiveGas) {
+        return;
+    }
+    for (const ChunkCoord& coord : gasField->getChangedChunks()) {
+        conductors->noteChunk(coord);
+    }
+}
+
+void CellularPhysics::noteParticleLandings()
+{
+    if (!conductors) {
+        return;
+    }
+    for (const WorldCoord& cell : particles->getLanded()) {
+        conductors->noteCell(cell.x, cell.y);
+    }
+}
+
+void CellularPhysics::addChunkCost(const ChunkCoord& coord, double ms, size_t& cursor)
+{
+    // Both phases visit the active set in order, but chunks activated by cells
+    // moving during the first phase only show up in the second one
+    while (cursor < chunkCosts.size() && chunkCosts[cursor].first < coord) {
+        cursor++;
+    }
+    if (cursor < chunkCosts.size() && chunkCosts[cursor].first == coord) {
+        chunkCosts[cursor].second += ms;
+    } else {
+        chunkCosts.insert(chunkCosts.begin() + cursor, {coord, ms});
+    }
+    cursor++;
+}
+
 void CellularPhysics::createExplosion(int x, int y, float radius, float power)
 {
     // Apply force and damage in a circular area
     int intRadius = static_cast<int>(radius);
     
+    // Heated and damaged liquid has to be simulated per cell again
+    releaseLiquidArea({x - intRadius, y - intRadius, 2 * intRadius + 1, 2 * intRadius + 1});
+    
     for (int dy = -intRadius; dy <= intRadius; dy++) {
         for (int dx = -intRadius; dx <= intRadius; dx++) {
             int nx = x + dx;
@@ -1375,37 +1960,67 @@ void CellularPhysics::createExplosion(int x, int y, float radius, float power)
             
             // Apply explosion effects
             Cell& cell = getCell(nx, ny);
+            const MaterialID material = cell.material;
             
             // Apply force
             applyForce(nx, ny, direction * forceMagnitude);
             
             // Apply damage
-            cellProcessor->damageCell(cell, damageAmount);
+            cellProcessor.damageCell(cell, damageAmount);
             
             // Increase temperature
             cell.temperature += 200.0f * intensity;
             
             // Chance to ignite flammable materials
-            const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
-            if (props.flammable && cellProcessor->rollProbability(props.flammability * intensity)) {
-                cellProcessor->igniteCell(cell);
+            const MaterialProperties& props = materialTable.getMaterial(cell.material);
+            if (props.flammable && cellRandom().rollProbability(props.flammability * intensity)) {
+                cellProcessor.igniteCell(cell, cellRandom());
+            }
+            
+            // Loose cells fly off as debris and droplets. Explosions set off
+            // inside OUTBOX tasks leave the particles alone.
+            MaterialType type = materialTable.getMaterial(cell.material).type;
+            if (particles && !currentWorker && (type == MaterialType::POWDER || type == MaterialType::LIQUID) &&
+                cellRandom().rollProbability(particles->getConfig().ejectChance)) {
+                float speed = particles->getConfig().ejectSpeed * power * intensity;
+                if (particles->spawn(nx + 0.5f, ny + 0.5f, direction.x * speed, direction.y * speed, cell)) {
+                    cellProcessor.initializeCellFromMaterial(cell, materialTable.getDefaultMaterialID());
+                }
             }
+            noteMaterialChange(nx, ny, material, cell.material);
         }
     }
     
     // Create fire at the center of explosion
     if (isValidPosition(x, y)) {
         Cell& centerCell = getCell(x, y);
-        centerCell.material = materialRegistry->getFireID();
+        noteMaterialChange(x, y, centerCell.material, materialTable.getFireID());
+        centerCell.material = materialTable.getFireID();
         centerCell.temperature = 800.0f;
         centerCell.setFlag(Cell::FLAG_BURNING);
     }
+    
+    // Sparks thrown from the centre land as fire
+    if (particles && !currentWorker) {
+        const ParticleSystemConfig& config = particles->getConfig();
+        Cell spark;
+        cellProcessor.initializeCellFromMaterial(spark, materialTable.getFireID());
+        spark.temperature = 800.0f;
+        spark.setFlag(Cell::FLAG_BURNING);
+        for (int i = 0; i < config.sparks; i++) {
+            float angle = cellRandom().getRandomFloat(0.0f, 6.2831853f);
+            float speed = config.ejectSpeed * power * cellRandom().getRandomFloat(0.5f, 1.0f);
+            particles->spawn(x + 0.5f, y + 0.5f, std::cos(angle) * speed, std::sin(angle) * speed, spark,
+                             config.sparkSeconds);
+        }
+    }
 }
 
 void CellularPhysics::createHeatSource(int x, int y, float temperature, float radius)
 {
     // Apply heat in a circular area
     int intRadius = static_cast<int>(radius);
+    releaseLiquidArea({x - intRadius, y - intRadius, 2 * intRadius + 1, 2 * intRadius + 1});
     
     for (int dy = -intRadius; dy <= intRadius; dy++) {
         for (int dx = -intRadius; dx <= intRadius; dx++) {
@@ -1427,7 +2042,7 @@ void CellularPhysics::createHeatSource(int x, int y, float temperature, float ra
             cell.temperature = std::max(cell.temperature, heatAmount);
             
             // Check for state changes due to temperature
-            cellProcessor->checkStateChangeByTemperature(cell);
+            cellProcessor.checkStateChangeByTemperature(cell);
         }
     }
 }
@@ -1461,7 +2076,7 @@ void CellularPhysics::applyForceField(int x, int y, const glm::vec2& direction,
 bool CellularPhysics::isCellUpdated(int x, int y) const
 {
     if (!isValidPosition(x, y)) return false;
-    return updated[y][x];
+    return isUpdated(x, y);
 }
 
 void CellularPhysics::visualizePropertyField(const std::string& propertyName)
@@ -1483,27 +2098,59 @@ void CellularPhysics::processActiveEffects(float deltaTime)
         // Process heat sources
         Chunk* chunk = chunkManager->getChunk(chunkCoord);
         if (chunk) {
-            for (int y = 0; y < CHUNK_SIZE; y++) {
-                for (int x = 0; x < CHUNK_SIZE; x++) {
-                    Cell& cell = chunk->getCell(x, y);
-                    
-                    // Skip cells that aren't heat sources
-                    if (cell.metadata != 1) continue;
-                    
-                    // Convert local coordinates to world coordinates
-                    WorldCoord worldCoord = ChunkManager::chunkToWorldCoord(
-                        chunkCoord, {x, y}
-                    );
-                    
-                    // Apply heat to surrounding cells
-                    float radius = static_cast<float>(cell.temperature / 100.0f);
-                    createHeatSource(worldCoord.x, worldCoord.y, cell.temperature, radius);
-                }
-            }
+            dispatchChunkSize(chunk->getSize(), [&](auto size) {
+                processChunkHeatSources<decltype(size)::value>(chunk);
+            });
         }
     }
 }
 
+template <int Size>
+void CellularPhysics::processChunkHeatSources(Chunk* chunk)
+{
+    for (int y = 0; y < Size; y++) {
+        for (int x = 0; x < Size; x++) {
+            Cell& cell = chunk->cellAt<Size>(x, y);
+            
+            // Skip cells that aren't heat sources
+            if (cell.metadata != 1) continue;
+            
+            // Convert local coordinates to world coordinates
+            WorldCoord worldCoord = ChunkManager::chunkToWorldCoord(
+                chunk->getCoord(), {x, y}, Size
+            );
+            
+            // Apply heat to surrounding cells
+            float radius = static_cast<float>(cell.temperature / 100.0f);
+            createHeatSource(worldCoord.x, worldCoord.y, cell.temperature, radius);
+        }
+    }
+}
+
+void CellularPhysics::addMemoryUsage(MemoryReport& report) const
+{
+    report.add("materials/table", materialTable.getMemoryUsage(), materialTable.size());
+    report.add("materials/reactions", reactionMatrix.getMemoryUsage());
+    
+    // Per-tick scratch, reused from tick to tick
+    size_t outboxBytes = heapBytes(workers) + heapBytes(workerIndex) + heapBytes(boundaryWrites);
+    for (const ChunkWorker& worker : workers) {
+        outboxBytes += heapBytes(worker.snapshot) + heapBytes(worker.foreign) + worker.outbox.getMemoryUsage();
+    }
+    report.add("tick/reaction_mask", reactionMask.getMemoryUsage());
+    report.add("tick/outbox", outboxBytes, workers.size());
+    report.add("tick/scratch", heapBytes(chunkCosts) + heapBytes(expiredCells));
+    
+    // Disabled modules are reported as empty so the entries stay the same
+    // from tick to tick
+    report.add("modules/liquid_bodies", liquidBodies->getMemoryUsage(), liquidBodies->getBodies().size());
+    report.add("modules/gas_field", gasField ? gasField->getMemoryUsage() : 0);
+    report.add("modules/catch_up", catchUp ? catchUp->getMemoryUsage() : 0);
+    report.add("modules/particles", particles ? particles->getMemoryUsage() : 0, particles ? particles->size() : 0);
+    report.add("modules/conductors", conductors ? conductors->getMemoryUsage() : 0,
+               conductors ? conductors->getStats().components : 0);
+}
+
 void CellularPhysics::dumpPerformanceStats() const
 {
     // Get performance statistics from the chunk manager
@@ -0,0 +1,258 @@
+#include "astral/physics/ChunkCatchUp.h"
+#include "astral/physics/CellProcessor.h"
+#include "astral/physics/CellularPhysics.h"
+#include "astral/physics/ChunkManager.h"
+#include "astral/physics/Material.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace astral {
+
+namespace {
+
+// Lifetimes and temperatures the per-tick rules give burning cells
+constexpr int WOOD_FIRE_TICKS = 25;        // Fire left when wood burns through
+constexpr float FIRE_BURN_TICKS = 200.0f;  // Fire lifetime per unit of burnRate
+
+constexpr double NEVER = std::numeric_limits<double>::infinity();
+
+int64_t ticksIn(double seconds, float deltaTime)
+{
+    return static_cast<int64_t>(std::min(std::floor(seconds / deltaTime), 1e12));
+}
+
+uint8_t fireTicks(const MaterialProperties& fuel)
+{
+    return static_cast<uint8_t>(std::clamp(fuel.burnRate * FIRE_BURN_TICKS, 1.0f, 255.0f));
+}
+
+bool falls(const MaterialProperties& props)
+{
+    return props.type == MaterialType::POWDER || props.type == MaterialType::LIQUID;
+}
+
+bool givesWay(const MaterialProperties& props)
+{
+    return props.type == MaterialType::EMPTY || props.type == MaterialType::GAS;
+}
+
+} // namespace
+
+ChunkCatchUp::ChunkCatchUp(const CellProcessor* processor, const ChunkCatchUpConfig& config)
+    : processor(processor)
+    , config(config)
+{
+}
+
+bool ChunkCatchUp::catchUp(Chunk& chunk, double frozenSeconds, float deltaTime)
+{
+    if (deltaTime <= 0.0f || frozenSeconds < config.minFrozenSeconds) {
+        return false;
+    }
+
+    advanceLifetimes(chunk, frozenSeconds, deltaTime);
+    relaxTemperatures(chunk, frozenSeconds);
+    settleColumns(chunk, ticksIn(frozenSeconds, deltaTime));
+    chunk.markDirty();
+
+    stats.chunks++;
+    stats.seconds += frozenSeconds;
+    return true;
+}
+
+double ChunkCatchUp::burnSeconds(const Cell& cell, const MaterialProperties& props, float deltaTime) const
+{
+    const MaterialTable& materials = processor->getMaterials();
+    if (props.type == MaterialType::FIRE) {
+        return std::max<int>(1, cell.lifetime) * static_cast<double>(deltaTime);
+    }
+    if (cell.material == materials.getWoodID()) {
+        return std::max(0.0f, cell.health) / config.woodBurnRate + WOOD_FIRE_TICKS * static_cast<double>(deltaTime);
+    }
+    return fireTicks(props) * static_cast<double>(deltaTime);
+}
+
+void ChunkCatchUp::advanceLifetimes(Chunk& chunk, double seconds, float deltaTime)
+{
+    const MaterialTable& materials = processor->getMaterials();
+    const int size = chunk.getSize();
+    ignitedAt.assign(static_cast<size_t>(size) * size, NEVER);
+
+    // Earliest time fire reaches each cell, spreading from what burns now
+    using Arrival = std::pair<double, int>;
+    std::priority_queue<Arrival, std::vector<Arrival>, std::greater<Arrival>> front;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            const Cell& cell = chunk.getCell(x, y);
+            if (cell.hasFlag(Cell::FLAG_BURNING) || materials.getMaterial(cell.material).type == MaterialType::FIRE) {
+                ignitedAt[y * size + x] = 0.0;
+                front.push({0.0, y * size + x});
+            }
+        }
+    }
+    const int dx[] = {1, -1, 0, 0};
+    const int dy[] = {0, 0, 1, -1};
+    while (!front.empty()) {
+        Arrival arrival = front.top();
+        front.pop();
+        if (arrival.first > ignitedAt[arrival.second]) continue;
+
+        int x = arrival.second % size;
+        int y = arrival.second / size;
+        const Cell& cell = chunk.getCell(x, y);
+        double burntOut = arrival.first + burnSeconds(cell, materials.getMaterial(cell.material), deltaTime);
+        for (int i = 0; i < 4; i++) {
+            int nx = x + dx[i];
+            int ny = y + dy[i];
+            if (nx < 0 || ny < 0 || nx >= size || ny >= size) continue;
+            const MaterialProperties& props = materials.getMaterial(chunk.getCell(nx, ny).material);
+            if (!props.flammable || props.flammability <= 0.0f || props.type == MaterialType::FIRE) continue;
+
+            double reached = arrival.first + 1.0 / (config.spreadRate * props.flammability);
+            if (reached > seconds || reached > burntOut || reached >= ignitedAt[ny * size + nx]) continue;
+            ignitedAt[ny * size + nx] = reached;
+            front.push({reached, ny * size + nx});
+        }
+    }
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            Cell& cell = chunk.getCell(x, y);
+            const MaterialProperties& props = materials.getMaterial(cell.material);
+            double ignited = ignitedAt[y * size + x];
+            if (ignited == NEVER) {
+                // Gases that were left alone just run out
+                if (props.type == MaterialType::GAS) {
+                    expire(cell, ticksIn(seconds, deltaTime));
+                }
+                continue;
+            }
+
+            double burning = seconds - ignited;
+            if (props.type == MaterialType::FIRE) {
+                expire(cell, ticksIn(burning, deltaTime));
+            } else if (cell.material == materials.getWoodID()) {
+                // Wood burns in place until its health is gone
+                double consumed = ignited + std::max(0.0f, cell.health) / config.woodBurnRate;
+                cell.setFlag(Cell::FLAG_BURNING);
+                if (consumed > seconds) {
+                    cell.health -= static_cast<float>(burning * config.woodBurnRate);
+                    cell.temperature = std::max(cell.temperature, 400.0f);
+                    continue;
+                }
+                cell.material = materials.getFireID();
+                cell.temperature = 400.0f;
+                cell.lifetime = WOOD_FIRE_TICKS;
+                expire(cell, ticksIn(seconds - consumed, deltaTime));
+            } else {
+                // Other fuels turn to fire when they catch
+                bool oil = cell.material == materials.getOilID();
+                cell.material = oil ? materials.getOilFireID() : materials.getFireID();
+                cell.temperature = oil ? 650.0f : 550.0f;
+                cell.lifetime = fireTicks(props);
+                cell.setFlag(Cell::FLAG_BURNING);
+                expire(cell, ticksIn(burning, deltaTime));
+            }
+        }
+    }
+}
+
+void ChunkCatchUp::expire(Cell& cell, int64_t ticks)
+{
+    // Count the lifetime down as the decay pass would and apply the table's
+    // DecayRule each time it runs out, with the average lifetime jitter
+    const MaterialTable& materials = processor->getMaterials();
+    while (ticks > 0 && materials.decays(cell.material) && cell.lifetime > 0) {
+        if (cell.lifetime > ticks) {
+            cell.lifetime = static_cast<uint8_t>(cell.lifetime - ticks);
+            return;
+        }
+        ticks -= cell.lifetime;
+        bool fire = materials.getMaterial(cell.material).type == MaterialType::FIRE;
+        processor->applyDecay(cell, materials.getDecayRule(cell.material).lifetimeJitter / 2);
+        if (fire) {
+            stats.burnedOut++;
+        } else {
+            stats.expired++;
+        }
+    }
+}
+
+void ChunkCatchUp::relaxTemperatures(Chunk& chunk, double seconds)
+{
+    const MaterialTable& materials = processor->getMaterials();
+    const int size = chunk.getSize();
+    const float remaining = static_cast<float>(std::exp(-CellularPhysics::AMBIENT_RATE * seconds));
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            Cell& cell = chunk.getCell(x, y);
+            if (cell.material == materials.getDefaultMaterialID() || cell.hasFlag(Cell::FLAG_BURNING) ||
+                materials.getMaterial(cell.material).type == MaterialType::FIRE) {
+                continue;
+            }
+            const float ambient = CellularPhysics::AMBIENT_TEMPERATURE;
+            cell.temperature = ambient + (cell.temperature - ambient) * remaining;
+            processor->checkStateChangeByTemperature(cell);
+        }
+    }
+}
+
+void ChunkCatchUp::settleColumns(Chunk& chunk, int64_t ticks)
+{
+    const MaterialTable& materials = processor->getMaterials();
+    const int size = chunk.getSize();
+    for (int x = 0; x < size; x++) {
+        // Segments of the column between cells that hold things up; down is +y
+        int bottom = size - 1;
+        while (bottom >= 0) {
+            const MaterialProperties& base = materials.getMaterial(chunk.getCell(x, bottom).material);
+            if (!falls(base) && !givesWay(base)) {
+                bottom--;
+                continue;
+            }
+            int top = bottom;
+            while (top > 0) {
+                const MaterialProperties& above = materials.getMaterial(chunk.getCell(x, top - 1).material);
+                if (!falls(above) && !givesWay(above)) break;
+                top--;
+            }
+
+            // Falling cells drop by up to ticks cells, keeping their order;
+            // the cells they pass through move up into the gaps
+            const int length = bottom - top + 1;
+            column.resize(length);
+            columnTaken.assign(length, 0);
+            int floor = length - 1;
+            size_t moved = 0;
+            for (int i = length - 1; i >= 0; i--) {
+                const Cell& cell = chunk.getCell(x, top + i);
+                if (!falls(materials.getMaterial(cell.material))) continue;
+                int target = static_cast<int>(std::min<int64_t>(floor, i + ticks));
+                column[target] = cell;
+                columnTaken[target] = 1;
+                if (target != i) moved++;
+                floor = target - 1;
+            }
+            if (moved > 0) {
+                int next = 0;
+                for (int i = 0; i < length; i++) {
+                    const Cell& cell = chunk.getCell(x, top + i);
+                    if (falls(materials.getMaterial(cell.material))) continue;
+                    while (columnTaken[next]) next++;
+                    column[next] = cell;
+                    columnTaken[next] = 1;
+                }
+                for (int i = 0; i < length; i++) {
+                    chunk.getCell(x, top + i) = column[i];
+                }
+                stats.settled += moved;
+            }
+            bottom = top - 1;
+        }
+    }
+}
+
+} // namespace astral
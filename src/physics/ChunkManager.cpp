@@ -2,55 +2,173 @@
 #include "astral/physics/Material.h"
 #include <stdexcept>
 #include <algorithm>
+#include <memory>
 
 namespace astral {
 
+uint64_t hashMaterials(const MaterialID* materials, size_t count) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < count; i++) {
+        hash = (hash ^ (materials[i] & 0xFF)) * 1099511628211ull;
+        hash = (hash ^ (materials[i] >> 8)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t combineChunkHash(uint64_t seed, ChunkCoord coord, uint64_t chunkHash) {
+    uint64_t values[3] = {
+        static_cast<uint64_t>(static_cast<uint32_t>(coord.x)),
+        static_cast<uint64_t>(static_cast<uint32_t>(coord.y)),
+        chunkHash
+    };
+    for (uint64_t value : values) {
+        seed = (seed ^ value) * 1099511628211ull;
+        seed ^= seed >> 29;
+    }
+    return seed;
+}
+
+namespace {
+
+// Force material cells to be active by setting updated=true
+template <int Size>
+void markMaterialCellsUpdated(Chunk& chunk) {
+    for (int y = 0; y < Size; y++) {
+        for (int x = 0; x < Size; x++) {
+            Cell& cell = chunk.cellAt<Size>(x, y);
+            if (cell.material != 0) {
+                cell.updated = true;
+            }
+        }
+    }
+}
+
+} // namespace
+
 // ==================== Chunk Implementation ====================
 
-Chunk::Chunk(ChunkCoord coord, MaterialRegistry* materialRegistry)
+Chunk::Chunk(ChunkCoord coord, const MaterialRegistry* materialRegistry, int size, Cell* storage)
     : coord(coord)
+    , size(size)
+    , cells(storage)
+    , cellCount(static_cast<size_t>(size) * size)
     , isDirtyFlag(true)
     , isActiveFlag(false)
+    , activeCells(static_cast<size_t>(size) * size, false)
     , materialRegistry(materialRegistry)
+    , version(0)
+    , materialHash(0)
+    , updatedInTick(static_cast<size_t>(size) * size, false)
+    , trackedTick(0)
+    , aggregatedCount(0)
 {
-    // Initialize all cells to empty (air)
-    for (int y = 0; y < CHUNK_SIZE; y++) {
-        for (int x = 0; x < CHUNK_SIZE; x++) {
-            cells[y][x] = Cell();
-        }
+    // All empty (air)
+    if (storage) {
+        std::uninitialized_fill_n(storage, cellCount, Cell());
+    } else {
+        ownedCells.resize(cellCount);
+        cells = ownedCells.data();
+    }
+    
+    // Version 0 is the all-air layout
+    std::vector<MaterialID> materials(cellCount);
+    copyMaterials(materials.data());
+    materialHash = hashMaterials(materials.data(), materials.size());
+}
+
+bool Chunk::refreshVersion() {
+    // Called for every chunk each broadcast, so avoid reallocating
+    static thread_local std::vector<MaterialID> materials;
+    materials.resize(cellCount);
+    copyMaterials(materials.data());
+    
+    uint64_t hash = hashMaterials(materials.data(), materials.size());
+    if (hash == materialHash) {
+        return false;
     }
     
-    // Initialize active cells tracking
-    activeCells.resize(CHUNK_SIZE, std::vector<bool>(CHUNK_SIZE, false));
+    materialHash = hash;
+    version++;
+    return true;
+}
+
+void Chunk::copyMaterials(MaterialID* out) const {
+    for (size_t i = 0; i < cellCount; i++) {
+        out[i] = cells[i].material;
+    }
 }
 
 Cell& Chunk::getCell(int x, int y) {
-    if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_SIZE) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
         throw std::out_of_range("Cell coordinates out of range");
     }
-    return cells[y][x];
+    return cells[y * size + x];
 }
 
 const Cell& Chunk::getCell(int x, int y) const {
-    if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_SIZE) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
         throw std::out_of_range("Cell coordinates out of range");
     }
-    return cells[y][x];
+    return cells[y * size + x];
 }
 
 void Chunk::setCell(int x, int y, const Cell& cell) {
-    if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_SIZE) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
         throw std::out_of_range("Cell coordinates out of range");
     }
-    cells[y][x] = cell;
+    cells[y * size + x] = cell;
     markDirty();
 }
 
+void Chunk::relocateCells(Cell* storage) {
+    if (storage == cells || (!storage && !hasExternalStorage())) return;
+    if (storage) {
+        std::uninitialized_copy_n(cells, cellCount, storage);
+        cells = storage;
+        ownedCells.clear();
+        ownedCells.shrink_to_fit();
+    } else {
+        ownedCells.assign(cells, cells + cellCount);
+        cells = ownedCells.data();
+    }
+}
+
+void Chunk::markUpdatedInTick(int x, int y, uint64_t tick) {
+    if (trackedTick != tick) {
+        std::fill(updatedInTick.begin(), updatedInTick.end(), false);
+        trackedTick = tick;
+    }
+    updatedInTick[y * size + x] = true;
+}
+
+size_t Chunk::countUpdatedInTick(uint64_t tick) const {
+    if (trackedTick != tick) return 0;
+    return std::count(updatedInTick.begin(), updatedInTick.end(), true);
+}
+
+void Chunk::setAggregatedMaterial(int x, int y, MaterialID material) {
+    if (aggregated.empty()) {
+        if (material == 0) return;
+        aggregated.assign(cellCount, 0);
+    }
+
+    MaterialID& slot = aggregated[y * size + x];
+    if (slot == 0 && material != 0) aggregatedCount++;
+    if (slot != 0 && material == 0) aggregatedCount--;
+    slot = material;
+
+    // Chunks without bodies keep the kernels' check to one branch
+    if (aggregatedCount == 0) {
+        aggregated.clear();
+        aggregated.shrink_to_fit();
+    }
+}
+
 bool Chunk::isCellActive(int x, int y) const {
-    if (x < 0 || x >= CHUNK_SIZE || y < 0 || y >= CHUNK_SIZE) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
         return false;
     }
-    return activeCells[y][x];
+    return activeCells[y * size + x];
 }
 
 bool Chunk::hasActiveCells() const {
@@ -62,14 +180,8 @@ void Chunk::updateActiveState() {
     isActiveFlag = true;
     
     // Mark all non-empty cells as active
-    for (int y = 0; y < CHUNK_SIZE; y++) {
-        for (int x = 0; x < CHUNK_SIZE; x++) {
-            if (cells[y][x].material != 0) {
-                activeCells[y][x] = true;
-            } else {
-                activeCells[y][x] = false;
-            }
-        }
+    for (size_t i = 0; i < cellCount; i++) {
+        activeCells[i] = cells[i].material != 0;
     }
 }
 
@@ -79,16 +191,17 @@ void Chunk::update(float deltaTime) {
     
     // Check cells at edges of chunk to see if they contain particles 
     // that might need to cross boundaries
-    for (int y = 0; y < CHUNK_SIZE; y++) {
-        for (int x = 0; x < CHUNK_SIZE; x++) {
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
             // Check only boundary cells (edges of the chunk)
-            if (x == 0 || x == CHUNK_SIZE-1 || y == 0 || y == CHUNK_SIZE-1) {
-                if (cells[y][x].material != 0) {
+            if (x == 0 || x == size-1 || y == 0 || y == size-1) {
+                const Cell& cell = cells[y * size + x];
+                if (cell.material != 0) {
                     // Boundary has material - mark chunk as active
                     hasBoundaryCells = true;
                     
                     // For powder materials, explicitly force active
-                    const MaterialProperties& props = materialRegistry->getMaterial(cells[y][x].material);
+                    const MaterialProperties& props = materialRegistry->getMaterial(cell.material);
                     if (props.type == MaterialType::POWDER) {
                         setActive(true);
                         return;
@@ -110,41 +223,176 @@ void Chunk::update(float deltaTime) {
 
 // ==================== ChunkManager Implementation ====================
 
-ChunkManager::ChunkManager(MaterialRegistry* materialRegistry)
+ChunkManager::ChunkManager(const MaterialRegistry* materialRegistry, int chunkSize)
     : materialRegistry(materialRegistry)
+    , chunkSize(chunkSize)
+    , chunkShift(0)
+    , cachedCoord{0, 0}
+    , cachedChunk(nullptr)
+    , hasUpdateRegion(false)
+    , updateRegion{0, 0, 0, 0}
+    , simulationTime(0.0)
 {
+    if (!isSupportedChunkSize(chunkSize)) {
+        throw std::invalid_argument("Unsupported chunk size " + std::to_string(chunkSize));
+    }
+    while ((1 << chunkShift) < chunkSize) {
+        chunkShift++;
+    }
 }
 
-Chunk* ChunkManager::getChunk(ChunkCoord coord) {
+void ChunkManager::setUpdateRegion(const WorldRect& region) {
+    hasUpdateRegion = true;
+    updateRegion = region;
+    
+    // Drop chunks that are now outside the region
+    for (auto it = activeChunks.begin(); it != activeChunks.end();) {
+        if (!isInUpdateRegion(*it)) {
+            Chunk* chunk = getChunk(*it);
+            if (chunk) chunk->setActive(false);
+            frozenSince.emplace(*it, simulationTime);
+            it = activeChunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ChunkManager::refreshChunkVersions(std::vector<ChunkCoord>* changed) {
+    for (auto& pair : chunks) {
+        if (pair.second->refreshVersion() && changed) {
+            changed->push_back(pair.first);
+        }
+    }
+}
+
+bool ChunkManager::isInUpdateRegion(ChunkCoord coord) const {
+    if (!hasUpdateRegion) {
+        return true;
+    }
+    
+    int chunkX = coord.x * chunkSize;
+    int chunkY = coord.y * chunkSize;
+    return chunkX < updateRegion.x + updateRegion.width &&
+           chunkX + chunkSize > updateRegion.x &&
+           chunkY < updateRegion.y + updateRegion.height &&
+           chunkY + chunkSize > updateRegion.y;
+}
+
+Chunk* ChunkManager::findChunk(ChunkCoord coord) const {
+    if (cachedChunk && cachedCoord == coord) {
+        return cachedChunk;
+    }
     auto it = chunks.find(coord);
-    if (it != chunks.end()) {
-        return it->second.get();
+    if (it == chunks.end()) {
+        return nullptr;
     }
-    return nullptr;
+    cachedCoord = coord;
+    cachedChunk = it->second.get();
+    return cachedChunk;
 }
 
-Chunk* ChunkManager::getOrCreateChunk(ChunkCoord coord) {
+Chunk* ChunkManager::getChunk(ChunkCoord coord) {
+    return findChunk(coord);
+}
+
+const Chunk* ChunkManager::getChunk(ChunkCoord coord) const {
+    return findChunk(coord);
+}
+
+Chunk* ChunkManager::peekChunk(ChunkCoord coord) const {
     auto it = chunks.find(coord);
-    if (it != chunks.end()) {
-        return it->second.get();
+    return it == chunks.end() ? nullptr : it->second.get();
+}
+
+Chunk* ChunkManager::getOrCreateChunk(ChunkCoord coord) {
+    if (Chunk* chunk = findChunk(coord)) {
+        return chunk;
     }
     
-    // Create new chunk
-    auto chunk = std::make_unique<Chunk>(coord, materialRegistry);
+    // Create new chunk, in its slab slot when there is one
+    Cell* storage = slab ? slab->getChunkCells(coord) : nullptr;
+    auto chunk = std::make_unique<Chunk>(coord, materialRegistry, chunkSize, storage);
     Chunk* chunkPtr = chunk.get();
     chunks[coord] = std::move(chunk);
     
     return chunkPtr;
 }
 
+const ChunkSlab& ChunkManager::enableSlab(int worldWidth, int worldHeight, const ChunkSlabConfig& config) {
+    if (worldWidth <= 0 || worldHeight <= 0) {
+        throw std::invalid_argument("Slab storage needs a bounded world");
+    }
+    
+    disableSlab();
+    slab = std::make_unique<ChunkSlab>((worldWidth + chunkSize - 1) / chunkSize,
+                                       (worldHeight + chunkSize - 1) / chunkSize, chunkSize, config);
+    for (auto& entry : chunks) {
+        if (Cell* storage = slab->getChunkCells(entry.first)) {
+            entry.second->relocateCells(storage);
+        }
+    }
+    return *slab;
+}
+
+void ChunkManager::disableSlab() {
+    if (!slab) return;
+    for (auto& entry : chunks) {
+        entry.second->relocateCells(nullptr);
+    }
+    slab.reset();
+}
+
 void ChunkManager::removeChunk(ChunkCoord coord) {
     chunks.erase(coord);
     activeChunks.erase(coord);
+    frozenSince.erase(coord);
+    cachedChunk = nullptr;
+}
+
+void ChunkManager::clear() {
+    chunks.clear();
+    activeChunks.clear();
+    frozenSince.clear();
+    thawedChunks.clear();
+    cachedChunk = nullptr;
+}
+
+std::vector<ChunkCoord> ChunkManager::getResidentChunks() const {
+    std::vector<ChunkCoord> coords;
+    coords.reserve(chunks.size());
+    for (const auto& pair : chunks) {
+        coords.push_back(pair.first);
+    }
+    std::sort(coords.begin(), coords.end());
+    return coords;
+}
+
+size_t ChunkManager::removeChunksOutside(const WorldRect& area) {
+    size_t removed = 0;
+    for (auto it = chunks.begin(); it != chunks.end();) {
+        int chunkX = it->first.x * chunkSize;
+        int chunkY = it->first.y * chunkSize;
+        bool overlaps = chunkX < area.x + area.width && chunkX + chunkSize > area.x &&
+                        chunkY < area.y + area.height && chunkY + chunkSize > area.y;
+        if (overlaps) {
+            ++it;
+            continue;
+        }
+        activeChunks.erase(it->first);
+        frozenSince.erase(it->first);
+        it = chunks.erase(it);
+        removed++;
+    }
+    if (removed > 0) {
+        cachedChunk = nullptr;
+    }
+    return removed;
 }
 
 Cell& ChunkManager::getCell(int worldX, int worldY) {
-    ChunkCoord chunkCoord = worldToChunkCoord(worldX, worldY);
-    LocalCoord localCoord = worldToLocalCoord(worldX, worldY);
+    ChunkCoord chunkCoord = chunkCoordOf(worldX, worldY);
+    LocalCoord localCoord = localCoordOf(worldX, worldY);
     
     Chunk* chunk = getOrCreateChunk(chunkCoord);
     return chunk->getCell(localCoord.x, localCoord.y);
@@ -155,15 +403,15 @@ Cell& ChunkManager::getCell(WorldCoord coord) {
 }
 
 const Cell& ChunkManager::getCell(int worldX, int worldY) const {
-    ChunkCoord chunkCoord = worldToChunkCoord(worldX, worldY);
-    LocalCoord localCoord = worldToLocalCoord(worldX, worldY);
+    ChunkCoord chunkCoord = chunkCoordOf(worldX, worldY);
+    LocalCoord localCoord = localCoordOf(worldX, worldY);
     
-    auto it = chunks.find(chunkCoord);
-    if (it == chunks.end()) {
+    const Chunk* chunk = findChunk(chunkCoord);
+    if (!chunk) {
         throw std::out_of_range("No chunk at the specified coordinates");
     }
     
-    return it->second->getCell(localCoord.x, localCoord.y);
+    return chunk->getCell(localCoord.x, localCoord.y);
 }
 
 const Cell& ChunkManager::getCell(WorldCoord coord) const {
@@ -171,47 +419,47 @@ const Cell& ChunkManager::getCell(WorldCoord coord) const {
 }
 
 void ChunkManager::setCell(int worldX, int worldY, const Cell& cell) {
-    ChunkCoord chunkCoord = worldToChunkCoord(worldX, worldY);
-    LocalCoord localCoord = worldToLocalCoord(worldX, worldY);
+    ChunkCoord chunkCoord = chunkCoordOf(worldX, worldY);
+    LocalCoord localCoord = localCoordOf(worldX, worldY);
     
     Chunk* chunk = getOrCreateChunk(chunkCoord);
     chunk->setCell(localCoord.x, localCoord.y, cell);
     chunk->markDirty();
     
     // Add to active chunks if not already there
-    activeChunks.insert(chunkCoord);
+    activateChunk(chunkCoord);
 }
 
 void ChunkManager::setCell(WorldCoord coord, const Cell& cell) {
     setCell(coord.x, coord.y, cell);
 }
 
-ChunkCoord ChunkManager::worldToChunkCoord(int worldX, int worldY) {
+ChunkCoord ChunkManager::worldToChunkCoord(int worldX, int worldY, int chunkSize) {
     // Handle negative coordinates correctly
-    int chunkX = (worldX >= 0) ? (worldX / CHUNK_SIZE) : ((worldX - CHUNK_SIZE + 1) / CHUNK_SIZE);
-    int chunkY = (worldY >= 0) ? (worldY / CHUNK_SIZE) : ((worldY - CHUNK_SIZE + 1) / CHUNK_SIZE);
+    int chunkX = (worldX >= 0) ? (worldX / chunkSize) : ((worldX - chunkSize + 1) / chunkSize);
+    int chunkY = (worldY >= 0) ? (worldY / chunkSize) : ((worldY - chunkSize + 1) / chunkSize);
     
     return {chunkX, chunkY};
 }
 
-ChunkCoord ChunkManager::worldToChunkCoord(WorldCoord worldCoord) {
-    return worldToChunkCoord(worldCoord.x, worldCoord.y);
+ChunkCoord ChunkManager::worldToChunkCoord(WorldCoord worldCoord, int chunkSize) {
+    return worldToChunkCoord(worldCoord.x, worldCoord.y, chunkSize);
 }
 
-LocalCoord ChunkManager::worldToLocalCoord(int worldX, int worldY) {
+LocalCoord ChunkManager::worldToLocalCoord(int worldX, int worldY, int chunkSize) {
     // Handle negative coordinates correctly
-    int localX = worldX >= 0 ? (worldX % CHUNK_SIZE) : (CHUNK_SIZE + (worldX % CHUNK_SIZE)) % CHUNK_SIZE;
-    int localY = worldY >= 0 ? (worldY % CHUNK_SIZE) : (CHUNK_SIZE + (worldY % CHUNK_SIZE)) % CHUNK_SIZE;
+    int localX = worldX >= 0 ? (worldX % chunkSize) : (chunkSize + (worldX % chunkSize)) % chunkSize;
+    int localY = worldY >= 0 ? (worldY % chunkSize) : (chunkSize + (worldY % chunkSize)) % chunkSize;
     
     return {localX, localY};
 }
 
-LocalCoord ChunkManager::worldToLocalCoord(WorldCoord worldCoord) {
-    return worldToLocalCoord(worldCoord.x, worldCoord.y);
+LocalCoord ChunkManager::worldToLocalCoord(WorldCoord worldCoord, int chunkSize) {
+    return worldToLocalCoord(worldCoord.x, worldCoord.y, chunkSize);
 }
 
-WorldCoord ChunkManager::chunkToWorldCoord(ChunkCoord chunkCoord, LocalCoord localCoord) {
-    return {chunkCoord.x * CHUNK_SIZE + localCoord.x, chunkCoord.y * CHUNK_SIZE + localCoord.y};
+WorldCoord ChunkManager::chunkToWorldCoord(ChunkCoord chunkCoord, LocalCoord localCoord, int chunkSize) {
+    return {chunkCoord.x * chunkSize + localCoord.x, chunkCoord.y * chunkSize + localCoord.y};
 }
 
 void ChunkManager::updateActiveChunks(const WorldRect& activeArea) {
@@ -227,62 +475,75 @@ void ChunkManager::updateActiveChunks(const WorldRect& activeArea) {
     // Activate all chunks, regardless of their position or content
     for (const auto& coord : allChunks) {
         Chunk* chunk = getChunk(coord);
-        if (chunk) {
+        if (chunk && isInUpdateRegion(coord)) {
             // Force the chunk to be active
             chunk->setActive(true);
             
             // Make sure all cells in the chunk are marked as updated
-            for (int y = 0; y < CHUNK_SIZE; y++) {
-                for (int x = 0; x < CHUNK_SIZE; x++) {
-                    Cell& cell = chunk->getCell(x, y);
-                    if (cell.material != 0) {
-                        cell.updated = true;
-                    }
-                }
-            }
+            dispatchChunkSize(chunkSize, [chunk](auto size) {
+                markMaterialCellsUpdated<decltype(size)::value>(*chunk);
+            });
             
             // Add to active chunks set
-            activeChunks.insert(coord);
+            activateChunk(coord);
         }
     }
     
     // Create chunks for the active area if they don't exist
-    ChunkCoord minChunk = worldToChunkCoord(activeArea.x, activeArea.y);
+    if (activeArea.width <= 0 || activeArea.height <= 0) {
+        return;
+    }
+    ChunkCoord minChunk = worldToChunkCoord(activeArea.x, activeArea.y, chunkSize);
     ChunkCoord maxChunk = worldToChunkCoord(
         activeArea.x + activeArea.width - 1, 
-        activeArea.y + activeArea.height - 1
+        activeArea.y + activeArea.height - 1,
+        chunkSize
     );
     
     for (int y = minChunk.y; y <= maxChunk.y; y++) {
         for (int x = minChunk.x; x <= maxChunk.x; x++) {
             ChunkCoord coord = {x, y};
+            if (!isInUpdateRegion(coord)) continue;
             
             // Create chunk if it doesn't exist
             Chunk* chunk = getOrCreateChunk(coord);
             
             // Ensure it's active
             chunk->setActive(true);
-            activeChunks.insert(coord);
+            activateChunk(coord);
         }
     }
 }
 
+void ChunkManager::activateChunk(ChunkCoord coord) {
+    if (!activeChunks.insert(coord).second || frozenSince.empty()) {
+        return;
+    }
+    auto frozen = frozenSince.find(coord);
+    if (frozen != frozenSince.end()) {
+        thawedChunks.push_back({coord, simulationTime - frozen->second});
+        frozenSince.erase(frozen);
+    }
+}
+
+std::vector<ThawedChunk> ChunkManager::takeThawedChunks() {
+    std::vector<ThawedChunk> taken;
+    taken.swap(thawedChunks);
+    return taken;
+}
+
 void ChunkManager::updateChunks(float deltaTime) {
+    simulationTime += deltaTime;
+    
     // Update all active chunks
     for (const auto& chunkCoord : activeChunks) {
         Chunk* chunk = getChunk(chunkCoord);
         if (chunk) {
             // Set all non-empty cells active - THIS IS THE BUG FIX
             // We need this for every update to ensure cells with materials are ALWAYS processed
-            for (int y = 0; y < CHUNK_SIZE; y++) {
-                for (int x = 0; x < CHUNK_SIZE; x++) {
-                    Cell& cell = chunk->getCell(x, y);
-                    // The fix: Force material cells to be active by setting updated=true
-                    if (cell.material != 0) {
-                        cell.updated = true;
-                    }
-                }
-            }
+            dispatchChunkSize(chunkSize, [chunk](auto size) {
+                markMaterialCellsUpdated<decltype(size)::value>(*chunk);
+            });
             
             // Mark the chunk as active
             chunk->setActive(true);
@@ -296,6 +557,59 @@ void ChunkManager::updateChunks(float deltaTime) {
     // This was the bug - chunks need to stay active
 }
 
+ChunkManager::PerformanceStats ChunkManager::getPerformanceStats() const {
+    PerformanceStats stats;
+    stats.totalChunks = chunks.size();
+    stats.activeChunks = activeChunks.size();
+    stats.totalCells = chunks.size() * chunkSize * chunkSize;
+    
+    // Chunks only clear their flags when marked again, so older ticks'
+    // flags are left out by counting the newest tick only
+    uint64_t newestTick = 0;
+    for (const ChunkCoord& coord : activeChunks) {
+        if (const Chunk* chunk = findChunk(coord)) {
+            newestTick = std::max(newestTick, chunk->getTrackedTick());
+        }
+    }
+    for (const ChunkCoord& coord : activeChunks) {
+        if (const Chunk* chunk = findChunk(coord)) {
+            stats.activeCells += chunk->countUpdatedInTick(newestTick);
+        }
+    }
+    stats.activePercentage = stats.totalCells > 0 ? (stats.activeCells * 100.0f / stats.totalCells) : 0.0f;
+    return stats;
+}
+
+void ChunkManager::addMemoryUsage(MemoryReport& report) const {
+    size_t ownedBytes = 0, ownedChunks = 0;
+    size_t updatedBytes = 0, activeBytes = 0;
+    size_t aggregatedBytes = 0, aggregatedChunks = 0;
+    for (const auto& pair : chunks) {
+        const Chunk& chunk = *pair.second;
+        if (!chunk.hasExternalStorage()) {
+            ownedBytes += chunk.getOwnedCellBytes();
+            ownedChunks++;
+        }
+        updatedBytes += chunk.getUpdatedFlagBytes();
+        activeBytes += chunk.getActiveFlagBytes();
+        if (chunk.getAggregatedBytes() > 0) {
+            aggregatedBytes += chunk.getAggregatedBytes();
+            aggregatedChunks++;
+        }
+    }
+    
+    report.add("chunks/cells", ownedBytes, ownedChunks);
+    // The whole reservation, including slots of chunks not created yet
+    report.add("chunks/slab", slab ? slab->getMemoryUsage() : 0, chunks.size() - ownedChunks);
+    report.add("chunks/updated_flags", updatedBytes, chunks.size());
+    report.add("chunks/active_flags", activeBytes, chunks.size());
+    report.add("chunks/liquid_layouts", aggregatedBytes, aggregatedChunks);
+    report.add("chunks/index",
+               chunks.size() * sizeof(Chunk) + heapBytes(chunks) + heapBytes(activeChunks) +
+               heapBytes(frozenSince) + heapBytes(thawedChunks),
+               chunks.size());
+}
+
 bool ChunkManager::isValidCoord(WorldCoord coord) const {
     // For now, we'll consider any coordinate valid
     // In a real implementation, you might have world boundaries or other constraints
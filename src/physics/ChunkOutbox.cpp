@@ -0,0 +1,106 @@
+#include "astral/physics/ChunkOutbox.h"
+#include <algorithm>
+
+namespace astral {
+
+namespace {
+
+// splitmix64 finaliser
+uint64_t mix(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+uint64_t packCoord(WorldCoord coord)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32) | static_cast<uint32_t>(coord.y);
+}
+
+// Tie break for equal priorities
+bool cellsBefore(const BoundaryWrite& a, const BoundaryWrite& b)
+{
+    if (a.from.y != b.from.y) return a.from.y < b.from.y;
+    if (a.from.x != b.from.x) return a.from.x < b.from.x;
+    if (a.to.y != b.to.y) return a.to.y < b.to.y;
+    if (a.to.x != b.to.x) return a.to.x < b.to.x;
+    return a.kind < b.kind;
+}
+
+} // namespace
+
+// ==================== ChunkOutbox ====================
+
+ChunkOutbox::ChunkOutbox()
+    : tick(0)
+{
+}
+
+void ChunkOutbox::reset(uint64_t tick)
+{
+    this->tick = tick;
+    writes.clear();
+    releasePoints.clear();
+    releaseAreas.clear();
+}
+
+void ChunkOutbox::addMove(WorldCoord from, WorldCoord to, MaterialID fromMaterial, MaterialID toMaterial, bool swap)
+{
+    BoundaryWrite write;
+    write.kind = swap ? BoundaryWrite::Kind::SWAP : BoundaryWrite::Kind::MOVE;
+    write.from = from;
+    write.to = to;
+    write.fromMaterial = fromMaterial;
+    write.toMaterial = toMaterial;
+    write.priority = priorityOf(from, to, tick);
+    writes.push_back(write);
+}
+
+void ChunkOutbox::addEdit(WorldCoord to, MaterialID toMaterial, const Cell& cell)
+{
+    BoundaryWrite write;
+    write.kind = BoundaryWrite::Kind::EDIT;
+    write.from = to;
+    write.to = to;
+    write.fromMaterial = toMaterial;
+    write.toMaterial = toMaterial;
+    write.cell = cell;
+    write.priority = priorityOf(to, to, tick);
+    writes.push_back(write);
+}
+
+uint64_t ChunkOutbox::priorityOf(WorldCoord from, WorldCoord to, uint64_t tick)
+{
+    return mix(mix(mix(tick) ^ packCoord(from)) ^ packCoord(to));
+}
+
+// ==================== Settling ====================
+
+size_t settleBoundaryWrites(std::vector<BoundaryWrite>& writes)
+{
+    // Group by target, winner first
+    std::sort(writes.begin(), writes.end(), [](const BoundaryWrite& a, const BoundaryWrite& b) {
+        if (a.to.y != b.to.y) return a.to.y < b.to.y;
+        if (a.to.x != b.to.x) return a.to.x < b.to.x;
+        if (a.priority != b.priority) return a.priority > b.priority;
+        return cellsBefore(a, b);
+    });
+
+    size_t kept = 0;
+    for (size_t i = 0; i < writes.size(); i++) {
+        if (kept > 0 && writes[kept - 1].to == writes[i].to) continue;
+        writes[kept++] = writes[i];
+    }
+    size_t lost = writes.size() - kept;
+    writes.resize(kept);
+
+    std::sort(writes.begin(), writes.end(), [](const BoundaryWrite& a, const BoundaryWrite& b) {
+        if (a.priority != b.priority) return a.priority > b.priority;
+        return cellsBefore(a, b);
+    });
+    return lost;
+}
+
+} // namespace astral
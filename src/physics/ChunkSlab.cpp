@@ -0,0 +1,174 @@
+#include "astral/physics/ChunkSlab.h"
+#include "astral/physics/ChunkManager.h"
+#include "astral/core/ThreadPool.h"
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace astral {
+
+namespace {
+
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Slots are filled with placement copies and never destroyed
+static_assert(std::is_trivially_destructible<Cell>::value, "ChunkSlab does not destroy cells");
+
+// Spread the low 32 bits of v to the even bit positions
+uint64_t spreadBits(uint64_t v)
+{
+    v &= 0xFFFFFFFFull;
+    v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+    v = (v | (v << 8)) & 0x00FF00FF00FF00FFull;
+    v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0Full;
+    v = (v | (v << 2)) & 0x3333333333333333ull;
+    v = (v | (v << 1)) & 0x5555555555555555ull;
+    return v;
+}
+
+size_t roundUp(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+uint64_t ChunkSlab::mortonCode(uint32_t x, uint32_t y)
+{
+    return spreadBits(x) | (spreadBits(y) << 1);
+}
+
+ChunkSlab::ChunkSlab(int chunksX, int chunksY, int chunkSize, const ChunkSlabConfig& config)
+    : chunksX(chunksX)
+    , chunksY(chunksY)
+    , chunkSize(chunkSize)
+    , cellsPerChunk(static_cast<size_t>(chunkSize) * chunkSize)
+    , stripeCount(1)
+    , mapping(nullptr)
+    , mappingSize(0)
+    , base(nullptr)
+    , mapped(false)
+    , hugePageAdvised(false)
+{
+    if (chunksX <= 0 || chunksY <= 0 || chunkSize <= 0) {
+        throw std::invalid_argument("ChunkSlab needs a non-empty chunk grid");
+    }
+
+    // Rank the chunks by Morton code. Grids that are not powers of two leave
+    // gaps in the codes; ranking packs the slots without them.
+    size_t chunkCount = static_cast<size_t>(chunksX) * chunksY;
+    std::vector<uint32_t> order(chunkCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [chunksX](uint32_t a, uint32_t b) {
+        return mortonCode(a % chunksX, a / chunksX) < mortonCode(b % chunksX, b / chunksX);
+    });
+    slotOfChunk.resize(chunkCount);
+    for (size_t slot = 0; slot < chunkCount; slot++) {
+        slotOfChunk[order[slot]] = static_cast<uint32_t>(slot);
+    }
+
+    if (config.firstTouchPool) {
+        stripeCount = static_cast<int>(std::max<size_t>(1, config.firstTouchPool->getCoreGroupCount()));
+    }
+
+    reserve(config.hugePages);
+    if (config.prefault) {
+        prefault(config.firstTouchPool);
+    }
+}
+
+ChunkSlab::~ChunkSlab()
+{
+#ifdef __linux__
+    if (mapped) {
+        munmap(mapping, mappingSize);
+        return;
+    }
+#endif
+    ::operator delete(mapping);
+}
+
+void ChunkSlab::reserve(bool hugePages)
+{
+    size_t bytes = slotOfChunk.size() * cellsPerChunk * sizeof(Cell);
+
+#ifdef __linux__
+    // Over-reserve by one huge page so the slots can start on a huge page
+    // boundary, then hand the unused head and tail back
+    mappingSize = roundUp(bytes, HUGE_PAGE_SIZE);
+    size_t reserved = mappingSize + HUGE_PAGE_SIZE;
+    void* region = mmap(nullptr, reserved, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (region != MAP_FAILED) {
+        uintptr_t start = reinterpret_cast<uintptr_t>(region);
+        uintptr_t aligned = roundUp(start, HUGE_PAGE_SIZE);
+        size_t head = aligned - start;
+        size_t tail = reserved - head - mappingSize;
+        if (head > 0) munmap(region, head);
+        if (tail > 0) munmap(reinterpret_cast<char*>(aligned) + mappingSize, tail);
+
+        mapping = reinterpret_cast<void*>(aligned);
+        mapped = true;
+        if (hugePages) {
+            hugePageAdvised = madvise(mapping, mappingSize, MADV_HUGEPAGE) == 0;
+        }
+        base = static_cast<Cell*>(mapping);
+        return;
+    }
+#else
+    (void)hugePages;
+#endif
+
+    mappingSize = bytes;
+    mapping = ::operator new(mappingSize);
+    base = static_cast<Cell*>(mapping);
+}
+
+void ChunkSlab::prefault(ThreadPool* pool)
+{
+    size_t slotCount = slotOfChunk.size();
+    auto touchStripe = [this, slotCount](int stripe) {
+        size_t first = slotCount * stripe / stripeCount;
+        size_t last = slotCount * (stripe + 1) / stripeCount;
+        std::uninitialized_fill(base + first * cellsPerChunk, base + last * cellsPerChunk, Cell());
+    };
+
+    if (!pool) {
+        touchStripe(0);
+        return;
+    }
+    for (int stripe = 0; stripe < stripeCount; stripe++) {
+        pool->submit([touchStripe, stripe]() { touchStripe(stripe); }, stripe);
+    }
+    pool->waitIdle();
+}
+
+bool ChunkSlab::contains(ChunkCoord coord) const
+{
+    return coord.x >= 0 && coord.y >= 0 && coord.x < chunksX && coord.y < chunksY;
+}
+
+size_t ChunkSlab::getSlot(ChunkCoord coord) const
+{
+    return slotOfChunk[static_cast<size_t>(coord.y) * chunksX + coord.x];
+}
+
+Cell* ChunkSlab::getChunkCells(ChunkCoord coord) const
+{
+    if (!contains(coord)) return nullptr;
+    return base + getSlot(coord) * cellsPerChunk;
+}
+
+int ChunkSlab::getStripe(ChunkCoord coord) const
+{
+    return static_cast<int>(getSlot(coord) * stripeCount / slotOfChunk.size());
+}
+
+} // namespace astral
@@ -0,0 +1,351 @@
+#include "astral/physics/ConductorNetwork.h"
+#include "astral/physics/Material.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace astral {
+
+ConductorNetwork::ConductorNetwork(const MaterialTable* materials, ChunkManager* chunkManager,
+                                   int worldWidth, int worldHeight, const ConductorNetworkConfig& config)
+    : materials(materials)
+    , chunkManager(chunkManager)
+    , worldWidth(worldWidth)
+    , worldHeight(worldHeight)
+    , config(config)
+{
+    if (worldWidth <= 0 || worldHeight <= 0) {
+        throw std::invalid_argument("Conductor networks need a bounded world");
+    }
+    if (config.currentThreshold <= 0.0f || config.heating < 0.0f || config.leakRate < 0.0f) {
+        throw std::invalid_argument("Invalid conductor network settings");
+    }
+    rebuild();
+}
+
+int ConductorNetwork::find(int index) const
+{
+    // Path halving: every other node on the way up skips to its grandparent
+    while (parent[index] != index) {
+        parent[index] = parent[parent[index]];
+        index = parent[index];
+    }
+    return index;
+}
+
+void ConductorNetwork::unite(int a, int b)
+{
+    int rootA = find(a);
+    int rootB = find(b);
+    if (rootA == rootB) {
+        return;
+    }
+
+    // The smaller group's cells move over, so a cell changes groups at most
+    // log(cells) times
+    if (components[rootA].cells.size() < components[rootB].cells.size()) {
+        std::swap(rootA, rootB);
+    }
+    Component& into = components[rootA];
+    Component& from = components[rootB];
+    into.cells.insert(into.cells.end(), from.cells.begin(), from.cells.end());
+    into.charge += from.charge;
+    into.changed = true;
+    parent[rootB] = rootA;
+    components.erase(rootB);
+}
+
+void ConductorNetwork::refreshMaterials()
+{
+    // Materials can be registered while the network runs
+    const size_t count = materials->size();
+    conductiveMaterial.resize(count);
+    for (size_t id = 0; id < count; id++) {
+        const MaterialProperties& props = materials->getMaterial(static_cast<MaterialID>(id));
+        conductiveMaterial[id] = props.hasFlag(MaterialProperties::Flags::CONDUCTIVE) ? 1 : 0;
+    }
+}
+
+bool ConductorNetwork::lookUpConductive(MaterialID material) const
+{
+    // Registered since the last update
+    return materials->getMaterial(material).hasFlag(MaterialProperties::Flags::CONDUCTIVE);
+}
+
+void ConductorNetwork::scanCell(int index)
+{
+    int x = index % worldWidth;
+    int y = index / worldWidth;
+    const Chunk* chunk = chunkManager->peekChunk(chunkManager->chunkCoordOf(x, y));
+    if (!chunk) {
+        return;
+    }
+    stats.examined++;
+    LocalCoord local = chunkManager->localCoordOf(x, y);
+    bool conductive = conducts(chunk->getCell(local.x, local.y).material);
+    if (conductive == (parent[index] >= 0)) {
+        return;
+    }
+    (conductive ? added : removed).push_back(index);
+}
+
+void ConductorNetwork::scanChunk(const Chunk& chunk)
+{
+    const int size = chunk.getSize();
+    const int originX = chunk.getCoord().x * size;
+    const int originY = chunk.getCoord().y * size;
+    const int endX = std::min(originX + size, worldWidth);
+    const int endY = std::min(originY + size, worldHeight);
+    const size_t materialCount = conductiveMaterial.size();
+    const Cell* cells = chunk.getCells();
+    stats.examined += static_cast<size_t>(std::max(endX - std::max(originX, 0), 0)) *
+                      std::max(endY - std::max(originY, 0), 0);
+    for (int y = std::max(originY, 0); y < endY; y++) {
+        const Cell* row = cells + static_cast<size_t>(y - originY) * size;
+        const int* tracked = parent.data() + static_cast<size_t>(y) * worldWidth;
+        for (int x = std::max(originX, 0); x < endX; x++) {
+            MaterialID material = row[x - originX].material;
+            bool conductive = conductiveMaterial[material < materialCount ? material : 0] != 0;
+            if (conductive == (tracked[x] >= 0)) continue;
+            (conductive ? added : removed).push_back(indexOf(x, y));
+        }
+    }
+}
+
+void ConductorNetwork::update(float deltaTime)
+{
+    refreshMaterials();
+    added.clear();
+    removed.clear();
+    stats.examined = 0;
+
+    // A cell reported several times is read once, and not at all when its
+    // whole chunk is rescanned
+    std::sort(changedCells.begin(), changedCells.end());
+    changedCells.erase(std::unique(changedCells.begin(), changedCells.end()), changedCells.end());
+    for (int index : changedCells) {
+        if (!changedChunks.empty() &&
+            changedChunks.count(chunkManager->chunkCoordOf(index % worldWidth, index / worldWidth))) {
+            continue;
+        }
+        scanCell(index);
+    }
+    for (const ChunkCoord& coord : changedChunks) {
+        if (const Chunk* chunk = chunkManager->peekChunk(coord)) {
+            scanChunk(*chunk);
+        }
+    }
+    changedCells.clear();
+    changedChunks.clear();
+
+    // Find the groups that lost cells before unlinking any, since other
+    // members may still point through the removed cells
+    dirtyRoots.clear();
+    for (int index : removed) {
+        dirtyRoots.push_back(find(index));
+    }
+    for (int index : removed) {
+        parent[index] = -1;
+    }
+    std::sort(dirtyRoots.begin(), dirtyRoots.end());
+    dirtyRoots.erase(std::unique(dirtyRoots.begin(), dirtyRoots.end()), dirtyRoots.end());
+    stats.relabelled = 0;
+    for (int root : dirtyRoots) {
+        split(root);
+    }
+
+    // New cells start as groups of their own and join their neighbours
+    for (int index : added) {
+        parent[index] = index;
+        Component& component = components[index];
+        component.cells.assign(1, index);
+        component.charge = 0.0;
+        component.changed = true;
+    }
+    for (int index : added) {
+        int x = index % worldWidth;
+        int y = index / worldWidth;
+        if (x > 0 && parent[index - 1] >= 0) unite(index, index - 1);
+        if (x + 1 < worldWidth && parent[index + 1] >= 0) unite(index, index + 1);
+        if (y > 0 && parent[index - worldWidth] >= 0) unite(index, index - worldWidth);
+        if (y + 1 < worldHeight && parent[index + worldWidth] >= 0) unite(index, index + worldWidth);
+    }
+
+    applyCurrent(deltaTime);
+}
+
+void ConductorNetwork::split(int root)
+{
+    auto found = components.find(root);
+    if (found == components.end()) {
+        return;
+    }
+    Component old = std::move(found->second);
+    components.erase(found);
+
+    // Mark the cells that are left, then flood fill them into new groups
+    const int PENDING = -2;
+    size_t remaining = 0;
+    for (int index : old.cells) {
+        if (parent[index] == -1) continue;
+        parent[index] = PENDING;
+        remaining++;
+    }
+    stats.relabelled += remaining;
+    if (remaining == 0) {
+        return;
+    }
+
+    for (int seed : old.cells) {
+        if (parent[seed] != PENDING) continue;
+        Component& component = components[seed];
+        parent[seed] = seed;
+        queue.assign(1, seed);
+        for (size_t head = 0; head < queue.size(); head++) {
+            int index = queue[head];
+            component.cells.push_back(index);
+            int x = index % worldWidth;
+            int y = index / worldWidth;
+            int neighbours[4] = {
+                x > 0 ? index - 1 : -1,
+                x + 1 < worldWidth ? index + 1 : -1,
+                y > 0 ? index - worldWidth : -1,
+                y + 1 < worldHeight ? index + worldWidth : -1,
+            };
+            for (int next : neighbours) {
+                if (next >= 0 && parent[next] == PENDING) {
+                    parent[next] = seed;
+                    queue.push_back(next);
+                }
+            }
+        }
+
+        // The pieces share the charge by size; what the removed cells held stays
+        component.charge = old.charge * static_cast<double>(component.cells.size()) / remaining;
+        component.changed = true;
+    }
+}
+
+void ConductorNetwork::applyCurrent(float deltaTime)
+{
+    const double leak = std::max(0.0, 1.0 - static_cast<double>(config.leakRate) * deltaTime);
+    stats.cells = 0;
+    stats.components = components.size();
+    stats.carrying = 0;
+    for (auto& entry : components) {
+        Component& component = entry.second;
+        stats.cells += component.cells.size();
+        float share = static_cast<float>(component.charge / component.cells.size());
+        bool carrying = share >= config.currentThreshold;
+        if (!carrying && !component.changed) continue;
+
+        // Only the group's own cells are visited, and only when its charge
+        // moved or current flows through it
+        writeCells(component, share, carrying ? config.heating * share * deltaTime : 0.0f);
+        if (carrying) {
+            stats.carrying++;
+            component.charge *= leak;
+            component.changed = true;   // The cells hold the share before the leak
+        }
+    }
+}
+
+void ConductorNetwork::writeCells(Component& component, float share, float heat)
+{
+    const bool carrying = share >= config.currentThreshold;
+    ChunkCoord lastCoord = {0, 0};
+    Chunk* chunk = nullptr;
+    bool first = true;
+    for (int index : component.cells) {
+        int x = index % worldWidth;
+        int y = index / worldWidth;
+        ChunkCoord coord = chunkManager->chunkCoordOf(x, y);
+        if (first || !(coord == lastCoord)) {
+            chunk = chunkManager->peekChunk(coord);
+            lastCoord = coord;
+            first = false;
+            if (chunk && heat > 0.0f) {
+                chunkManager->forceActivateChunk(coord);
+            }
+        }
+        if (!chunk) continue;
+        LocalCoord local = chunkManager->localCoordOf(x, y);
+        Cell& cell = chunk->getCell(local.x, local.y);
+        cell.charge = share;
+        cell.temperature += heat;
+        if (carrying) {
+            cell.setFlag(Cell::FLAG_CHARGED);
+        } else {
+            cell.clearFlag(Cell::FLAG_CHARGED);
+        }
+    }
+    component.changed = false;
+}
+
+void ConductorNetwork::rebuild()
+{
+    refreshMaterials();
+    parent.assign(static_cast<size_t>(worldWidth) * worldHeight, -1);
+    components.clear();
+
+    // Every resident chunk counts, whether it is active or not
+    const int size = chunkManager->getChunkSize();
+    for (int cy = 0; cy * size < worldHeight; cy++) {
+        for (int cx = 0; cx * size < worldWidth; cx++) {
+            if (chunkManager->peekChunk({cx, cy})) {
+                noteChunk({cx, cy});
+            }
+        }
+    }
+    update(0.0f);
+}
+
+bool ConductorNetwork::addCharge(int x, int y, float amount)
+{
+    if (!isConductor(x, y)) {
+        return false;
+    }
+    Component& component = components[find(indexOf(x, y))];
+    component.charge = std::max(0.0, component.charge + amount);
+    component.changed = true;
+    return true;
+}
+
+bool ConductorNetwork::isConductor(int x, int y) const
+{
+    return inWorld(x, y) && parent[indexOf(x, y)] >= 0;
+}
+
+bool ConductorNetwork::isConnected(int x1, int y1, int x2, int y2) const
+{
+    return isConductor(x1, y1) && isConductor(x2, y2) && find(indexOf(x1, y1)) == find(indexOf(x2, y2));
+}
+
+size_t ConductorNetwork::getComponentSize(int x, int y) const
+{
+    if (!isConductor(x, y)) {
+        return 0;
+    }
+    return components.at(find(indexOf(x, y))).cells.size();
+}
+
+float ConductorNetwork::getCharge(int x, int y) const
+{
+    if (!isConductor(x, y)) {
+        return 0.0f;
+    }
+    const Component& component = components.at(find(indexOf(x, y)));
+    return static_cast<float>(component.charge / component.cells.size());
+}
+
+size_t ConductorNetwork::getMemoryUsage() const
+{
+    size_t bytes = heapBytes(parent) + heapBytes(components) + heapBytes(conductiveMaterial) +
+                   heapBytes(changedCells) + heapBytes(changedChunks) + heapBytes(added) + heapBytes(removed) +
+                   heapBytes(dirtyRoots) + heapBytes(queue);
+    for (const auto& pair : components) {
+        bytes += heapBytes(pair.second.cells);
+    }
+    return bytes;
+}
+
+} // namespace astral
@@ -0,0 +1,172 @@
+#include "astral/physics/DeterminismCheck.h"
+#include "astral/core/ThreadPool.h"
+#include "astral/physics/CellularAutomaton.h"
+#include "astral/physics/RegionFile.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <sstream>
+
+namespace astral {
+
+namespace {
+
+// Pool declared first so it outlives the world that runs on it
+struct Run {
+    std::unique_ptr<ThreadPool> pool;
+    std::unique_ptr<CellularAutomaton> world;
+};
+
+Run startRun(const DeterminismConfig& config, const EngineSetup& setup)
+{
+    Run run;
+    run.world = std::make_unique<CellularAutomaton>(config.worldWidth, config.worldHeight, config.chunkSize);
+    if (setup.slabStorage) {
+        run.world->enableSlabStorage();
+    }
+    if (setup.strategy == ChunkUpdateStrategy::OUTBOX) {
+        run.pool = std::make_unique<ThreadPool>(std::max(1, setup.threads));
+        run.world->setChunkUpdateStrategy(setup.strategy, run.pool.get());
+    }
+    buildScenario(*run.world, config.scenario);
+    if (setup.configure) {
+        setup.configure(*run.world);
+    }
+    return run;
+}
+
+bool sameBits(float a, float b)
+{
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// Every field the hash covers, compared the way the hash sees it
+bool sameState(const Cell& a, const Cell& b)
+{
+    return a.material == b.material && sameBits(a.temperature, b.temperature) &&
+           sameBits(a.velocity.x, b.velocity.x) && sameBits(a.velocity.y, b.velocity.y) &&
+           a.metadata == b.metadata && sameBits(a.pressure, b.pressure) && sameBits(a.health, b.health) &&
+           a.lifetime == b.lifetime && sameBits(a.energy, b.energy) && sameBits(a.charge, b.charge) &&
+           a.stateFlags == b.stateFlags;
+}
+
+void diffChunk(const Cell* first, const Cell* second, ChunkCoord coord, int chunkSize,
+               size_t maxCells, DeterminismResult& result)
+{
+    for (int y = 0; y < chunkSize; y++) {
+        for (int x = 0; x < chunkSize; x++) {
+            size_t index = static_cast<size_t>(y) * chunkSize + x;
+            if (sameState(first[index], second[index])) continue;
+            if (result.cells.size() < maxCells) {
+                result.cells.push_back({coord.x * chunkSize + x, coord.y * chunkSize + y, first[index], second[index]});
+            }
+            result.differingCells++;
+        }
+    }
+}
+
+// Compare every chunk resident in either world; a chunk missing from one
+// side is compared as air. Returns false and records the first diverging
+// chunk when they differ.
+bool compareWorlds(const ChunkManager& first, const ChunkManager& second, const DeterminismConfig& config,
+                   const std::vector<Cell>& air, uint64_t airHash, DeterminismResult& result)
+{
+    std::vector<ChunkCoord> firstChunks = first.getResidentChunks();
+    std::vector<ChunkCoord> secondChunks = second.getResidentChunks();
+    std::vector<ChunkCoord> chunks;
+    std::set_union(firstChunks.begin(), firstChunks.end(), secondChunks.begin(), secondChunks.end(),
+                   std::back_inserter(chunks));
+
+    for (const ChunkCoord& coord : chunks) {
+        const Chunk* a = first.peekChunk(coord);
+        const Chunk* b = second.peekChunk(coord);
+        if ((a ? hashChunkContent(*a) : airHash) == (b ? hashChunkContent(*b) : airHash)) continue;
+        if (result.divergingChunks++ == 0) {
+            result.chunk = coord;
+            diffChunk(a ? a->getCells() : air.data(), b ? b->getCells() : air.data(), coord,
+                      config.chunkSize, config.maxCellDiffs, result);
+        }
+    }
+    return result.divergingChunks == 0;
+}
+
+} // namespace
+
+uint64_t hashChunkContent(const Chunk& chunk)
+{
+    // The save encoding holds every field but the per-tick updated flag,
+    // written field by field, so padding never reaches the hash
+    thread_local std::vector<uint8_t> encoded;
+    RegionFile::encodeCells(chunk.getCells(), chunk.getCellCount(), encoded);
+    return RegionFile::hashBytes(encoded.data(), encoded.size());
+}
+
+std::string describeCell(const Cell& cell)
+{
+    std::ostringstream out;
+    out << std::setprecision(9)
+        << "material " << cell.material
+        << ", temperature " << cell.temperature
+        << ", velocity (" << cell.velocity.x << ", " << cell.velocity.y << ")"
+        << ", metadata " << static_cast<int>(cell.metadata)
+        << ", pressure " << cell.pressure
+        << ", health " << cell.health
+        << ", lifetime " << static_cast<int>(cell.lifetime)
+        << ", energy " << cell.energy
+        << ", charge " << cell.charge
+        << ", flags 0x" << std::hex << static_cast<int>(cell.stateFlags);
+    return out.str();
+}
+
+DeterminismResult verifyDeterminism(const DeterminismConfig& config, const EngineSetup& first,
+                                    const EngineSetup& second)
+{
+    Run a = startRun(config, first);
+    Run b = startRun(config, second);
+    std::vector<Cell> air(static_cast<size_t>(config.chunkSize) * config.chunkSize);
+    std::vector<uint8_t> encoded;
+    RegionFile::encodeCells(air.data(), air.size(), encoded);
+    uint64_t airHash = RegionFile::hashBytes(encoded.data(), encoded.size());
+
+    DeterminismResult result;
+    for (int tick = 0; tick <= config.ticks; tick++) {
+        if (tick > 0) {
+            a.world->update(config.deltaTime);
+            b.world->update(config.deltaTime);
+            result.ticksCompared = tick;
+        }
+        if (!compareWorlds(a.world->getChunkManager(), b.world->getChunkManager(), config, air, airHash, result)) {
+            result.diverged = true;
+            result.tick = tick;
+            break;
+        }
+    }
+    return result;
+}
+
+std::string DeterminismResult::describe(const EngineSetup& first, const EngineSetup& second) const
+{
+    std::ostringstream out;
+    if (!diverged) {
+        out << first.name << " and " << second.name << " match over " << ticksCompared << " ticks";
+        return out.str();
+    }
+
+    out << first.name << " and " << second.name << " diverge at tick " << tick
+        << " in chunk (" << chunk.x << ", " << chunk.y << "): "
+        << divergingChunks << (divergingChunks == 1 ? " chunk differs, " : " chunks differ, ")
+        << differingCells << (differingCells == 1 ? " cell" : " cells") << " in this one";
+    for (const CellDiff& diff : cells) {
+        out << "\n  (" << diff.x << ", " << diff.y << ")"
+            << "\n    " << first.name << ": " << describeCell(diff.first)
+            << "\n    " << second.name << ": " << describeCell(diff.second);
+    }
+    if (differingCells > cells.size()) {
+        out << "\n  ... " << differingCells - cells.size() << " more";
+    }
+    return out.str();
+}
+
+} // namespace astral
@@ -0,0 +1,126 @@
+#include "astral/physics/EditCommandQueue.h"
+
+namespace astral {
+
+namespace {
+
+const char* const EDIT_TYPE_NAMES[] = {
+    "paint_cell", "paint_circle", "fill_rectangle", "explosion", "heat_source", "force"
+};
+
+} // namespace
+
+nlohmann::json editCommandToJson(const EditCommand& command)
+{
+    return {
+        {"type", EDIT_TYPE_NAMES[static_cast<int>(command.type)]},
+        {"x", command.x},
+        {"y", command.y},
+        {"width", command.width},
+        {"height", command.height},
+        {"radius", command.radius},
+        {"amount", command.amount},
+        {"direction", {command.direction.x, command.direction.y}},
+        {"material", command.material},
+        {"sequence", command.sequence}
+    };
+}
+
+bool editCommandFromJson(const nlohmann::json& json, EditCommand& command)
+{
+    std::string type = json.value("type", "");
+    int index = 0;
+    for (const char* name : EDIT_TYPE_NAMES) {
+        if (type == name) break;
+        index++;
+    }
+    if (index == static_cast<int>(sizeof(EDIT_TYPE_NAMES) / sizeof(EDIT_TYPE_NAMES[0]))) {
+        return false;
+    }
+
+    command.type = static_cast<EditCommandType>(index);
+    command.x = json.value("x", 0);
+    command.y = json.value("y", 0);
+    command.width = json.value("width", 0);
+    command.height = json.value("height", 0);
+    command.radius = json.value("radius", 0.0f);
+    command.amount = json.value("amount", 0.0f);
+    if (json.contains("direction") && json["direction"].size() == 2) {
+        command.direction = glm::vec2(json["direction"][0].get<float>(), json["direction"][1].get<float>());
+    }
+    command.material = json.value("material", static_cast<MaterialID>(0));
+    command.sequence = json.value("sequence", static_cast<uint64_t>(0));
+    return true;
+}
+
+EditCommandQueue::EditCommandQueue()
+    : head(nullptr)
+    , nextSequence(0)
+{
+}
+
+EditCommandQueue::~EditCommandQueue()
+{
+    Node* node = head.exchange(nullptr, std::memory_order_acquire);
+    while (node) {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+void EditCommandQueue::push(const EditCommand& command)
+{
+    Node* node = new Node{command, nullptr};
+    node->command.sequence = nextSequence.fetch_add(1, std::memory_order_relaxed);
+
+    // Treiber push: link onto the current head until the CAS succeeds
+    Node* expected = head.load(std::memory_order_relaxed);
+    do {
+        node->next = expected;
+    } while (!head.compare_exchange_weak(expected, node,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+size_t EditCommandQueue::drain(std::vector<EditCommand>& out)
+{
+    // Take everything at once; producers keep pushing onto a fresh stack
+    Node* node = head.exchange(nullptr, std::memory_order_acquire);
+    if (!node) {
+        return 0;
+    }
+
+    // The stack is newest-first, so reverse it to restore submission order
+    Node* reversed = nullptr;
+    while (node) {
+        Node* next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+    }
+
+    size_t count = 0;
+    while (reversed) {
+        Node* next = reversed->next;
+        out.push_back(reversed->command);
+        delete reversed;
+        reversed = next;
+        count++;
+    }
+
+    return count;
+}
+
+size_t EditCommandQueue::getPendingCount() const
+{
+    // Producers only link nodes in front of the head and only the consumer
+    // frees them, so the list behind a loaded head is stable
+    size_t count = 0;
+    for (Node* node = head.load(std::memory_order_acquire); node; node = node->next) {
+        count++;
+    }
+    return count;
+}
+
+} // namespace astral
@@ -0,0 +1,423 @@
+#include "astral/physics/GasField.h"
+#include "astral/physics/Material.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace astral {
+
+namespace {
+
+// Weight of each absorbed cell in a channel's running means
+constexpr float MEAN_WEIGHT = 0.05f;
+
+
+float sum(const std::vector<float>& values)
+{
+    return std::accumulate(values.begin(), values.end(), 0.0f);
+}
+
+} // anonymous namespace
+
+GasField::GasField(const MaterialRegistry* registry, ChunkManager* chunkManager,
+                   int worldWidth, int worldHeight, const GasFieldConfig& config)
+    : materialRegistry(registry)
+    , chunkManager(chunkManager)
+    , config(config)
+    , worldWidth(worldWidth)
+    , worldHeight(worldHeight)
+    , sampleWidth(0)
+    , sampleHeight(0)
+    , absorbedCells(0)
+    , materializedCells(0)
+{
+    if (worldWidth <= 0 || worldHeight <= 0) {
+        throw std::invalid_argument("The gas field needs a bounded world");
+    }
+    // Blocks must not straddle chunks of any supported size
+    if (config.cellsPerSample <= 0 || SUPPORTED_CHUNK_SIZES[0] % config.cellsPerSample != 0) {
+        throw std::invalid_argument("Gas field sample size must divide " + std::to_string(SUPPORTED_CHUNK_SIZES[0]));
+    }
+    if (config.denseCells <= static_cast<float>(config.sparseCells)) {
+        throw std::invalid_argument("Gas field denseCells must exceed sparseCells");
+    }
+
+    const int s = config.cellsPerSample;
+    sampleWidth = (worldWidth + s - 1) / s;
+    sampleHeight = (worldHeight + s - 1) / s;
+    const size_t samples = static_cast<size_t>(sampleWidth) * sampleHeight;
+
+    for (const std::string& name : config.materials) {
+        if (!registry->hasMaterialName(name)) {
+            throw std::invalid_argument("Unknown gas field material: " + name);
+        }
+        MaterialID id = registry->getIDFromName(name);
+        MaterialProperties props = registry->getMaterial(id);
+        if (props.type != MaterialType::GAS) {
+            throw std::invalid_argument("Gas field material is not a gas: " + name);
+        }
+        if (id >= channelOfMaterial.size()) {
+            channelOfMaterial.resize(id + 1, -1);
+        }
+        if (channelOfMaterial[id] >= 0) continue;
+
+        channelOfMaterial[id] = static_cast<int>(channels.size());
+        Channel channel;
+        channel.material = id;
+        channel.density.assign(samples, 0.0f);
+        channel.next.assign(samples, 0.0f);
+        channel.pending.assign(samples, 0.0f);
+        channel.meanLifetime = std::max(props.lifetime, 0.0f);
+        channel.meanTemperature = 20.0f;
+        channels.push_back(std::move(channel));
+    }
+
+    velocityX.assign(samples, 0.0f);
+    velocityY.assign(samples, 0.0f);
+    open.assign(samples, 0.0f);
+    gasCells.assign(samples, 0);
+}
+
+void GasField::update(float deltaTime)
+{
+    changedChunks.clear();
+    absorbSparseBlocks();
+    updateVelocity(deltaTime);
+    materializeBlocked(deltaTime);
+    for (Channel& channel : channels) {
+        advect(channel, deltaTime);
+        decay(channel);
+    }
+    materializeDense();
+}
+
+void GasField::absorbSparseBlocks()
+{
+    const int s = config.cellsPerSample;
+    const int chunkSize = chunkManager->getChunkSize();
+    const int blocksPerChunk = chunkSize / s;
+    const auto& activeChunks = chunkManager->getActiveChunks();
+
+    // Only air and untouched tracked gas may share a block with the field.
+    // Blocks of chunks that are not simulated this tick count as closed.
+    std::fill(open.begin(), open.end(), 0.0f);
+    for (const ChunkCoord& coord : activeChunks) {
+        const Chunk* chunk = chunkManager->getChunk(coord);
+        if (!chunk) continue;
+
+        for (int blockY = 0; blockY < blocksPerChunk; blockY++) {
+            int sampleY = coord.y * blocksPerChunk + blockY;
+            if (sampleY < 0 || sampleY >= sampleHeight) continue;
+
+            for (int blockX = 0; blockX < blocksPerChunk; blockX++) {
+                int sampleX = coord.x * blocksPerChunk + blockX;
+                if (sampleX < 0 || sampleX >= sampleWidth) continue;
+
+                int total = 0;
+                bool closed = false;
+                for (int y = blockY * s; y < (blockY + 1) * s && !closed; y++) {
+                    for (int x = blockX * s; x < (blockX + 1) * s; x++) {
+                        const Cell& cell = chunk->getCell(x, y);
+                        if (cell.material == 0) continue;
+                        if (channelOf(cell.material) < 0 || cell.stateFlags != 0) {
+                            closed = true;
+                            break;
+                        }
+                        total++;
+                    }
+                }
+
+                size_t index = static_cast<size_t>(sampleY) * sampleWidth + sampleX;
+                open[index] = closed ? 0.0f : 1.0f;
+                gasCells[index] = closed ? 0 : static_cast<uint16_t>(total);
+            }
+        }
+    }
+
+    // Absorb sparse blocks whose gas can rise; gas below a closed block
+    // stays in cells so it is not absorbed again as soon as it lands there
+    for (const ChunkCoord& coord : activeChunks) {
+        Chunk* chunk = chunkManager->getChunk(coord);
+        if (!chunk) continue;
+
+        for (int blockY = 0; blockY < blocksPerChunk; blockY++) {
+            int sampleY = coord.y * blocksPerChunk + blockY;
+            if (sampleY < 0 || sampleY >= sampleHeight) continue;
+
+            for (int blockX = 0; blockX < blocksPerChunk; blockX++) {
+                int sampleX = coord.x * blocksPerChunk + blockX;
+                if (sampleX < 0 || sampleX >= sampleWidth) continue;
+
+                size_t index = static_cast<size_t>(sampleY) * sampleWidth + sampleX;
+                int total = gasCells[index];
+                if (total == 0 || total > config.sparseCells || !isOpen(sampleX, sampleY - 1)) continue;
+
+                for (int y = blockY * s; y < (blockY + 1) * s; y++) {
+                    for (int x = blockX * s; x < (blockX + 1) * s; x++) {
+                        Cell& cell = chunk->getCell(x, y);
+                        if (cell.material == 0) continue;
+
+                        Channel& channel = channels[channelOf(cell.material)];
+                        if (cell.lifetime > 0) {
+                            channel.meanLifetime += (cell.lifetime - channel.meanLifetime) * MEAN_WEIGHT;
+                        }
+                        channel.meanTemperature += (cell.temperature - channel.meanTemperature) * MEAN_WEIGHT;
+                        channel.density[index] += 1.0f;
+                        cell = Cell();
+                    }
+                }
+                absorbedCells += total;
+                changedChunks.push_back(coord);
+            }
+        }
+    }
+}
+
+void GasField::updateVelocity(float deltaTime)
+{
+    const size_t samples = velocityX.size();
+    const float lift = config.buoyancy * deltaTime;
+    const float keep = std::max(0.0f, 1.0f - config.drag * deltaTime);
+
+    // Up is -y. Gas lifts its own sample and the one above it; advection
+    // pulls density from upstream, so the sample gas rises into has to be
+    // moving as well.
+    std::vector<float> total(samples, 0.0f);
+    for (const Channel& channel : channels) {
+        for (size_t i = 0; i < samples; i++) {
+            total[i] += channel.density[i];
+        }
+    }
+    const size_t width = static_cast<size_t>(sampleWidth);
+    for (size_t i = 0; i < samples; i++) {
+        float below = i + width < samples ? total[i + width] : 0.0f;
+        float hasGas = total[i] + below > 0.0f ? 1.0f : 0.0f;
+        velocityY[i] = (velocityY[i] - lift * hasGas) * keep;
+        velocityX[i] *= keep;
+    }
+}
+
+void GasField::materializeBlocked(float deltaTime)
+{
+    const float scale = deltaTime / config.cellsPerSample;
+
+    for (int sampleY = 0; sampleY < sampleHeight; sampleY++) {
+        for (int sampleX = 0; sampleX < sampleWidth; sampleX++) {
+            size_t index = static_cast<size_t>(sampleY) * sampleWidth + sampleX;
+
+            // Share of this sample's gas flowing into closed neighbours this
+            // tick; the world's edges are closed. A closed sample gives up all
+            // of it.
+            float stepX = velocityX[index] * scale;
+            float stepY = velocityY[index] * scale;
+            int towardX = stepX > 0.0f ? 1 : -1;
+            int towardY = stepY > 0.0f ? 1 : -1;
+            float share = 0.0f;
+            if (open[index] == 0.0f) {
+                share = 1.0f;
+            } else {
+                if (!isOpen(sampleX + towardX, sampleY)) share += std::abs(stepX);
+                if (!isOpen(sampleX, sampleY + towardY)) share += std::abs(stepY);
+                share = std::min(share, 1.0f);
+            }
+            if (share == 0.0f) continue;
+
+            // Gas that touches anything but air becomes cells again, one
+            // whole cell at a time
+            for (Channel& channel : channels) {
+                float& density = channel.density[index];
+                if (density <= 0.0f) continue;
+                float flow = density * share;
+                density -= flow;
+                float& pending = channel.pending[index];
+                pending += flow;
+                if (pending >= 1.0f) {
+                    pending -= materialize(channel, sampleX, sampleY, static_cast<int>(pending));
+                }
+            }
+            if (open[index] == 0.0f) {
+                velocityX[index] = 0.0f;
+                velocityY[index] = 0.0f;
+            }
+        }
+    }
+}
+
+void GasField::advect(Channel& channel, float deltaTime)
+{
+    const float before = sum(channel.density);
+    if (before <= 0.0f) return;
+
+    const float scale = deltaTime / config.cellsPerSample;
+    const float maxX = static_cast<float>(sampleWidth - 1);
+    const float maxY = static_cast<float>(sampleHeight - 1);
+    const std::vector<float>& density = channel.density;
+    std::vector<float>& next = channel.next;
+
+    // Semi-Lagrangian step: each sample takes the density found upstream
+    for (int sampleY = 0; sampleY < sampleHeight; sampleY++) {
+        const size_t row = static_cast<size_t>(sampleY) * sampleWidth;
+        for (int sampleX = 0; sampleX < sampleWidth; sampleX++) {
+            const size_t index = row + sampleX;
+            float px = std::min(std::max(sampleX - velocityX[index] * scale, 0.0f), maxX);
+            float py = std::min(std::max(sampleY - velocityY[index] * scale, 0.0f), maxY);
+            int x0 = static_cast<int>(px);
+            int y0 = static_cast<int>(py);
+            int x1 = std::min(x0 + 1, sampleWidth - 1);
+            int y1 = std::min(y0 + 1, sampleHeight - 1);
+            float fx = px - x0;
+            float fy = py - y0;
+
+            const float* top = &density[static_cast<size_t>(y0) * sampleWidth];
+            const float* bottom = &density[static_cast<size_t>(y1) * sampleWidth];
+            float upper = top[x0] + (top[x1] - top[x0]) * fx;
+            float lower = bottom[x0] + (bottom[x1] - bottom[x0]) * fx;
+            next[index] = (upper + (lower - upper) * fy) * open[index];
+        }
+    }
+
+    // Sideways spreading between open neighbours, as fluxes so it conserves mass
+    const float rate = std::min(config.diffusion * deltaTime, 0.25f);
+    std::vector<float>& result = channel.density;
+    result = next;
+    for (int sampleY = 0; sampleY < sampleHeight; sampleY++) {
+        const size_t row = static_cast<size_t>(sampleY) * sampleWidth;
+        for (int sampleX = 0; sampleX + 1 < sampleWidth; sampleX++) {
+            const size_t left = row + sampleX;
+            float flux = rate * (next[left] - next[left + 1]) * open[left] * open[left + 1];
+            result[left] -= flux;
+            result[left + 1] += flux;
+        }
+    }
+
+    // Semi-Lagrangian advection is not conservative, and gas aimed at
+    // closed samples was already turned into cells
+    const float after = sum(result);
+    if (after > 0.0f) {
+        const float correction = before / after;
+        for (float& value : result) {
+            value *= correction;
+        }
+    }
+}
+
+void GasField::decay(Channel& channel)
+{
+    // Cells vanish when their lifetime runs out; on average that removes
+    // 1/lifetime of the gas per tick
+    if (channel.meanLifetime <= 0.0f) return;
+    const float keep = std::exp(-1.0f / channel.meanLifetime);
+    for (float& value : channel.density) {
+        value *= keep;
+    }
+}
+
+void GasField::materializeDense()
+{
+    for (Channel& channel : channels) {
+        for (int sampleY = 0; sampleY < sampleHeight; sampleY++) {
+            for (int sampleX = 0; sampleX < sampleWidth; sampleX++) {
+                float& density = channel.density[static_cast<size_t>(sampleY) * sampleWidth + sampleX];
+                if (density < config.denseCells) continue;
+                density -= materialize(channel, sampleX, sampleY, static_cast<int>(density));
+            }
+        }
+    }
+}
+
+int GasField::materialize(Channel& channel, int sampleX, int sampleY, int count)
+{
+    const int s = config.cellsPerSample;
+    const int left = sampleX * s;
+    const int top = sampleY * s;
+    const uint8_t lifetime = static_cast<uint8_t>(std::min(std::lround(channel.meanLifetime), 255L));
+
+    int placed = 0;
+    for (int y = top; y < std::min(top + s, worldHeight) && placed < count; y++) {
+        for (int x = left; x < std::min(left + s, worldWidth) && placed < count; x++) {
+            Cell& cell = chunkManager->getCell(x, y);
+            if (cell.material != 0) continue;
+
+            cell = Cell(channel.material);
+            cell.temperature = channel.meanTemperature;
+            cell.lifetime = lifetime;
+            placed++;
+        }
+    }
+
+    if (placed > 0) {
+        ChunkCoord coord = chunkManager->chunkCoordOf(left, top);
+        chunkManager->forceActivateChunk(coord);
+        changedChunks.push_back(coord);
+        materializedCells += placed;
+    }
+    return placed;
+}
+
+void GasField::materializeAll()
+{
+    changedChunks.clear();
+    for (Channel& channel : channels) {
+        for (int sampleY = 0; sampleY < sampleHeight; sampleY++) {
+            for (int sampleX = 0; sampleX < sampleWidth; sampleX++) {
+                size_t index = static_cast<size_t>(sampleY) * sampleWidth + sampleX;
+                float amount = channel.density[index] + channel.pending[index];
+                if (amount <= 0.0f) continue;
+                materialize(channel, sampleX, sampleY, static_cast<int>(std::lround(amount)));
+                channel.density[index] = 0.0f;
+                channel.pending[index] = 0.0f;
+            }
+        }
+    }
+    std::fill(velocityX.begin(), velocityX.end(), 0.0f);
+    std::fill(velocityY.begin(), velocityY.end(), 0.0f);
+}
+
+void GasField::clear()
+{
+    for (Channel& channel : channels) {
+        std::fill(channel.density.begin(), channel.density.end(), 0.0f);
+        std::fill(channel.pending.begin(), channel.pending.end(), 0.0f);
+    }
+    std::fill(velocityX.begin(), velocityX.end(), 0.0f);
+    std::fill(velocityY.begin(), velocityY.end(), 0.0f);
+}
+
+float GasField::getDensity(int x, int y, MaterialID material) const
+{
+    int channel = channelOf(material);
+    if (channel < 0 || x < 0 || y < 0 || x >= worldWidth || y >= worldHeight) {
+        return 0.0f;
+    }
+    const int s = config.cellsPerSample;
+    size_t index = static_cast<size_t>(y / s) * sampleWidth + x / s;
+    return channels[channel].density[index] / (s * s);
+}
+
+float GasField::getTotalDensity(MaterialID material) const
+{
+    int channel = channelOf(material);
+    return channel < 0 ? 0.0f : sum(channels[channel].density) + sum(channels[channel].pending);
+}
+
+float GasField::getTotalDensity() const
+{
+    float total = 0.0f;
+    for (const Channel& channel : channels) {
+        total += sum(channel.density) + sum(channel.pending);
+    }
+    return total;
+}
+
+size_t GasField::getMemoryUsage() const
+{
+    size_t bytes = heapBytes(channels) + heapBytes(velocityX) + heapBytes(velocityY) + heapBytes(open) +
+                   heapBytes(gasCells) + heapBytes(channelOfMaterial) + heapBytes(changedChunks);
+    for (const Channel& channel : channels) {
+        bytes += heapBytes(channel.density) + heapBytes(channel.next) + heapBytes(channel.pending);
+    }
+    return bytes;
+}
+
+} // namespace astral
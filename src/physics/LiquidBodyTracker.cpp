@@ -0,0 +1,417 @@
+#include "astral/physics/LiquidBodyTracker.h"
+#include "astral/physics/CellularPhysics.h"
+#include "astral/physics/CellProcessor.h"
+#include "astral/physics/Material.h"
+#include <algorithm>
+
+namespace astral {
+
+namespace {
+
+// Detection marks
+constexpr uint8_t MARK_NONE = 0;
+constexpr uint8_t MARK_CANDIDATE = 1;   // Interior cell not yet grouped
+constexpr uint8_t MARK_GROUPED = 2;     // Visited by the flood fill
+constexpr uint8_t MARK_BOUNDARY = 3;    // Boundary of the group being built
+
+constexpr int NEIGHBOR_DX[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+constexpr int NEIGHBOR_DY[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+
+// Where updateLiquid() may move a cell, relative to it
+constexpr int MOVE_DX[5] = {0, -1, 1, -1, 1};
+constexpr int MOVE_DY[5] = {1, 1, 1, 0, 0};
+
+float driftToAmbient(float temperature, float decay)
+{
+    return CellularPhysics::AMBIENT_TEMPERATURE +
+           (temperature - CellularPhysics::AMBIENT_TEMPERATURE) * decay;
+}
+
+} // anonymous namespace
+
+LiquidBodyTracker::LiquidBodyTracker(const MaterialRegistry* registry, ChunkManager* chunkManager,
+                                     const CellProcessor* cellProcessor, PositionCheck isValidPosition)
+    : materialRegistry(registry)
+    , chunkManager(chunkManager)
+    , cellProcessor(cellProcessor)
+    , isValidPosition(std::move(isValidPosition))
+    , enabled(true)
+    , minimumCells(64)
+    , detectionInterval(16)
+    , ticksUntilDetection(16)
+    , nextBodyId(1)
+    , releasedBodies(0)
+{
+}
+
+void LiquidBodyTracker::setEnabled(bool enabled)
+{
+    if (!enabled) {
+        releaseAll();
+    }
+    this->enabled = enabled;
+    ticksUntilDetection = detectionInterval;
+}
+
+void LiquidBodyTracker::setDetectionInterval(int ticks)
+{
+    detectionInterval = std::max(ticks, 1);
+    ticksUntilDetection = std::min(ticksUntilDetection, detectionInterval);
+}
+
+const LiquidBodyTracker::MaterialInfo& LiquidBodyTracker::getMaterialInfo(MaterialID id)
+{
+    if (id >= materialInfo.size()) {
+        materialInfo.resize(id + 1);
+    }
+    MaterialInfo& info = materialInfo[id];
+    if (!info.known) {
+        MaterialProperties props = materialRegistry->getMaterial(id);
+        info.known = true;
+        info.liquid = props.type == MaterialType::LIQUID;
+        info.freezingPoint = props.freezingPoint;
+        info.boilingPoint = props.boilingPoint;
+    }
+    return info;
+}
+
+const Cell* LiquidBodyTracker::findCell(int x, int y) const
+{
+    const Chunk* chunk = chunkManager->getChunk(chunkManager->chunkCoordOf(x, y));
+    if (!chunk) return nullptr;
+    LocalCoord local = chunkManager->localCoordOf(x, y);
+    return &chunk->getCell(local.x, local.y);
+}
+
+uint8_t& LiquidBodyTracker::markAt(int x, int y)
+{
+    std::vector<uint8_t>& chunkMarks = marks[chunkManager->chunkCoordOf(x, y)];
+    if (chunkMarks.empty()) {
+        chunkMarks.assign(static_cast<size_t>(chunkManager->getChunkSize()) * chunkManager->getChunkSize(), MARK_NONE);
+    }
+    LocalCoord local = chunkManager->localCoordOf(x, y);
+    return chunkMarks[local.y * chunkManager->getChunkSize() + local.x];
+}
+
+uint8_t LiquidBodyTracker::getMark(int x, int y) const
+{
+    auto it = marks.find(chunkManager->chunkCoordOf(x, y));
+    if (it == marks.end()) return MARK_NONE;
+    LocalCoord local = chunkManager->localCoordOf(x, y);
+    return it->second[local.y * chunkManager->getChunkSize() + local.x];
+}
+
+bool LiquidBodyTracker::isInteriorCandidate(int x, int y, const Cell& cell)
+{
+    // Heat sources, burning cells and decaying cells need their own updates
+    if (cell.metadata != 0 || cell.stateFlags != 0 || cell.lifetime != 0) return false;
+    if (!getMaterialInfo(cell.material).liquid) return false;
+
+    for (int i = 0; i < 8; i++) {
+        int nx = x + NEIGHBOR_DX[i];
+        int ny = y + NEIGHBOR_DY[i];
+        if (!isValidPosition(nx, ny)) return false;
+        const Cell* neighbor = findCell(nx, ny);
+        if (!neighbor || neighbor->material != cell.material) return false;
+    }
+    return true;
+}
+
+bool LiquidBodyTracker::isStuck(int x, int y, const Cell& cell) const
+{
+    for (int i = 0; i < 5; i++) {
+        int tx = x + MOVE_DX[i];
+        int ty = y + MOVE_DY[i];
+        if (!isValidPosition(tx, ty)) continue;
+
+        // Inside a bounded world a missing chunk is air the physics would create
+        const Cell* target = findCell(tx, ty);
+        if (!target || cellProcessor->canCellMove(cell, *target)) return false;
+    }
+    return true;
+}
+
+bool LiquidBodyTracker::isBreached(const LiquidBody& body)
+{
+    for (const WorldCoord& coord : body.boundary) {
+        const Cell* cell = findCell(coord.x, coord.y);
+        if (!cell || cell->material != body.material) return true;
+    }
+
+    const MaterialInfo& info = getMaterialInfo(body.material);
+    if (info.freezingPoint > 0 && driftToAmbient(body.initialMinTemperature, body.ambientDecay) <= info.freezingPoint) {
+        return true;
+    }
+    if (info.boilingPoint > 0 && driftToAmbient(body.initialMaxTemperature, body.ambientDecay) >= info.boilingPoint) {
+        return true;
+    }
+    return false;
+}
+
+void LiquidBodyTracker::update(float deltaTime)
+{
+    if (!enabled) return;
+
+    // What applyTemperature() keeps of a cell's offset from ambient; liquid
+    // cells go through it in both the movement and the interaction pass
+    const float step = 1.0f - CellularPhysics::AMBIENT_RATE * deltaTime;
+    const float retained = step * step;
+
+    for (size_t i = bodies.size(); i-- > 0;) {
+        LiquidBody& body = bodies[i];
+        body.ambientDecay *= retained;
+        body.meanTemperature = driftToAmbient(body.initialMeanTemperature, body.ambientDecay);
+        if (isBreached(body)) {
+            release(i);
+        }
+    }
+
+    if (--ticksUntilDetection <= 0) {
+        ticksUntilDetection = detectionInterval;
+        detect();
+    }
+}
+
+void LiquidBodyTracker::detect()
+{
+    const int chunkSize = chunkManager->getChunkSize();
+    marks.clear();
+
+    // Mark the interior cells of the active chunks that are not aggregated yet
+    std::vector<WorldCoord> seeds;
+    for (const ChunkCoord& coord : chunkManager->getActiveChunks()) {
+        const Chunk* chunk = chunkManager->getChunk(coord);
+        if (!chunk) continue;
+
+        const Cell* cells = chunk->getCells();
+        for (int localY = 0; localY < chunkSize; localY++) {
+            for (int localX = 0; localX < chunkSize; localX++) {
+                const Cell& cell = cells[localY * chunkSize + localX];
+                if (cell.material == 0 || chunk->getAggregatedMaterial(localX, localY) != 0) continue;
+
+                int worldX = coord.x * chunkSize + localX;
+                int worldY = coord.y * chunkSize + localY;
+                if (isInteriorCandidate(worldX, worldY, cell)) {
+                    markAt(worldX, worldY) = MARK_CANDIDATE;
+                    seeds.push_back({worldX, worldY});
+                }
+            }
+        }
+    }
+
+    // Group them; neighbouring interior cells always hold the same liquid
+    std::vector<WorldCoord> group;
+    std::vector<WorldCoord> stack;
+    for (const WorldCoord& seed : seeds) {
+        uint8_t& seedMark = markAt(seed.x, seed.y);
+        if (seedMark != MARK_CANDIDATE) continue;
+        seedMark = MARK_GROUPED;
+
+        group.clear();
+        stack.push_back(seed);
+        while (!stack.empty()) {
+            WorldCoord current = stack.back();
+            stack.pop_back();
+            group.push_back(current);
+
+            for (int i = 0; i < 8; i++) {
+                int nx = current.x + NEIGHBOR_DX[i];
+                int ny = current.y + NEIGHBOR_DY[i];
+                if (getMark(nx, ny) == MARK_CANDIDATE) {
+                    markAt(nx, ny) = MARK_GROUPED;
+                    stack.push_back({nx, ny});
+                }
+            }
+        }
+
+        if (group.size() >= minimumCells) {
+            aggregate(findCell(seed.x, seed.y)->material, group);
+        }
+    }
+}
+
+void LiquidBodyTracker::aggregate(MaterialID material, std::vector<WorldCoord>& cells)
+{
+    LiquidBody body;
+    body.material = material;
+    body.cellCount = cells.size();
+
+    // Boundary: the cells around the group, each recorded once. Every one of
+    // them must be stuck, otherwise the liquid is still flowing.
+    bool settled = true;
+    for (const WorldCoord& coord : cells) {
+        for (int i = 0; i < 8 && settled; i++) {
+            int nx = coord.x + NEIGHBOR_DX[i];
+            int ny = coord.y + NEIGHBOR_DY[i];
+            uint8_t& mark = markAt(nx, ny);
+            if (mark != MARK_NONE) continue;
+
+            mark = MARK_BOUNDARY;
+            body.boundary.push_back({nx, ny});
+            const Cell* cell = findCell(nx, ny);
+            settled = cell && isStuck(nx, ny, *cell);
+        }
+        if (!settled) break;
+    }
+
+    // Boundary cells may border another group too
+    for (const WorldCoord& coord : body.boundary) {
+        markAt(coord.x, coord.y) = MARK_NONE;
+    }
+    if (!settled) return;
+
+    // Interior as row spans, plus its bounds and temperatures
+    std::sort(cells.begin(), cells.end(), [](const WorldCoord& a, const WorldCoord& b) {
+        return a.y < b.y || (a.y == b.y && a.x < b.x);
+    });
+    int minX = cells.front().x;
+    int maxX = cells.front().x;
+    double temperatureSum = 0.0;
+    float minTemperature = findCell(cells.front().x, cells.front().y)->temperature;
+    float maxTemperature = minTemperature;
+    for (const WorldCoord& coord : cells) {
+        if (!body.interior.empty() && body.interior.back().y == coord.y && body.interior.back().x1 == coord.x) {
+            body.interior.back().x1++;
+        } else {
+            body.interior.push_back({coord.y, coord.x, coord.x + 1});
+        }
+        minX = std::min(minX, coord.x);
+        maxX = std::max(maxX, coord.x);
+
+        float temperature = findCell(coord.x, coord.y)->temperature;
+        temperatureSum += temperature;
+        minTemperature = std::min(minTemperature, temperature);
+        maxTemperature = std::max(maxTemperature, temperature);
+    }
+    body.bounds = {minX, cells.front().y, maxX - minX + 1, cells.back().y - cells.front().y + 1};
+    body.initialMeanTemperature = static_cast<float>(temperatureSum / cells.size());
+    body.initialMinTemperature = minTemperature;
+    body.initialMaxTemperature = maxTemperature;
+    body.meanTemperature = body.initialMeanTemperature;
+
+    // A body about to freeze or boil has to change per cell
+    if (isBreached(body)) return;
+
+    // Surface: the shallowest boundary cell of each column
+    std::vector<WorldCoord> columns = body.boundary;
+    std::sort(columns.begin(), columns.end(), [](const WorldCoord& a, const WorldCoord& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    for (const WorldCoord& coord : columns) {
+        if (body.surface.empty() || body.surface.back().x != coord.x) {
+            body.surface.push_back(coord);
+        }
+    }
+
+    for (const WorldCoord& coord : cells) {
+        setAggregated(coord.x, coord.y, material);
+    }
+    body.id = nextBodyId++;
+    bodies.push_back(std::move(body));
+}
+
+void LiquidBodyTracker::setAggregated(int x, int y, MaterialID material)
+{
+    Chunk* chunk = chunkManager->getChunk(chunkManager->chunkCoordOf(x, y));
+    if (!chunk) return;
+    LocalCoord local = chunkManager->localCoordOf(x, y);
+    chunk->setAggregatedMaterial(local.x, local.y, material);
+}
+
+void LiquidBodyTracker::release(size_t index)
+{
+    LiquidBody body = std::move(bodies[index]);
+    if (index + 1 != bodies.size()) {
+        bodies[index] = std::move(bodies.back());
+    }
+    bodies.pop_back();
+    releasedBodies++;
+
+    // Back to per-cell form, applying the ambient drift the cells missed
+    for (const LiquidBody::Span& span : body.interior) {
+        for (int x = span.x0; x < span.x1; x++) {
+            Chunk* chunk = chunkManager->getChunk(chunkManager->chunkCoordOf(x, span.y));
+            if (!chunk) continue;
+            LocalCoord local = chunkManager->localCoordOf(x, span.y);
+            chunk->setAggregatedMaterial(local.x, local.y, 0);
+
+            Cell& cell = chunk->getCell(local.x, local.y);
+            if (cell.material == body.material) {
+                cell.temperature = driftToAmbient(cell.temperature, body.ambientDecay);
+            }
+        }
+    }
+}
+
+void LiquidBodyTracker::releaseAt(int x, int y)
+{
+    for (size_t i = 0; i < bodies.size(); i++) {
+        const LiquidBody& body = bodies[i];
+        if (x < body.bounds.x || x >= body.bounds.x + body.bounds.width ||
+            y < body.bounds.y || y >= body.bounds.y + body.bounds.height) {
+            continue;
+        }
+
+        auto row = std::lower_bound(body.interior.begin(), body.interior.end(), y,
+                                    [](const LiquidBody::Span& span, int row) { return span.y < row; });
+        for (; row != body.interior.end() && row->y == y; ++row) {
+            if (x >= row->x0 && x < row->x1) {
+                release(i);
+                return;
+            }
+        }
+    }
+
+    // A flag left behind by a body that no longer exists
+    setAggregated(x, y, 0);
+}
+
+void LiquidBodyTracker::releaseArea(const WorldRect& area)
+{
+    for (size_t i = bodies.size(); i-- > 0;) {
+        const WorldRect& bounds = bodies[i].bounds;
+        if (bounds.x < area.x + area.width && area.x < bounds.x + bounds.width &&
+            bounds.y < area.y + area.height && area.y < bounds.y + bounds.height) {
+            release(i);
+        }
+    }
+}
+
+void LiquidBodyTracker::releaseAll()
+{
+    while (!bodies.empty()) {
+        release(bodies.size() - 1);
+    }
+}
+
+size_t LiquidBodyTracker::getAggregatedCellCount() const
+{
+    size_t count = 0;
+    for (const LiquidBody& body : bodies) {
+        count += body.cellCount;
+    }
+    return count;
+}
+
+size_t LiquidBodyTracker::getBoundaryCellCount() const
+{
+    size_t count = 0;
+    for (const LiquidBody& body : bodies) {
+        count += body.boundary.size();
+    }
+    return count;
+}
+
+size_t LiquidBodyTracker::getMemoryUsage() const
+{
+    size_t bytes = heapBytes(bodies) + heapBytes(materialInfo) + heapBytes(marks);
+    for (const LiquidBody& body : bodies) {
+        bytes += heapBytes(body.interior) + heapBytes(body.surface) + heapBytes(body.boundary);
+    }
+    for (const auto& pair : marks) {
+        bytes += heapBytes(pair.second);
+    }
+    return bytes;
+}
+
+} // namespace astral
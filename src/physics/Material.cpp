@@ -1,4 +1,6 @@
 #include "astral/physics/Material.h"
+#include "astral/core/MemoryReport.h"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 
@@ -40,6 +42,7 @@ MaterialProperties::MaterialProperties()
     , ignitionPoint(0.0f)
     , lifetime(0.0f)
     , burnRate(0.0f)
+    , updateInterval(1)
     , flags(0)
 {
 }
@@ -65,10 +68,47 @@ MaterialProperties::MaterialProperties(MaterialType type, const std::string& nam
     , ignitionPoint(0.0f)
     , lifetime(0.0f)
     , burnRate(0.0f)
+    , updateInterval(1)
     , flags(0)
 {
 }
 
+int MaterialProperties::intervalForViscosity(float viscosity)
+{
+    return 1 + std::max(0, static_cast<int>(viscosity * 4.0f));
+}
+
+size_t MaterialProperties::getMemoryUsage() const
+{
+    return heapBytes(name) + heapBytes(reactions) + heapBytes(stateChanges);
+}
+
+const char* materialTypeName(MaterialType type) {
+    switch (type) {
+        case MaterialType::EMPTY: return "EMPTY";
+        case MaterialType::SOLID: return "SOLID";
+        case MaterialType::METAL: return "METAL";
+        case MaterialType::WOOD: return "WOOD";
+        case MaterialType::GLASS: return "GLASS";
+        case MaterialType::CRYSTAL: return "CRYSTAL";
+        case MaterialType::POWDER: return "POWDER";
+        case MaterialType::SOIL: return "SOIL";
+        case MaterialType::GRANULAR: return "GRANULAR";
+        case MaterialType::LIQUID: return "LIQUID";
+        case MaterialType::OIL: return "OIL";
+        case MaterialType::ACID: return "ACID";
+        case MaterialType::LAVA: return "LAVA";
+        case MaterialType::GAS: return "GAS";
+        case MaterialType::STEAM: return "STEAM";
+        case MaterialType::SMOKE: return "SMOKE";
+        case MaterialType::FIRE: return "FIRE";
+        case MaterialType::PLASMA: return "PLASMA";
+        case MaterialType::ORGANIC: return "ORGANIC";
+        case MaterialType::SPECIAL: return "SPECIAL";
+    }
+    return "UNKNOWN";
+}
+
 // MaterialRegistry implementation
 MaterialRegistry::MaterialRegistry() : nextID(1) {
     // Always register air/empty as ID 0
@@ -161,6 +201,7 @@ void MaterialRegistry::registerBasicMaterials() {
     lava.density = 2800.0f;       // Higher density to ensure lava can displace most materials
     lava.dispersion = 4.0f;       // Lower dispersion for thicker flow
     lava.viscosity = 0.6f;        // Higher viscosity for slower, more realistic flow
+    lava.updateInterval = MaterialProperties::intervalForViscosity(lava.viscosity);
     lava.emissive = true;
     lava.emissiveStrength = 0.8f; // Brighter glow
     lava.movable = true;
@@ -183,6 +224,7 @@ void MaterialRegistry::registerBasicMaterials() {
     blueLava.density = 2500.0f;       // Slightly less dense
     blueLava.dispersion = 6.0f;       // Higher dispersion for more fluid flow
     blueLava.viscosity = 0.4f;        // Less viscous, flows faster
+    blueLava.updateInterval = MaterialProperties::intervalForViscosity(blueLava.viscosity);
     blueLava.emissive = true;
     blueLava.emissiveStrength = 1.0f; // Brighter glow
     blueLava.movable = true;
@@ -197,6 +239,7 @@ void MaterialRegistry::registerBasicMaterials() {
     obsidianLava.density = 3000.0f;       // Denser
     obsidianLava.dispersion = 2.0f;       // Lower dispersion for slower flow
     obsidianLava.viscosity = 0.8f;        // Much more viscous, flows slowly
+    obsidianLava.updateInterval = MaterialProperties::intervalForViscosity(obsidianLava.viscosity);
     obsidianLava.emissive = true;
     obsidianLava.emissiveStrength = 0.6f; // Less bright
     obsidianLava.movable = true;
@@ -211,6 +254,7 @@ void MaterialRegistry::registerBasicMaterials() {
     moltenMetal.density = 3500.0f;       // Very dense
     moltenMetal.dispersion = 3.0f;       // Moderate dispersion
     moltenMetal.viscosity = 0.5f;        // Moderate viscosity
+    moltenMetal.updateInterval = MaterialProperties::intervalForViscosity(moltenMetal.viscosity);
     moltenMetal.emissive = true;
     moltenMetal.emissiveStrength = 0.9f;  // Bright glow
     moltenMetal.movable = true;
@@ -400,6 +444,12 @@ void MaterialRegistry::registerBasicMaterials() {
     woodProps.reactions.push_back(woodOilFireReaction);
 }
 
+std::shared_ptr<const MaterialRegistry> MaterialRegistry::createShared() {
+    auto registry = std::make_shared<MaterialRegistry>();
+    registry->registerBasicMaterials();
+    return registry;
+}
+
 MaterialID MaterialRegistry::registerMaterial(const MaterialProperties& properties) {
     // Check if a material with this name already exists
     if (nameToID.find(properties.name) != nameToID.end()) {
@@ -478,4 +528,63 @@ MaterialID MaterialRegistry::getOilFireID() const {
     return getIDFromName("OilFire");
 }
 
-} // namespace astral
\ No newline at end of file
+size_t MaterialRegistry::getMemoryUsage() const {
+    size_t bytes = heapBytes(materials) + heapBytes(nameToID);
+    for (const auto& pair : materials) {
+        bytes += pair.second.getMemoryUsage();
+    }
+    for (const auto& pair : nameToID) {
+        bytes += heapBytes(pair.first);
+    }
+    return bytes;
+}
+
+// ==================== MaterialTable ====================
+
+MaterialTable::MaterialTable(const MaterialRegistry& registry)
+    : sandID(registry.getSandID())
+    , waterID(registry.getWaterID())
+    , stoneID(registry.getStoneID())
+    , oilID(registry.getOilID())
+    , lavaID(registry.getLavaID())
+    , fireID(registry.getFireID())
+    , steamID(registry.getSteamID())
+    , smokeID(registry.getSmokeID())
+    , woodID(registry.getWoodID())
+    , oilFireID(registry.getOilFireID())
+{
+    properties.reserve(registry.getIDLimit());
+    updateIntervals.reserve(registry.getIDLimit());
+    decaying.reserve(registry.getIDLimit());
+    decayRules.reserve(registry.getIDLimit());
+    for (MaterialID id = 0; id < registry.getIDLimit(); id++) {
+        properties.push_back(registry.getMaterial(id));
+        updateIntervals.push_back(static_cast<uint8_t>(std::min(255, std::max(1, properties.back().updateInterval))));
+        
+        // Fire burns down to smoke, oil fire to darker, hotter and longer
+        // lived smoke; gases dissipate
+        DecayRule rule;
+        MaterialType type = properties.back().type;
+        if (type == MaterialType::FIRE) {
+            bool oil = id == oilFireID;
+            rule.product = smokeID;
+            rule.temperature = oil ? 130.0f : 100.0f;
+            rule.lifetime = oil ? 120 : 80;
+            rule.lifetimeJitter = oil ? 30 : 20;
+            rule.metadata = oil ? 1 : 0;
+        }
+        decaying.push_back(type == MaterialType::FIRE || type == MaterialType::GAS ? 1 : 0);
+        decayRules.push_back(rule);
+    }
+}
+
+size_t MaterialTable::getMemoryUsage() const
+{
+    size_t bytes = heapBytes(properties) + heapBytes(updateIntervals) + heapBytes(decaying) + heapBytes(decayRules);
+    for (const MaterialProperties& material : properties) {
+        bytes += material.getMemoryUsage();
+    }
+    return bytes;
+}
+
+} // namespace astral
@@ -0,0 +1,295 @@
+#include "astral/physics/ParticleSystem.h"
+#include "astral/physics/CellProcessor.h"
+#include "astral/physics/Material.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace astral {
+
+namespace {
+
+// How far above its cell a settling particle looks for room
+constexpr int DEPOSIT_REACH = 64;
+
+// Longest trace of one step, in cells
+constexpr int MAX_TRACE_STEPS = 4096;
+
+int cellOf(float position)
+{
+    return static_cast<int>(std::floor(position));
+}
+
+} // namespace
+
+ParticleSystem::ParticleSystem(const CellProcessor* processor, ChunkManager* chunkManager,
+                               int worldWidth, int worldHeight, const ParticleSystemConfig& config)
+    : processor(processor)
+    , chunkManager(chunkManager)
+    , worldWidth(worldWidth)
+    , worldHeight(worldHeight)
+    , config(config)
+    , wordsPerRow((chunkManager->getChunkSize() + 63) / 64)
+{
+    if (config.drag < 0.0f || config.restitution < 0.0f || config.restitution > 1.0f ||
+        config.friction < 0.0f || config.friction > 1.0f || config.restSpeed < 0.0f) {
+        throw std::invalid_argument("Invalid particle system settings");
+    }
+}
+
+bool ParticleSystem::spawn(float x, float y, float velocityX, float velocityY, const Cell& cell, float flightSeconds)
+{
+    if (size() >= config.maxParticles) {
+        return false;
+    }
+    positionX.push_back(x);
+    positionY.push_back(y);
+    this->velocityX.push_back(velocityX);
+    this->velocityY.push_back(velocityY);
+    flightLeft.push_back(flightSeconds);
+    cells.push_back(cell);
+    lastX.push_back(x);
+    lastY.push_back(y);
+    stats.spawned++;
+    return true;
+}
+
+void ParticleSystem::update(float deltaTime)
+{
+    landed.clear();
+    if (empty()) {
+        return;
+    }
+    occupancy.clear();
+
+    // Integrate every particle; no branches, so this loop vectorises
+    const size_t count = size();
+    const float damping = std::max(0.0f, 1.0f - config.drag * deltaTime);
+    const float fall = config.gravity * deltaTime;
+    lastX = positionX;
+    lastY = positionY;
+    float* px = positionX.data();
+    float* py = positionY.data();
+    float* vx = velocityX.data();
+    float* vy = velocityY.data();
+    float* flight = flightLeft.data();
+    for (size_t i = 0; i < count; i++) {
+        vx[i] *= damping;
+        vy[i] = (vy[i] + fall) * damping;
+        px[i] += vx[i] * deltaTime;
+        py[i] += vy[i] * deltaTime;
+        flight[i] -= deltaTime;
+    }
+
+    // Collide, settle and burn out; removing moves the last particle into
+    // the freed slot, so the index only advances past kept particles
+    for (size_t i = 0; i < size();) {
+        if (flightLeft[i] <= 0.0f) {
+            stats.burnedOut++;
+            remove(i);
+            continue;
+        }
+        if (trace(i)) {
+            if (deposit(i, cellOf(positionX[i]), cellOf(positionY[i]))) {
+                stats.deposited++;
+            } else {
+                stats.lost++;
+            }
+            remove(i);
+            continue;
+        }
+        i++;
+    }
+}
+
+bool ParticleSystem::trace(size_t index)
+{
+    const float startX = lastX[index];
+    const float startY = lastY[index];
+    const float stepX = positionX[index] - startX;
+    const float stepY = positionY[index] - startY;
+    float longest = std::ceil(std::max(std::abs(stepX), std::abs(stepY)));
+    int steps = std::isfinite(longest) ? std::clamp(static_cast<int>(longest), 1, MAX_TRACE_STEPS) : MAX_TRACE_STEPS;
+
+    // Cells that moved in around the particle bury it; it settles on top
+    int freeX = cellOf(startX);
+    int freeY = cellOf(startY);
+    if (isBlocked(freeX, freeY)) {
+        return true;
+    }
+    for (int s = 1; s <= steps; s++) {
+        float t = static_cast<float>(s) / steps;
+        int x = cellOf(startX + stepX * t);
+        int y = cellOf(startY + stepY * t);
+        if (x == freeX && y == freeY) continue;
+        if (!isBlocked(x, y)) {
+            freeX = x;
+            freeY = y;
+            continue;
+        }
+
+        // Bounce off the side that was hit; a corner reflects both ways
+        bool hitX = x != freeX && isBlocked(x, freeY);
+        bool hitY = y != freeY && isBlocked(freeX, y);
+        if (!hitX && !hitY) {
+            hitX = hitY = true;
+        }
+        float& vx = velocityX[index];
+        float& vy = velocityY[index];
+        if (hitY) {
+            vy = -vy * config.restitution;
+            vx *= config.friction;
+        }
+        if (hitX) {
+            vx = -vx * config.restitution;
+            vy *= config.friction;
+        }
+        // Rest against the surface that was hit, so the next step touches
+        // it again instead of falling back across the cell
+        const float inside = 0.999f;
+        float reachedX = std::clamp(startX + stepX * t, static_cast<float>(freeX), freeX + inside);
+        float reachedY = std::clamp(startY + stepY * t, static_cast<float>(freeY), freeY + inside);
+        positionX[index] = hitX ? (x > freeX ? freeX + inside : static_cast<float>(freeX)) : reachedX;
+        positionY[index] = hitY ? (y > freeY ? freeY + inside : static_cast<float>(freeY)) : reachedY;
+        return vx * vx + vy * vy < config.restSpeed * config.restSpeed;
+    }
+    return false;
+}
+
+const std::vector<uint64_t>* ParticleSystem::occupancyOf(ChunkCoord coord)
+{
+    auto found = occupancy.find(coord);
+    if (found != occupancy.end()) {
+        return &found->second;
+    }
+    const Chunk* chunk = chunkManager->peekChunk(coord);
+    if (!chunk) {
+        return nullptr;
+    }
+
+    const MaterialTable& materials = processor->getMaterials();
+    const int size = chunk->getSize();
+    std::vector<uint64_t>& bits = occupancy[coord];
+    bits.assign(static_cast<size_t>(size) * wordsPerRow, 0);
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            MaterialType type = materials.getMaterial(chunk->getCell(x, y).material).type;
+            if (type != MaterialType::EMPTY && type != MaterialType::GAS) {
+                bits[static_cast<size_t>(y) * wordsPerRow + x / 64] |= uint64_t(1) << (x % 64);
+            }
+        }
+    }
+    return &bits;
+}
+
+bool ParticleSystem::isBlocked(int x, int y)
+{
+    if ((worldWidth > 0 && (x < 0 || x >= worldWidth)) || (worldHeight > 0 && (y < 0 || y >= worldHeight))) {
+        return true;
+    }
+    const std::vector<uint64_t>* bits = occupancyOf(chunkManager->chunkCoordOf(x, y));
+    if (!bits) {
+        return true;
+    }
+    LocalCoord local = chunkManager->localCoordOf(x, y);
+    return ((*bits)[static_cast<size_t>(local.y) * wordsPerRow + local.x / 64] >> (local.x % 64)) & 1;
+}
+
+void ParticleSystem::markOccupied(int x, int y)
+{
+    auto found = occupancy.find(chunkManager->chunkCoordOf(x, y));
+    if (found != occupancy.end()) {
+        LocalCoord local = chunkManager->localCoordOf(x, y);
+        found->second[static_cast<size_t>(local.y) * wordsPerRow + local.x / 64] |= uint64_t(1) << (local.x % 64);
+    }
+}
+
+bool ParticleSystem::deposit(size_t index, int x, int y)
+{
+    for (int up = 0; up <= DEPOSIT_REACH; up++) {
+        int cellY = y - up;
+        if (isBlocked(x, cellY)) continue;
+
+        ChunkCoord coord = chunkManager->chunkCoordOf(x, cellY);
+        LocalCoord local = chunkManager->localCoordOf(x, cellY);
+        Chunk* chunk = chunkManager->peekChunk(coord);
+        Cell& target = chunk->getCell(local.x, local.y);
+        target = cells[index];
+        target.velocity = glm::vec2(0.0f, 0.0f);
+        chunk->markDirty();
+        chunkManager->forceActivateChunk(coord);
+        markOccupied(x, cellY);
+        landed.push_back({x, cellY});
+        return true;
+    }
+    return false;
+}
+
+void ParticleSystem::remove(size_t index)
+{
+    size_t last = size() - 1;
+    if (index != last) {
+        positionX[index] = positionX[last];
+        positionY[index] = positionY[last];
+        velocityX[index] = velocityX[last];
+        velocityY[index] = velocityY[last];
+        flightLeft[index] = flightLeft[last];
+        cells[index] = cells[last];
+        lastX[index] = lastX[last];
+        lastY[index] = lastY[last];
+    }
+    positionX.pop_back();
+    positionY.pop_back();
+    velocityX.pop_back();
+    velocityY.pop_back();
+    flightLeft.pop_back();
+    cells.pop_back();
+    lastX.pop_back();
+    lastY.pop_back();
+}
+
+void ParticleSystem::depositAll()
+{
+    occupancy.clear();
+    landed.clear();
+    for (size_t i = 0; i < size(); i++) {
+        if (deposit(i, cellOf(positionX[i]), cellOf(positionY[i]))) {
+            stats.deposited++;
+        } else {
+            stats.lost++;
+        }
+    }
+    clear();
+}
+
+void ParticleSystem::clear()
+{
+    positionX.clear();
+    positionY.clear();
+    velocityX.clear();
+    velocityY.clear();
+    flightLeft.clear();
+    cells.clear();
+    lastX.clear();
+    lastY.clear();
+    occupancy.clear();
+}
+
+size_t ParticleSystem::countMaterial(MaterialID material) const
+{
+    return static_cast<size_t>(std::count_if(cells.begin(), cells.end(),
+                                             [material](const Cell& cell) { return cell.material == material; }));
+}
+
+size_t ParticleSystem::getMemoryUsage() const
+{
+    size_t bytes = heapBytes(positionX) + heapBytes(positionY) + heapBytes(velocityX) + heapBytes(velocityY) +
+                   heapBytes(flightLeft) + heapBytes(cells) + heapBytes(lastX) + heapBytes(lastY) +
+                   heapBytes(landed) + heapBytes(occupancy);
+    for (const auto& pair : occupancy) {
+        bytes += heapBytes(pair.second);
+    }
+    return bytes;
+}
+
+} // namespace astral
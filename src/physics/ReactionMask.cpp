@@ -0,0 +1,204 @@
+#include "astral/physics/ReactionMask.h"
+#include "astral/physics/CellProcessor.h"
+#include <algorithm>
+#include <bitset>
+
+namespace astral {
+
+// ==================== ReactionMatrix ====================
+
+ReactionMatrix::ReactionMatrix(const CellProcessor& processor)
+    : materialCount(processor.getMaterials().size())
+    , pairs(materialCount * materialCount, 0)
+    , participantOf(materialCount, -1)
+{
+    for (size_t a = 0; a < materialCount; a++) {
+        Cell first(static_cast<MaterialID>(a));
+        for (size_t b = 0; b < materialCount; b++) {
+            Cell second(static_cast<MaterialID>(b));
+            pairs[a * materialCount + b] = processor.canReact(first, second) ? 1 : 0;
+        }
+    }
+
+    // Number the materials that appear on either side of a reactive pair
+    for (size_t a = 0; a < materialCount; a++) {
+        for (size_t b = 0; b < materialCount; b++) {
+            if (!pairs[a * materialCount + b]) continue;
+            for (size_t material : {a, b}) {
+                if (participantOf[material] < 0) {
+                    participantOf[material] = static_cast<int>(participants.size());
+                    participants.push_back(static_cast<MaterialID>(material));
+                }
+            }
+        }
+    }
+
+    partners.resize(participants.size());
+    for (size_t i = 0; i < participants.size(); i++) {
+        for (size_t j = 0; j < participants.size(); j++) {
+            if (canReact(participants[i], participants[j])) {
+                partners[i].push_back(static_cast<int>(j));
+            }
+        }
+    }
+}
+
+size_t ReactionMatrix::getMemoryUsage() const
+{
+    size_t bytes = heapBytes(pairs) + heapBytes(participantOf) + heapBytes(participants) + heapBytes(partners);
+    for (const std::vector<int>& row : partners) {
+        bytes += heapBytes(row);
+    }
+    return bytes;
+}
+
+// ==================== ReactionMask ====================
+
+namespace {
+
+void setBit(uint64_t* row, int column)
+{
+    row[column / 64] |= uint64_t(1) << (column % 64);
+}
+
+} // namespace
+
+ReactionMask::ReactionMask()
+    : size(0)
+    , words(0)
+    , builtCandidates(0)
+{
+}
+
+void ReactionMask::build(const ReactionMatrix& matrix, const ChunkManager& chunks, ChunkCoord coord)
+{
+    size = chunks.getChunkSize();
+    words = (size + 2 + 63) / 64;
+    candidates.assign(static_cast<size_t>(size) * words, 0);
+    builtCandidates = 0;
+
+    const int participantCount = matrix.getParticipantCount();
+    const Chunk* chunk = chunks.getChunk(coord);
+    if (participantCount == 0 || !chunk) return;
+
+    // Rows of the present masks are offset by one for the halo row above, and
+    // columns by one for the halo column on the left
+    const size_t presentRows = static_cast<size_t>(size) + 2;
+    present.assign(participantCount * presentRows * words, 0);
+    auto presentRow = [&](int participant, int haloY) {
+        return present.data() + (participant * presentRows + haloY) * words;
+    };
+
+    bool anyReactive = false;
+    const Cell* cells = chunk->getCells();
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int participant = matrix.getParticipant(cells[y * size + x].material);
+            if (participant < 0) continue;
+            setBit(presentRow(participant, y + 1), x + 1);
+            anyReactive |= !matrix.getPartners(participant).empty();
+        }
+    }
+    if (!anyReactive) return;
+
+    // Halo from the neighbouring chunks; cells of missing chunks read as air,
+    // as they would when the interaction pass creates them
+    const int originX = coord.x * size;
+    const int originY = coord.y * size;
+    auto addHalo = [&](int x, int y) {
+        int worldX = originX + x;
+        int worldY = originY + y;
+        const Chunk* neighbour = chunks.getChunk(chunks.chunkCoordOf(worldX, worldY));
+        MaterialID material = 0;
+        if (neighbour) {
+            LocalCoord local = chunks.localCoordOf(worldX, worldY);
+            material = neighbour->getCell(local.x, local.y).material;
+        }
+        int participant = matrix.getParticipant(material);
+        if (participant >= 0) setBit(presentRow(participant, y + 1), x + 1);
+    };
+    for (int x = -1; x <= size; x++) {
+        addHalo(x, -1);
+        addHalo(x, size);
+    }
+    for (int y = 0; y < size; y++) {
+        addHalo(-1, y);
+        addHalo(size, y);
+    }
+
+    // Dilate the rows of every material something reacts with
+    isPartner.assign(participantCount, 0);
+    for (int participant = 0; participant < participantCount; participant++) {
+        for (int partner : matrix.getPartners(participant)) {
+            isPartner[partner] = 1;
+        }
+    }
+    near.assign(participantCount * static_cast<size_t>(size) * words, 0);
+    for (int participant = 0; participant < participantCount; participant++) {
+        if (!isPartner[participant]) continue;
+        for (int y = 0; y < size; y++) {
+            const uint64_t* above = presentRow(participant, y);
+            const uint64_t* row = presentRow(participant, y + 1);
+            const uint64_t* below = presentRow(participant, y + 2);
+            uint64_t* out = near.data() + (participant * static_cast<size_t>(size) + y) * words;
+            for (int w = 0; w < words; w++) {
+                uint64_t column = above[w] | row[w] | below[w];
+                uint64_t lower = w > 0 ? (above[w - 1] | row[w - 1] | below[w - 1]) >> 63 : 0;
+                uint64_t upper = w + 1 < words ? (above[w + 1] | row[w + 1] | below[w + 1]) << 63 : 0;
+                out[w] = column | (column << 1) | lower | (column >> 1) | upper;
+            }
+        }
+    }
+
+    // A cell is a candidate when a partner of its material is in reach
+    reach.resize(words);
+    for (int participant = 0; participant < participantCount; participant++) {
+        const std::vector<int>& partnerList = matrix.getPartners(participant);
+        if (partnerList.empty()) continue;
+        for (int y = 0; y < size; y++) {
+            const uint64_t* row = presentRow(participant, y + 1);
+            std::fill(reach.begin(), reach.end(), 0);
+            for (int partner : partnerList) {
+                const uint64_t* partnerNear = near.data() + (partner * static_cast<size_t>(size) + y) * words;
+                for (int w = 0; w < words; w++) {
+                    reach[w] |= partnerNear[w];
+                }
+            }
+            uint64_t* out = candidates.data() + static_cast<size_t>(y) * words;
+            for (int w = 0; w < words; w++) {
+                out[w] |= row[w] & reach[w];
+            }
+        }
+    }
+
+    // Drop the halo columns and count
+    for (int y = 0; y < size; y++) {
+        uint64_t* out = candidates.data() + static_cast<size_t>(y) * words;
+        out[0] &= ~uint64_t(1);
+        out[(size + 1) / 64] &= ~(uint64_t(1) << ((size + 1) % 64));
+        for (int w = 0; w < words; w++) {
+            builtCandidates += std::bitset<64>(out[w]).count();
+        }
+    }
+}
+
+bool ReactionMask::isRowQuiet(int y) const
+{
+    const uint64_t* row = candidates.data() + static_cast<size_t>(y) * words;
+    for (int w = 0; w < words; w++) {
+        if (row[w]) return false;
+    }
+    return true;
+}
+
+void ReactionMask::markAround(int x, int y)
+{
+    for (int yy = std::max(0, y - 1); yy <= std::min(size - 1, y + 1); yy++) {
+        uint64_t* row = candidates.data() + static_cast<size_t>(yy) * words;
+        for (int xx = std::max(0, x - 1); xx <= std::min(size - 1, x + 1); xx++) {
+            setBit(row, xx + 1);
+        }
+    }
+}
+
+} // namespace astral
@@ -0,0 +1,372 @@
+#include "astral/physics/RegionFile.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace astral {
+
+namespace {
+
+constexpr char MAGIC[8] = {'A', 'S', 'T', 'R', 'R', 'E', 'G', '1'};
+constexpr size_t HEADER_BYTES = sizeof(MAGIC) + 4;
+constexpr size_t RECORD_PREFIX = 8;            // Body length and checksum
+constexpr size_t RECORD_KEY = 4 + 4 + 8;       // Coordinate and tick
+constexpr uint32_t MAX_RECORD_BODY = 1u << 28;
+
+void putBits(std::vector<uint8_t>& out, uint64_t bits, int bytes)
+{
+    for (int i = 0; i < bytes; i++) {
+        out.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+    }
+}
+
+uint64_t getBits(const uint8_t* data, int bytes)
+{
+    uint64_t bits = 0;
+    for (int i = 0; i < bytes; i++) {
+        bits |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return bits;
+}
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool getVarint(const uint8_t*& data, const uint8_t* end, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && data < end; shift += 7) {
+        uint8_t byte = *data++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t floatBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+float bitsFloat(uint64_t bits)
+{
+    uint32_t narrow = static_cast<uint32_t>(bits);
+    float value;
+    std::memcpy(&value, &narrow, sizeof(value));
+    return value;
+}
+
+// One stored field: its width in bytes, how to read it from a cell and how
+// to write it back
+struct Field {
+    int bytes;
+    uint64_t (*get)(const Cell&);
+    void (*set)(Cell&, uint64_t);
+};
+
+const Field FIELDS[] = {
+    {2, [](const Cell& c) -> uint64_t { return c.material; },
+        [](Cell& c, uint64_t v) { c.material = static_cast<MaterialID>(v); }},
+    {4, [](const Cell& c) -> uint64_t { return floatBits(c.temperature); },
+        [](Cell& c, uint64_t v) { c.temperature = bitsFloat(v); }},
+    {4, [](const Cell& c) -> uint64_t { return floatBits(c.velocity.x); },
+        [](Cell& c, uint64_t v) { c.velocity.x = bitsFloat(v); }},
+    {4, [](const Cell& c) -> uint64_t { return floatBits(c.velocity.y); },
+        [](Cell& c, uint64_t v) { c.velocity.y = bitsFloat(v); }},
+    {1, [](const Cell& c) -> uint64_t { return c.metadata; },
+        [](Cell& c, uint64_t v) { c.metadata = static_cast<uint8_t>(v); }},
+    {4, [](const Cell& c) -> uint64_t { return floatBits(c.pressure); },
+        [](Cell& c, uint64_t v) { c.pressure = bitsFloat(v); }},
+    {4, [](const Cell& c) -> uint64_t { return floatBits(c.health); },
+        [](Cell& c, uint64_t v) { c.health = bitsFloat(v); }},
+    {1, [](const Cell& c) -> uint64_t { return c.lifetime; },
+        [](Cell& c, uint64_t v) { c.lifetime = static_cast<uint8_t>(v); }},
+    {4, [](const Cell& c) -> uint64_t { return floatBits(c.energy); },
+        [](Cell& c, uint64_t v) { c.energy = bitsFloat(v); }},
+    {4, [](const Cell& c) -> uint64_t { return floatBits(c.charge); },
+        [](Cell& c, uint64_t v) { c.charge = bitsFloat(v); }},
+    {1, [](const Cell& c) -> uint64_t { return c.stateFlags; },
+        [](Cell& c, uint64_t v) { c.stateFlags = static_cast<uint8_t>(v); }},
+};
+
+bool syncFile(std::FILE* file)
+{
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef __linux__
+    return fsync(fileno(file)) == 0;
+#else
+    return true;
+#endif
+}
+
+} // namespace
+
+RegionFile::RegionFile()
+    : file(nullptr)
+    , chunkSize(0)
+    , fileBytes(0)
+    , liveBytes(0)
+{
+}
+
+RegionFile::~RegionFile()
+{
+    close();
+}
+
+bool RegionFile::open(const std::string& filePath, int size, bool create)
+{
+    close();
+    path = filePath;
+    chunkSize = size;
+    file = std::fopen(path.c_str(), "r+b");
+    if (!file) {
+        if (!create) {
+            return false;
+        }
+        file = std::fopen(path.c_str(), "w+b");
+        if (!file) {
+            return false;
+        }
+        std::vector<uint8_t> header(MAGIC, MAGIC + sizeof(MAGIC));
+        putBits(header, static_cast<uint32_t>(chunkSize), 4);
+        if (std::fwrite(header.data(), 1, header.size(), file) != header.size() || !syncFile(file)) {
+            close();
+            return false;
+        }
+    }
+    if (!scan()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void RegionFile::close()
+{
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    index.clear();
+    fileBytes = 0;
+    liveBytes = 0;
+}
+
+bool RegionFile::scan()
+{
+    uint8_t header[HEADER_BYTES];
+    std::rewind(file);
+    if (std::fread(header, 1, HEADER_BYTES, file) != HEADER_BYTES ||
+        std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0 ||
+        getBits(header + sizeof(MAGIC), 4) != static_cast<uint32_t>(chunkSize)) {
+        return false;
+    }
+
+    index.clear();
+    fileBytes = HEADER_BYTES;
+    liveBytes = HEADER_BYTES;
+    std::vector<uint8_t> body;
+    for (;;) {
+        uint8_t prefix[RECORD_PREFIX];
+        if (std::fread(prefix, 1, RECORD_PREFIX, file) != RECORD_PREFIX) break;
+        uint32_t length = static_cast<uint32_t>(getBits(prefix, 4));
+        if (length < RECORD_KEY || length > MAX_RECORD_BODY) break;
+        body.resize(length);
+        if (std::fread(body.data(), 1, length, file) != length) break;
+        if (static_cast<uint32_t>(hashBytes(body.data(), length)) != getBits(prefix + 4, 4)) break;
+
+        ChunkCoord coord = {static_cast<int32_t>(getBits(body.data(), 4)),
+                            static_cast<int32_t>(getBits(body.data() + 4, 4))};
+        indexRecord(coord, {fileBytes, static_cast<uint32_t>(RECORD_PREFIX + length), getBits(body.data() + 8, 8)});
+        fileBytes += RECORD_PREFIX + length;
+    }
+
+    // Cut off a record torn by a crash so appends follow the last good one
+#ifdef __linux__
+    std::fflush(file);
+    if (ftruncate(fileno(file), static_cast<off_t>(fileBytes)) != 0) {
+        return false;
+    }
+#endif
+    return std::fseek(file, static_cast<long>(fileBytes), SEEK_SET) == 0;
+}
+
+void RegionFile::indexRecord(ChunkCoord coord, const Record& record)
+{
+    auto found = index.find(coord);
+    if (found != index.end()) {
+        liveBytes -= found->second.length;
+        found->second = record;
+    } else {
+        index.emplace(coord, record);
+    }
+    liveBytes += record.length;
+}
+
+bool RegionFile::append(ChunkCoord coord, uint64_t tick, const std::vector<uint8_t>& encoded)
+{
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> record;
+    record.reserve(RECORD_PREFIX + RECORD_KEY + encoded.size());
+    putBits(record, static_cast<uint32_t>(RECORD_KEY + encoded.size()), 4);
+    putBits(record, 0, 4);
+    putBits(record, static_cast<uint32_t>(coord.x), 4);
+    putBits(record, static_cast<uint32_t>(coord.y), 4);
+    putBits(record, tick, 8);
+    record.insert(record.end(), encoded.begin(), encoded.end());
+    uint32_t checksum = static_cast<uint32_t>(hashBytes(record.data() + RECORD_PREFIX, record.size() - RECORD_PREFIX));
+    for (int i = 0; i < 4; i++) {
+        record[4 + i] = static_cast<uint8_t>(checksum >> (8 * i));
+    }
+
+    if (std::fseek(file, static_cast<long>(fileBytes), SEEK_SET) != 0 ||
+        std::fwrite(record.data(), 1, record.size(), file) != record.size()) {
+        return false;
+    }
+    indexRecord(coord, {fileBytes, static_cast<uint32_t>(record.size()), tick});
+    fileBytes += record.size();
+    return true;
+}
+
+bool RegionFile::sync()
+{
+    return file && syncFile(file);
+}
+
+bool RegionFile::compact()
+{
+    if (!file) {
+        return false;
+    }
+
+    // Live records in file order, so the copy reads the old file front to back
+    std::vector<std::pair<ChunkCoord, Record>> live(index.begin(), index.end());
+    std::sort(live.begin(), live.end(), [](const auto& a, const auto& b) { return a.second.offset < b.second.offset; });
+
+    std::string tempPath = path + ".compact";
+    std::FILE* out = std::fopen(tempPath.c_str(), "wb");
+    if (!out) {
+        return false;
+    }
+    std::vector<uint8_t> buffer(MAGIC, MAGIC + sizeof(MAGIC));
+    putBits(buffer, static_cast<uint32_t>(chunkSize), 4);
+    bool ok = std::fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+    for (size_t i = 0; ok && i < live.size(); i++) {
+        const Record& record = live[i].second;
+        buffer.resize(record.length);
+        ok = std::fseek(file, static_cast<long>(record.offset), SEEK_SET) == 0 &&
+             std::fread(buffer.data(), 1, record.length, file) == record.length &&
+             std::fwrite(buffer.data(), 1, record.length, out) == record.length;
+    }
+    ok = ok && syncFile(out);
+    std::fclose(out);
+
+    // The rename replaces the old file in one step; a crash before it
+    // leaves the old file whole
+    if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(tempPath.c_str());
+        std::fseek(file, static_cast<long>(fileBytes), SEEK_SET);
+        return false;
+    }
+    std::string reopenPath = path;
+    return open(reopenPath, chunkSize, false);
+}
+
+bool RegionFile::read(ChunkCoord coord, Cell* cells)
+{
+    auto found = index.find(coord);
+    if (!file || found == index.end()) {
+        return false;
+    }
+    const Record& record = found->second;
+    std::vector<uint8_t> buffer(record.length);
+    bool ok = std::fseek(file, static_cast<long>(record.offset), SEEK_SET) == 0 &&
+              std::fread(buffer.data(), 1, record.length, file) == record.length;
+    std::fseek(file, static_cast<long>(fileBytes), SEEK_SET);
+    const size_t headerBytes = RECORD_PREFIX + RECORD_KEY;
+    return ok && decodeCells(buffer.data() + headerBytes, buffer.size() - headerBytes, cells,
+                             static_cast<size_t>(chunkSize) * chunkSize);
+}
+
+std::vector<ChunkCoord> RegionFile::getChunks() const
+{
+    std::vector<ChunkCoord> coords;
+    coords.reserve(index.size());
+    for (const auto& entry : index) {
+        coords.push_back(entry.first);
+    }
+    std::sort(coords.begin(), coords.end());
+    return coords;
+}
+
+void RegionFile::encodeCells(const Cell* cells, size_t count, std::vector<uint8_t>& out)
+{
+    out.clear();
+    for (const Field& field : FIELDS) {
+        size_t i = 0;
+        while (i < count) {
+            uint64_t value = field.get(cells[i]);
+            size_t run = 1;
+            while (i + run < count && field.get(cells[i + run]) == value) {
+                run++;
+            }
+            putVarint(out, run);
+            putBits(out, value, field.bytes);
+            i += run;
+        }
+    }
+}
+
+bool RegionFile::decodeCells(const uint8_t* data, size_t size, Cell* cells, size_t count)
+{
+    const uint8_t* end = data + size;
+    for (size_t i = 0; i < count; i++) {
+        cells[i] = Cell();
+    }
+    for (const Field& field : FIELDS) {
+        size_t i = 0;
+        while (i < count) {
+            uint64_t run;
+            if (!getVarint(data, end, run) || run == 0 || run > count - i ||
+                static_cast<size_t>(end - data) < static_cast<size_t>(field.bytes)) {
+                return false;
+            }
+            uint64_t value = getBits(data, field.bytes);
+            data += field.bytes;
+            for (size_t j = 0; j < run; j++) {
+                field.set(cells[i + j], value);
+            }
+            i += run;
+        }
+    }
+    return data == end;
+}
+
+uint64_t RegionFile::hashBytes(const uint8_t* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace astral
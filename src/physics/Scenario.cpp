@@ -0,0 +1,91 @@
+#include "astral/physics/Scenario.h"
+#include "astral/physics/CellularAutomaton.h"
+#include <algorithm>
+#include <random>
+
+namespace astral {
+
+namespace {
+
+const char* const SCENARIO_NAMES[] = { "idle", "sand", "water", "lava", "mixed" };
+
+// Materials the moving blocks of a scenario are made of
+std::vector<std::string> scenarioMaterials(ScenarioType type)
+{
+    switch (type) {
+        case ScenarioType::IDLE:  return {};
+        case ScenarioType::SAND:  return {"Sand"};
+        case ScenarioType::WATER: return {"Water"};
+        case ScenarioType::LAVA:  return {"Lava", "Water", "Wood"};
+        case ScenarioType::MIXED: return {"Sand", "Water", "Lava", "Oil", "Wood"};
+    }
+    return {};
+}
+
+} // namespace
+
+const char* scenarioName(ScenarioType type)
+{
+    return SCENARIO_NAMES[static_cast<int>(type)];
+}
+
+bool parseScenario(const std::string& name, ScenarioType& type)
+{
+    for (ScenarioType candidate : allScenarios()) {
+        if (name == scenarioName(candidate)) {
+            type = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<ScenarioType> allScenarios()
+{
+    return {ScenarioType::IDLE, ScenarioType::SAND, ScenarioType::WATER,
+            ScenarioType::LAVA, ScenarioType::MIXED};
+}
+
+void buildScenario(CellularAutomaton& world, const ScenarioConfig& config)
+{
+    world.clearWorld();
+    world.setRandomSeed(config.seed);
+
+    int width = world.getWorldWidth();
+    int height = world.getWorldHeight();
+    MaterialID stone = world.getMaterialIDByName("Stone");
+
+    // Floor, plus a settled stone layer standing in for terrain when idle
+    int floorHeight = std::max(4, height / 64);
+    world.fillRectangle(0, height - floorHeight, width, floorHeight, stone);
+
+    std::vector<MaterialID> materials;
+    for (const auto& name : scenarioMaterials(config.type)) {
+        materials.push_back(world.getMaterialIDByName(name));
+    }
+    if (materials.empty()) {
+        materials.push_back(stone);
+    }
+
+    // Seeded blocks in the space above the floor until the requested share of
+    // the world is covered (overlaps are counted twice, so this is approximate)
+    std::mt19937 random(config.seed);
+    int openHeight = height - floorHeight;
+    long long target = static_cast<long long>(std::clamp(config.activity, 0.0f, 1.0f) * width * openHeight);
+    int maxBlockWidth = std::max(2, width / 8);
+    int maxBlockHeight = std::max(2, openHeight / 8);
+
+    long long covered = 0;
+    while (covered < target) {
+        int blockWidth = std::uniform_int_distribution<int>(maxBlockWidth / 2, maxBlockWidth)(random);
+        int blockHeight = std::uniform_int_distribution<int>(maxBlockHeight / 2, maxBlockHeight)(random);
+        int x = std::uniform_int_distribution<int>(0, width - blockWidth)(random);
+        int y = std::uniform_int_distribution<int>(0, openHeight - blockHeight)(random);
+        MaterialID material = materials[std::uniform_int_distribution<size_t>(0, materials.size() - 1)(random)];
+
+        world.fillRectangle(x, y, blockWidth, blockHeight, material);
+        covered += static_cast<long long>(blockWidth) * blockHeight;
+    }
+}
+
+} // namespace astral
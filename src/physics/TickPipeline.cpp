@@ -0,0 +1,164 @@
+#include "astral/physics/TickPipeline.h"
+#include <chrono>
+
+namespace astral {
+
+bool TickPipeline::State::runOne(std::unique_lock<std::mutex>& lock)
+{
+    if (queue.empty()) {
+        return false;
+    }
+    Job job = queue.front();
+    queue.pop_front();
+    const Consumer& consumer = consumers[job.consumer].second;
+    const PublishedTick& tick = slots[job.slot];
+    lock.unlock();
+
+    auto start = std::chrono::steady_clock::now();
+    consumer(tick);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    lock.lock();
+    consumerMilliseconds[job.consumer] += ms;
+    outstanding[job.slot]--;
+    done.notify_all();
+    return true;
+}
+
+TickPipeline::TickPipeline(ThreadPool* pool)
+    : pool(pool)
+    , state(std::make_shared<State>())
+    , currentSlot(1)
+    , publishedTicks(0)
+    , waitMilliseconds(0.0)
+{
+}
+
+TickPipeline::~TickPipeline()
+{
+    flush();
+}
+
+void TickPipeline::addConsumer(const std::string& name, Consumer consumer)
+{
+    // The consumer list is read by queued jobs without copying
+    flush();
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->consumers.emplace_back(name, std::move(consumer));
+    state->consumerMilliseconds.push_back(0.0);
+}
+
+size_t TickPipeline::getConsumerCount() const
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->consumers.size();
+}
+
+void TickPipeline::waitForSlot(size_t slot)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    while (state->outstanding[slot] > 0) {
+        // Help with queued jobs rather than wait for a worker to pick them up
+        if (!state->runOne(lock)) {
+            state->done.wait(lock);
+        }
+    }
+    waitMilliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+PublishedTick& TickPipeline::beginPublish()
+{
+    currentSlot ^= 1;
+    waitForSlot(currentSlot);
+    return state->slots[currentSlot];
+}
+
+void TickPipeline::publish()
+{
+    publishedTicks++;
+
+    size_t jobCount;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        jobCount = state->consumers.size();
+        state->outstanding[currentSlot] = jobCount;
+        for (size_t i = 0; i < jobCount; i++) {
+            state->queue.push_back({currentSlot, i});
+        }
+    }
+
+    if (!pool) {
+        waitForSlot(currentSlot);
+        return;
+    }
+
+    // Each task runs whichever job is next; tasks whose job was taken by a
+    // helper find the queue empty and return
+    for (size_t i = 0; i < jobCount; i++) {
+        std::shared_ptr<State> shared = state;
+        pool->submit([shared]() {
+            std::unique_lock<std::mutex> lock(shared->mutex);
+            shared->runOne(lock);
+        });
+    }
+}
+
+void TickPipeline::capture(const ChunkManager& chunks, PublishedTick& out)
+{
+    const auto& active = chunks.getActiveChunks();
+    out.chunkSize = chunks.getChunkSize();
+
+    // Reuse the buffers of two ticks ago; after the first few ticks this
+    // does not allocate unless the active set grows
+    out.chunks.resize(active.size());
+    size_t index = 0;
+    for (const ChunkCoord& coord : active) {
+        const Chunk* chunk = chunks.getChunk(coord);
+        if (!chunk) continue;
+        PublishedChunk& published = out.chunks[index++];
+        published.coord = coord;
+        published.cells.assign(chunk->getCells(), chunk->getCells() + chunk->getCellCount());
+    }
+    out.chunks.resize(index);
+}
+
+void TickPipeline::flush()
+{
+    waitForSlot(0);
+    waitForSlot(1);
+}
+
+double TickPipeline::getWaitMilliseconds() const
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return waitMilliseconds;
+}
+
+double TickPipeline::getConsumerMilliseconds(const std::string& name) const
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    for (size_t i = 0; i < state->consumers.size(); i++) {
+        if (state->consumers[i].first == name) {
+            return state->consumerMilliseconds[i];
+        }
+    }
+    return 0.0;
+}
+
+size_t TickPipeline::getMemoryUsage() const
+{
+    // Consumers only read the buffers, so their sizes can be taken while
+    // they run
+    size_t bytes = 0;
+    for (const PublishedTick& slot : state->slots) {
+        bytes += heapBytes(slot.chunks);
+        for (const PublishedChunk& chunk : slot.chunks) {
+            bytes += heapBytes(chunk.cells);
+        }
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return bytes + heapBytes(state->queue) + heapBytes(state->consumerMilliseconds);
+}
+
+} // namespace astral
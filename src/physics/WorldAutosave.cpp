@@ -0,0 +1,266 @@
+#include "astral/physics/WorldAutosave.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace astral {
+
+namespace {
+
+// Nice value of the writer; on a loaded or single core machine it yields to
+// the ticking thread instead of splitting time with it
+constexpr int WRITER_NICE = 10;
+
+} // namespace
+
+WorldAutosave::WorldAutosave(ChunkManager* chunkManager, const WorldAutosaveConfig& config)
+    : chunkManager(chunkManager)
+    , config(config)
+    , sinceSave(0.0f)
+    , tickCount(0)
+    , stopping(false)
+    , writing(false)
+    , writerBytes(0)
+{
+    if (config.intervalSeconds <= 0.0f || config.handoffBudgetMs <= 0.0 || config.compactRatio < 1.0f) {
+        throw std::invalid_argument("Invalid autosave settings");
+    }
+}
+
+WorldAutosave::~WorldAutosave()
+{
+    stop();
+}
+
+bool WorldAutosave::start(const std::string& path)
+{
+    stop();
+    if (!file.open(path, chunkManager->getChunkSize(), true)) {
+        return false;
+    }
+    savedHashes.clear();
+    stopping = false;
+    writer = std::thread(&WorldAutosave::writerLoop, this);
+    return true;
+}
+
+void WorldAutosave::stop()
+{
+    if (!writer.joinable()) {
+        return;
+    }
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    writer.join();
+    file.close();
+}
+
+WorldAutosaveStats WorldAutosave::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+size_t WorldAutosave::getMemoryUsage() const
+{
+    size_t bytes = heapBytes(touched) + heapBytes(pendingChunks) + writerBytes.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex);
+    bytes += heapBytes(jobs) + heapBytes(freeBuffers);
+    for (const Job& job : jobs) {
+        bytes += heapBytes(job.cells);
+    }
+    for (const std::vector<Cell>& buffer : freeBuffers) {
+        bytes += heapBytes(buffer);
+    }
+    return bytes;
+}
+
+void WorldAutosave::tick(float deltaTime, const std::set<ChunkCoord>& activeChunks)
+{
+    tickCount++;
+    touched.insert(activeChunks.begin(), activeChunks.end());
+
+    sinceSave += deltaTime;
+    if (pendingChunks.empty() && sinceSave >= config.intervalSeconds) {
+        beginSave();
+    }
+    if (!pendingChunks.empty()) {
+        handOff(config.handoffBudgetMs);
+    }
+}
+
+void WorldAutosave::saveNow()
+{
+    if (pendingChunks.empty()) {
+        beginSave();
+    }
+}
+
+void WorldAutosave::beginSave()
+{
+    sinceSave = 0.0f;
+
+    // Cells moving out of a simulated chunk land in its neighbours, which
+    // are not simulated themselves
+    std::unordered_set<ChunkCoord, ChunkCoordHash> candidates;
+    for (const ChunkCoord& coord : touched) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                ChunkCoord neighbour = {coord.x + dx, coord.y + dy};
+                if (chunkManager->peekChunk(neighbour)) {
+                    candidates.insert(neighbour);
+                }
+            }
+        }
+    }
+    touched.clear();
+    if (candidates.empty()) {
+        return;
+    }
+
+    // Copied from the back, so in ascending order
+    pendingChunks.assign(candidates.begin(), candidates.end());
+    std::sort(pendingChunks.begin(), pendingChunks.end(), [](const ChunkCoord& a, const ChunkCoord& b) { return b < a; });
+}
+
+void WorldAutosave::handOff(double budgetMs)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    double elapsedMs = 0.0;
+    size_t copied = 0;
+
+    // At least one chunk per tick, so a save always finishes; after that,
+    // only as many as fit in the budget at the average cost so far
+    while (!pendingChunks.empty() && (copied == 0 || elapsedMs * (copied + 1) / copied <= budgetMs)) {
+        ChunkCoord coord = pendingChunks.back();
+        pendingChunks.pop_back();
+        const Chunk* chunk = chunkManager->peekChunk(coord);
+        if (chunk) {
+            Job job;
+            job.coord = coord;
+            job.tick = tickCount;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!freeBuffers.empty()) {
+                    job.cells = std::move(freeBuffers.back());
+                    freeBuffers.pop_back();
+                }
+            }
+            job.cells.assign(chunk->getCells(), chunk->getCells() + chunk->getCellCount());
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(std::move(job));
+            stats.chunksCopied++;
+            copied++;
+        }
+        elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // A job without cells ends the save. The writer is woken once, after
+    // the copying, so it does not compete with it.
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pendingChunks.empty()) {
+            Job end;
+            end.tick = tickCount;
+            jobs.push_back(std::move(end));
+        }
+        if (budgetMs == config.handoffBudgetMs) {
+            stats.maxHandoffMs = std::max(stats.maxHandoffMs, elapsedMs);
+        }
+    }
+    wake.notify_one();
+}
+
+void WorldAutosave::flush()
+{
+    if (!pendingChunks.empty()) {
+        handOff(std::numeric_limits<double>::infinity());
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return jobs.empty() && !writing; });
+}
+
+void WorldAutosave::writerLoop()
+{
+#ifdef __linux__
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), WRITER_NICE);
+#endif
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || !jobs.empty(); });
+        if (jobs.empty()) {
+            return;
+        }
+
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        writing = true;
+        lock.unlock();
+
+        write(job);
+
+        lock.lock();
+        if (!job.cells.empty()) {
+            freeBuffers.push_back(std::move(job.cells));
+        }
+        writing = false;
+        if (jobs.empty()) {
+            idle.notify_all();
+        }
+    }
+}
+
+void WorldAutosave::write(const Job& job)
+{
+    if (job.cells.empty()) {
+        bool synced = file.sync();
+        bool compact = file.getFileBytes() >= config.compactMinBytes &&
+                       file.getFileBytes() > config.compactRatio * file.getLiveBytes();
+        bool compacted = compact && file.compact();
+        if (compact && !compacted) {
+            std::cerr << "WorldAutosave: failed to compact the region file" << std::endl;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.saves++;
+        stats.compactions += compacted ? 1 : 0;
+        stats.failures += (synced ? 0 : 1) + (compact && !compacted ? 1 : 0);
+        return;
+    }
+
+    RegionFile::encodeCells(job.cells.data(), job.cells.size(), encoded);
+    uint64_t hash = RegionFile::hashBytes(encoded.data(), encoded.size());
+    auto saved = savedHashes.find(job.coord);
+    if (saved != savedHashes.end() && saved->second == hash) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.chunksUnchanged++;
+        return;
+    }
+
+    bool appended = file.append(job.coord, job.tick, encoded);
+    if (appended) {
+        savedHashes[job.coord] = hash;
+    }
+    writerBytes.store(heapBytes(savedHashes) + heapBytes(encoded) + file.getMemoryUsage(), std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (appended) {
+        stats.chunksWritten++;
+        stats.bytesWritten += encoded.size();
+    } else {
+        stats.failures++;
+    }
+}
+
+} // namespace astral
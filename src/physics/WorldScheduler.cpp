@@ -0,0 +1,83 @@
+#include "astral/physics/WorldScheduler.h"
+#include <chrono>
+
+namespace astral {
+
+WorldScheduler::WorldScheduler(ThreadPool& pool)
+    : pool(pool)
+    , roundOffset(0)
+    , lastRunSeconds(0.0)
+    , lastRunTicks(0)
+    , runningWorlds(0)
+{
+}
+
+size_t WorldScheduler::addWorld(std::shared_ptr<CellularAutomaton> world)
+{
+    WorldSlot slot;
+    slot.world = std::move(world);
+    worlds.push_back(std::move(slot));
+    return worlds.size() - 1;
+}
+
+void WorldScheduler::scheduleTick(size_t index, float deltaTime)
+{
+    WorldSlot& slot = worlds[index];
+    pool.submit([this, index, deltaTime]() {
+        WorldSlot& slot = worlds[index];
+        auto tickStart = std::chrono::steady_clock::now();
+        slot.world->update(deltaTime);
+        slot.tickMilliseconds.push_back(std::chrono::duration<float, std::milli>(
+            std::chrono::steady_clock::now() - tickStart).count());
+        slot.ticks++;
+        slot.remainingTicks--;
+
+        if (slot.remainingTicks > 0) {
+            // Requeue behind every other world waiting in this group
+            scheduleTick(index, deltaTime);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        runningWorlds--;
+        if (runningWorlds == 0) {
+            finished.notify_all();
+        }
+    }, slot.coreGroup);
+}
+
+void WorldScheduler::run(float deltaTime, int ticksPerWorld)
+{
+    if (worlds.empty() || ticksPerWorld <= 0) {
+        return;
+    }
+
+    // Contiguous blocks of worlds per core group
+    size_t groupCount = pool.getCoreGroupCount();
+    for (size_t i = 0; i < worlds.size(); i++) {
+        worlds[i].coreGroup = static_cast<int>(i * groupCount / worlds.size());
+        worlds[i].remainingTicks = ticksPerWorld;
+        worlds[i].tickMilliseconds.clear();
+        worlds[i].tickMilliseconds.reserve(ticksPerWorld);
+    }
+
+    runningWorlds = worlds.size();
+    auto start = std::chrono::steady_clock::now();
+
+    // Start each world once; they requeue themselves until done
+    for (size_t i = 0; i < worlds.size(); i++) {
+        scheduleTick((i + roundOffset) % worlds.size(), deltaTime);
+    }
+    roundOffset = (roundOffset + 1) % worlds.size();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]() { return runningWorlds == 0; });
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    lastRunSeconds = std::chrono::duration<double>(end - start).count();
+    lastRunTicks = static_cast<uint64_t>(worlds.size()) * ticksPerWorld;
+}
+
+} // namespace astral
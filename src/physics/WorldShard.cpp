@@ -0,0 +1,445 @@
+#include "astral/physics/WorldShard.h"
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace astral {
+
+namespace {
+
+constexpr uint32_t SHARD_EXCHANGE_MAGIC = 0x41534852; // "ASHR"
+constexpr size_t SHARD_ALIGNMENT = 64;
+
+size_t alignUp(size_t size)
+{
+    return (size + SHARD_ALIGNMENT - 1) / SHARD_ALIGNMENT * SHARD_ALIGNMENT;
+}
+
+std::string segmentName(const std::string& name)
+{
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+
+} // namespace
+
+// ==================== ShardExchange Implementation ====================
+
+struct ShardExchange::Header {
+    uint32_t magic;
+    int32_t worldWidth;
+    int32_t worldHeight;
+    int32_t shardCount;
+#ifdef __linux__
+    pthread_barrier_t barrier;
+#endif
+};
+
+size_t ShardExchange::linkSize(int worldHeight)
+{
+    size_t cells = static_cast<size_t>(CHUNK_SIZE) * worldHeight;
+    return alignUp(sizeof(uint32_t)) + alignUp(cells * sizeof(Cell)) +
+           alignUp(cells * sizeof(ShardMigrant));
+}
+
+size_t ShardExchange::totalSize(int worldHeight, int shardCount)
+{
+    size_t links = static_cast<size_t>(shardCount - 1) * 2;
+    return alignUp(sizeof(Header)) + alignUp(shardCount * sizeof(ShardStats)) +
+           links * linkSize(worldHeight);
+}
+
+ShardExchange::Header* ShardExchange::header() const
+{
+    return static_cast<Header*>(mapping);
+}
+
+char* ShardExchange::linkBase(int from, bool toRight) const
+{
+    // Links are ordered by boundary, then direction (rightward first)
+    int boundary = toRight ? from : from - 1;
+    size_t index = static_cast<size_t>(boundary) * 2 + (toRight ? 0 : 1);
+    char* base = static_cast<char*>(mapping) + alignUp(sizeof(Header)) +
+                 alignUp(getShardCount() * sizeof(ShardStats));
+    return base + index * linkSize(getWorldHeight());
+}
+
+std::unique_ptr<ShardExchange> ShardExchange::create(const std::string& name, int worldWidth,
+                                                     int worldHeight, int shardCount)
+{
+    if (shardCount < 1 || worldWidth <= 0 || worldHeight <= 0 || worldWidth % CHUNK_SIZE != 0) {
+        throw std::invalid_argument("Sharded world width must be a positive multiple of CHUNK_SIZE");
+    }
+    if (worldWidth / CHUNK_SIZE < shardCount) {
+        throw std::invalid_argument("Sharded world needs at least one chunk column per shard");
+    }
+
+#ifdef __linux__
+    std::unique_ptr<ShardExchange> exchange(new ShardExchange());
+    exchange->name = segmentName(name);
+    exchange->mappingSize = totalSize(worldHeight, shardCount);
+
+    // Replace a segment left behind by a crashed run
+    shm_unlink(exchange->name.c_str());
+    int fd = shm_open(exchange->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create shared memory segment " + exchange->name);
+    }
+    exchange->owner = true;
+
+    if (ftruncate(fd, static_cast<off_t>(exchange->mappingSize)) != 0) {
+        close(fd);
+        throw std::runtime_error("Failed to size shared memory segment " + exchange->name);
+    }
+
+    void* mapping = mmap(nullptr, exchange->mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Failed to map shared memory segment " + exchange->name);
+    }
+    exchange->mapping = mapping;
+
+    // The segment starts zeroed, so migrant counts and stats are already empty
+    Header* header = new (mapping) Header();
+    header->worldWidth = worldWidth;
+    header->worldHeight = worldHeight;
+    header->shardCount = shardCount;
+    for (int i = 0; i < shardCount; i++) {
+        new (&exchange->getStats(i)) ShardStats();
+    }
+
+    pthread_barrierattr_t attributes;
+    pthread_barrierattr_init(&attributes);
+    pthread_barrierattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    pthread_barrier_init(&header->barrier, &attributes, static_cast<unsigned>(shardCount));
+    pthread_barrierattr_destroy(&attributes);
+
+    header->magic = SHARD_EXCHANGE_MAGIC;
+    return exchange;
+#else
+    (void)name;
+    throw std::runtime_error("Sharded worlds require Linux shared memory");
+#endif
+}
+
+std::unique_ptr<ShardExchange> ShardExchange::open(const std::string& name)
+{
+#ifdef __linux__
+    std::unique_ptr<ShardExchange> exchange(new ShardExchange());
+    exchange->name = segmentName(name);
+
+    int fd = shm_open(exchange->name.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open shared memory segment " + exchange->name);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        close(fd);
+        throw std::runtime_error("Invalid shared memory segment " + exchange->name);
+    }
+    exchange->mappingSize = static_cast<size_t>(info.st_size);
+
+    void* mapping = mmap(nullptr, exchange->mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Failed to map shared memory segment " + exchange->name);
+    }
+    exchange->mapping = mapping;
+
+    Header* header = exchange->header();
+    if (header->magic != SHARD_EXCHANGE_MAGIC ||
+        exchange->mappingSize < totalSize(header->worldHeight, header->shardCount)) {
+        throw std::runtime_error("Invalid shared memory segment " + exchange->name);
+    }
+    return exchange;
+#else
+    (void)name;
+    throw std::runtime_error("Sharded worlds require Linux shared memory");
+#endif
+}
+
+ShardExchange::~ShardExchange()
+{
+#ifdef __linux__
+    if (!mapping) {
+        return;
+    }
+    if (owner && header()->magic == SHARD_EXCHANGE_MAGIC) {
+        pthread_barrier_destroy(&header()->barrier);
+    }
+    munmap(mapping, mappingSize);
+    if (owner) {
+        shm_unlink(name.c_str());
+    }
+#endif
+}
+
+int ShardExchange::getWorldWidth() const { return header()->worldWidth; }
+int ShardExchange::getWorldHeight() const { return header()->worldHeight; }
+int ShardExchange::getShardCount() const { return header()->shardCount; }
+
+int ShardExchange::getShardBegin(int shard) const
+{
+    int columns = getWorldWidth() / CHUNK_SIZE;
+    return shard * columns / getShardCount() * CHUNK_SIZE;
+}
+
+int ShardExchange::getShardEnd(int shard) const
+{
+    return getShardBegin(shard + 1);
+}
+
+void ShardExchange::arriveAndWait()
+{
+#ifdef __linux__
+    pthread_barrier_wait(&header()->barrier);
+#endif
+}
+
+Cell* ShardExchange::getEdge(int from, bool toRight)
+{
+    return reinterpret_cast<Cell*>(linkBase(from, toRight) + alignUp(sizeof(uint32_t)));
+}
+
+uint32_t& ShardExchange::getMigrantCount(int from, bool toRight)
+{
+    return *reinterpret_cast<uint32_t*>(linkBase(from, toRight));
+}
+
+ShardMigrant* ShardExchange::getMigrants(int from, bool toRight)
+{
+    size_t edgeBytes = alignUp(getLinkCapacity() * sizeof(Cell));
+    return reinterpret_cast<ShardMigrant*>(linkBase(from, toRight) +
+                                           alignUp(sizeof(uint32_t)) + edgeBytes);
+}
+
+size_t ShardExchange::getLinkCapacity() const
+{
+    return static_cast<size_t>(CHUNK_SIZE) * getWorldHeight();
+}
+
+ShardStats& ShardExchange::getStats(int shard)
+{
+    char* base = static_cast<char*>(mapping) + alignUp(sizeof(Header));
+    return reinterpret_cast<ShardStats*>(base)[shard];
+}
+
+// ==================== WorldShard Implementation ====================
+
+WorldShard::WorldShard(ShardExchange& exchange, int shardIndex,
+                       std::shared_ptr<const MaterialRegistry> registry)
+    : exchange(exchange)
+    , shardIndex(shardIndex)
+    , ownedBegin(exchange.getShardBegin(shardIndex))
+    , ownedEnd(exchange.getShardEnd(shardIndex))
+    , localOrigin(ownedBegin - (shardIndex > 0 ? CHUNK_SIZE : 0))
+    , hasLeft(shardIndex > 0)
+    , hasRight(shardIndex < exchange.getShardCount() - 1)
+    , world(ownedEnd + (hasRight ? CHUNK_SIZE : 0) - localOrigin, exchange.getWorldHeight(),
+            std::move(registry))
+{
+    // Only the owned strip is simulated; halo columns are neighbours only
+    world.setUpdateRegion(ownedBegin - localOrigin, 0, ownedEnd - ownedBegin,
+                          exchange.getWorldHeight());
+}
+
+int WorldShard::haloBegin(bool right) const
+{
+    return right ? ownedEnd : ownedBegin - CHUNK_SIZE;
+}
+
+void WorldShard::tick(float deltaTime)
+{
+    // Phase 1: take ownership of cells that crossed into this strip last tick,
+    // then publish the border columns
+    exchange.arriveAndWait();
+    if (hasLeft) applyMigrants(shardIndex - 1, true);
+    if (hasRight) applyMigrants(shardIndex + 1, false);
+    if (hasLeft) publishEdge(false);
+    if (hasRight) publishEdge(true);
+
+    // Phase 2: every border is published; refresh the halos and simulate
+    exchange.arriveAndWait();
+    if (hasLeft) loadHalo(false);
+    if (hasRight) loadHalo(true);
+
+    world.update(deltaTime);
+
+    if (hasLeft) sendMigrants(false);
+    if (hasRight) sendMigrants(true);
+
+    getStats().ticks++;
+}
+
+void WorldShard::run(float deltaTime, int ticks)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < ticks; i++) {
+        tick(deltaTime);
+    }
+
+    // Accept the migrants sent during the final tick
+    exchange.arriveAndWait();
+    if (hasLeft) applyMigrants(shardIndex - 1, true);
+    if (hasRight) applyMigrants(shardIndex + 1, false);
+
+    auto end = std::chrono::steady_clock::now();
+    getStats().elapsedSeconds += std::chrono::duration<double>(end - start).count();
+}
+
+void WorldShard::applyMigrants(int from, bool toRight)
+{
+    uint32_t& count = exchange.getMigrantCount(from, toRight);
+    const ShardMigrant* migrants = exchange.getMigrants(from, toRight);
+    MaterialID air = world.getMaterialRegistry().getDefaultMaterialID();
+    ShardStats& stats = getStats();
+
+    for (uint32_t i = 0; i < count; i++) {
+        const ShardMigrant& migrant = migrants[i];
+        if (!ownsColumn(migrant.x)) {
+            stats.migrantsDropped++;
+            continue;
+        }
+
+        int localX = migrant.x - localOrigin;
+        Cell& target = world.getCell(localX, migrant.y);
+        if (target.material == migrant.expected) {
+            target = migrant.cell;
+            world.noteCellChanged(localX, migrant.y, migrant.expected);
+            stats.migrantsAccepted++;
+            continue;
+        }
+
+        // This shard changed the target during the same tick; settle the
+        // migrant in the nearest free owned cell instead
+        if (placeNearTarget(migrant, air)) {
+            stats.migrantsDisplaced++;
+        } else {
+            stats.migrantsDropped++;
+        }
+    }
+
+    count = 0;
+}
+
+bool WorldShard::placeNearTarget(const ShardMigrant& migrant, MaterialID air)
+{
+    int height = exchange.getWorldHeight();
+
+    // Grow square rings around the target, scanning each ring top to bottom
+    // so cells settle on top of whatever took their place
+    for (int radius = 1; radius <= CHUNK_SIZE; radius++) {
+        for (int dy = -radius; dy <= radius; dy++) {
+            int y = migrant.y + dy;
+            if (y < 0 || y >= height) continue;
+
+            int step = (dy == -radius || dy == radius) ? 1 : 2 * radius;
+            for (int dx = -radius; dx <= radius; dx += step) {
+                int x = migrant.x + dx;
+                if (!ownsColumn(x)) continue;
+
+                Cell& candidate = world.getCell(x - localOrigin, y);
+                if (candidate.material == air) {
+                    candidate = migrant.cell;
+                    world.noteCellChanged(x - localOrigin, y, air);
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+void WorldShard::publishEdge(bool toRight)
+{
+    Cell* edge = exchange.getEdge(shardIndex, toRight);
+    int begin = (toRight ? ownedEnd - CHUNK_SIZE : ownedBegin) - localOrigin;
+    int height = exchange.getWorldHeight();
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            edge[y * CHUNK_SIZE + x] = world.getCell(begin + x, y);
+        }
+    }
+}
+
+void WorldShard::loadHalo(bool right)
+{
+    int neighbour = right ? shardIndex + 1 : shardIndex - 1;
+    const Cell* edge = exchange.getEdge(neighbour, !right);
+    int begin = haloBegin(right) - localOrigin;
+    int height = exchange.getWorldHeight();
+
+    std::vector<MaterialID>& before = haloBefore[right ? 1 : 0];
+    before.resize(static_cast<size_t>(CHUNK_SIZE) * height);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            const Cell& cell = edge[y * CHUNK_SIZE + x];
+            Cell& target = world.getCell(begin + x, y);
+            MaterialID material = target.material;
+            target = cell;
+            world.noteCellChanged(begin + x, y, material);
+            before[y * CHUNK_SIZE + x] = cell.material;
+        }
+    }
+}
+
+void WorldShard::sendMigrants(bool right)
+{
+    uint32_t& count = exchange.getMigrantCount(shardIndex, right);
+    ShardMigrant* migrants = exchange.getMigrants(shardIndex, right);
+    const std::vector<MaterialID>& before = haloBefore[right ? 1 : 0];
+    int begin = haloBegin(right);
+    int height = exchange.getWorldHeight();
+
+    // Any halo cell this tick changed now belongs to the neighbour
+    uint32_t sent = 0;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            const Cell& cell = world.getCell(begin + x - localOrigin, y);
+            MaterialID expected = before[y * CHUNK_SIZE + x];
+            if (cell.material != expected) {
+                migrants[sent++] = ShardMigrant{begin + x, y, expected, cell};
+            }
+        }
+    }
+
+    count = sent;
+    getStats().migrantsSent += sent;
+}
+
+void WorldShard::fillRectangle(int x, int y, int width, int height, MaterialID material)
+{
+    int begin = std::max(x, ownedBegin);
+    int end = std::min(x + width, ownedEnd);
+    if (begin < end) {
+        world.fillRectangle(begin - localOrigin, y, end - begin, height, material);
+    }
+}
+
+size_t WorldShard::countMaterial(MaterialID material) const
+{
+    size_t count = 0;
+    for (int y = 0; y < exchange.getWorldHeight(); y++) {
+        for (int x = ownedBegin; x < ownedEnd; x++) {
+            if (world.getCell(x - localOrigin, y).material == material) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+} // namespace astral
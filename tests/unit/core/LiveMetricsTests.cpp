@@ -0,0 +1,195 @@
+#include "astral/core/LiveMetrics.h"
+#include "astral/core/MetricsEndpoint.h"
+#include "astral/core/Profiler.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+std::string testSegmentName(const char* suffix) {
+    return "/astral_metrics_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+std::string httpGet(uint16_t port, const std::string& path) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return "";
+    }
+
+    std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    send(fd, request.data(), request.size(), 0);
+
+    std::string response;
+    char buffer[4096];
+    ssize_t received;
+    while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<size_t>(received));
+    }
+    close(fd);
+    return response;
+}
+
+} // namespace
+
+TEST(LiveMetricsTest, ReaderSeesPublishedSnapshot) {
+    std::string name = testSegmentName("roundtrip");
+    MetricsPublisher publisher;
+    ASSERT_TRUE(publisher.open(name));
+
+    LiveMetrics metrics;
+    metrics.frame = 42;
+    metrics.frameTimeP99Ms = 17.5;
+    metrics.activeChunks = 12;
+    metrics.passCount = 1;
+    std::strcpy(metrics.passes[0].name, "Physics");
+    metrics.passes[0].lastMs = 3.25;
+    publisher.publish(metrics);
+
+    MetricsReader reader;
+    ASSERT_TRUE(reader.open(name));
+    EXPECT_EQ(reader.getPublisherPid(), getpid());
+
+    LiveMetrics read;
+    ASSERT_TRUE(reader.read(read));
+    EXPECT_EQ(read.frame, 42u);
+    EXPECT_DOUBLE_EQ(read.frameTimeP99Ms, 17.5);
+    EXPECT_EQ(read.activeChunks, 12);
+    EXPECT_STREQ(read.passes[0].name, "Physics");
+    EXPECT_DOUBLE_EQ(read.passes[0].lastMs, 3.25);
+
+    // The segment disappears with the publisher
+    publisher.close();
+    MetricsReader late;
+    EXPECT_FALSE(late.open(name));
+}
+
+TEST(LiveMetricsTest, ReadsAreNeverTorn) {
+    std::string name = testSegmentName("torn");
+    MetricsPublisher publisher;
+    ASSERT_TRUE(publisher.open(name));
+    MetricsReader reader;
+    ASSERT_TRUE(reader.open(name));
+
+    // Every field of a published snapshot carries the same frame number
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        LiveMetrics metrics;
+        for (uint64_t frame = 1; frame <= 200000; frame++) {
+            metrics.frame = frame;
+            metrics.frameTimeMs = static_cast<double>(frame);
+            metrics.activeChunks = static_cast<int32_t>(frame);
+            metrics.memoryBytes = frame;
+            publisher.publish(metrics);
+        }
+        done = true;
+    });
+
+    int reads = 0;
+    int torn = 0;
+    while (!done) {
+        LiveMetrics metrics;
+        if (!reader.read(metrics)) continue;
+        reads++;
+        if (metrics.frameTimeMs != static_cast<double>(metrics.frame) ||
+            metrics.activeChunks != static_cast<int32_t>(metrics.frame) ||
+            metrics.memoryBytes != metrics.frame) {
+            torn++;
+        }
+    }
+    writer.join();
+
+    EXPECT_GT(reads, 0);
+    EXPECT_EQ(torn, 0);
+}
+
+TEST(LiveMetricsTest, FormatsPrometheusText) {
+    LiveMetrics metrics;
+    metrics.frame = 7;
+    metrics.frameTimeP50Ms = 16.0;
+    metrics.passCount = 1;
+    std::strcpy(metrics.passes[0].name, "Up\"date");
+    metrics.passes[0].lastMs = 2.0;
+
+    std::string text = formatPrometheus(metrics, 4096);
+    EXPECT_NE(text.find("# TYPE astral_frames_total counter\nastral_frames_total 7\n"), std::string::npos);
+    EXPECT_NE(text.find("astral_frame_time_ms{quantile=\"0.5\"} 16\n"), std::string::npos);
+    EXPECT_NE(text.find("astral_process_resident_bytes 4096\n"), std::string::npos);
+    EXPECT_NE(text.find("astral_pass_time_ms{pass=\"Up_date\"} 2\n"), std::string::npos);
+
+    // Resident size is optional
+    EXPECT_EQ(formatPrometheus(metrics).find("astral_process_resident_bytes"), std::string::npos);
+}
+
+TEST(LiveMetricsTest, EndpointServesLatestSnapshot) {
+    MetricsPublisher publisher;
+    ASSERT_TRUE(publisher.open(""));
+
+    MetricsEndpoint endpoint(publisher);
+    ASSERT_TRUE(endpoint.start(0));
+    ASSERT_NE(endpoint.getPort(), 0);
+
+    // Nothing published yet
+    EXPECT_NE(httpGet(endpoint.getPort(), "/metrics").find("503"), std::string::npos);
+
+    LiveMetrics metrics;
+    metrics.frame = 99;
+    publisher.publish(metrics);
+
+    std::string response = httpGet(endpoint.getPort(), "/metrics");
+    EXPECT_NE(response.find("200 OK"), std::string::npos);
+    EXPECT_NE(response.find("text/plain; version=0.0.4"), std::string::npos);
+    EXPECT_NE(response.find("astral_frames_total 99"), std::string::npos);
+    EXPECT_EQ(endpoint.getRequestCount(), 2u);
+
+    endpoint.stop();
+}
+
+TEST(LiveMetricsTest, ProfilerPublishesEachFrame) {
+    Profiler& profiler = Profiler::getInstance();
+    profiler.initialize(true);
+    ASSERT_TRUE(profiler.enableLiveMetrics(""));
+
+    for (int frame = 0; frame < 3; frame++) {
+        profiler.beginFrame();
+        {
+            ScopedTimer timer("Simulate");
+        }
+        profiler.recordValue("ActiveChunks", 5);
+        profiler.endFrame();
+    }
+
+    LiveMetrics metrics;
+    ASSERT_NE(profiler.getLiveMetrics(), nullptr);
+    ASSERT_TRUE(profiler.getLiveMetrics()->snapshot(metrics));
+    EXPECT_GE(metrics.frame, 3u);
+    EXPECT_EQ(metrics.activeChunks, 5);
+
+    bool foundPass = false;
+    for (int i = 0; i < metrics.passCount; i++) {
+        foundPass |= std::string(metrics.passes[i].name) == "Simulate";
+    }
+    EXPECT_TRUE(foundPass);
+
+    profiler.disableLiveMetrics();
+    profiler.initialize(false);
+    EXPECT_EQ(profiler.getLiveMetrics(), nullptr);
+}
+
+} // namespace test
+} // namespace astral
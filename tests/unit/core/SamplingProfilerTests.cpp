@@ -0,0 +1,102 @@
+#include "astral/core/SamplingProfiler.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+// Burn CPU in a function the profile should be able to name
+__attribute__((noinline)) double spinForSampling(std::chrono::milliseconds duration) {
+    auto end = std::chrono::steady_clock::now() + duration;
+    volatile double sink = 0.0;
+    while (std::chrono::steady_clock::now() < end) {
+        for (int i = 0; i < 1000; i++) {
+            sink = sink + std::sqrt(static_cast<double>(i));
+        }
+    }
+    return sink;
+}
+
+} // namespace
+
+TEST(SamplingProfilerTest, AttributesSamplesToContextAndFunction) {
+    SamplingProfiler& profiler = SamplingProfiler::getInstance();
+    ASSERT_TRUE(profiler.start(1000));
+    EXPECT_TRUE(profiler.isRunning());
+    {
+        SampleContextScope scope("test_phase");
+        currentSampleContext().material = "LIQUID";
+        currentSampleContext().chunkX = 3;
+        currentSampleContext().chunkY = 4;
+        currentSampleContext().hasChunk = true;
+        spinForSampling(std::chrono::milliseconds(300));
+    }
+    profiler.stop();
+    EXPECT_FALSE(profiler.isRunning());
+
+    // The scope restores the previous context
+    EXPECT_EQ(currentSampleContext().phase, nullptr);
+
+    SampleProfile profile = profiler.buildProfile();
+    ASSERT_GT(profile.totalSamples, 50u);
+    EXPECT_GT(profile.phaseSamples["test_phase"], profile.totalSamples / 2);
+    EXPECT_GT(profile.materialSamples["LIQUID"], profile.totalSamples / 2);
+    EXPECT_GT((profile.chunkSamples[{3, 4}]), profile.totalSamples / 2);
+
+    bool namedSpin = false;
+    for (const auto& function : profile.totalSamplesByFunction) {
+        if (function.first.find("spinForSampling") != std::string::npos &&
+            function.second > profile.totalSamples / 2) {
+            namedSpin = true;
+        }
+    }
+    EXPECT_TRUE(namedSpin);
+}
+
+TEST(SamplingProfilerTest, WritesFoldedStacksAndFlatProfile) {
+    SamplingProfiler& profiler = SamplingProfiler::getInstance();
+    ASSERT_TRUE(profiler.start(1000));
+    {
+        SampleContextScope scope("folded");
+        spinForSampling(std::chrono::milliseconds(100));
+    }
+    profiler.stop();
+    SampleProfile profile = profiler.buildProfile();
+    ASSERT_GT(profile.totalSamples, 0u);
+
+    auto directory = std::filesystem::temp_directory_path();
+    std::string foldedPath = (directory / "astral_profile_test.folded").string();
+    std::string flatPath = (directory / "astral_profile_test.txt").string();
+    ASSERT_TRUE(SamplingProfiler::writeFoldedStacks(profile, foldedPath));
+    ASSERT_TRUE(SamplingProfiler::writeFlatProfile(profile, flatPath));
+
+    // Every line is "frame;frame;... count" and the counts add up
+    std::ifstream folded(foldedPath);
+    std::string line;
+    uint64_t total = 0;
+    bool taggedRoot = false;
+    while (std::getline(folded, line)) {
+        size_t space = line.rfind(' ');
+        ASSERT_NE(space, std::string::npos);
+        total += std::stoull(line.substr(space + 1));
+        taggedRoot |= line.rfind("[phase folded];", 0) == 0;
+    }
+    EXPECT_EQ(total, profile.totalSamples);
+    EXPECT_TRUE(taggedRoot);
+
+    std::ifstream flat(flatPath);
+    std::string header;
+    std::getline(flat, header);
+    EXPECT_EQ(header.rfind("Samples: ", 0), 0u);
+
+    std::filesystem::remove(foldedPath);
+    std::filesystem::remove(flatPath);
+}
+
+} // namespace test
+} // namespace astral
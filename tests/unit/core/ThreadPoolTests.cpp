@@ -0,0 +1,72 @@
+#include "astral/core/ThreadPool.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace astral {
+namespace test {
+
+TEST(ThreadPoolTest, RunsAllTasks) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.getThreadCount(), 4u);
+    EXPECT_GE(pool.getCoreGroupCount(), 1u);
+    
+    std::atomic<int> counter(0);
+    for (int i = 0; i < 1000; i++) {
+        pool.submit([&counter]() { counter++; }, i % 3 - 1);
+    }
+    pool.waitIdle();
+    
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(ThreadPoolTest, WaitIdleCoversResubmittedTasks) {
+    ThreadPool pool(2);
+    std::atomic<int> counter(0);
+    
+    // Each task queues the next one from inside the pool
+    std::function<void(int)> chain = [&](int remaining) {
+        counter++;
+        if (remaining > 0) {
+            pool.submit([&chain, remaining]() { chain(remaining - 1); }, 0);
+        }
+    };
+    pool.submit([&chain]() { chain(49); });
+    pool.waitIdle();
+    
+    EXPECT_EQ(counter.load(), 50);
+}
+
+TEST(ThreadPoolTest, ParallelForWaitsOnlyForItsIterations) {
+    ThreadPool pool(2);
+    
+    // Unrelated work keeps one worker busy for the whole loop
+    std::atomic<bool> release(false);
+    pool.submit([&release]() {
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    
+    std::vector<int> hits(100, 0);
+    pool.parallelFor(hits.size(), [&hits](size_t i) { hits[i]++; });
+    for (int hit : hits) {
+        EXPECT_EQ(hit, 1);
+    }
+    
+    // Nested inside a pool task, with every worker busy, the caller runs it
+    std::atomic<int> nested(0);
+    pool.submit([&pool, &nested]() {
+        pool.parallelFor(10, [&nested](size_t) { nested++; });
+    });
+    while (nested < 10) {
+        std::this_thread::yield();
+    }
+    release = true;
+    pool.waitIdle();
+    EXPECT_EQ(nested.load(), 10);
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,121 @@
+#include "astral/core/TickWatchdog.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+TickWatchdogConfig testConfig(const char* name) {
+    TickWatchdogConfig config;
+    config.thresholdMs = 50.0;
+    config.historyTicks = 4;
+    config.minDumpIntervalSeconds = 0.0;
+    config.directory = (std::filesystem::temp_directory_path() / ("astral_" + std::string(name))).string();
+    std::filesystem::remove_all(config.directory);
+    return config;
+}
+
+void recordTick(TickWatchdog& watchdog, double durationMs) {
+    watchdog.beginTick();
+    watchdog.recordSection("Physics", durationMs * 0.75);
+    watchdog.endTick(durationMs);
+}
+
+} // namespace
+
+TEST(TickWatchdogTest, FastTicksAreNotDumped) {
+    TickWatchdogConfig config = testConfig("watchdog_fast");
+    TickWatchdog watchdog(config);
+    for (int i = 0; i < 20; i++) {
+        recordTick(watchdog, 10.0);
+    }
+    watchdog.flush();
+
+    EXPECT_EQ(watchdog.getTickCount(), 20u);
+    EXPECT_EQ(watchdog.getOutlierCount(), 0u);
+    EXPECT_EQ(watchdog.getDumpCount(), 0u);
+    EXPECT_FALSE(std::filesystem::exists(config.directory));
+}
+
+TEST(TickWatchdogTest, OutlierDumpsRecentHistory) {
+    TickWatchdogConfig config = testConfig("watchdog_outlier");
+    config.hotChunkCount = 2;
+    TickWatchdog watchdog(config);
+
+    std::vector<TraceChunkCost> snapshotRequest;
+    watchdog.setSnapshotProvider([&](const std::vector<TraceChunkCost>& hottest) {
+        snapshotRequest = hottest;
+        return nlohmann::json::array({"snapshot"});
+    });
+
+    for (int i = 0; i < 6; i++) {
+        recordTick(watchdog, 10.0);
+    }
+    watchdog.beginTick();
+    watchdog.recordEvent({{"type", "paint_cell"}});
+    for (int i = 0; i < 5; i++) {
+        watchdog.recordChunkCost(i, 1, static_cast<double>(i));
+    }
+    EXPECT_TRUE(watchdog.endTick(120.0));
+    watchdog.flush();
+
+    // Hottest chunks first
+    ASSERT_EQ(snapshotRequest.size(), 2u);
+    EXPECT_EQ(snapshotRequest[0].chunkX, 4);
+    EXPECT_EQ(snapshotRequest[1].chunkX, 3);
+
+    ASSERT_EQ(watchdog.getDumpCount(), 1u);
+    std::ifstream file(watchdog.getLastDumpPath());
+    nlohmann::json dump = nlohmann::json::parse(file);
+
+    // The history holds the outlier and the ticks right before it, oldest first
+    EXPECT_EQ(dump["outlierTick"], 6);
+    ASSERT_EQ(dump["ticks"].size(), 4u);
+    EXPECT_EQ(dump["ticks"][0]["tick"], 3);
+    EXPECT_EQ(dump["ticks"][3]["tick"], 6);
+    EXPECT_DOUBLE_EQ(dump["ticks"][3]["durationMs"].get<double>(), 120.0);
+    EXPECT_EQ(dump["ticks"][3]["events"][0]["type"], "paint_cell");
+    EXPECT_EQ(dump["ticks"][3]["chunkCosts"][0][0], 4);
+    EXPECT_EQ(dump["hotChunks"][0], "snapshot");
+
+    std::filesystem::remove_all(config.directory);
+}
+
+TEST(TickWatchdogTest, DumpsAreThrottled) {
+    TickWatchdogConfig config = testConfig("watchdog_throttle");
+    config.minDumpIntervalSeconds = 3600.0;
+    TickWatchdog watchdog(config);
+
+    for (int i = 0; i < 5; i++) {
+        recordTick(watchdog, 200.0);
+    }
+    watchdog.flush();
+
+    EXPECT_EQ(watchdog.getOutlierCount(), 5u);
+    EXPECT_EQ(watchdog.getDumpCount(), 1u);
+    EXPECT_EQ(watchdog.getSuppressedCount(), 4u);
+
+    std::filesystem::remove_all(config.directory);
+}
+
+TEST(TickWatchdogTest, DumpCountIsCapped) {
+    TickWatchdogConfig config = testConfig("watchdog_cap");
+    config.maxDumps = 2;
+    TickWatchdog watchdog(config);
+
+    for (int i = 0; i < 5; i++) {
+        recordTick(watchdog, 200.0);
+        watchdog.flush();
+    }
+
+    EXPECT_EQ(watchdog.getDumpCount(), 2u);
+    EXPECT_EQ(watchdog.getSuppressedCount(), 3u);
+
+    std::filesystem::remove_all(config.directory);
+}
+
+} // namespace test
+} // namespace astral
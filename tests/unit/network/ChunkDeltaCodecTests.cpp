@@ -0,0 +1,80 @@
+#include "astral/network/ChunkDeltaCodec.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+namespace astral {
+namespace test {
+
+TEST(ChunkDeltaCodecTest, RoundTripAgainstBase) {
+    std::vector<MaterialID> base(ChunkDeltaCodec::CELL_COUNT, 0);
+    std::vector<MaterialID> current(ChunkDeltaCodec::CELL_COUNT, 0);
+    for (int i = 0; i < ChunkDeltaCodec::CELL_COUNT; i++) {
+        base[i] = static_cast<MaterialID>(i / 100);
+        current[i] = base[i];
+    }
+    current[10] = 7;
+    current[500] = 3;
+    
+    std::vector<uint8_t> encoded;
+    ChunkDeltaCodec::encode(current.data(), base.data(), encoded);
+    
+    // A couple of changed cells compress to a few runs
+    EXPECT_LT(encoded.size(), 32u);
+    
+    std::vector<MaterialID> decoded(ChunkDeltaCodec::CELL_COUNT);
+    ByteReader reader(encoded.data(), encoded.size());
+    ASSERT_TRUE(ChunkDeltaCodec::decode(reader, base.data(), decoded.data()));
+    EXPECT_EQ(decoded, current);
+    EXPECT_EQ(reader.remaining(), 0u);
+}
+
+TEST(ChunkDeltaCodecTest, RoundTripWithoutPalette) {
+    // More distinct values than a byte-indexed palette can hold
+    std::vector<MaterialID> base(ChunkDeltaCodec::CELL_COUNT, 0);
+    std::vector<MaterialID> current(ChunkDeltaCodec::CELL_COUNT);
+    for (int i = 0; i < ChunkDeltaCodec::CELL_COUNT; i++) {
+        current[i] = static_cast<MaterialID>(i * 37);
+    }
+    
+    std::vector<uint8_t> encoded;
+    ChunkDeltaCodec::encode(current.data(), base.data(), encoded);
+    
+    std::vector<MaterialID> decoded(ChunkDeltaCodec::CELL_COUNT);
+    ByteReader reader(encoded.data(), encoded.size());
+    ASSERT_TRUE(ChunkDeltaCodec::decode(reader, base.data(), decoded.data()));
+    EXPECT_EQ(decoded, current);
+}
+
+TEST(ChunkDeltaCodecTest, RejectsTruncatedInput) {
+    std::vector<MaterialID> base(ChunkDeltaCodec::CELL_COUNT, 0);
+    std::vector<MaterialID> current(ChunkDeltaCodec::CELL_COUNT, 0);
+    std::mt19937 random(42);
+    for (auto& material : current) {
+        material = static_cast<MaterialID>(random() % 5);
+    }
+    
+    std::vector<uint8_t> encoded;
+    ChunkDeltaCodec::encode(current.data(), base.data(), encoded);
+    
+    std::vector<MaterialID> decoded(ChunkDeltaCodec::CELL_COUNT);
+    ByteReader reader(encoded.data(), encoded.size() / 2);
+    EXPECT_FALSE(ChunkDeltaCodec::decode(reader, base.data(), decoded.data()));
+}
+
+TEST(ChunkDeltaCodecTest, ViewportChunksClipToWorld) {
+    auto coords = ChunkDeltaCodec::viewportChunks({-10, 20, 80, 20}, 64, 64);
+    ASSERT_EQ(coords.size(), 4u);
+    EXPECT_EQ(coords[0], (ChunkCoord{0, 0}));
+    EXPECT_EQ(coords[3], (ChunkCoord{1, 1}));
+    
+    EXPECT_TRUE(ChunkDeltaCodec::viewportChunks({100, 100, 10, 10}, 64, 64).empty());
+    
+    // Edges past INT32_MAX clip to the world instead of wrapping around
+    const int big = std::numeric_limits<int32_t>::max();
+    EXPECT_EQ(ChunkDeltaCodec::viewportChunks({10, 10, big, big}, 64, 64).size(), 4u);
+    EXPECT_TRUE(ChunkDeltaCodec::viewportChunks({-big, -big, -big, 10}, 64, 64).empty());
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,86 @@
+#include "astral/network/SimulationClient.h"
+#include "astral/network/SimulationServer.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+// Step the world and pump both ends of the loopback connection
+void step(CellularAutomaton& world, SimulationServer& server, SimulationClient& client, int ticks) {
+    for (int i = 0; i < ticks; i++) {
+        world.update(1.0f / 60.0f);
+        server.tick(1.0f / 60.0f);
+        client.poll(20);
+    }
+}
+
+} // namespace
+
+TEST(SimulationServerTest, ClientReconstructsViewport) {
+    CellularAutomaton world(128, 128);
+    world.fillRectangle(0, 120, 128, 8, world.getMaterialIDByName("Stone"));
+    world.fillRectangle(40, 10, 20, 30, world.getMaterialIDByName("Sand"));
+    
+    SimulationServer server(world);
+    ASSERT_TRUE(server.listenTcp(0));
+    
+    SimulationClient client;
+    ASSERT_TRUE(client.connectTcp("127.0.0.1", server.getPort()));
+    client.setViewport(0, 0, 96, 128);
+    
+    step(world, server, client, 30);
+    
+    EXPECT_EQ(client.getWorldWidth(), 128);
+    EXPECT_GT(client.getStats().chunksApplied, 0u);
+    EXPECT_GT(client.getStats().verifiedTicks, 0u);
+    EXPECT_EQ(client.getStats().hashMismatches, 0u);
+    EXPECT_EQ(client.getStats().protocolErrors, 0u);
+    
+    // Let the last acks arrive, then compare against the world directly
+    server.tick(1.0f / 60.0f);
+    client.poll(20);
+    ASSERT_TRUE(client.isVerified());
+    for (int y = 0; y < 128; y++) {
+        for (int x = 0; x < 96; x++) {
+            ASSERT_EQ(client.getMaterial(x, y), world.getCell(x, y).material) << x << "," << y;
+        }
+    }
+    
+    // Compression should beat raw material ids by a wide margin
+    EXPECT_LT(server.getStats().bytesSent * 4, server.getStats().rawBytes);
+}
+
+TEST(SimulationServerTest, RejectsWorldsItCannotStream) {
+    CellularAutomaton unbounded(CellularAutomaton::UNBOUNDED, 128);
+    EXPECT_THROW(SimulationServer server(unbounded), std::invalid_argument);
+    CellularAutomaton smallChunks(128, 128, 16);
+    EXPECT_THROW(SimulationServer server(smallChunks), std::invalid_argument);
+}
+
+TEST(SimulationServerTest, BandwidthCapDelaysSync) {
+    CellularAutomaton world(256, 256);
+    for (int x = 0; x < 256; x += 8) {
+        world.fillRectangle(x, 0, 4, 200, world.getMaterialIDByName("Sand"));
+    }
+    
+    SimulationServer server(world);
+    ASSERT_TRUE(server.listenTcp(0));
+    server.setBandwidthLimit(2000);
+    
+    SimulationClient client;
+    ASSERT_TRUE(client.connectTcp("127.0.0.1", server.getPort()));
+    client.setViewport(0, 0, 256, 256);
+    
+    world.pause();
+    step(world, server, client, 5);
+    
+    // 64 chunks cannot all fit in five ticks of a 2 KB/s budget
+    EXPECT_FALSE(client.isVerified());
+    EXPECT_LT(server.getStats().bytesSent, 2000u + 2 * 1024u);
+}
+
+} // namespace test
+} // namespace astral
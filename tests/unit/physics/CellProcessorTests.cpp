@@ -0,0 +1,134 @@
+#include "astral/physics/CellProcessor.h"
+#include "astral/physics/CellularAutomaton.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+// Outcome of a run of lava/water, fire/wood and lava/sand contacts
+std::vector<MaterialID> runReactions(const CellProcessor& processor, uint32_t seed) {
+    const MaterialTable& materials = processor.getMaterials();
+    const MaterialID pairs[][2] = {
+        {materials.getLavaID(), materials.getWaterID()},
+        {materials.getFireID(), materials.getWoodID()},
+        {materials.getLavaID(), materials.getSandID()},
+    };
+
+    CellRandom random(seed);
+    std::vector<MaterialID> outcome;
+    for (int i = 0; i < 300; i++) {
+        Cell first;
+        Cell second;
+        processor.initializeCellFromMaterial(first, pairs[i % 3][0]);
+        processor.initializeCellFromMaterial(second, pairs[i % 3][1]);
+        processor.processPotentialReaction(first, second, 1.0f / 60.0f, random);
+        outcome.push_back(first.material);
+        outcome.push_back(second.material);
+    }
+    return outcome;
+}
+
+} // namespace
+
+TEST(CellProcessorTest, MaterialTableMatchesTheRegistry) {
+    auto shared = MaterialRegistry::createShared();
+    const MaterialRegistry& registry = *shared;
+    MaterialTable table(registry);
+    EXPECT_EQ(table.size(), static_cast<size_t>(registry.getIDLimit()));
+    EXPECT_EQ(table.getWaterID(), registry.getWaterID());
+    EXPECT_EQ(table.getOilFireID(), registry.getOilFireID());
+    EXPECT_EQ(table.getMaterial(registry.getLavaID()).name, "Lava");
+
+    // Unknown ids read as air, like the registry
+    EXPECT_EQ(table.getMaterial(60000).type, registry.getMaterial(60000).type);
+}
+
+TEST(CellProcessorTest, RulesOnlyDependOnTheCallersRandomSource) {
+    MaterialTable table(*MaterialRegistry::createShared());
+    const CellProcessor processor(&table);
+
+    std::vector<MaterialID> expected = runReactions(processor, 7);
+    EXPECT_EQ(runReactions(processor, 7), expected);
+    EXPECT_NE(runReactions(processor, 8), expected);
+
+    // One processor shared by several threads, each with its own generator
+    std::vector<std::vector<MaterialID>> outcomes(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < outcomes.size(); i++) {
+        threads.emplace_back([&processor, &outcomes, i]() { outcomes[i] = runReactions(processor, 7); });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const auto& outcome : outcomes) {
+        EXPECT_EQ(outcome, expected);
+    }
+}
+
+TEST(CellProcessorTest, RegisteredMaterialsReachTheRules) {
+    CellularAutomaton world(64, 64);
+    MaterialProperties mist(MaterialType::GAS, "Mist", glm::vec4(0.8f, 0.8f, 0.9f, 0.5f));
+    mist.density = 0.5f;
+    mist.lifetime = 40.0f;
+    mist.movable = true;
+    MaterialID id = world.registerMaterial(mist);
+
+    world.setCell(10, 10, id);
+    EXPECT_EQ(world.getCell(10, 10).material, id);
+    EXPECT_EQ(world.getCell(10, 10).lifetime, 40);
+}
+
+TEST(CellProcessorTest, TemporaryMaterialsDecayByTheirTableRule) {
+    MaterialTable table(*MaterialRegistry::createShared());
+    const CellProcessor processor(&table);
+    CellRandom random(1);
+
+    EXPECT_TRUE(table.decays(table.getFireID()));
+    EXPECT_TRUE(table.decays(table.getSmokeID()));
+    EXPECT_FALSE(table.decays(table.getSandID()));
+    EXPECT_EQ(table.getDecayRule(table.getOilFireID()).product, table.getSmokeID());
+    EXPECT_EQ(table.getDecayRule(table.getSmokeID()).product, table.getDefaultMaterialID());
+
+    // Oil fire runs out into darker smoke
+    Cell fire;
+    processor.initializeCellFromMaterial(fire, table.getOilFireID());
+    fire.lifetime = 0;
+    fire.setFlag(Cell::FLAG_BURNING);
+    processor.applyDecay(fire, random);
+    EXPECT_EQ(fire.material, table.getSmokeID());
+    EXPECT_FALSE(fire.hasFlag(Cell::FLAG_BURNING));
+    EXPECT_EQ(fire.metadata, 1);
+    EXPECT_GE(fire.lifetime, 120);
+}
+
+TEST(CellProcessorTest, DecayPassRunsEachLifetimeDownOncePerTick) {
+    CellularAutomaton world(64, 64, 16);
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    for (int x = 10; x < 50; x += 4) {
+        world.setCell(x, 40, registry.getSmokeID());
+        world.getCell(x, 40).lifetime = 5;
+    }
+    auto countSmoke = [&]() {
+        int count = 0;
+        for (int y = 0; y < 64; y++) {
+            for (int x = 0; x < 64; x++) {
+                if (world.getCell(x, y).material == registry.getSmokeID()) count++;
+            }
+        }
+        return count;
+    };
+
+    for (int i = 0; i < 4; i++) {
+        world.update(1.0f / 60.0f);
+    }
+    EXPECT_EQ(countSmoke(), 10);
+    world.update(1.0f / 60.0f);
+    EXPECT_EQ(countSmoke(), 0);
+}
+
+} // namespace test
+} // namespace astral
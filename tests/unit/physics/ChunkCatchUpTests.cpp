@@ -0,0 +1,142 @@
+#include "astral/physics/ChunkCatchUp.h"
+#include "astral/physics/CellProcessor.h"
+#include "astral/physics/CellularAutomaton.h"
+#include <gtest/gtest.h>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+constexpr float TICK = 0.5f;
+
+// Chunk (2, 0) of a 64x64 world with 16-cell chunks: a stone floor on its
+// bottom row, a short sand column, a puff of smoke, hot stone and a row of
+// wood burning at one end
+void buildFrozenChunk(CellularAutomaton& world) {
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    world.fillRectangle(32, 15, 16, 1, registry.getStoneID());
+    world.fillRectangle(42, 2, 1, 3, registry.getSandID());
+    world.setCell(34, 5, registry.getSmokeID());
+    world.setCell(44, 10, registry.getStoneID());
+    world.getCell(44, 10).temperature = 500.0f;
+    world.fillRectangle(32, 8, 8, 1, registry.getWoodID());
+    world.getCell(32, 8).setFlag(Cell::FLAG_BURNING);
+}
+
+// Keep the top row of chunks out of the simulation for a while
+void freezeTopRow(CellularAutomaton& world, int ticks) {
+    world.update(TICK);
+    world.setUpdateRegion(0, 16, 64, 48);
+    for (int i = 0; i < ticks; i++) {
+        world.update(TICK);
+    }
+    world.setUpdateRegion(0, 0, 64, 64);
+    world.update(TICK);
+}
+
+int countInRect(const CellularAutomaton& world, int x, int y, int width, int height, MaterialID material) {
+    int count = 0;
+    for (int cy = y; cy < y + height; cy++) {
+        for (int cx = x; cx < x + width; cx++) {
+            if (world.getCell(cx, cy).material == material) count++;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(ChunkCatchUpTest, ChunksLeavingTheUpdateRegionAreTimed) {
+    CellularAutomaton world(64, 64, 16);
+    ChunkManager& manager = world.getChunkManager();
+    manager.updateActiveChunks({0, 0, 32, 16});
+
+    manager.setUpdateRegion({0, 0, 16, 16});
+    for (int i = 0; i < 4; i++) {
+        manager.updateChunks(TICK);
+    }
+    manager.setUpdateRegion({0, 0, 32, 16});
+    EXPECT_TRUE(manager.takeThawedChunks().empty());
+
+    manager.updateActiveChunks({0, 0, 32, 16});
+    std::vector<ThawedChunk> thawed = manager.takeThawedChunks();
+    ASSERT_EQ(thawed.size(), 1u);
+    EXPECT_EQ(thawed[0].coord, (ChunkCoord{1, 0}));
+    EXPECT_DOUBLE_EQ(thawed[0].frozenSeconds, 4 * TICK);
+    EXPECT_TRUE(manager.takeThawedChunks().empty());
+    EXPECT_DOUBLE_EQ(manager.getSimulationTime(), 4 * TICK);
+}
+
+TEST(ChunkCatchUpTest, ThawedChunkIsFastForwarded) {
+    CellularAutomaton caughtUp(64, 64, 16);
+    CellularAutomaton resumed(64, 64, 16);
+    caughtUp.enableCatchUp();
+    buildFrozenChunk(caughtUp);
+    buildFrozenChunk(resumed);
+    freezeTopRow(caughtUp, 200);
+    freezeTopRow(resumed, 200);
+
+    const MaterialRegistry& registry = caughtUp.getMaterialRegistry();
+    ASSERT_NE(caughtUp.getCatchUp(), nullptr);
+    EXPECT_EQ(caughtUp.getCatchUp()->getStats().chunks, 4u);
+    EXPECT_DOUBLE_EQ(caughtUp.getCatchUp()->getStats().seconds, 4 * 200 * TICK);
+
+    // The sand lies on the floor; left alone it would only just start falling
+    EXPECT_EQ(countInRect(caughtUp, 32, 11, 16, 4, registry.getSandID()), 3);
+    EXPECT_EQ(countInRect(resumed, 32, 11, 16, 4, registry.getSandID()), 0);
+
+    // The smoke ran out and the stone cooled most of the way to ambient
+    EXPECT_EQ(caughtUp.getCell(34, 5).material, registry.getDefaultMaterialID());
+    EXPECT_GT(caughtUp.getCatchUp()->getStats().expired, 0u);
+    EXPECT_LT(caughtUp.getCell(44, 10).temperature, 250.0f);
+    EXPECT_GT(resumed.getCell(44, 10).temperature, 450.0f);
+
+    // The fire crept along the wood, which burns far longer than 100 seconds
+    for (int x = 32; x < 40; x++) {
+        EXPECT_EQ(caughtUp.getCell(x, 8).material, registry.getWoodID()) << "x " << x;
+        EXPECT_TRUE(caughtUp.getCell(x, 8).hasFlag(Cell::FLAG_BURNING)) << "x " << x;
+    }
+    EXPECT_LT(caughtUp.getCell(32, 8).health, caughtUp.getCell(39, 8).health);
+}
+
+TEST(ChunkCatchUpTest, BurntOutFireFollowsTheDecayRule) {
+    CellularAutomaton world(64, 64, 16);
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    world.setCell(34, 5, registry.getOilFireID());
+    world.getCell(34, 5).lifetime = 3;
+
+    MaterialTable table(registry);
+    CellProcessor processor(&table);
+    ChunkCatchUp catchUp(&processor, ChunkCatchUpConfig());
+    Chunk* chunk = world.getChunkManager().getChunk({2, 0});
+    ASSERT_NE(chunk, nullptr);
+    ASSERT_TRUE(catchUp.catchUp(*chunk, 5 * TICK, TICK));
+
+    // Three ticks of fire, then the oil fire's smoke for the last two
+    const DecayRule& rule = table.getDecayRule(registry.getOilFireID());
+    const Cell& cell = world.getCell(34, 5);
+    EXPECT_EQ(cell.material, rule.product);
+    EXPECT_EQ(cell.metadata, rule.metadata);
+    EXPECT_EQ(cell.lifetime, rule.lifetime + rule.lifetimeJitter / 2 - 2);
+    EXPECT_FALSE(cell.hasFlag(Cell::FLAG_BURNING));
+    EXPECT_EQ(catchUp.getStats().burnedOut, 1u);
+}
+
+TEST(ChunkCatchUpTest, ShortAbsencesAreLeftToTheTicks) {
+    CellularAutomaton world(64, 64, 16);
+    ChunkCatchUpConfig config;
+    config.minFrozenSeconds = 10.0f;
+    world.enableCatchUp(config);
+    buildFrozenChunk(world);
+    freezeTopRow(world, 4);
+
+    EXPECT_EQ(world.getCatchUp()->getStats().chunks, 0u);
+    EXPECT_EQ(countInRect(world, 32, 11, 16, 4, world.getMaterialRegistry().getSandID()), 0);
+
+    world.disableCatchUp();
+    EXPECT_EQ(world.getCatchUp(), nullptr);
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,76 @@
+#include "astral/physics/ChunkManager.h"
+#include "astral/physics/CellularAutomaton.h"
+#include "astral/physics/Scenario.h"
+#include <gtest/gtest.h>
+
+namespace astral {
+namespace test {
+
+TEST(ChunkManagerTest, RejectsUnsupportedSizes) {
+    auto registry = MaterialRegistry::createShared();
+    EXPECT_THROW(ChunkManager(registry.get(), 24), std::invalid_argument);
+    EXPECT_THROW(CellularAutomaton(64, 64, registry, 256), std::invalid_argument);
+    for (int size : SUPPORTED_CHUNK_SIZES) {
+        EXPECT_EQ(ChunkManager(registry.get(), size).getChunkSize(), size);
+    }
+}
+
+TEST(ChunkManagerTest, CellsLandInTheirChunkForEverySize) {
+    auto registry = MaterialRegistry::createShared();
+    for (int size : SUPPORTED_CHUNK_SIZES) {
+        ChunkManager chunks(registry.get(), size);
+        for (int worldY : {-size - 1, -1, 0, size - 1, size, 3 * size + 5}) {
+            for (int worldX : {-2 * size, -size + 3, -1, 0, 1, size, 2 * size - 1}) {
+                Cell cell(7);
+                chunks.setCell(worldX, worldY, cell);
+                
+                ChunkCoord chunkCoord = ChunkManager::worldToChunkCoord(worldX, worldY, size);
+                LocalCoord local = ChunkManager::worldToLocalCoord(worldX, worldY, size);
+                WorldCoord world = ChunkManager::chunkToWorldCoord(chunkCoord, local, size);
+                EXPECT_EQ(world.x, worldX);
+                EXPECT_EQ(world.y, worldY);
+                
+                const Chunk* chunk = chunks.getChunk(chunkCoord);
+                ASSERT_NE(chunk, nullptr) << size << " " << worldX << "," << worldY;
+                EXPECT_EQ(chunk->getSize(), size);
+                EXPECT_EQ(chunk->getCell(local.x, local.y).material, 7);
+                EXPECT_EQ(&chunks.getCell(worldX, worldY), &chunk->getCell(local.x, local.y));
+            }
+        }
+    }
+}
+
+TEST(ChunkManagerTest, WorldLayoutDoesNotDependOnChunkSize) {
+    auto registry = MaterialRegistry::createShared();
+    ScenarioConfig config;
+    config.type = ScenarioType::MIXED;
+    config.activity = 0.3f;
+    config.seed = 11;
+    
+    CellularAutomaton reference(256, 256, registry);
+    buildScenario(reference, config);
+    
+    for (int size : SUPPORTED_CHUNK_SIZES) {
+        CellularAutomaton world(256, 256, registry, size);
+        buildScenario(world, config);
+        EXPECT_EQ(world.getChunkSize(), size);
+        EXPECT_EQ(world.getChunkManager().getChunkCount(), (256 / size) * (256 / size));
+        
+        size_t mismatches = 0;
+        for (int y = 0; y < 256; y++) {
+            for (int x = 0; x < 256; x++) {
+                mismatches += world.getCell(x, y).material != reference.getCell(x, y).material;
+            }
+        }
+        EXPECT_EQ(mismatches, 0u) << "chunk size " << size;
+        
+        // The kernels for this size run and keep material inside the world
+        for (int tick = 0; tick < 3; tick++) {
+            world.update(1.0f / 60.0f);
+        }
+        EXPECT_EQ(world.getSimulationStats().totalCells, 256 * 256);
+    }
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,192 @@
+#include "astral/physics/ChunkOutbox.h"
+#include "astral/physics/CellularAutomaton.h"
+#include "astral/physics/WorldScheduler.h"
+#include "astral/core/ThreadPool.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+// Sand poured over the corners of 16-cell chunks and water beside it, over a
+// stone floor
+void buildPour(CellularAutomaton& world) {
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    world.fillRectangle(0, 120, 128, 8, registry.getStoneID());
+    world.fillRectangle(10, 10, 44, 40, registry.getSandID());
+    world.fillRectangle(74, 20, 44, 30, registry.getWaterID());
+}
+
+std::vector<MaterialID> layout(const CellularAutomaton& world) {
+    std::vector<MaterialID> materials;
+    for (int y = 0; y < world.getWorldHeight(); y++) {
+        for (int x = 0; x < world.getWorldWidth(); x++) {
+            materials.push_back(world.getCell(x, y).material);
+        }
+    }
+    return materials;
+}
+
+size_t countMaterial(const std::vector<MaterialID>& materials, MaterialID material) {
+    return static_cast<size_t>(std::count(materials.begin(), materials.end(), material));
+}
+
+} // namespace
+
+TEST(ChunkOutboxTest, HighestPriorityWriteWinsRegardlessOfOrder) {
+    ChunkOutbox first;
+    ChunkOutbox second;
+    first.reset(7);
+    second.reset(7);
+
+    // Three cells contend for (5, 5); two other writes do not conflict
+    first.addMove({4, 4}, {5, 5}, 1, 0, false);
+    second.addMove({6, 4}, {5, 5}, 1, 0, false);
+    second.addEdit({5, 5}, 0, Cell(2));
+    first.addMove({4, 6}, {4, 7}, 1, 0, true);
+    second.addEdit({9, 9}, 0, Cell(3));
+
+    std::vector<BoundaryWrite> writes = first.getWrites();
+    writes.insert(writes.end(), second.getWrites().begin(), second.getWrites().end());
+    uint64_t best = 0;
+    for (const BoundaryWrite& write : writes) {
+        if (write.to == WorldCoord{5, 5}) best = std::max(best, write.priority);
+    }
+
+    std::vector<BoundaryWrite> settled = writes;
+    EXPECT_EQ(settleBoundaryWrites(settled), 2u);
+    ASSERT_EQ(settled.size(), 3u);
+    for (size_t i = 1; i < settled.size(); i++) {
+        EXPECT_GE(settled[i - 1].priority, settled[i].priority);
+    }
+    auto contested = std::find_if(settled.begin(), settled.end(),
+                                  [](const BoundaryWrite& write) { return write.to == WorldCoord{5, 5}; });
+    ASSERT_NE(contested, settled.end());
+    EXPECT_EQ(contested->priority, best);
+
+    // Any arrival order settles the same way
+    std::mt19937 random(3);
+    for (int round = 0; round < 5; round++) {
+        std::vector<BoundaryWrite> shuffled = writes;
+        std::shuffle(shuffled.begin(), shuffled.end(), random);
+        settleBoundaryWrites(shuffled);
+        ASSERT_EQ(shuffled.size(), settled.size());
+        for (size_t i = 0; i < settled.size(); i++) {
+            EXPECT_EQ(shuffled[i].from, settled[i].from);
+            EXPECT_EQ(shuffled[i].to, settled[i].to);
+            EXPECT_EQ(shuffled[i].kind, settled[i].kind);
+        }
+    }
+
+    // Priorities change from tick to tick
+    EXPECT_NE(ChunkOutbox::priorityOf({4, 4}, {5, 5}, 7), ChunkOutbox::priorityOf({4, 4}, {5, 5}, 8));
+}
+
+TEST(ChunkOutboxTest, OutboxTicksDoNotDependOnThreadCount) {
+    ThreadPool onePool(1);
+    ThreadPool manyPool(4);
+    CellularAutomaton one(128, 128, 16);
+    CellularAutomaton many(128, 128, 16);
+    one.setChunkUpdateStrategy(ChunkUpdateStrategy::OUTBOX, &onePool);
+    many.setChunkUpdateStrategy(ChunkUpdateStrategy::OUTBOX, &manyPool);
+    buildPour(one);
+    buildPour(many);
+
+    const MaterialRegistry& registry = one.getMaterialRegistry();
+    std::vector<MaterialID> start = layout(one);
+    size_t crossed = 0;
+    for (int i = 0; i < 40; i++) {
+        one.update(1.0f / 60.0f);
+        many.update(1.0f / 60.0f);
+        crossed += one.getOutboxStats().applied;
+        ASSERT_EQ(layout(one), layout(many)) << "tick " << i;
+    }
+
+    // Cells crossed chunk borders and none were lost or duplicated
+    std::vector<MaterialID> end = layout(one);
+    EXPECT_GT(crossed, 0u);
+    EXPECT_NE(end, start);
+    for (MaterialID material : {registry.getSandID(), registry.getWaterID(), registry.getStoneID()}) {
+        EXPECT_EQ(countMaterial(end, material), countMaterial(start, material));
+    }
+}
+
+TEST(ChunkOutboxTest, OutboxWorldsTickOnTheSchedulersPool) {
+    ThreadPool referencePool(1);
+    CellularAutomaton reference(128, 128, 16);
+    reference.setChunkUpdateStrategy(ChunkUpdateStrategy::OUTBOX, &referencePool);
+    reference.setRandomSeed(7);
+    buildPour(reference);
+
+    // More worlds than workers, so every worker ticks a world whose movement
+    // phase needs the same pool
+    ThreadPool pool(2);
+    WorldScheduler scheduler(pool);
+    for (int i = 0; i < 3; i++) {
+        auto world = std::make_shared<CellularAutomaton>(128, 128, 16);
+        world->setChunkUpdateStrategy(ChunkUpdateStrategy::OUTBOX, &pool);
+        world->setRandomSeed(7);
+        buildPour(*world);
+        scheduler.addWorld(world);
+    }
+
+    scheduler.run(1.0f / 60.0f, 20);
+    for (int i = 0; i < 20; i++) {
+        reference.update(1.0f / 60.0f);
+    }
+    for (size_t i = 0; i < scheduler.getWorldCount(); i++) {
+        EXPECT_EQ(scheduler.getWorldTicks(i), 20u);
+        EXPECT_EQ(layout(scheduler.getWorld(i)), layout(reference)) << "world " << i;
+    }
+}
+
+TEST(ChunkOutboxTest, OutboxMovementDoesNotWaitForPipelineConsumers) {
+    ThreadPool pool(2);
+    CellularAutomaton world(128, 128, 16);
+    world.setChunkUpdateStrategy(ChunkUpdateStrategy::OUTBOX, &pool);
+    buildPour(world);
+
+    // The consumer of the first tick holds a worker until the second tick,
+    // whose movement runs on the same pool, is done
+    std::atomic<bool> release(false);
+    TickPipeline& pipeline = world.enablePipeline(pool);
+    pipeline.addConsumer("hold", [&release](const PublishedTick& tick) {
+        while (tick.tick == 1 && !release) {
+            std::this_thread::yield();
+        }
+    });
+
+    world.update(1.0f / 60.0f);
+    world.update(1.0f / 60.0f);
+    EXPECT_EQ(pipeline.getPublishedTicks(), 2u);
+    release = true;
+    for (int i = 0; i < 10; i++) {
+        world.update(1.0f / 60.0f);
+    }
+    world.flushPipeline();
+    EXPECT_EQ(pipeline.getPublishedTicks(), 12u);
+    EXPECT_GT(world.getOutboxStats().writes, 0u);
+}
+
+TEST(ChunkOutboxTest, OutboxStrategyNeedsAPool) {
+    CellularAutomaton world(64, 64);
+    EXPECT_THROW(world.setChunkUpdateStrategy(ChunkUpdateStrategy::OUTBOX), std::invalid_argument);
+    EXPECT_EQ(world.getChunkUpdateStrategy(), ChunkUpdateStrategy::SERIAL);
+
+    ThreadPool pool(2);
+    world.setChunkUpdateStrategy(ChunkUpdateStrategy::OUTBOX, &pool);
+    world.setCell(5, 5, world.getMaterialRegistry().getSandID());
+    world.update(1.0f / 60.0f);
+    world.setChunkUpdateStrategy(ChunkUpdateStrategy::SERIAL);
+    world.update(1.0f / 60.0f);
+    EXPECT_EQ(world.getChunkUpdateStrategy(), ChunkUpdateStrategy::SERIAL);
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,123 @@
+#include "astral/physics/CellularAutomaton.h"
+#include "astral/core/ThreadPool.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+size_t countMaterial(const CellularAutomaton& world, MaterialID material) {
+    size_t count = 0;
+    for (int y = 0; y < world.getWorldHeight(); y++) {
+        for (int x = 0; x < world.getWorldWidth(); x++) {
+            count += world.getCell(x, y).material == material;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(ChunkSlabTest, ChunksAreLaidOutInMortonOrder) {
+    EXPECT_EQ(ChunkSlab::mortonCode(0, 0), 0u);
+    EXPECT_EQ(ChunkSlab::mortonCode(1, 0), 1u);
+    EXPECT_EQ(ChunkSlab::mortonCode(0, 1), 2u);
+    EXPECT_EQ(ChunkSlab::mortonCode(3, 5), 0x27u);
+
+    ChunkSlab slab(4, 4, 32);
+    EXPECT_EQ(slab.getSlot({0, 0}), 0u);
+    EXPECT_EQ(slab.getSlot({1, 0}), 1u);
+    EXPECT_EQ(slab.getSlot({0, 1}), 2u);
+    EXPECT_EQ(slab.getSlot({1, 1}), 3u);
+    EXPECT_EQ(slab.getSlot({2, 0}), 4u);
+    EXPECT_EQ(slab.getChunkCells({1, 0}) - slab.getChunkCells({0, 0}), 32 * 32);
+    EXPECT_EQ(slab.getChunkCells({4, 0}), nullptr);
+    EXPECT_GE(slab.getBytes(), 16u * 32 * 32 * sizeof(Cell));
+
+    // Grids that are not powers of two are packed without gaps
+    ChunkSlab packed(3, 5, 16);
+    std::vector<size_t> slots;
+    for (int y = 0; y < 5; y++) {
+        for (int x = 0; x < 3; x++) {
+            slots.push_back(packed.getSlot({x, y}));
+        }
+    }
+    std::sort(slots.begin(), slots.end());
+    for (size_t i = 0; i < slots.size(); i++) {
+        EXPECT_EQ(slots[i], i);
+    }
+
+    EXPECT_THROW(ChunkSlab(0, 4, 32), std::invalid_argument);
+}
+
+TEST(ChunkSlabTest, PrefaultSplitsTheSlabIntoStripes) {
+    ThreadPool pool(2);
+    ChunkSlabConfig config;
+    config.prefault = true;
+    config.firstTouchPool = &pool;
+    ChunkSlab slab(8, 8, 16, config);
+    ASSERT_EQ(slab.getStripeCount(), static_cast<int>(pool.getCoreGroupCount()));
+
+    // Stripes are contiguous runs of slots, and every cell starts as air
+    int lastStripe = 0;
+    for (size_t slot = 0; slot < 64; slot++) {
+        for (int y = 0; y < 8; y++) {
+            for (int x = 0; x < 8; x++) {
+                if (slab.getSlot({x, y}) != slot) continue;
+                int stripe = slab.getStripe({x, y});
+                EXPECT_GE(stripe, lastStripe);
+                EXPECT_LT(stripe, slab.getStripeCount());
+                lastStripe = stripe;
+                EXPECT_EQ(slab.getChunkCells({x, y})[16 * 16 - 1].material, 0);
+            }
+        }
+    }
+}
+
+TEST(ChunkSlabTest, WorldMovesIntoAndOutOfTheSlab) {
+    CellularAutomaton unbounded(CellularAutomaton::UNBOUNDED, 256);
+    EXPECT_THROW(unbounded.enableSlabStorage(), std::invalid_argument);
+
+    CellularAutomaton world(128, 96);
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    world.fillRectangle(0, 90, 128, 6, registry.getStoneID());
+    world.fillRectangle(20, 10, 40, 20, registry.getSandID());
+    world.setCell(100, 50, registry.getWaterID());
+
+    const ChunkSlab& slab = world.enableSlabStorage();
+    EXPECT_EQ(slab.getChunksX(), 4);
+    EXPECT_EQ(slab.getChunksY(), 3);
+    EXPECT_EQ(world.getSlabStorage(), &slab);
+    EXPECT_EQ(world.getCell(100, 50).material, registry.getWaterID());
+
+    const Chunk* chunk = world.getChunkManager().getChunk({1, 0});
+    ASSERT_NE(chunk, nullptr);
+    EXPECT_TRUE(chunk->hasExternalStorage());
+    EXPECT_EQ(chunk->getCells(), slab.getChunkCells({1, 0}));
+
+    // The simulation runs unchanged on slab storage
+    for (int i = 0; i < 60; i++) {
+        world.update(1.0f / 60.0f);
+    }
+    EXPECT_EQ(countMaterial(world, registry.getSandID()), 40u * 20u);
+    EXPECT_EQ(countMaterial(world, registry.getStoneID()), 128u * 6u);
+
+    // Chunks created after a clear land in their slots again
+    world.clearWorld();
+    world.setCell(5, 5, registry.getStoneID());
+    chunk = world.getChunkManager().getChunk({0, 0});
+    ASSERT_NE(chunk, nullptr);
+    EXPECT_EQ(chunk->getCells(), slab.getChunkCells({0, 0}));
+
+    world.disableSlabStorage();
+    EXPECT_EQ(world.getSlabStorage(), nullptr);
+    EXPECT_FALSE(world.getChunkManager().getChunk({0, 0})->hasExternalStorage());
+    EXPECT_EQ(world.getCell(5, 5).material, registry.getStoneID());
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,161 @@
+#include "astral/physics/ConductorNetwork.h"
+#include "astral/physics/CellularAutomaton.h"
+#include "astral/core/ThreadPool.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+constexpr float TICK = 1.0f / 60.0f;
+
+MaterialID registerWire(CellularAutomaton& world) {
+    MaterialProperties wire(MaterialType::SOLID, "Wire", glm::vec4(0.8f, 0.5f, 0.2f, 1.0f));
+    wire.setFlag(MaterialProperties::Flags::CONDUCTIVE);
+    return world.registerMaterial(wire);
+}
+
+// Drop a conductive grain onto a wire and check the network follows it
+// from the moves alone
+void dropFilingOntoWire(CellularAutomaton& world) {
+    MaterialID wire = registerWire(world);
+    MaterialProperties filings(MaterialType::POWDER, "Filings", glm::vec4(0.6f, 0.6f, 0.6f, 1.0f));
+    filings.setFlag(MaterialProperties::Flags::CONDUCTIVE);
+    MaterialID filing = world.registerMaterial(filings);
+    world.fillRectangle(4, 40, 56, 1, wire);
+    world.setCell(30, 10, filing);
+    ConductorNetworkConfig config;
+    config.currentThreshold = 100.0f;
+    world.enableConductors(config);
+    const ConductorNetwork& conductors = *world.getConductors();
+    EXPECT_EQ(conductors.getStats().components, 2u);
+
+    // Each tick reads only the cells the grain left and entered, across
+    // chunk borders too
+    for (int i = 0; i < 60; i++) {
+        world.update(TICK);
+        EXPECT_LE(conductors.getStats().examined, 4u);
+    }
+    EXPECT_FALSE(conductors.isConductor(30, 10));
+    EXPECT_TRUE(conductors.isConductor(30, 39));
+    EXPECT_EQ(conductors.getStats().components, 1u);
+    EXPECT_TRUE(conductors.isConnected(30, 39, 4, 40));
+    EXPECT_EQ(conductors.getComponentSize(4, 40), 57u);
+
+    world.update(TICK);
+    EXPECT_EQ(conductors.getStats().examined, 0u);
+}
+
+} // namespace
+
+TEST(ConductorNetworkTest, BridgingTwoWiresSharesTheirCharge) {
+    CellularAutomaton world(64, 64, 16);
+    MaterialID wire = registerWire(world);
+    world.fillRectangle(4, 10, 20, 1, wire);
+    world.fillRectangle(25, 10, 30, 1, wire);
+    ConductorNetworkConfig config;
+    config.currentThreshold = 100.0f;
+    world.enableConductors(config);
+    const ConductorNetwork& conductors = *world.getConductors();
+
+    EXPECT_EQ(conductors.getStats().components, 2u);
+    EXPECT_FALSE(conductors.isConnected(4, 10, 54, 10));
+    EXPECT_EQ(conductors.getComponentSize(10, 10), 20u);
+
+    // Charge spreads over the whole left wire at once
+    ASSERT_TRUE(world.addCharge(4, 10, 40.0f));
+    EXPECT_FALSE(world.addCharge(4, 11, 1.0f));
+    world.update(TICK);
+    EXPECT_FLOAT_EQ(world.getCell(23, 10).charge, 2.0f);
+    EXPECT_FLOAT_EQ(world.getCell(30, 10).charge, 0.0f);
+
+    // Painting the gap joins the wires into one, charge shared over 51 cells
+    world.setCell(24, 10, wire);
+    world.update(TICK);
+    EXPECT_EQ(conductors.getStats().components, 1u);
+    EXPECT_TRUE(conductors.isConnected(4, 10, 54, 10));
+    EXPECT_FLOAT_EQ(conductors.getCharge(54, 10), 40.0f / 51.0f);
+    EXPECT_FLOAT_EQ(world.getCell(54, 10).charge, 40.0f / 51.0f);
+}
+
+TEST(ConductorNetworkTest, CuttingAWireSplitsItsCharge) {
+    CellularAutomaton world(64, 64, 16);
+    MaterialID wire = registerWire(world);
+    world.fillRectangle(10, 20, 1, 31, wire);
+    world.fillRectangle(11, 35, 10, 1, wire);
+    ConductorNetworkConfig config;
+    config.currentThreshold = 100.0f;
+    world.enableConductors(config);
+    ASSERT_TRUE(world.addCharge(10, 20, 80.0f));
+    world.update(TICK);
+
+    // Cutting the upright above the branch leaves 14 cells above and 26 below;
+    // the cut cell's charge stays with them
+    world.setCell(10, 34, world.getMaterialRegistry().getDefaultMaterialID());
+    world.update(TICK);
+    const ConductorNetwork& conductors = *world.getConductors();
+    EXPECT_EQ(conductors.getStats().components, 2u);
+    EXPECT_EQ(conductors.getStats().relabelled, 40u);
+    EXPECT_EQ(conductors.getComponentSize(10, 20), 14u);
+    EXPECT_EQ(conductors.getComponentSize(20, 35), 26u);
+    EXPECT_FALSE(conductors.isConnected(10, 20, 10, 50));
+    EXPECT_FLOAT_EQ(conductors.getCharge(10, 20), 2.0f);
+    EXPECT_FLOAT_EQ(conductors.getCharge(20, 35), 2.0f);
+    EXPECT_FALSE(conductors.isConductor(10, 34));
+}
+
+TEST(ConductorNetworkTest, FollowsConductorsTheSimulationMoves) {
+    CellularAutomaton world(64, 64, 16);
+    dropFilingOntoWire(world);
+}
+
+TEST(ConductorNetworkTest, FollowsConductorsMovedByOutboxTasks) {
+    CellularAutomaton world(64, 64, 16);
+    ThreadPool pool(2);
+    world.setChunkUpdateStrategy(ChunkUpdateStrategy::OUTBOX, &pool);
+    dropFilingOntoWire(world);
+}
+
+TEST(ConductorNetworkTest, CurrentHeatsOnlyTheChargedWire) {
+    CellularAutomaton world(64, 64, 16);
+    MaterialID wire = registerWire(world);
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    world.fillRectangle(0, 60, 64, 4, registry.getStoneID());
+    world.fillRectangle(4, 30, 10, 1, wire);
+    world.fillRectangle(4, 40, 10, 1, wire);
+    ConductorNetworkConfig config;
+    config.currentThreshold = 1.0f;
+    config.heating = 40.0f;
+    config.leakRate = 0.5f;
+    world.enableConductors(config);
+
+    ASSERT_TRUE(world.addCharge(8, 30, 50.0f));
+    for (int i = 0; i < 30; i++) {
+        world.update(TICK);
+    }
+    const ConductorNetwork& conductors = *world.getConductors();
+    EXPECT_EQ(conductors.getStats().carrying, 1u);
+    EXPECT_TRUE(world.getCell(8, 30).hasFlag(Cell::FLAG_CHARGED));
+    EXPECT_GT(world.getCell(8, 30).temperature, 30.0f);
+    EXPECT_FALSE(world.getCell(8, 40).hasFlag(Cell::FLAG_CHARGED));
+    EXPECT_FLOAT_EQ(world.getCell(8, 40).temperature, 20.0f);
+    EXPECT_LT(conductors.getCharge(8, 30), 5.0f);
+
+    // The charge leaks away until the wire stops carrying current
+    for (int i = 0; i < 600; i++) {
+        world.update(TICK);
+    }
+    EXPECT_EQ(conductors.getStats().carrying, 0u);
+    EXPECT_FALSE(world.getCell(8, 30).hasFlag(Cell::FLAG_CHARGED));
+
+    world.disableConductors();
+    EXPECT_EQ(world.getConductors(), nullptr);
+    EXPECT_FALSE(world.addCharge(8, 30, 1.0f));
+    config.leakRate = -1.0f;
+    EXPECT_THROW(world.enableConductors(config), std::invalid_argument);
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,87 @@
+#include "astral/physics/DeterminismCheck.h"
+#include "astral/physics/CellularAutomaton.h"
+#include <gtest/gtest.h>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+DeterminismConfig smallConfig(ScenarioType type) {
+    DeterminismConfig config;
+    config.scenario.type = type;
+    config.worldWidth = 128;
+    config.worldHeight = 128;
+    config.chunkSize = 32;
+    config.ticks = 40;
+    return config;
+}
+
+EngineSetup outbox(const std::string& name, int threads) {
+    EngineSetup setup;
+    setup.name = name;
+    setup.strategy = ChunkUpdateStrategy::OUTBOX;
+    setup.threads = threads;
+    return setup;
+}
+
+} // namespace
+
+TEST(DeterminismCheckTest, SeededScenarioRepeatsExactly) {
+    DeterminismConfig config = smallConfig(ScenarioType::MIXED);
+    EngineSetup first;
+    first.name = "first";
+    EngineSetup second;
+    second.name = "second";
+
+    DeterminismResult result = verifyDeterminism(config, first, second);
+    EXPECT_FALSE(result.diverged);
+    EXPECT_EQ(result.ticksCompared, config.ticks);
+    EXPECT_EQ(result.describe(first, second), "first and second match over 40 ticks");
+}
+
+TEST(DeterminismCheckTest, DivergenceIsReportedWithTheCellDiff) {
+    DeterminismConfig config = smallConfig(ScenarioType::SAND);
+    EngineSetup first;
+    first.name = "first";
+    EngineSetup second;
+    second.name = "second";
+    second.configure = [](CellularAutomaton& world) {
+        Cell cell = world.getCell(40, 5);
+        cell.temperature += 1.0f;
+        world.setCell(40, 5, cell);
+    };
+
+    DeterminismResult result = verifyDeterminism(config, first, second);
+    ASSERT_TRUE(result.diverged);
+    EXPECT_EQ(result.tick, 0);
+    EXPECT_EQ(result.chunk.x, 1);
+    EXPECT_EQ(result.chunk.y, 0);
+    EXPECT_EQ(result.divergingChunks, 1u);
+    EXPECT_EQ(result.differingCells, 1u);
+    ASSERT_EQ(result.cells.size(), 1u);
+    EXPECT_EQ(result.cells[0].x, 40);
+    EXPECT_EQ(result.cells[0].y, 5);
+    EXPECT_EQ(result.cells[0].second.temperature, result.cells[0].first.temperature + 1.0f);
+    EXPECT_NE(result.describe(first, second).find("diverge at tick 0 in chunk (1, 0)"), std::string::npos);
+}
+
+TEST(DeterminismCheckTest, OutboxMatchesAcrossWorkerCounts) {
+    DeterminismConfig config = smallConfig(ScenarioType::LAVA);
+    DeterminismResult result = verifyDeterminism(config, outbox("outbox x1", 1), outbox("outbox x4", 4));
+    EXPECT_FALSE(result.diverged) << result.describe(outbox("outbox x1", 1), outbox("outbox x4", 4));
+}
+
+TEST(DeterminismCheckTest, SlabStorageMatchesHeapStorage) {
+    DeterminismConfig config = smallConfig(ScenarioType::WATER);
+    EngineSetup heap;
+    heap.name = "heap";
+    EngineSetup slab;
+    slab.name = "slab";
+    slab.slabStorage = true;
+    DeterminismResult result = verifyDeterminism(config, heap, slab);
+    EXPECT_FALSE(result.diverged) << result.describe(heap, slab);
+}
+
+} // namespace test
+} // namespace astral
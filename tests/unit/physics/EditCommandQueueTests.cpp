@@ -0,0 +1,177 @@
+#include "astral/physics/EditCommandQueue.h"
+#include "astral/physics/CellularAutomaton.h"
+#include "astral/core/TickWatchdog.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace astral {
+namespace test {
+
+TEST(EditCommandQueueTest, DrainPreservesSubmissionOrder) {
+    EditCommandQueue queue;
+    for (int i = 0; i < 10; i++) {
+        EditCommand command;
+        command.x = i;
+        queue.push(command);
+    }
+    
+    std::vector<EditCommand> commands;
+    EXPECT_EQ(queue.drain(commands), 10u);
+    ASSERT_EQ(commands.size(), 10u);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(commands[i].x, i);
+        EXPECT_EQ(commands[i].sequence, static_cast<uint64_t>(i));
+    }
+    
+    // Queue is empty after draining
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.drain(commands), 0u);
+}
+
+TEST(EditCommandQueueTest, ConcurrentProducers) {
+    EditCommandQueue queue;
+    const int producerCount = 4;
+    const int commandsPerProducer = 2000;
+    
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; p++) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < commandsPerProducer; i++) {
+                EditCommand command;
+                command.x = p;
+                command.y = i;
+                queue.push(command);
+            }
+        });
+    }
+    
+    // Drain while producers are still running
+    std::vector<EditCommand> commands;
+    while (commands.size() < static_cast<size_t>(producerCount * commandsPerProducer)) {
+        queue.drain(commands);
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    queue.drain(commands);
+    
+    // Every command arrives exactly once and each producer's commands stay in order
+    ASSERT_EQ(commands.size(), static_cast<size_t>(producerCount * commandsPerProducer));
+    std::vector<int> nextExpected(producerCount, 0);
+    for (const auto& command : commands) {
+        EXPECT_EQ(command.y, nextExpected[command.x]);
+        nextExpected[command.x]++;
+    }
+}
+
+TEST(EditCommandQueueTest, QueuedEditsApplyOnUpdate) {
+    CellularAutomaton automaton(64, 64);
+    MaterialID stoneId = automaton.getMaterialIDByName("Stone");
+    
+    std::thread producer([&automaton, stoneId]() {
+        automaton.queuePaintCircle(20, 20, 3, stoneId);
+        automaton.queueFillRectangle(40, 40, 4, 4, stoneId);
+    });
+    producer.join();
+    
+    // Nothing is written until the queue is drained
+    EXPECT_NE(automaton.getCell(20, 20).material, stoneId);
+    
+    EXPECT_EQ(automaton.applyQueuedEdits(), 2u);
+    EXPECT_EQ(automaton.getCell(20, 20).material, stoneId);
+    EXPECT_EQ(automaton.getCell(23, 20).material, stoneId);
+    EXPECT_EQ(automaton.getCell(43, 43).material, stoneId);
+    EXPECT_NE(automaton.getCell(44, 44).material, stoneId);
+}
+
+TEST(EditCommandQueueTest, OverlappingEditsKeepSubmissionOrder) {
+    CellularAutomaton automaton(64, 64, 32);
+    MaterialID stoneId = automaton.getMaterialIDByName("Stone");
+    automaton.fillRectangle(24, 4, 16, 12, stoneId);
+    
+    // An erase anchored in chunk (1, 0), then a paint anchored in chunk (0, 0)
+    // that overlaps it: the paint must win where they overlap
+    automaton.queuePaintCircle(33, 10, 4, 0);
+    automaton.queueFillRectangle(28, 8, 4, 4, stoneId);
+    EXPECT_EQ(automaton.applyQueuedEdits(), 2u);
+    
+    EXPECT_EQ(automaton.getCell(30, 10).material, stoneId);
+    EXPECT_EQ(automaton.getCell(31, 11).material, stoneId);
+    EXPECT_EQ(automaton.getCell(33, 10).material, 0);
+    EXPECT_EQ(automaton.getCell(36, 10).material, 0);
+}
+
+TEST(EditCommandQueueTest, JsonRoundTrip) {
+    EditCommand command;
+    command.type = EditCommandType::FORCE;
+    command.x = 12;
+    command.y = -3;
+    command.radius = 4.5f;
+    command.amount = 2.0f;
+    command.direction = glm::vec2(0.0f, -1.0f);
+    command.material = 7;
+    command.sequence = 99;
+    
+    EditCommand parsed;
+    ASSERT_TRUE(editCommandFromJson(editCommandToJson(command), parsed));
+    EXPECT_EQ(parsed.type, EditCommandType::FORCE);
+    EXPECT_EQ(parsed.x, 12);
+    EXPECT_EQ(parsed.y, -3);
+    EXPECT_FLOAT_EQ(parsed.radius, 4.5f);
+    EXPECT_FLOAT_EQ(parsed.direction.y, -1.0f);
+    EXPECT_EQ(parsed.material, 7);
+    EXPECT_EQ(parsed.sequence, 99u);
+    
+    EXPECT_FALSE(editCommandFromJson({{"type", "teleport"}}, parsed));
+}
+
+TEST(EditCommandQueueTest, WatchdogTracesAppliedEdits) {
+    CellularAutomaton automaton(64, 64);
+    MaterialID sandId = automaton.getMaterialIDByName("Sand");
+    
+    // A negative threshold makes every tick an outlier
+    TickWatchdogConfig config;
+    config.thresholdMs = -1.0;
+    config.minDumpIntervalSeconds = 0.0;
+    config.hotChunkCount = 2;
+    config.directory = (std::filesystem::temp_directory_path() /
+                        ("astral_watchdog_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()))).string();
+    TickWatchdog& watchdog = automaton.enableWatchdog(config);
+    
+    automaton.queueFillRectangle(8, 8, 16, 16, sandId);
+    automaton.update(1.0f / 60.0f);
+    watchdog.flush();
+    
+    ASSERT_EQ(watchdog.getDumpCount(), 1u);
+    std::ifstream file(watchdog.getLastDumpPath());
+    ASSERT_TRUE(file.is_open());
+    nlohmann::json dump = nlohmann::json::parse(file);
+    
+    ASSERT_EQ(dump["ticks"].size(), 1u);
+    const auto& tick = dump["ticks"][0];
+    EXPECT_TRUE(tick["sections"].contains("Physics"));
+    EXPECT_EQ(tick["chunkCosts"].size(), 4u);   // Every chunk of a 64x64 world
+    ASSERT_EQ(tick["events"].size(), 1u);
+    
+    EditCommand edit;
+    ASSERT_TRUE(editCommandFromJson(tick["events"][0], edit));
+    EXPECT_EQ(edit.type, EditCommandType::FILL_RECTANGLE);
+    EXPECT_EQ(edit.material, sandId);
+    
+    // Hot chunks decode back to a full chunk of cells
+    ASSERT_EQ(dump["hotChunks"].size(), 2u);
+    int cells = 0;
+    for (const auto& run : dump["hotChunks"][0]["materials"]) {
+        cells += run[1].get<int>();
+    }
+    EXPECT_EQ(cells, CHUNK_SIZE * CHUNK_SIZE);
+    
+    automaton.disableWatchdog();
+    std::filesystem::remove_all(config.directory);
+}
+
+} // namespace test
+} // namespace astral
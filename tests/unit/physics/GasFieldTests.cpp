@@ -0,0 +1,120 @@
+#include "astral/physics/CellularAutomaton.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+// One smoke cell in every 4x4 block of the rectangle
+void scatterSmoke(CellularAutomaton& world, int x, int y, int width, int height) {
+    MaterialID smoke = world.getMaterialRegistry().getSmokeID();
+    for (int cy = y; cy < y + height; cy += 4) {
+        for (int cx = x; cx < x + width; cx += 4) {
+            Cell cell(smoke);
+            cell.lifetime = 250;
+            world.setCell(cx, cy, cell);
+        }
+    }
+}
+
+size_t countMaterial(const CellularAutomaton& world, MaterialID material, int y0 = 0, int y1 = -1) {
+    if (y1 < 0) y1 = world.getWorldHeight();
+    size_t count = 0;
+    for (int y = y0; y < y1; y++) {
+        for (int x = 0; x < world.getWorldWidth(); x++) {
+            count += world.getCell(x, y).material == material;
+        }
+    }
+    return count;
+}
+
+// Density-weighted mean row of a material in the field
+float densityCentroidY(const CellularAutomaton& world, MaterialID material) {
+    const GasField* field = world.getGasField();
+    float weighted = 0.0f;
+    float total = 0.0f;
+    for (int y = 0; y < world.getWorldHeight(); y++) {
+        for (int x = 0; x < world.getWorldWidth(); x++) {
+            float density = field->getDensity(x, y, material);
+            weighted += density * y;
+            total += density;
+        }
+    }
+    return total > 0.0f ? weighted / total : -1.0f;
+}
+
+void runTicks(CellularAutomaton& world, int ticks) {
+    for (int i = 0; i < ticks; i++) {
+        world.update(1.0f / 60.0f);
+    }
+}
+
+} // namespace
+
+TEST(GasFieldTest, RejectsUnboundedWorldsAndBadSettings) {
+    CellularAutomaton unbounded(CellularAutomaton::UNBOUNDED, 256);
+    EXPECT_THROW(unbounded.enableGasField(), std::invalid_argument);
+
+    CellularAutomaton world(128, 128);
+    GasFieldConfig config;
+    config.cellsPerSample = 3;
+    EXPECT_THROW(world.enableGasField(config), std::invalid_argument);
+    config = GasFieldConfig();
+    config.materials = {"Water"};
+    EXPECT_THROW(world.enableGasField(config), std::invalid_argument);
+    EXPECT_EQ(world.getGasField(), nullptr);
+
+    GasField& field = world.enableGasField();
+    EXPECT_EQ(field.getSampleWidth(), 32);
+    EXPECT_EQ(field.getSampleHeight(), 32);
+}
+
+TEST(GasFieldTest, SparseSmokeIsAbsorbedAndRises) {
+    CellularAutomaton world(128, 128);
+    MaterialID smoke = world.getMaterialRegistry().getSmokeID();
+    world.enableGasField();
+    scatterSmoke(world, 32, 96, 64, 16);
+    const size_t scattered = countMaterial(world, smoke);
+    ASSERT_EQ(scattered, 64u);
+
+    runTicks(world, 1);
+    const GasField* field = world.getGasField();
+    EXPECT_EQ(field->getAbsorbedCells(), scattered);
+    EXPECT_EQ(countMaterial(world, smoke), 0u);
+    EXPECT_GT(field->getTotalDensity(smoke), 0.9f * scattered);
+    const float startY = densityCentroidY(world, smoke);
+
+    runTicks(world, 30);
+    EXPECT_LT(densityCentroidY(world, smoke), startY - 4.0f);
+}
+
+TEST(GasFieldTest, GasBecomesCellsAgainAtSolids) {
+    CellularAutomaton world(128, 128);
+    MaterialID smoke = world.getMaterialRegistry().getSmokeID();
+    world.fillRectangle(0, 40, 128, 4, world.getMaterialRegistry().getStoneID());
+    world.enableGasField();
+    scatterSmoke(world, 32, 80, 64, 16);
+
+    runTicks(world, 90);
+    EXPECT_GT(world.getGasField()->getMaterializedCells(), 0u);
+    EXPECT_GT(countMaterial(world, smoke, 44, 56), 0u);
+    EXPECT_EQ(countMaterial(world, smoke, 0, 40), 0u);
+}
+
+TEST(GasFieldTest, DisablingTurnsTheFieldBackIntoCells) {
+    CellularAutomaton world(128, 128);
+    MaterialID smoke = world.getMaterialRegistry().getSmokeID();
+    world.enableGasField();
+    scatterSmoke(world, 32, 96, 64, 16);
+    runTicks(world, 1);
+    const float held = world.getGasField()->getTotalDensity(smoke);
+
+    world.disableGasField();
+    EXPECT_EQ(world.getGasField(), nullptr);
+    EXPECT_NEAR(static_cast<float>(countMaterial(world, smoke)), held, 8.0f);
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,170 @@
+#include "astral/physics/CellularAutomaton.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+// Stone basin with walls at x = 8..9 and 50..51 and a floor at y = 90..93,
+// filled with water over x = 10..49, y = 60..89
+constexpr int BASIN_LEFT = 10;
+constexpr int BASIN_RIGHT = 50;
+constexpr int WATER_TOP = 60;
+constexpr int BASIN_FLOOR = 90;
+
+void buildLake(CellularAutomaton& world, float temperature = 20.0f) {
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    world.fillRectangle(BASIN_LEFT - 2, 50, 2, BASIN_FLOOR + 4 - 50, registry.getStoneID());
+    world.fillRectangle(BASIN_RIGHT, 50, 2, BASIN_FLOOR + 4 - 50, registry.getStoneID());
+    world.fillRectangle(BASIN_LEFT - 2, BASIN_FLOOR, BASIN_RIGHT - BASIN_LEFT + 4, 4, registry.getStoneID());
+    world.fillRectangle(BASIN_LEFT, WATER_TOP, BASIN_RIGHT - BASIN_LEFT, BASIN_FLOOR - WATER_TOP, registry.getWaterID());
+    for (int y = WATER_TOP; y < BASIN_FLOOR; y++) {
+        for (int x = BASIN_LEFT; x < BASIN_RIGHT; x++) {
+            world.getCell(x, y).temperature = temperature;
+        }
+    }
+}
+
+void runTicks(CellularAutomaton& world, int ticks) {
+    for (int i = 0; i < ticks; i++) {
+        world.update(1.0f / 60.0f);
+    }
+}
+
+size_t countMaterial(const CellularAutomaton& world, MaterialID material) {
+    size_t count = 0;
+    for (int y = 0; y < world.getWorldHeight(); y++) {
+        for (int x = 0; x < world.getWorldWidth(); x++) {
+            count += world.getCell(x, y).material == material;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(LiquidBodyTrackerTest, SettledLakeInteriorIsAggregated) {
+    CellularAutomaton world(128, 128);
+    world.getLiquidBodies().setDetectionInterval(1);
+    buildLake(world);
+    runTicks(world, 2);
+
+    const auto& bodies = world.getLiquidBodies().getBodies();
+    ASSERT_EQ(bodies.size(), 1u);
+    const LiquidBody& body = bodies[0];
+    EXPECT_EQ(body.material, world.getMaterialRegistry().getWaterID());
+
+    // Everything but the outermost ring of the water
+    const size_t interior = (BASIN_RIGHT - BASIN_LEFT - 2) * (BASIN_FLOOR - WATER_TOP - 2);
+    EXPECT_EQ(body.cellCount, interior);
+    EXPECT_EQ(world.getLiquidBodies().getAggregatedCellCount(), interior);
+    EXPECT_EQ(body.bounds.x, BASIN_LEFT + 1);
+    EXPECT_EQ(body.bounds.y, WATER_TOP + 1);
+    EXPECT_EQ(body.bounds.width, BASIN_RIGHT - BASIN_LEFT - 2);
+    EXPECT_EQ(body.bounds.height, BASIN_FLOOR - WATER_TOP - 2);
+
+    // The surface line runs along the top of the water
+    EXPECT_EQ(body.surface.size(), static_cast<size_t>(BASIN_RIGHT - BASIN_LEFT));
+    for (const WorldCoord& coord : body.surface) {
+        EXPECT_EQ(coord.y, WATER_TOP);
+    }
+    EXPECT_NEAR(body.meanTemperature, 20.0f, 0.01f);
+
+    // The interior cells stay readable and the lake stays put
+    EXPECT_EQ(world.getCell(30, 75).material, body.material);
+    runTicks(world, 10);
+    EXPECT_EQ(world.getLiquidBodies().getBodies().size(), 1u);
+    EXPECT_EQ(countMaterial(world, body.material),
+              static_cast<size_t>((BASIN_RIGHT - BASIN_LEFT) * (BASIN_FLOOR - WATER_TOP)));
+}
+
+TEST(LiquidBodyTrackerTest, SmallOrFallingLiquidStaysPerCell) {
+    CellularAutomaton world(128, 128);
+    world.getLiquidBodies().setDetectionInterval(1);
+    MaterialID water = world.getMaterialRegistry().getWaterID();
+
+    // A block of water in mid-air: its lower edge can fall
+    world.fillRectangle(20, 10, 20, 20, water);
+    runTicks(world, 1);
+    EXPECT_TRUE(world.getLiquidBodies().getBodies().empty());
+
+    // Too few interior cells
+    CellularAutomaton pond(128, 128);
+    pond.getLiquidBodies().setDetectionInterval(1);
+    pond.getLiquidBodies().setMinimumCells(2000);
+    buildLake(pond);
+    runTicks(pond, 2);
+    EXPECT_TRUE(pond.getLiquidBodies().getBodies().empty());
+}
+
+TEST(LiquidBodyTrackerTest, BreachedShoreReexpandsTheBody) {
+    CellularAutomaton world(128, 128);
+    world.getLiquidBodies().setDetectionInterval(1000);
+    buildLake(world);
+    world.getLiquidBodies().detect();
+    ASSERT_EQ(world.getLiquidBodies().getBodies().size(), 1u);
+
+    // Open the right wall; the shoreline cells flow out
+    world.fillRectangle(BASIN_RIGHT, 70, 2, BASIN_FLOOR - 70, world.getMaterialRegistry().getDefaultMaterialID());
+    runTicks(world, 3);
+    EXPECT_TRUE(world.getLiquidBodies().getBodies().empty());
+    EXPECT_EQ(world.getLiquidBodies().getReleasedBodyCount(), 1u);
+    EXPECT_EQ(world.getChunkManager().getChunk({0, 2})->getAggregatedCellCount(), 0u);
+
+    // The whole lake drains, not only the former shoreline
+    runTicks(world, 120);
+    EXPECT_NE(world.getCell(30, WATER_TOP + 5).material, world.getMaterialRegistry().getWaterID());
+}
+
+TEST(LiquidBodyTrackerTest, OverwrittenInteriorCellReexpandsTheBody) {
+    CellularAutomaton world(128, 128);
+    world.getLiquidBodies().setDetectionInterval(1000);
+    buildLake(world);
+    world.getLiquidBodies().detect();
+    ASSERT_EQ(world.getLiquidBodies().getBodies().size(), 1u);
+
+    world.setCell(30, 70, world.getMaterialRegistry().getSandID());
+    runTicks(world, 1);
+    EXPECT_TRUE(world.getLiquidBodies().getBodies().empty());
+}
+
+TEST(LiquidBodyTrackerTest, HeatSourceReexpandsTheBody) {
+    CellularAutomaton world(128, 128);
+    world.getLiquidBodies().setDetectionInterval(1000);
+    buildLake(world);
+    world.getLiquidBodies().detect();
+    ASSERT_EQ(world.getLiquidBodies().getBodies().size(), 1u);
+
+    world.createHeatSource(30, 80, 90.0f, 3.0f);
+    EXPECT_TRUE(world.getLiquidBodies().getBodies().empty());
+    EXPECT_NEAR(world.getCell(30, 80).temperature, 90.0f, 0.01f);
+}
+
+TEST(LiquidBodyTrackerTest, InteriorDriftsToAmbientAsIfSimulated) {
+    // The centre of a uniformly hot lake only exchanges heat with cells at
+    // its own temperature, so both worlds must agree on it
+    CellularAutomaton aggregated(128, 128);
+    CellularAutomaton perCell(128, 128);
+    aggregated.getLiquidBodies().setDetectionInterval(1);
+    perCell.getLiquidBodies().setEnabled(false);
+    buildLake(aggregated, 80.0f);
+    buildLake(perCell, 80.0f);
+
+    runTicks(aggregated, 300);
+    runTicks(perCell, 300);
+    ASSERT_EQ(aggregated.getLiquidBodies().getBodies().size(), 1u);
+    float mean = aggregated.getLiquidBodies().getBodies()[0].meanTemperature;
+
+    aggregated.getLiquidBodies().setEnabled(false);
+    EXPECT_TRUE(aggregated.getLiquidBodies().getBodies().empty());
+
+    float expected = perCell.getCell(30, 75).temperature;
+    EXPECT_LT(expected, 79.0f);
+    EXPECT_NEAR(aggregated.getCell(30, 75).temperature, expected, 0.05f);
+    EXPECT_NEAR(mean, expected, 0.5f);
+}
+
+} // namespace test
+} // namespace astral
@@ -1,5 +1,7 @@
 #include "astral/physics/Material.h"
+#include "astral/physics/CellularAutomaton.h"
 #include <gtest/gtest.h>
+#include <set>
 
 namespace astral {
 namespace test {
@@ -18,5 +20,55 @@ TEST(MaterialTest, ParameterizedConstructor) {
     EXPECT_EQ(props.color, glm::vec4(0.5f, 0.5f, 0.5f, 1.0f));
 }
 
+TEST(MaterialTest, ViscousLavaUpdatesEveryFewTicks) {
+    EXPECT_EQ(MaterialProperties::intervalForViscosity(0.0f), 1);
+    EXPECT_EQ(MaterialProperties::intervalForViscosity(0.6f), 3);
+    EXPECT_EQ(MaterialProperties().updateInterval, 1);
+
+    auto registry = MaterialRegistry::createShared();
+    MaterialTable table(*registry);
+    EXPECT_EQ(table.getUpdateInterval(table.getLavaID()), 3);
+    EXPECT_EQ(table.getUpdateInterval(table.getWaterID()), 1);
+    EXPECT_EQ(table.getUpdateInterval(60000), 1);
+}
+
+TEST(MaterialTest, SlowCellsAreSpreadOverTheInterval) {
+    CellularAutomaton world(64, 64);
+    MaterialID lava = world.getMaterialRegistry().getLavaID();
+    for (int y = 2; y < 62; y += 3) {
+        for (int x = 2; x < 62; x += 3) {
+            world.setCell(x, y, lava);
+            world.getCell(x, y).temperature = 1000.0f;
+        }
+    }
+    const float start = 1000.0f;
+
+    // Isolated cells only change on their own ticks
+    world.update(1.0f / 60.0f);
+    int changed = 0;
+    int total = 0;
+    for (int y = 2; y < 62; y += 3) {
+        for (int x = 2; x < 62; x += 3) {
+            changed += world.getCell(x, y).temperature != start;
+            total++;
+        }
+    }
+    EXPECT_GT(changed, total / 5);
+    EXPECT_LT(changed, total / 2);
+
+    // After one interval each cell has taken exactly one three-tick step
+    world.update(1.0f / 60.0f);
+    world.update(1.0f / 60.0f);
+    std::set<float> temperatures;
+    for (int y = 2; y < 62; y += 3) {
+        for (int x = 2; x < 62; x += 3) {
+            ASSERT_EQ(world.getCell(x, y).material, lava);
+            temperatures.insert(world.getCell(x, y).temperature);
+        }
+    }
+    ASSERT_EQ(temperatures.size(), 1u);
+    EXPECT_NE(*temperatures.begin(), start);
+}
+
 } // namespace test
 } // namespace astral
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "astral/physics/CellularAutomaton.h"
+#include "astral/core/Profiler.h"
+#include <gtest/gtest.h>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+constexpr float TICK = 1.0f / 60.0f;
+
+const MemoryReport::Entry* findEntry(const MemoryReport& report, const std::string& name) {
+    for (const MemoryReport::Entry& entry : report.getEntries()) {
+        if (entry.name == name) return &entry;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST(MemoryReportTest, ChunksAreReportedByWhereTheirCellsLive) {
+    CellularAutomaton world(128, 128, 32);
+    world.loadRegion(0, 0, 128, 128);
+    const size_t cellBytes = 32 * 32 * sizeof(Cell);
+
+    MemoryReport report = world.getMemoryReport();
+    const MemoryReport::Entry* cells = findEntry(report, "chunks/cells");
+    ASSERT_NE(cells, nullptr);
+    EXPECT_EQ(cells->count, 16u);
+    EXPECT_EQ(cells->bytes, 16 * cellBytes);
+    EXPECT_EQ(report.getBytes("chunks/slab"), 0u);
+    EXPECT_EQ(report.getBytes("chunks/updated_flags"), 16u * 32 * 32 / 8);
+    EXPECT_GT(report.getBytes("materials/table"), 0u);
+
+    // Moved into the slab, the cells are only counted there
+    world.enableSlabStorage();
+    report = world.getMemoryReport();
+    EXPECT_EQ(report.getBytes("chunks/cells"), 0u);
+    EXPECT_GE(report.getBytes("chunks/slab"), 16 * cellBytes);
+    EXPECT_EQ(findEntry(report, "chunks/slab")->count, 16u);
+
+    size_t sum = 0;
+    for (const MemoryReport::Entry& entry : report.getEntries()) {
+        sum += entry.bytes;
+    }
+    EXPECT_EQ(report.getTotalBytes(), sum);
+    EXPECT_EQ(report.getBytes("chunks/"), report.getBytes("chunks/cells") + report.getBytes("chunks/slab") +
+                                              report.getBytes("chunks/updated_flags") +
+                                              report.getBytes("chunks/active_flags") +
+                                              report.getBytes("chunks/liquid_layouts") +
+                                              report.getBytes("chunks/index"));
+}
+
+TEST(MemoryReportTest, ModulesAndQueuesAreCountedWhileEnabled) {
+    CellularAutomaton world(128, 128, 32);
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    MemoryReport before = world.getMemoryReport();
+    EXPECT_EQ(before.getBytes("modules/gas_field"), 0u);
+    EXPECT_EQ(before.getBytes("modules/conductors"), 0u);
+    EXPECT_EQ(before.getBytes("queues/edits"), 0u);
+
+    world.enableGasField();
+    world.enableConductors();
+    for (int i = 0; i < 3; i++) {
+        world.queuePaintCell(10 + i, 10, registry.getSandID());
+    }
+    MemoryReport after = world.getMemoryReport();
+    EXPECT_GT(after.getBytes("modules/gas_field"), 0u);
+    EXPECT_GE(after.getBytes("modules/conductors"), 128u * 128 * sizeof(int));
+    EXPECT_EQ(findEntry(after, "queues/edits")->count, 3u);
+    EXPECT_GT(after.getBytes("queues/edits"), 0u);
+
+    // The same entries are reported either way, so the Profiler's per-name
+    // totals never keep a stale module
+    ASSERT_EQ(before.getEntries().size(), after.getEntries().size());
+    for (size_t i = 0; i < before.getEntries().size(); i++) {
+        EXPECT_EQ(before.getEntries()[i].name, after.getEntries()[i].name);
+    }
+
+    world.disableGasField();
+    world.update(TICK);
+    MemoryReport applied = world.getMemoryReport();
+    EXPECT_EQ(applied.getBytes("modules/gas_field"), 0u);
+    EXPECT_EQ(findEntry(applied, "queues/edits")->count, 0u);
+}
+
+TEST(MemoryReportTest, TicksFeedTheProfilerAndCountUpdatedCells) {
+    CellularAutomaton world(64, 64, 16);
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    world.fillRectangle(8, 4, 16, 4, registry.getSandID());
+
+    Profiler& profiler = Profiler::getInstance();
+    profiler.initialize(true);
+    profiler.beginFrame();
+    world.update(TICK);
+    profiler.endFrame();
+    size_t recorded = profiler.getMetrics().memoryUsage;
+    profiler.setEnabled(false);
+    EXPECT_EQ(recorded, world.getMemoryReport().getTotalBytes());
+
+    // Only the falling sand was updated in the last tick; a move marks the
+    // cell it left and the one it entered
+    ChunkManager::PerformanceStats stats = world.getChunkManager().getPerformanceStats();
+    EXPECT_GT(stats.activeCells, 0);
+    EXPECT_LE(stats.activeCells, 2 * 16 * 4);
+    for (int i = 0; i < 600; i++) {
+        world.update(TICK);
+    }
+    EXPECT_LT(world.getChunkManager().getPerformanceStats().activeCells, stats.activeCells);
+}
+
+TEST(MemoryReportTest, EachWorldKeepsItsOwnProfilerEntries) {
+    Profiler& profiler = Profiler::getInstance();
+    profiler.initialize(true);
+    profiler.reset();
+    auto recordedBytes = [&profiler]() {
+        profiler.beginFrame();
+        profiler.endFrame();
+        return profiler.getMetrics().memoryUsage;
+    };
+
+    CellularAutomaton first(64, 64, 16);
+    auto second = std::make_unique<CellularAutomaton>(128, 128, 16);
+    EXPECT_NE(first.getProfilerPrefix(), second->getProfilerPrefix());
+    first.update(TICK);
+    second->update(TICK);
+    size_t firstBytes = first.getMemoryReport().getTotalBytes();
+    EXPECT_EQ(recordedBytes(), firstBytes + second->getMemoryReport().getTotalBytes());
+
+    // Samples are taken every MEMORY_SAMPLE_TICKS ticks, not on every tick
+    first.enableGasField();
+    first.update(TICK);
+    EXPECT_EQ(recordedBytes() - second->getMemoryReport().getTotalBytes(), firstBytes);
+    for (int i = 1; i < CellularAutomaton::MEMORY_SAMPLE_TICKS; i++) {
+        first.update(TICK);
+    }
+    firstBytes = first.getMemoryReport().getTotalBytes();
+    EXPECT_EQ(recordedBytes() - second->getMemoryReport().getTotalBytes(), firstBytes);
+
+    // A destroyed world's entries go with it
+    second.reset();
+    EXPECT_EQ(recordedBytes(), firstBytes);
+    profiler.reset();
+    profiler.setEnabled(false);
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,109 @@
+#include "astral/physics/ParticleSystem.h"
+#include "astral/physics/CellularAutomaton.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+constexpr float TICK = 1.0f / 60.0f;
+
+int countMaterial(const CellularAutomaton& world, MaterialID material) {
+    int count = 0;
+    for (int y = 0; y < world.getWorldHeight(); y++) {
+        for (int x = 0; x < world.getWorldWidth(); x++) {
+            if (world.getCell(x, y).material == material) count++;
+        }
+    }
+    return count;
+}
+
+// Tick until nothing is in flight; returns false if that takes too long
+bool landAll(CellularAutomaton& world, int maxTicks = 600) {
+    for (int i = 0; i < maxTicks; i++) {
+        world.update(TICK);
+        if (world.getParticles()->empty()) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(ParticleSystemTest, ParticleBouncesOffAWallAndLands) {
+    CellularAutomaton world(64, 64, 16);
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    world.fillRectangle(0, 60, 64, 4, registry.getStoneID());
+    world.fillRectangle(40, 20, 2, 40, registry.getStoneID());
+    ParticleSystem& particles = world.enableParticles();
+
+    // Thrown hard at the wall, it bounces back and settles on the floor
+    ASSERT_TRUE(particles.spawn(20.5f, 30.5f, 90.0f, -20.0f, Cell(registry.getSandID())));
+    EXPECT_EQ(particles.countMaterial(registry.getSandID()), 1u);
+    ASSERT_TRUE(landAll(world));
+
+    int found = 0;
+    for (int x = 0; x < 40; x++) {
+        for (int y = 55; y < 60; y++) {
+            if (world.getCell(x, y).material == registry.getSandID()) found++;
+        }
+    }
+    EXPECT_EQ(found, 1);
+    EXPECT_EQ(countMaterial(world, registry.getSandID()), 1);
+    EXPECT_EQ(particles.getStats().deposited, 1u);
+}
+
+TEST(ParticleSystemTest, ExplosionThrowsLooseCellsWithoutLosingThem) {
+    CellularAutomaton world(128, 128, 32);
+    CellularAutomaton gridOnly(128, 128, 32);
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    for (CellularAutomaton* target : {&world, &gridOnly}) {
+        target->fillRectangle(0, 120, 128, 8, registry.getStoneID());
+        target->fillRectangle(40, 100, 48, 20, registry.getSandID());
+    }
+    ParticleSystemConfig config;
+    config.sparks = 0;
+    world.enableParticles(config);
+
+    // The blast is too weak to destroy sand, so only the centre cell goes
+    world.createExplosion(64, 105, 10.0f, 3.0f);
+    gridOnly.createExplosion(64, 105, 10.0f, 3.0f);
+    const int sand = countMaterial(gridOnly, registry.getSandID());
+    const ParticleSystem& particles = *world.getParticles();
+    EXPECT_GT(particles.size(), 20u);
+    EXPECT_EQ(countMaterial(world, registry.getSandID()) + static_cast<int>(particles.countMaterial(registry.getSandID())),
+              sand);
+
+    ASSERT_TRUE(landAll(world));
+    EXPECT_EQ(particles.getStats().lost, 0u);
+    EXPECT_EQ(countMaterial(world, registry.getSandID()), sand);
+}
+
+TEST(ParticleSystemTest, SparksBurnOutAndDisablingLandsTheRest) {
+    CellularAutomaton world(64, 64, 16);
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    ParticleSystemConfig config;
+    config.gravity = 0.0f;
+    config.drag = 0.0f;
+    ParticleSystem& particles = world.enableParticles(config);
+
+    Cell fire(registry.getFireID());
+    particles.spawn(10.5f, 10.5f, 1.0f, 0.0f, fire, 0.1f);
+    particles.spawn(30.5f, 10.5f, 1.0f, 0.0f, Cell(registry.getWaterID()));
+    for (int i = 0; i < 10; i++) {
+        world.update(TICK);
+    }
+    EXPECT_EQ(particles.getStats().burnedOut, 1u);
+    EXPECT_EQ(particles.size(), 1u);
+
+    world.disableParticles();
+    EXPECT_EQ(world.getParticles(), nullptr);
+    EXPECT_EQ(countMaterial(world, registry.getWaterID()), 1);
+
+    config.restitution = 2.0f;
+    EXPECT_THROW(world.enableParticles(config), std::invalid_argument);
+}
+
+} // namespace test
+} // namespace astral
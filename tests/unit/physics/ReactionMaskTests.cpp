@@ -0,0 +1,103 @@
+#include "astral/physics/ReactionMask.h"
+#include "astral/physics/CellProcessor.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+class ReactionMaskTest : public ::testing::Test {
+protected:
+    std::shared_ptr<const MaterialRegistry> registry = MaterialRegistry::createShared();
+    MaterialTable table{*registry};
+    CellProcessor processor{&table};
+    ReactionMatrix matrix{processor};
+
+    // Brute force: some neighbour of the 8 can react with the cell
+    bool hasReactiveNeighbour(const ChunkManager& chunks, int worldX, int worldY) const {
+        MaterialID material = chunks.getCell(worldX, worldY).material;
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if (dx == 0 && dy == 0) continue;
+                const Chunk* chunk = chunks.getChunk(chunks.chunkCoordOf(worldX + dx, worldY + dy));
+                MaterialID neighbour = chunk ? chunks.getCell(worldX + dx, worldY + dy).material : 0;
+                if (matrix.canReact(material, neighbour)) return true;
+            }
+        }
+        return false;
+    }
+};
+
+} // namespace
+
+TEST_F(ReactionMaskTest, MatrixMatchesTheRules) {
+    EXPECT_TRUE(matrix.canReact(table.getLavaID(), table.getWaterID()));
+    EXPECT_TRUE(matrix.canReact(table.getFireID(), table.getWoodID()));
+    EXPECT_TRUE(matrix.canReact(table.getWoodID(), table.getFireID()));
+    EXPECT_FALSE(matrix.canReact(table.getStoneID(), table.getStoneID()));
+    EXPECT_FALSE(matrix.canReact(table.getSandID(), 0));
+    EXPECT_EQ(matrix.getParticipant(table.getStoneID()) < 0,
+              !matrix.canReact(table.getStoneID(), table.getLavaID()) &&
+              !matrix.canReact(table.getLavaID(), table.getStoneID()) &&
+              !matrix.canReact(table.getStoneID(), table.getFireID()) &&
+              !matrix.canReact(table.getFireID(), table.getStoneID()));
+}
+
+TEST_F(ReactionMaskTest, MaskMatchesBruteForceAcrossChunkBorders) {
+    for (int chunkSize : {16, 64, 128}) {
+        ChunkManager chunks(registry.get(), chunkSize);
+        const MaterialID palette[] = {0, 0, 0, table.getStoneID(), table.getSandID(), table.getWaterID(),
+                                      table.getLavaID(), table.getWoodID(), table.getFireID(), table.getOilID()};
+        std::mt19937 random(static_cast<uint32_t>(chunkSize));
+        std::uniform_int_distribution<int> pick(0, 9);
+        for (int y = 0; y < 3 * chunkSize; y++) {
+            for (int x = 0; x < 3 * chunkSize; x++) {
+                chunks.setCell(x, y, Cell(palette[pick(random)]));
+            }
+        }
+
+        ReactionMask mask;
+        mask.build(matrix, chunks, {1, 1});
+        size_t expected = 0;
+        for (int y = 0; y < chunkSize; y++) {
+            for (int x = 0; x < chunkSize; x++) {
+                bool reactive = hasReactiveNeighbour(chunks, chunkSize + x, chunkSize + y);
+                expected += reactive;
+                ASSERT_EQ(mask.isCandidate(x, y), reactive) << "size " << chunkSize << " at " << x << "," << y;
+            }
+        }
+        EXPECT_EQ(mask.getBuiltCandidateCount(), expected);
+        EXPECT_GT(expected, 0u);
+    }
+}
+
+TEST_F(ReactionMaskTest, QuietChunksHaveNoCandidates) {
+    ChunkManager chunks(registry.get(), 32);
+    for (int y = 0; y < 32; y++) {
+        for (int x = 0; x < 32; x++) {
+            chunks.setCell(x, y, Cell(y < 16 ? table.getStoneID() : table.getSandID()));
+        }
+    }
+
+    ReactionMask mask;
+    mask.build(matrix, chunks, {0, 0});
+    EXPECT_EQ(mask.getBuiltCandidateCount(), 0u);
+    EXPECT_TRUE(mask.isRowQuiet(10));
+
+    // Fire just across the border reaches the wood on the edge
+    chunks.setCell(31, 5, Cell(table.getWoodID()));
+    chunks.setCell(32, 5, Cell(table.getFireID()));
+    mask.build(matrix, chunks, {0, 0});
+    EXPECT_EQ(mask.getBuiltCandidateCount(), 1u);
+    EXPECT_TRUE(mask.isCandidate(31, 5));
+
+    mask.markAround(0, 0);
+    EXPECT_TRUE(mask.isCandidate(1, 1));
+    EXPECT_FALSE(mask.isCandidate(2, 0));
+}
+
+} // namespace test
+} // namespace astral
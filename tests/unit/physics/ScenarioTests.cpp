@@ -0,0 +1,82 @@
+#include "astral/physics/Scenario.h"
+#include "astral/physics/CellularAutomaton.h"
+#include <gtest/gtest.h>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+uint64_t worldHash(const CellularAutomaton& world) {
+    uint64_t hash = 0;
+    const ChunkManager& chunks = world.getChunkManager();
+    for (int cy = 0; cy < world.getWorldHeight() / CHUNK_SIZE; cy++) {
+        for (int cx = 0; cx < world.getWorldWidth() / CHUNK_SIZE; cx++) {
+            ChunkCoord coord{cx, cy};
+            const Chunk* chunk = chunks.getChunk(coord);
+            if (!chunk) continue;
+            MaterialID materials[CHUNK_SIZE * CHUNK_SIZE];
+            chunk->copyMaterials(materials);
+            hash = combineChunkHash(hash, coord, hashMaterials(materials, CHUNK_SIZE * CHUNK_SIZE));
+        }
+    }
+    return hash;
+}
+
+size_t countNonAir(const CellularAutomaton& world) {
+    size_t count = 0;
+    for (int y = 0; y < world.getWorldHeight(); y++) {
+        for (int x = 0; x < world.getWorldWidth(); x++) {
+            count += world.getCell(x, y).material != 0;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(ScenarioTest, NamesRoundTrip) {
+    for (ScenarioType type : allScenarios()) {
+        ScenarioType parsed;
+        ASSERT_TRUE(parseScenario(scenarioName(type), parsed));
+        EXPECT_EQ(parsed, type);
+    }
+    ScenarioType parsed;
+    EXPECT_FALSE(parseScenario("volcano", parsed));
+}
+
+TEST(ScenarioTest, SameSeedBuildsSameWorld) {
+    CellularAutomaton first(128, 128);
+    CellularAutomaton second(128, 128);
+    CellularAutomaton third(128, 128);
+
+    ScenarioConfig config;
+    config.type = ScenarioType::MIXED;
+    buildScenario(first, config);
+    buildScenario(second, config);
+    config.seed = 2;
+    buildScenario(third, config);
+
+    EXPECT_EQ(worldHash(first), worldHash(second));
+    EXPECT_NE(worldHash(first), worldHash(third));
+}
+
+TEST(ScenarioTest, ActivityControlsCoverage) {
+    CellularAutomaton sparse(128, 128);
+    CellularAutomaton dense(128, 128);
+
+    ScenarioConfig config;
+    config.type = ScenarioType::SAND;
+    config.activity = 0.05f;
+    buildScenario(sparse, config);
+    config.activity = 0.5f;
+    buildScenario(dense, config);
+
+    size_t floor = 128 * 4;
+    EXPECT_GT(countNonAir(sparse), floor);
+    EXPECT_GT(countNonAir(dense), 2 * countNonAir(sparse));
+    EXPECT_LE(countNonAir(dense), 128u * 128u);
+}
+
+} // namespace test
+} // namespace astral
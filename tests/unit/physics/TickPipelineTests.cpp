@@ -0,0 +1,122 @@
+#include "astral/physics/TickPipeline.h"
+#include "astral/physics/CellularAutomaton.h"
+#include "astral/physics/Scenario.h"
+#include "astral/physics/WorldScheduler.h"
+#include <gtest/gtest.h>
+#include <map>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+uint64_t publishedHash(const PublishedTick& tick) {
+    uint64_t hash = 0;
+    std::vector<MaterialID> materials;
+    for (const auto& chunk : tick.chunks) {
+        materials.clear();
+        for (const Cell& cell : chunk.cells) materials.push_back(cell.material);
+        hash = combineChunkHash(hash, chunk.coord, hashMaterials(materials.data(), materials.size()));
+    }
+    return hash;
+}
+
+uint64_t activeHash(const ChunkManager& chunks) {
+    uint64_t hash = 0;
+    std::vector<MaterialID> materials(static_cast<size_t>(chunks.getChunkSize()) * chunks.getChunkSize());
+    for (const ChunkCoord& coord : chunks.getActiveChunks()) {
+        chunks.getChunk(coord)->copyMaterials(materials.data());
+        hash = combineChunkHash(hash, coord, hashMaterials(materials.data(), materials.size()));
+    }
+    return hash;
+}
+
+} // namespace
+
+TEST(TickPipelineTest, ConsumersSeeEachTickAsItEnded) {
+    ThreadPool pool(2);
+    auto world = std::make_shared<CellularAutomaton>(128, 128, MaterialRegistry::createShared());
+    ScenarioConfig config;
+    config.type = ScenarioType::MIXED;
+    buildScenario(*world, config);
+    
+    std::mutex mutex;
+    std::map<uint64_t, uint64_t> seen;
+    TickPipeline& pipeline = world->enablePipeline(pool);
+    pipeline.addConsumer("hash", [&](const PublishedTick& tick) {
+        uint64_t hash = publishedHash(tick);
+        std::lock_guard<std::mutex> lock(mutex);
+        seen[tick.tick] = hash;
+    });
+    EXPECT_EQ(pipeline.getConsumerCount(), 2u);
+    
+    std::map<uint64_t, uint64_t> expected;
+    for (uint64_t tick = 1; tick <= 8; tick++) {
+        world->update(1.0f / 60.0f);
+        expected[tick] = activeHash(world->getChunkManager());
+    }
+    world->flushPipeline();
+    
+    EXPECT_EQ(pipeline.getPublishedTicks(), 8u);
+    EXPECT_EQ(seen, expected);
+    EXPECT_GT(pipeline.getConsumerMilliseconds("stats"), 0.0);
+}
+
+TEST(TickPipelineTest, PipelinedStatsMatchSerialStats) {
+    ThreadPool pool(2);
+    auto registry = MaterialRegistry::createShared();
+    CellularAutomaton serial(96, 96, registry);
+    CellularAutomaton pipelined(96, 96, registry);
+    pipelined.enablePipeline(pool);
+    
+    // Static material only, so both worlds stay identical
+    for (CellularAutomaton* world : {&serial, &pipelined}) {
+        world->fillRectangle(0, 64, 96, 32, registry->getStoneID());
+        for (int tick = 0; tick < 5; tick++) {
+            world->update(1.0f / 60.0f);
+        }
+    }
+    pipelined.flushPipeline();
+    
+    const SimulationStats& a = serial.getSimulationStats();
+    const SimulationStats& b = pipelined.getSimulationStats();
+    EXPECT_EQ(a.totalCells, b.totalCells);
+    EXPECT_EQ(a.activeCells, b.activeCells);
+    EXPECT_EQ(a.activeChunks, b.activeChunks);
+    EXPECT_FLOAT_EQ(a.averageTemp, b.averageTemp);
+    EXPECT_EQ(a.materialCounts, b.materialCounts);
+}
+
+TEST(TickPipelineTest, WorldsTickingOnTheSamePoolDoNotDeadlock) {
+    // One worker: every consumer job queues behind the ticking worlds, so the
+    // ticking thread has to run them itself
+    ThreadPool pool(1);
+    WorldScheduler scheduler(pool);
+    auto registry = MaterialRegistry::createShared();
+    for (int i = 0; i < 2; i++) {
+        auto world = std::make_shared<CellularAutomaton>(64, 64, registry);
+        world->enablePipeline(pool);
+        scheduler.addWorld(world);
+    }
+    
+    scheduler.run(1.0f / 60.0f, 10);
+    for (size_t i = 0; i < scheduler.getWorldCount(); i++) {
+        scheduler.getWorld(i).flushPipeline();
+        EXPECT_EQ(scheduler.getWorld(i).getPipeline()->getPublishedTicks(), 10u);
+    }
+}
+
+TEST(TickPipelineTest, InlinePipelineRunsConsumersDuringPublish) {
+    TickPipeline pipeline(nullptr);
+    int calls = 0;
+    pipeline.addConsumer("count", [&](const PublishedTick&) { calls++; });
+    
+    for (int i = 0; i < 3; i++) {
+        pipeline.beginPublish().tick = i;
+        pipeline.publish();
+        EXPECT_EQ(calls, i + 1);
+    }
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,96 @@
+#include "astral/physics/CellularAutomaton.h"
+#include <gtest/gtest.h>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+size_t countMaterial(const CellularAutomaton& world, int x, int y, int width, int height, MaterialID material) {
+    size_t count = 0;
+    for (int cy = y; cy < y + height; cy++) {
+        for (int cx = x; cx < x + width; cx++) {
+            count += world.getCell(cx, cy).material == material;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST(UnboundedWorldTest, ChunksBecomeResidentWhenWritten) {
+    auto registry = MaterialRegistry::createShared();
+    CellularAutomaton world(CellularAutomaton::UNBOUNDED, CellularAutomaton::UNBOUNDED, registry);
+    EXPECT_TRUE(world.isUnbounded());
+    EXPECT_EQ(world.getResidentChunkCount(), 0);
+    
+    // Far from the origin in both directions
+    MaterialID stone = registry->getStoneID();
+    world.setCell(5000000, -3000000, stone);
+    world.setCell(-7000001, 9000000, stone);
+    EXPECT_EQ(world.getResidentChunkCount(), 2);
+    EXPECT_EQ(world.getCell(5000000, -3000000).material, stone);
+    EXPECT_EQ(world.getCell(-7000001, 9000000).material, stone);
+    
+    world.update(1.0f / 60.0f);
+    EXPECT_EQ(world.getSimulationStats().activeChunks, 2);
+    EXPECT_EQ(world.getSimulationStats().totalCells, 2 * CHUNK_SIZE * CHUNK_SIZE);
+    
+    world.clearWorld();
+    EXPECT_EQ(world.getResidentChunkCount(), 0);
+}
+
+TEST(UnboundedWorldTest, UnloadedChunksActAsWalls) {
+    auto registry = MaterialRegistry::createShared();
+    CellularAutomaton world(CellularAutomaton::UNBOUNDED, CellularAutomaton::UNBOUNDED, registry);
+    
+    // Two chunks by two, placed away from the origin
+    const int originX = -1000 * CHUNK_SIZE;
+    const int originY = 400 * CHUNK_SIZE;
+    world.loadRegion(originX, originY, 2 * CHUNK_SIZE, 2 * CHUNK_SIZE);
+    ASSERT_EQ(world.getResidentChunkCount(), 4);
+    
+    MaterialID sand = registry->getSandID();
+    world.fillRectangle(originX + 10, originY, 4, 2, sand);
+    
+    for (int tick = 0; tick < 4 * CHUNK_SIZE; tick++) {
+        world.update(1.0f / 60.0f);
+    }
+    
+    // Falling sand piles up on the edge of the resident area instead of
+    // loading new chunks below it
+    EXPECT_EQ(world.getResidentChunkCount(), 4);
+    EXPECT_EQ(countMaterial(world, originX, originY, 2 * CHUNK_SIZE, 2 * CHUNK_SIZE, sand), 8u);
+    EXPECT_GT(countMaterial(world, originX, originY + 2 * CHUNK_SIZE - 2, 2 * CHUNK_SIZE, 2, sand), 0u);
+}
+
+TEST(UnboundedWorldTest, UnloadKeepsOnlyTheGivenArea) {
+    auto registry = MaterialRegistry::createShared();
+    CellularAutomaton world(CellularAutomaton::UNBOUNDED, CellularAutomaton::UNBOUNDED, registry);
+    world.loadRegion(0, 0, 3 * CHUNK_SIZE, CHUNK_SIZE);
+    world.loadRegion(100000, 100000, CHUNK_SIZE, CHUNK_SIZE);
+    ASSERT_EQ(world.getResidentChunkCount(), 4);
+    
+    EXPECT_EQ(world.unloadChunksOutside(0, 0, CHUNK_SIZE, CHUNK_SIZE), 3u);
+    EXPECT_EQ(world.getResidentChunkCount(), 1);
+    
+    // Ticking does not bring the unloaded chunks back
+    world.update(1.0f / 60.0f);
+    EXPECT_EQ(world.getResidentChunkCount(), 1);
+}
+
+TEST(UnboundedWorldTest, SingleUnboundedAxis) {
+    auto registry = MaterialRegistry::createShared();
+    CellularAutomaton world(CellularAutomaton::UNBOUNDED, 64, registry);
+    EXPECT_TRUE(world.isInBounds(-123456, 10));
+    EXPECT_FALSE(world.isInBounds(0, 64));
+    EXPECT_FALSE(world.isInBounds(0, -1));
+    
+    // Painting is clipped vertically only
+    world.fillRectangle(-10, 60, 20, 10, registry->getStoneID());
+    EXPECT_EQ(countMaterial(world, -10, 60, 20, 4, registry->getStoneID()), 80u);
+    EXPECT_EQ(world.getResidentChunkCount(), 2);
+}
+
+} // namespace test
+} // namespace astral
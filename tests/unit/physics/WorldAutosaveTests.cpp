@@ -0,0 +1,152 @@
+#include "astral/physics/WorldAutosave.h"
+#include "astral/physics/CellularAutomaton.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+
+namespace astral {
+namespace test {
+
+namespace {
+
+constexpr float TICK = 1.0f / 60.0f;
+
+std::string tempPath(const std::string& name) {
+    std::string path = (std::filesystem::temp_directory_path() / ("astral_" + name + ".region")).string();
+    std::filesystem::remove(path);
+    return path;
+}
+
+bool sameCells(const CellularAutomaton& a, const CellularAutomaton& b) {
+    for (int y = 0; y < a.getWorldHeight(); y++) {
+        for (int x = 0; x < a.getWorldWidth(); x++) {
+            const Cell& left = a.getCell(x, y);
+            const Cell& right = b.getCell(x, y);
+            if (left != right || left.health != right.health || left.lifetime != right.lifetime ||
+                left.charge != right.charge || left.stateFlags != right.stateFlags) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(WorldAutosaveTest, SaveWorldRoundTrips) {
+    std::string path = tempPath("roundtrip");
+    CellularAutomaton world(64, 64, 16);
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    world.fillRectangle(0, 56, 64, 8, registry.getStoneID());
+    world.fillRectangle(14, 14, 12, 12, registry.getSandID());
+    world.fillRectangle(40, 26, 10, 8, registry.getWaterID());
+    world.getCell(3, 3).temperature = 812.5f;
+    world.getCell(4, 3).setFlag(Cell::FLAG_BURNING);
+    for (int i = 0; i < 20; i++) {
+        world.update(TICK);
+    }
+    ASSERT_TRUE(world.saveWorld(path));
+
+    CellularAutomaton loaded(64, 64, 16);
+    ASSERT_TRUE(loaded.loadWorld(path));
+    EXPECT_TRUE(sameCells(world, loaded));
+
+    // Loading replaces a modified world entirely, including the chunks the
+    // file does not have
+    CellularAutomaton wider(96, 64, 16);
+    wider.fillRectangle(0, 0, 96, 64, registry.getWaterID());
+    wider.update(TICK);
+    ASSERT_TRUE(wider.loadWorld(path));
+    EXPECT_TRUE(sameCells(world, wider));
+    EXPECT_EQ(wider.getCell(80, 10).material, registry.getDefaultMaterialID());
+    EXPECT_EQ(wider.getCell(80, 60).material, registry.getDefaultMaterialID());
+
+    // Another chunk size cannot read it
+    CellularAutomaton other(64, 64, 32);
+    EXPECT_FALSE(other.loadWorld(path));
+    EXPECT_FALSE(loaded.loadWorld(tempPath("missing")));
+}
+
+TEST(WorldAutosaveTest, SavesOnlyChangedChunksInTheBackground) {
+    std::string path = tempPath("incremental");
+    CellularAutomaton world(128, 128, 16);
+    const MaterialRegistry& registry = world.getMaterialRegistry();
+    world.fillRectangle(0, 120, 128, 8, registry.getStoneID());
+    WorldAutosaveConfig config;
+    config.intervalSeconds = 0.5f;
+    ASSERT_TRUE(world.enableAutosave(path, config));
+    WorldAutosave& autosave = *world.getAutosave();
+
+    // The first save covers the whole active world
+    for (int i = 0; i < 31; i++) {
+        world.update(TICK);
+    }
+    autosave.flush();
+    WorldAutosaveStats first = autosave.getStats();
+    EXPECT_EQ(first.saves, 1u);
+    EXPECT_EQ(first.chunksWritten, 64u);
+
+    // Once everything has settled, only a chunk that is edited is written
+    for (int i = 0; i < 300; i++) {
+        world.update(TICK);
+    }
+    autosave.flush();
+    WorldAutosaveStats settled = autosave.getStats();
+    world.fillRectangle(66, 100, 4, 4, registry.getStoneID());
+    for (int i = 0; i < 31; i++) {
+        world.update(TICK);
+    }
+    autosave.flush();
+    WorldAutosaveStats edited = autosave.getStats();
+    EXPECT_EQ(edited.chunksWritten - settled.chunksWritten, 1u);
+    EXPECT_GT(edited.chunksUnchanged, settled.chunksUnchanged);
+    EXPECT_EQ(edited.failures, 0u);
+
+    world.disableAutosave();
+    CellularAutomaton loaded(128, 128, 16);
+    ASSERT_TRUE(loaded.loadWorld(path));
+    EXPECT_TRUE(sameCells(world, loaded));
+}
+
+TEST(WorldAutosaveTest, TornRecordsAreCutAndCompactionKeepsTheNewest) {
+    std::string path = tempPath("compact");
+    std::vector<Cell> cells(16 * 16, Cell(1));
+    std::vector<uint8_t> encoded;
+    uint64_t fullSize = 0;
+    {
+        RegionFile file;
+        ASSERT_TRUE(file.open(path, 16, true));
+        for (int version = 0; version < 5; version++) {
+            cells[0].temperature = 100.0f + version;
+            RegionFile::encodeCells(cells.data(), cells.size(), encoded);
+            ASSERT_TRUE(file.append({0, 0}, version, encoded));
+            ASSERT_TRUE(file.append({1, -2}, version, encoded));
+        }
+        ASSERT_TRUE(file.sync());
+        fullSize = file.getFileBytes();
+        EXPECT_EQ(file.getChunkCount(), 2u);
+        EXPECT_LT(file.getLiveBytes() * 4, fullSize);
+    }
+
+    // A crash in the middle of an append leaves half a record
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out.write("\x40\x00\x00\x00\x12\x34", 6);
+    }
+    RegionFile file;
+    ASSERT_TRUE(file.open(path, 16, false));
+    EXPECT_EQ(file.getFileBytes(), fullSize);
+    EXPECT_EQ(std::filesystem::file_size(path), fullSize);
+
+    ASSERT_TRUE(file.compact());
+    EXPECT_EQ(file.getFileBytes(), file.getLiveBytes());
+    EXPECT_EQ(std::filesystem::file_size(path), file.getLiveBytes());
+    std::vector<Cell> read(16 * 16);
+    ASSERT_TRUE(file.read({1, -2}, read.data()));
+    EXPECT_FLOAT_EQ(read[0].temperature, 104.0f);
+    EXPECT_EQ(read[255].material, 1);
+    EXPECT_FALSE(file.read({5, 5}, read.data()));
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,44 @@
+#include "astral/physics/WorldScheduler.h"
+#include <gtest/gtest.h>
+
+namespace astral {
+namespace test {
+
+TEST(WorldSchedulerTest, WorldsShareOneRegistry) {
+    auto registry = MaterialRegistry::createShared();
+    CellularAutomaton first(64, 64, registry);
+    CellularAutomaton second(64, 64, registry);
+    first.initialize();
+    second.initialize();
+    
+    EXPECT_EQ(&first.getMaterialRegistry(), registry.get());
+    EXPECT_EQ(&second.getMaterialRegistry(), registry.get());
+    EXPECT_EQ(first.getMaterialIDByName("Sand"), second.getMaterialIDByName("Sand"));
+}
+
+TEST(WorldSchedulerTest, RunTicksEveryWorld) {
+    auto registry = MaterialRegistry::createShared();
+    ThreadPool pool(4);
+    WorldScheduler scheduler(pool);
+    
+    for (int i = 0; i < 6; i++) {
+        auto world = std::make_shared<CellularAutomaton>(64, 64, registry);
+        world->initialize();
+        world->fillRectangle(10, 10, 20, 5, world->getMaterialIDByName("Sand"));
+        scheduler.addWorld(world);
+    }
+    
+    scheduler.run(1.0f / 60.0f, 3);
+    scheduler.run(1.0f / 60.0f, 2);
+    
+    ASSERT_EQ(scheduler.getWorldCount(), 6u);
+    for (size_t i = 0; i < scheduler.getWorldCount(); i++) {
+        EXPECT_EQ(scheduler.getWorldTicks(i), 5u);
+        EXPECT_EQ(scheduler.getLastRunTickTimes(i).size(), 2u);
+        EXPECT_LT(static_cast<size_t>(scheduler.getWorldCoreGroup(i)), pool.getCoreGroupCount());
+    }
+    EXPECT_GT(scheduler.getLastRunSeconds(), 0.0);
+}
+
+} // namespace test
+} // namespace astral
@@ -0,0 +1,64 @@
+#include "astral/physics/WorldShard.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+
+namespace astral {
+namespace test {
+
+TEST(WorldShardTest, StripsCoverWholeChunkColumns) {
+    auto exchange = ShardExchange::create("astral_shard_test_" + std::to_string(getpid()),
+                                          CHUNK_SIZE * 5, 64, 2);
+    EXPECT_EQ(exchange->getShardBegin(0), 0);
+    EXPECT_EQ(exchange->getShardEnd(0), CHUNK_SIZE * 2);
+    EXPECT_EQ(exchange->getShardBegin(1), CHUNK_SIZE * 2);
+    EXPECT_EQ(exchange->getShardEnd(1), CHUNK_SIZE * 5);
+    
+    EXPECT_THROW(ShardExchange::create("astral_shard_bad", CHUNK_SIZE * 2 + 1, 64, 2),
+                 std::invalid_argument);
+    EXPECT_THROW(ShardExchange::create("astral_shard_bad", CHUNK_SIZE, 64, 2),
+                 std::invalid_argument);
+}
+
+TEST(WorldShardTest, CellsCrossBoundaryWithoutLoss) {
+    const std::string name = "astral_shard_test_" + std::to_string(getpid());
+    const int width = CHUNK_SIZE * 4;
+    const int height = 64;
+    const int ticks = 60;
+    auto registry = MaterialRegistry::createShared();
+    auto exchange = ShardExchange::create(name, width, height, 2);
+    MaterialID sand = registry->getIDFromName("Sand");
+    MaterialID stone = registry->getIDFromName("Stone");
+    
+    size_t counts[2] = {0, 0};
+    auto runShard = [&](int index) {
+        auto attached = ShardExchange::open(name);
+        WorldShard shard(*attached, index, registry);
+        
+        // A sand column on the boundary spreads into both strips
+        shard.fillRectangle(0, height - 2, width, 2, stone);
+        shard.fillRectangle(width / 2 - 4, 4, 8, 40, sand);
+        shard.run(1.0f / 60.0f, ticks);
+        counts[index] = shard.countMaterial(sand);
+    };
+    
+    std::thread left(runShard, 0);
+    std::thread right(runShard, 1);
+    left.join();
+    right.join();
+    
+    uint64_t sent = 0;
+    uint64_t dropped = 0;
+    for (int i = 0; i < 2; i++) {
+        EXPECT_EQ(exchange->getStats(i).ticks, static_cast<uint64_t>(ticks));
+        sent += exchange->getStats(i).migrantsSent;
+        dropped += exchange->getStats(i).migrantsDropped;
+    }
+    
+    EXPECT_GT(sent, 0u);
+    EXPECT_EQ(dropped, 0u);
+    EXPECT_EQ(counts[0] + counts[1], 8u * 40u);
+}
+
+} // namespace test
+} // namespace astral